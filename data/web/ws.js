@@ -107,10 +107,15 @@ cpjs.ws.Client.prototype._onMessage = function(msg) {
             } else if ("FINISHED" == rsp.event) {
                 rsp.duration = parseInt(data[1]);
                 rsp.activeGroup = parseInt(data[2]);
+                /* An implausible lap time is marked, a held one waits for confirmRun(). */
+                rsp.isPending = ("PENDING" === data[3]);
+                rsp.isSuspicious = (("SUSPICIOUS" === data[3]) || (true === rsp.isPending));
             } else if("TABLE" == rsp.event){
                 rsp.activeGroup = parseInt(data[1]);
                 rsp.duration = parseInt(data[2]);
                 rsp.name = data[3];
+            } else if ("CHANGED" == rsp.event) {
+                /* No further parameter */
             } else {
                 console.error("Unknown event: " + rsp.event);
             }
@@ -131,12 +136,21 @@ cpjs.ws.Client.prototype._onMessage = function(msg) {
                 this.pendingCmd.resolve(rsp);
             } else if ("GET_GROUPS" === this.pendingCmd.name) {
                 rsp.groups = parseInt(data[1]);
+                rsp.maxGroups = parseInt(data[2]);
                 this.pendingCmd.resolve(rsp);
             } else if ("SET_GROUPS" === this.pendingCmd.name) {
                 this.pendingCmd.resolve(rsp);
             } else if ("GET_TABLE" === this.pendingCmd.name) {
                 rsp.groups = parseInt(data[1]);
                 this.pendingCmd.resolve(rsp);
+            } else if ("GET_STATS" === this.pendingCmd.name) {
+                rsp.group = parseInt(data[1]);
+                rsp.laps = parseInt(data[2]);
+                rsp.mean = parseInt(data[3]);
+                rsp.stdDev = parseInt(data[4]);
+                rsp.median = parseInt(data[5]);
+                rsp.p90 = parseInt(data[6]);
+                this.pendingCmd.resolve(rsp);
             } else if ("CLEAR" === this.pendingCmd.name) {
                 rsp.cleared = parseInt(data[1]);
                 this.pendingCmd.resolve(rsp);
@@ -153,6 +167,49 @@ cpjs.ws.Client.prototype._onMessage = function(msg) {
                 this.pendingCmd.resolve(rsp);
             } else if ("REJECT_RUN" === this.pendingCmd.name) {
                 this.pendingCmd.resolve(rsp);
+            } else if (("UNDO" === this.pendingCmd.name) || ("REDO" === this.pendingCmd.name)) {
+                rsp.run = parseInt(data[1]);
+                this.pendingCmd.resolve(rsp);
+            } else if ("GET_JOURNAL" === this.pendingCmd.name) {
+                rsp.runs = [];
+                for(index = 2; index < data.length; ++index) {
+                    var run = data[index].split(":");
+                    rsp.runs.push({
+                        run: parseInt(run[0]),
+                        group: parseInt(run[1]),
+                        lapTime: parseInt(run[2]),
+                        isUndone: ("1" === run[3])
+                    });
+                }
+                this.pendingCmd.resolve(rsp);
+            } else if ("GET_BLIND_PERIOD" === this.pendingCmd.name) {
+                rsp.period = parseInt(data[1]);
+                rsp.ratio = parseInt(data[2]);
+                rsp.effective = parseInt(data[3]);
+                this.pendingCmd.resolve(rsp);
+            } else if ("SET_BLIND_PERIOD" === this.pendingCmd.name) {
+                rsp.effective = parseInt(data[1]);
+                this.pendingCmd.resolve(rsp);
+            } else if ("CONFIRM_RUN" === this.pendingCmd.name) {
+                this.pendingCmd.resolve(rsp);
+            } else if ("HOLD_SUSPICIOUS" === this.pendingCmd.name) {
+                rsp.isEnabled = ("1" === data[1]);
+                this.pendingCmd.resolve(rsp);
+            } else if ("BATCH" === this.pendingCmd.name) {
+                rsp.count = parseInt(data[1]);
+                this.pendingCmd.resolve(rsp);
+            } else if ("GET_METRICS" === this.pendingCmd.name) {
+                rsp.metrics = {};
+                for(index = 1; index < data.length; ++index) {
+                    var metric = data[index].split(":");
+                    rsp.metrics[metric[0]] = {
+                        count: parseInt(metric[1]),
+                        mean: parseInt(metric[2]),
+                        p99: parseInt(metric[3]),
+                        max: parseInt(metric[4])
+                    };
+                }
+                this.pendingCmd.resolve(rsp);
             } else {
                 console.error("Unknown command: " + this.pendingCmd.name);
                 this.pendingCmd.reject();
@@ -296,4 +353,187 @@ cpjs.ws.Client.prototype.rejectRun =  function () {
             });
         }
     }.bind(this));
+};
+
+/* Undo the latest applied run. Repeated calls undo the runs before it. */
+cpjs.ws.Client.prototype.undo =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "UNDO",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Redo the earliest undone run. A new run discards all undone runs. */
+cpjs.ws.Client.prototype.redo =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "REDO",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Get the recent runs, the oldest first. */
+cpjs.ws.Client.prototype.getJournal =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "GET_JOURNAL",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Get the blind period after the start in ms. The ratio is in % of the track record, 0 if the blind period is fixed. */
+cpjs.ws.Client.prototype.getBlindPeriod =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "GET_BLIND_PERIOD",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Set a fixed blind period in ms or with a ratio in %, an adaptive one with period as minimum. */
+cpjs.ws.Client.prototype.setBlindPeriod =  function (period, ratio) {
+    return new Promise( function (resolve, reject) {
+        if ((null === this.socket) || ("number" !== typeof period)) {
+            reject();
+        } else {
+            this._sendCmd({
+                name: "SET_BLIND_PERIOD",
+                par: ("number" === typeof ratio) ? (period + ":" + ratio) : period,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Apply a held lap time, see holdSuspicious(). */
+cpjs.ws.Client.prototype.confirmRun =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "CONFIRM_RUN",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Hold implausible lap times until confirmRun() or rejectRun(), instead of only marking them. */
+cpjs.ws.Client.prototype.holdSuspicious =  function (isEnabled) {
+    return new Promise( function (resolve, reject) {
+        if ((null === this.socket) || ("boolean" !== typeof isEnabled)) {
+            reject();
+        } else {
+            this._sendCmd({
+                name: "HOLD_SUSPICIOUS",
+                par: (true === isEnabled) ? "1" : "0",
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+cpjs.ws.Client.prototype.clearName =  function (group) {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else if ((typeof group === 'number') && (isFinite(group))) {
+            this._sendCmd({
+                name: "CLEAR_NAME",
+                par: group,
+                resolve: resolve,
+                reject: reject
+            });
+        } else {
+            reject();
+        }
+    }.bind(this));
+};
+
+/* Get the lap time statistics of a group, all times are in ms. */
+cpjs.ws.Client.prototype.getStats =  function (group) {
+    return new Promise( function (resolve, reject) {
+        if ((null === this.socket) || ("number" !== typeof group)) {
+            reject();
+        } else {
+            this._sendCmd({
+                name: "GET_STATS",
+                par: group,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+cpjs.ws.Client.prototype.getMetrics =  function () {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else {
+            this._sendCmd({
+                name: "GET_METRICS",
+                par: null,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+/* Send several commands at once, which are applied all or nothing.
+ * Each command is an object like { name: "SET_NAME", par: "0:Team A" }.
+ * Supported commands: SET_NAME, CLEAR, CLEAR_NAME and SET_GROUPS.
+ */
+cpjs.ws.Client.prototype.batch =  function (cmds) {
+    return new Promise( function (resolve, reject) {
+        if (null === this.socket){
+            reject();
+        } else if ((Array.isArray(cmds)) && (0 < cmds.length)) {
+            this._sendCmd({
+                name: "BATCH",
+                par: cmds.map(function(cmd) {
+                    return cmd.name + ":" + cmd.par;
+                }).join(";"),
+                resolve: resolve,
+                reject: reject
+            });
+        } else {
+            reject();
+        }
+    }.bind(this));
 };
\ No newline at end of file
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "Board.h"
+#include <Log.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -46,10 +47,20 @@
  * Types and classes
  *****************************************************************************/
 
+/** Header of the data in the RTC user memory. */
+typedef struct
+{
+    uint32_t    crc;    /**< CRC-32 of the size and the data. */
+    uint32_t    size;   /**< Data size in byte. */
+
+} RtcHeader;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
+static uint32_t calculateCrc32(uint32_t crc, const uint8_t* data, size_t size);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -63,6 +74,12 @@ static const uint8_t    SENSOR_DIN_PIN          = 5U;
 /** Duration in ms before the MCU will be reset, caused by fatal error halt. */
 static const uint32_t   FATAL_ERROR_WAIT_TIME   = 30000U;
 
+/**
+ * Offset of the data in the RTC user memory in 32-bit blocks. The first
+ * 128 byte are used by the boot loader for OTA updates.
+ */
+static const uint32_t   RTC_DATA_OFFSET         = 32U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -96,10 +113,61 @@ bool Board::isRobotDetected()
 
 void Board::errorHalt()
 {
+    Log::flush();
     delay(FATAL_ERROR_WAIT_TIME);
     ESP.restart();
 }
 
+bool Board::writeRtcData(const void* data, size_t size)
+{
+    bool        isSuccess   = false;
+    uint32_t    block[(sizeof(RtcHeader) + RTC_DATA_MAX_SIZE + sizeof(uint32_t) - 1U) / sizeof(uint32_t)];
+
+    if ((nullptr != data) &&
+        (RTC_DATA_MAX_SIZE >= size))
+    {
+        RtcHeader header;
+
+        header.size = size;
+        header.crc  = calculateCrc32(0U, reinterpret_cast<const uint8_t*>(&header.size), sizeof(header.size));
+        header.crc  = calculateCrc32(header.crc, static_cast<const uint8_t*>(data), size);
+
+        memcpy(block, &header, sizeof(header));
+        memcpy(reinterpret_cast<uint8_t*>(block) + sizeof(header), data, size);
+
+        /* The RTC memory is written in 32-bit blocks. */
+        isSuccess = ESP.rtcUserMemoryWrite(RTC_DATA_OFFSET, block, (sizeof(header) + size + sizeof(uint32_t) - 1U) & ~(sizeof(uint32_t) - 1U));
+    }
+
+    return isSuccess;
+}
+
+bool Board::readRtcData(void* data, size_t size)
+{
+    bool        isValid = false;
+    uint32_t    block[(sizeof(RtcHeader) + RTC_DATA_MAX_SIZE + sizeof(uint32_t) - 1U) / sizeof(uint32_t)];
+
+    if ((nullptr != data) &&
+        (RTC_DATA_MAX_SIZE >= size) &&
+        (true == ESP.rtcUserMemoryRead(RTC_DATA_OFFSET, block, (sizeof(RtcHeader) + size + sizeof(uint32_t) - 1U) & ~(sizeof(uint32_t) - 1U))))
+    {
+        RtcHeader       header;
+        const uint8_t*  payload = reinterpret_cast<const uint8_t*>(block) + sizeof(header);
+
+        memcpy(&header, block, sizeof(header));
+
+        /* After a power-on the RTC memory content is random. */
+        if ((size == header.size) &&
+            (header.crc == calculateCrc32(calculateCrc32(0U, reinterpret_cast<const uint8_t*>(&header.size), sizeof(header.size)), payload, size)))
+        {
+            memcpy(data, payload, size);
+            isValid = true;
+        }
+    }
+
+    return isValid;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -114,4 +182,35 @@ void Board::errorHalt()
 
 /******************************************************************************
  * Local Functions
- *****************************************************************************/
\ No newline at end of file
+ *****************************************************************************/
+
+/**
+ * Calculate the CRC-32 (IEEE 802.3) bitwise. The data is small, therefore
+ * no table is spent.
+ *
+ * @param[in] crc   CRC of the previous data, 0 at start.
+ * @param[in] data  Data
+ * @param[in] size  Data size in byte.
+ *
+ * @return CRC-32
+ */
+static uint32_t calculateCrc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    size_t idx = 0U;
+
+    crc = ~crc;
+
+    for (idx = 0U; idx < size; ++idx)
+    {
+        uint8_t bit = 0U;
+
+        crc ^= data[idx];
+
+        for (bit = 0U; bit < 8U; ++bit)
+        {
+            crc = (crc >> 1U) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
\ No newline at end of file
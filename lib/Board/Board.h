@@ -69,6 +69,28 @@ namespace Board
      */
     void errorHalt();
 
+    /**
+     *  Store data in the RTC user memory, which survives a restart, but
+     *  not a power loss. The data is protected by a CRC.
+     * 
+     *  @param[in] data Data
+     *  @param[in] size Data size in byte, max. RTC_DATA_MAX_SIZE.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool writeRtcData(const void* data, size_t size);
+
+    /**
+     *  Load data from the RTC user memory, which was stored by writeRtcData().
+     * 
+     *  @param[out] data    Data
+     *  @param[in]  size    Data size in byte, must be the stored size.
+     *  @return If valid data of this size is stored, returns true. Otherwise, false.
+     */
+    bool readRtcData(void* data, size_t size);
+
+    /** Max. size in byte of the data in the RTC user memory. */
+    static const size_t RTC_DATA_MAX_SIZE = 256U;
+
 };
 
 /******************************************************************************
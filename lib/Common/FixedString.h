@@ -0,0 +1,378 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  String with a fixed capacity, which never allocates memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef FIXED_STRING_H_
+#define FIXED_STRING_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  String with a fixed capacity, which is stored inline.
+ *
+ *  In difference to the Arduino String it never allocates memory, therefore
+ *  it doesn't fragment the heap, no matter how often a message is built. If
+ *  the capacity is exceeded, the string is truncated and marked as truncated.
+ *  Numbers are appended in decimal, like the String does.
+ *
+ *  @tparam CAPACITY Max. number of characters, without string termination.
+ */
+template <size_t CAPACITY>
+class FixedString
+{
+public:
+
+    /**
+     * Constructs a empty string.
+     */
+    FixedString() :
+        m_length(0U),
+        m_isTruncated(false)
+    {
+        m_buffer[0U] = '\0';
+    }
+
+    /**
+     * Constructs a string with the given characters.
+     *
+     * @param[in] str   Null-terminated string
+     */
+    FixedString(const char* str) :
+        m_length(0U),
+        m_isTruncated(false)
+    {
+        m_buffer[0U] = '\0';
+        (void)append(str);
+    }
+
+    /**
+     * Destroys the string.
+     */
+    ~FixedString()
+    {
+    }
+
+    /**
+     * Assign characters.
+     *
+     * @param[in] str   Null-terminated string
+     *
+     * @return This string
+     */
+    FixedString& operator=(const char* str)
+    {
+        clear();
+
+        return append(str);
+    }
+
+    /**
+     * Append a value, see append().
+     *
+     * @param[in] value Value
+     *
+     * @return This string
+     */
+    template <typename T>
+    FixedString& operator+=(T value)
+    {
+        return append(value);
+    }
+
+    /**
+     * Get the null-terminated characters.
+     *
+     * @return Characters
+     */
+    const char* c_str() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * Get the number of characters, without string termination.
+     *
+     * @return Length
+     */
+    size_t length() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Get the max. number of characters, without string termination.
+     *
+     * @return Capacity
+     */
+    size_t capacity() const
+    {
+        return CAPACITY;
+    }
+
+    /**
+     * Is the string empty?
+     *
+     * @return If empty, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return (0U == m_length);
+    }
+
+    /**
+     * Was something cut off, because the capacity was exceeded?
+     *
+     * @return If truncated, it will return true otherwise false.
+     */
+    bool isTruncated() const
+    {
+        return m_isTruncated;
+    }
+
+    /**
+     * Compare with null-terminated characters.
+     *
+     * @param[in] str   Null-terminated string
+     *
+     * @return If equal, it will return true otherwise false.
+     */
+    bool equals(const char* str) const
+    {
+        return ((nullptr != str) && (0 == strcmp(m_buffer, str)));
+    }
+
+    /**
+     * Remove all characters.
+     */
+    void clear()
+    {
+        m_length        = 0U;
+        m_isTruncated   = false;
+        m_buffer[0U]    = '\0';
+    }
+
+    /**
+     * Append characters.
+     *
+     * @param[in] str       Characters, need no string termination.
+     * @param[in] length    Number of characters.
+     *
+     * @return This string
+     */
+    FixedString& append(const char* str, size_t length)
+    {
+        if (nullptr != str)
+        {
+            if ((CAPACITY - m_length) < length)
+            {
+                length          = CAPACITY - m_length;
+                m_isTruncated   = true;
+            }
+
+            memcpy(&m_buffer[m_length], str, length);
+            m_length += length;
+            m_buffer[m_length] = '\0';
+        }
+
+        return *this;
+    }
+
+    /**
+     * Append null-terminated characters.
+     *
+     * @param[in] str   Null-terminated string
+     *
+     * @return This string
+     */
+    FixedString& append(const char* str)
+    {
+        if (nullptr != str)
+        {
+            (void)append(str, strlen(str));
+        }
+
+        return *this;
+    }
+
+    /**
+     * Append a string of any capacity.
+     *
+     * @param[in] str   String
+     *
+     * @return This string
+     */
+    template <size_t OTHER_CAPACITY>
+    FixedString& append(const FixedString<OTHER_CAPACITY>& str)
+    {
+        return append(str.c_str(), str.length());
+    }
+
+    /**
+     * Append a single character.
+     *
+     * @param[in] value Character
+     *
+     * @return This string
+     */
+    FixedString& append(char value)
+    {
+        return append(&value, 1U);
+    }
+
+    /**
+     * Append a number in decimal.
+     *
+     * @param[in] value Number
+     *
+     * @return This string
+     */
+    FixedString& append(unsigned char value)
+    {
+        return append(static_cast<unsigned long>(value));
+    }
+
+    /** @copydoc append(unsigned char) */
+    FixedString& append(unsigned short value)
+    {
+        return append(static_cast<unsigned long>(value));
+    }
+
+    /** @copydoc append(unsigned char) */
+    FixedString& append(unsigned int value)
+    {
+        return append(static_cast<unsigned long>(value));
+    }
+
+    /** @copydoc append(unsigned char) */
+    FixedString& append(unsigned long value)
+    {
+        char    digits[DIGITS_SIZE];
+        size_t  idx     = DIGITS_SIZE;
+
+        do
+        {
+            --idx;
+            digits[idx] = static_cast<char>('0' + (value % 10U));
+            value /= 10U;
+        }
+        while (0U < value);
+
+        return append(&digits[idx], DIGITS_SIZE - idx);
+    }
+
+    /** @copydoc append(unsigned char) */
+    FixedString& append(int value)
+    {
+        return append(static_cast<long>(value));
+    }
+
+    /** @copydoc append(unsigned char) */
+    FixedString& append(long value)
+    {
+        if (0 > value)
+        {
+            (void)append('-');
+
+            /* Negate in unsigned arithmetic, which works for the min. value too. */
+            (void)append(0UL - static_cast<unsigned long>(value));
+        }
+        else
+        {
+            (void)append(static_cast<unsigned long>(value));
+        }
+
+        return *this;
+    }
+
+    /**
+     * Append formatted characters, like printf() does.
+     *
+     * @param[in] format    Format string
+     * @param[in] ...       Arguments
+     *
+     * @return This string
+     */
+    FixedString& appendFormat(const char* format, ...)
+    {
+        va_list args;
+        int     length  = 0;
+
+        va_start(args, format);
+        length = vsnprintf(&m_buffer[m_length], (CAPACITY - m_length) + 1U, format, args);
+        va_end(args);
+
+        if (0 > length)
+        {
+            /* Format error, discard the partial output. */
+            m_buffer[m_length] = '\0';
+        }
+        else if ((CAPACITY - m_length) < static_cast<size_t>(length))
+        {
+            m_length        = CAPACITY;
+            m_isTruncated   = true;
+        }
+        else
+        {
+            m_length += static_cast<size_t>(length);
+        }
+
+        return *this;
+    }
+
+private:
+
+    /** Max. number of decimal digits of a unsigned long. */
+    static const size_t DIGITS_SIZE = 20U;
+
+    char    m_buffer[CAPACITY + 1U];    /**< Characters with string termination. */
+    size_t  m_length;                   /**< Number of characters, without string termination. */
+    bool    m_isTruncated;              /**< Was something cut off? */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* FIXED_STRING_H_ */
@@ -0,0 +1,184 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed memory histogram
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Histogram.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+const uint32_t Histogram::TIME_BOUNDS[] =
+{
+    50U, 100U, 250U, 500U, 1000U, 2500U, 5000U, 10000U, 25000U, 50000U, 100000U, 250000U
+};
+
+const uint8_t Histogram::TIME_BOUNDS_COUNT = sizeof(Histogram::TIME_BOUNDS) / sizeof(Histogram::TIME_BOUNDS[0]);
+
+Histogram::Histogram(const uint32_t* bounds, uint8_t boundsCount) :
+    m_bounds(bounds),
+    m_boundsCount((MAX_BOUNDS < boundsCount) ? MAX_BOUNDS : boundsCount),
+    m_counters(),
+    m_count(0U),
+    m_sum(0U),
+    m_max(0U)
+{
+    if (nullptr == m_bounds)
+    {
+        m_boundsCount = 0U;
+    }
+}
+
+void Histogram::record(uint32_t value)
+{
+    uint8_t idx = 0U;
+
+    /* The number of buckets is small, a linear search is fast enough. */
+    while ((m_boundsCount > idx) && (m_bounds[idx] < value))
+    {
+        ++idx;
+    }
+
+    ++m_counters[idx];
+    ++m_count;
+    m_sum += value;
+
+    if (m_max < value)
+    {
+        m_max = value;
+    }
+}
+
+void Histogram::clear()
+{
+    uint8_t idx = 0U;
+
+    for (idx = 0U; idx <= MAX_BOUNDS; ++idx)
+    {
+        m_counters[idx] = 0U;
+    }
+
+    m_count = 0U;
+    m_sum   = 0U;
+    m_max   = 0U;
+}
+
+uint32_t Histogram::getBound(uint8_t idx) const
+{
+    uint32_t bound = UINT32_MAX;
+
+    if (m_boundsCount > idx)
+    {
+        bound = m_bounds[idx];
+    }
+
+    return bound;
+}
+
+uint32_t Histogram::getPercentileBound(uint8_t percent) const
+{
+    uint32_t bound = 0U;
+
+    if (0U < m_count)
+    {
+        /* Rank of the percentile, rounded up. */
+        uint64_t    rank    = ((static_cast<uint64_t>(m_count) * percent) + 99U) / 100U;
+        uint64_t    sum     = 0U;
+        uint8_t     idx     = 0U;
+
+        while ((m_boundsCount > idx) && ((sum + m_counters[idx]) < rank))
+        {
+            sum += m_counters[idx];
+            ++idx;
+        }
+
+        /* The max. value is a tighter bound, than the bucket bound. */
+        if ((m_boundsCount > idx) && (m_max > m_bounds[idx]))
+        {
+            bound = m_bounds[idx];
+        }
+        else
+        {
+            bound = m_max;
+        }
+    }
+
+    return bound;
+}
+
+uint32_t Histogram::getBucketCounter(uint8_t idx) const
+{
+    uint32_t counter = 0U;
+
+    if (m_boundsCount >= idx)
+    {
+        counter = m_counters[idx];
+    }
+
+    return counter;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
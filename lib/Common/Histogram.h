@@ -0,0 +1,184 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed memory histogram
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Histogram with a fixed number of buckets, which never allocates memory.
+ *  The buckets are defined by their inclusive upper bounds, values above
+ *  the last bound are counted in an additional overflow bucket (+Inf).
+ */
+class Histogram
+{
+public:
+
+    /** Max. number of bucket bounds, without the overflow bucket. */
+    static const uint8_t MAX_BOUNDS = 12U;
+
+    /** Bucket bounds in us, suitable for runtimes and latencies. */
+    static const uint32_t TIME_BOUNDS[];
+
+    /** Number of bucket bounds in TIME_BOUNDS. */
+    static const uint8_t TIME_BOUNDS_COUNT;
+
+    /**
+     *  Constructs a histogram.
+     *  The bounds are not copied, they must be available during the whole lifetime.
+     *
+     *  @param[in] bounds       Inclusive upper bounds in ascending order.
+     *  @param[in] boundsCount  Number of bounds. Bounds above MAX_BOUNDS are ignored.
+     */
+    Histogram(const uint32_t* bounds = TIME_BOUNDS, uint8_t boundsCount = TIME_BOUNDS_COUNT);
+
+    /**
+     *  Destroys the histogram.
+     */
+    ~Histogram()
+    {
+    }
+
+    /**
+     *  Record a single value.
+     *
+     *  @param[in] value    Value
+     */
+    void record(uint32_t value);
+
+    /**
+     *  Clear all recorded values.
+     */
+    void clear();
+
+    /**
+     *  Get the number of buckets, including the overflow bucket.
+     *
+     *  @return Number of buckets
+     */
+    uint8_t getBucketCount() const
+    {
+        return m_boundsCount + 1U;
+    }
+
+    /**
+     *  Get the inclusive upper bound of a bucket.
+     *
+     *  @param[in] idx  Bucket index
+     *  @return Upper bound. For the overflow bucket, UINT32_MAX is returned.
+     */
+    uint32_t getBound(uint8_t idx) const;
+
+    /**
+     *  Get the number of values in a single bucket (not cumulative).
+     *
+     *  @param[in] idx  Bucket index
+     *  @return Number of values. If the index is invalid, 0 is returned.
+     */
+    uint32_t getBucketCounter(uint8_t idx) const;
+
+    /**
+     *  Get the number of all recorded values.
+     *
+     *  @return Number of values
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     *  Get the sum of all recorded values.
+     *
+     *  @return Sum of values
+     */
+    uint64_t getSum() const
+    {
+        return m_sum;
+    }
+
+    /**
+     *  Get the upper bound of the bucket, which contains the given percentile.
+     *
+     *  @param[in] percent  Percentile in %, e.g. 99.
+     *  @return Upper bound, but never more than the max. value. If no value
+     *          is recorded, 0 is returned.
+     */
+    uint32_t getPercentileBound(uint8_t percent) const;
+
+    /**
+     *  Get the max. recorded value.
+     *
+     *  @return Max. value
+     */
+    uint32_t getMax() const
+    {
+        return m_max;
+    }
+
+private:
+
+    /** Inclusive upper bounds of the buckets. */
+    const uint32_t* m_bounds;
+
+    /** Number of bounds. */
+    uint8_t         m_boundsCount;
+
+    /** Number of values per bucket, the last one is the overflow bucket. */
+    uint32_t        m_counters[MAX_BOUNDS + 1U];
+
+    /** Number of all recorded values. */
+    uint32_t        m_count;
+
+    /** Sum of all recorded values. */
+    uint64_t        m_sum;
+
+    /** Max. recorded value. */
+    uint32_t        m_max;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* HISTOGRAM_H_ */
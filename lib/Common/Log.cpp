@@ -42,6 +42,11 @@
  * Macros
  *****************************************************************************/
 
+/** Size of the log ring buffer in byte. */
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE     2048U
+#endif
+
 /******************************************************************************
  * Types and classes
  *****************************************************************************/
@@ -50,12 +55,42 @@
  * Prototypes
  *****************************************************************************/
 
-static void printHead(const char* filename, int lineNumber, Log::Level level);
+static const char* getLevelStr(Log::Level level);
+static bool isEnabled(Log::Level level);
+static void write(const char* msg, size_t length, Log::Level level);
+static size_t getUsed();
+static size_t drain(size_t maxLength);
+static void reportDropped();
 
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Max. size of a single log message in byte, including the head. */
+static const size_t     MESSAGE_BUFFER_SIZE = 256U;
+
+/**
+ * Ring buffer with the formatted log messages.
+ * There is only one producer and one consumer, both in the main loop
+ * context, therefore the read and write index need no lock.
+ */
+static char             gRingBuffer[LOG_BUFFER_SIZE];
+
+/** Write index in the ring buffer, only changed by the producer. */
+static volatile size_t  gWriteIdx       = 0U;
+
+/** Read index in the ring buffer, only changed by the consumer. */
+static volatile size_t  gReadIdx        = 0U;
+
+/** Min. log level at runtime. */
+static Log::Level       gLevel          = Log::LOG_INFO;
+
+/** Number of dropped log messages since start. */
+static uint32_t         gDroppedCount   = 0U;
+
+/** Number of dropped log messages, which are already reported. */
+static uint32_t         gReportedCount  = 0U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -74,31 +109,142 @@ static void printHead(const char* filename, int lineNumber, Log::Level level);
 
 void Log::print(const char* filename, int lineNumber, Log::Level level, const char* format, ...)
 {
-    const size_t    MESSAGE_BUFFER_SIZE = 512;
-    char            buffer[MESSAGE_BUFFER_SIZE];
-    va_list         args;
+    if (true == isEnabled(level))
+    {
+        char    buffer[MESSAGE_BUFFER_SIZE];
+        int     headLength  = snprintf(buffer, MESSAGE_BUFFER_SIZE, "%6lu %24s (%5u) %7s ", millis(), filename, lineNumber, getLevelStr(level));
+        size_t  length      = 0U;
+        va_list args;
+
+        if (0 < headLength)
+        {
+            length = static_cast<size_t>(headLength);
+        }
+
+        /* Keep space for the line feed. */
+        if ((MESSAGE_BUFFER_SIZE - 1U) > length)
+        {
+            int msgLength = 0;
+
+            va_start(args, format);
+            msgLength = vsnprintf(&buffer[length], MESSAGE_BUFFER_SIZE - 1U - length, format, args);
+            va_end(args);
 
-    printHead(filename, lineNumber, level);
+            if (0 < msgLength)
+            {
+                length += static_cast<size_t>(msgLength);
+            }
+        }
 
-    va_start(args, format);
-    vsnprintf(buffer, MESSAGE_BUFFER_SIZE, format, args);
-    va_end(args);
+        /* Truncated message? */
+        if ((MESSAGE_BUFFER_SIZE - 2U) < length)
+        {
+            length = MESSAGE_BUFFER_SIZE - 2U;
+        }
 
-    Serial.printf("%s\n", buffer);
+        buffer[length] = '\n';
+        ++length;
+
+        write(buffer, length, level);
+    }
 }
 
 void Log::print(const char* filename, int lineNumber, Log::Level level, const String& msg)
 {
-    printHead(filename, lineNumber, level);
+    if (true == isEnabled(level))
+    {
+        print(filename, lineNumber, level, "%s", msg.c_str());
+    }
+}
+
+void Log::writeToken(Log::Level level, uint32_t token, const uint8_t* args, size_t length)
+{
+    /* Start, length, token, timestamp and level. */
+    const size_t    HEAD_SIZE   = 11U;
+    uint8_t         frame[HEAD_SIZE + LogToken::MAX_ARGS_SIZE];
+    uint32_t        timestamp   = millis();
+    size_t          idx         = 0U;
+
+    if (LogToken::MAX_ARGS_SIZE < length)
+    {
+        length = LogToken::MAX_ARGS_SIZE;
+    }
+
+    frame[0] = LogToken::FRAME_START;
+    frame[1] = static_cast<uint8_t>(HEAD_SIZE - 2U + length);
+
+    for (idx = 0U; idx < 4U; ++idx)
+    {
+        frame[2U + idx] = static_cast<uint8_t>(token >> (8U * idx));
+        frame[6U + idx] = static_cast<uint8_t>(timestamp >> (8U * idx));
+    }
+
+    frame[10] = static_cast<uint8_t>(level);
+
+    if ((nullptr != args) && (0U < length))
+    {
+        memcpy(&frame[HEAD_SIZE], args, length);
+    }
+
+    write(reinterpret_cast<const char*>(frame), HEAD_SIZE + length, level);
+}
+
+void Log::setLevel(Log::Level level)
+{
+    gLevel = level;
+}
+
+Log::Level Log::getLevel()
+{
+    return gLevel;
+}
+
+bool Log::process()
+{
+    int available = Serial.availableForWrite();
+
+    /* Send only as much as fits into the UART FIFO, to never block. */
+    if (0 < available)
+    {
+        (void)drain(static_cast<size_t>(available));
+    }
+
+    if (0U == getUsed())
+    {
+        reportDropped();
+    }
+
+    return true;
+}
+
+void Log::flush()
+{
+    while (0U < drain(LOG_BUFFER_SIZE))
+    {
+        ;
+    }
+
+    reportDropped();
+    Serial.flush();
+}
 
-    Serial.printf("%s\n", msg.c_str());
+uint32_t Log::getDroppedCount()
+{
+    return gDroppedCount;
 }
 
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
 
-static void printHead(const char* filename, int lineNumber, Log::Level level)
+/**
+ * Get the level as user friendly string.
+ * 
+ * @param[in] level The severity level.
+ * 
+ * @return Level string
+ */
+static const char* getLevelStr(Log::Level level)
 {
     const char* levelStr = "Unknown";
 
@@ -124,5 +270,118 @@ static void printHead(const char* filename, int lineNumber, Log::Level level)
         break;
     }
 
-    Serial.printf("%6lu %24s (%5u) %7s ", millis(), filename, lineNumber, levelStr);
+    return levelStr;
+}
+
+/**
+ * Is the level enabled at runtime?
+ * Fatal messages are always enabled.
+ * 
+ * @param[in] level The severity level.
+ * 
+ * @return If enabled, it will return true otherwise false.
+ */
+static bool isEnabled(Log::Level level)
+{
+    return ((Log::LOG_FATAL == level) || (gLevel <= level));
+}
+
+/**
+ * Write a formatted log message to the ring buffer. A message is written
+ * completely or dropped, but never partly.
+ * 
+ * @param[in] msg       The formatted log message.
+ * @param[in] length    The message length in byte.
+ * @param[in] level     The severity level.
+ */
+static void write(const char* msg, size_t length, Log::Level level)
+{
+    /* One byte always keeps free, to distinguish between full and empty. */
+    size_t free = LOG_BUFFER_SIZE - 1U - getUsed();
+
+    if (free < length)
+    {
+        ++gDroppedCount;
+    }
+    else
+    {
+        size_t writeIdx = gWriteIdx;
+        size_t idx      = 0U;
+
+        for (idx = 0U; idx < length; ++idx)
+        {
+            gRingBuffer[writeIdx] = msg[idx];
+            writeIdx = (writeIdx + 1U) % LOG_BUFFER_SIZE;
+        }
+
+        gWriteIdx = writeIdx;
+    }
+
+    /* The system will halt after a fatal error, therefore it can't wait for the idle time. */
+    if (Log::LOG_FATAL == level)
+    {
+        Log::flush();
+    }
+}
+
+/**
+ * Get the number of used bytes in the ring buffer.
+ * 
+ * @return Number of used bytes
+ */
+static size_t getUsed()
+{
+    size_t writeIdx = gWriteIdx;
+    size_t readIdx  = gReadIdx;
+
+    return (writeIdx + LOG_BUFFER_SIZE - readIdx) % LOG_BUFFER_SIZE;
+}
+
+/**
+ * Send log messages from the ring buffer to the serial interface.
+ * 
+ * @param[in] maxLength Max. number of bytes to send.
+ * 
+ * @return Number of sent bytes
+ */
+static size_t drain(size_t maxLength)
+{
+    size_t used     = getUsed();
+    size_t length   = (maxLength < used) ? maxLength : used;
+    size_t readIdx  = gReadIdx;
+    size_t sent     = 0U;
+
+    while (sent < length)
+    {
+        /* Send the contiguous part up to the end of the ring buffer at once. */
+        size_t chunk = LOG_BUFFER_SIZE - readIdx;
+
+        if ((length - sent) < chunk)
+        {
+            chunk = length - sent;
+        }
+
+        (void)Serial.write(reinterpret_cast<const uint8_t*>(&gRingBuffer[readIdx]), chunk);
+
+        readIdx = (readIdx + chunk) % LOG_BUFFER_SIZE;
+        sent += chunk;
+    }
+
+    gReadIdx = readIdx;
+
+    return sent;
+}
+
+/**
+ * Report the number of dropped log messages, since the last report.
+ */
+static void reportDropped()
+{
+    if (gReportedCount != gDroppedCount)
+    {
+        uint32_t dropped = gDroppedCount - gReportedCount;
+
+        gReportedCount += dropped;
+        Serial.printf("%6lu Log: %lu messages dropped.\n", millis(), static_cast<unsigned long>(dropped));
+    }
 }
\ No newline at end of file
@@ -36,22 +36,52 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include "LogToken.h"
 
 /******************************************************************************
  * Macros
  *****************************************************************************/
 
+/**
+ * Min. log level, which is compiled in. Log messages below are removed
+ * completely, which saves flash and runtime.
+ * 0: Info, 1: Warning, 2: Error, 3: Fatal
+ */
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL   0
+#endif
+
+#ifdef LOG_TOKENIZED
+/** Log a tokenized message. Only the token and the raw arguments are sent, see LogToken.h. */
+#define LOG_PRINT(level, format, ...)   Log::printToken(level, std::integral_constant<uint32_t, LogToken::getToken(__FILE__, format)>::value, ##__VA_ARGS__)
+#else
+/** Log a text message. */
+#define LOG_PRINT(level, ...)           Log::print(__FILE__, __LINE__, level, __VA_ARGS__)
+#endif
+
+#if (0 >= LOG_COMPILE_LEVEL)
 /** Log information, which is useful for the normal user. */
-#define LOG_INFO(...)       Log::print(__FILE__, __LINE__, Log::LOG_INFO, __VA_ARGS__)
+#define LOG_INFO(...)       LOG_PRINT(Log::LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)       ((void)0)
+#endif
 
+#if (1 >= LOG_COMPILE_LEVEL)
 /** Log warning in case there is something the user should know, but the system can continoue without limitation. */
-#define LOG_WARNING(...)    Log::print(__FILE__, __LINE__, Log::LOG_WARNING, __VA_ARGS__)
+#define LOG_WARNING(...)    LOG_PRINT(Log::LOG_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...)    ((void)0)
+#endif
 
+#if (2 >= LOG_COMPILE_LEVEL)
 /** Log error in case a failure happened, but the system can continoue with limitation. */
-#define LOG_ERROR(...)      Log::print(__FILE__, __LINE__, Log::LOG_ERROR, __VA_ARGS__)
+#define LOG_ERROR(...)      LOG_PRINT(Log::LOG_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)      ((void)0)
+#endif
 
-/** Log fatal error in case a failure happened and the system can not continoue. */
-#define LOG_FATAL(...)      Log::print(__FILE__, __LINE__, Log::LOG_FATAL, __VA_ARGS__)
+/** Log fatal error in case a failure happened and the system can not continoue. Never removed. */
+#define LOG_FATAL(...)      LOG_PRINT(Log::LOG_FATAL, __VA_ARGS__)
 
 /******************************************************************************
  * Types and Classes
@@ -79,6 +109,9 @@ typedef enum
 
 /**
  * Print log message.
+ * The message is written to a ring buffer and sent later by process().
+ * If the ring buffer is full, the message is dropped and counted.
+ * Fatal messages are sent at once, because the system will halt afterwards.
  * 
  * @param[in] filename      The name of the file, where the log message is located.
  * @param[in] lineNumber    The line number in the file, where the log message is located.
@@ -97,6 +130,72 @@ void print(const char* filename, int lineNumber, Level level, const char* format
  */
 void print(const char* filename, int lineNumber, Level level, const String& msg);
 
+/**
+ * Set the min. log level at runtime. Log messages below are discarded,
+ * before they are formatted.
+ * 
+ * @param[in] level         The min. severity level.
+ */
+void setLevel(Level level);
+
+/**
+ * Get the min. log level.
+ * 
+ * @return The min. severity level.
+ */
+Level getLevel();
+
+/**
+ * Send buffered log messages to the serial interface, as far as it is
+ * possible without blocking. Call it periodically in idle time.
+ * 
+ * @return If successful, returns true. Otherwise, false.
+ */
+bool process();
+
+/**
+ * Send all buffered log messages to the serial interface. It blocks until
+ * all are sent.
+ */
+void flush();
+
+/**
+ * Get the number of dropped log messages, because the ring buffer was full.
+ * 
+ * @return Number of dropped log messages since start.
+ */
+uint32_t getDroppedCount();
+
+/**
+ * Write a tokenized log message to the ring buffer.
+ * 
+ * @param[in] level         The severity level.
+ * @param[in] token         The token of the call site.
+ * @param[in] args          The encoded arguments.
+ * @param[in] length        The length of the encoded arguments in byte.
+ */
+void writeToken(Level level, uint32_t token, const uint8_t* args, size_t length);
+
+/**
+ * Print tokenized log message. Use the LOG_* macros with LOG_TOKENIZED
+ * defined, which calculate the token at compile time.
+ * 
+ * @param[in] level         The severity level.
+ * @param[in] token         The token of the call site.
+ * @param[in] args          The arguments of the format string.
+ */
+template < typename... Args >
+void printToken(Level level, uint32_t token, Args... args)
+{
+    if ((LOG_FATAL == level) || (getLevel() <= level))
+    {
+        LogToken::Encoder encoder;
+
+        encoder.encodeAll(args...);
+        writeToken(level, token, encoder.getData(), encoder.getLength());
+    }
+}
+
 };
 
 #endif /* LOG_H_ */
\ No newline at end of file
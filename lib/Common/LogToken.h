@@ -0,0 +1,284 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tokenized logging
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef LOG_TOKEN_H_
+#define LOG_TOKEN_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <type_traits>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Tokenized logging.
+ *
+ *  Instead of the format string, only a 32-bit token and the raw arguments
+ *  are sent. The token is the FNV-1a hash of the file name (without path),
+ *  a '|' and the format string. It is calculated at compile time, therefore
+ *  neither the file name nor the format string are stored in flash.
+ *  The host decoder (tools/LogDecoder) calculates the same token from the
+ *  sources and rebuilds the text.
+ *
+ *  Frame: <0xFE> <length> <token:u32> <timestamp ms:u32> <level:u8> <args>
+ *  The length counts all bytes after the length byte. Multi-byte values are
+ *  little endian. Every argument starts with a type tag:
+ *  - 'i' / 'u': signed / unsigned 32-bit integer.
+ *  - 'I' / 'U': signed / unsigned 64-bit integer.
+ *  - 'f': 32-bit float.
+ *  - 's': string with u8 length and the characters, without termination.
+ */
+namespace LogToken
+{
+
+/** Frame start byte, which never appears in text log output. */
+static const uint8_t FRAME_START = 0xFEU;
+
+/** Max. size of all encoded arguments in byte. */
+static const size_t MAX_ARGS_SIZE = 64U;
+
+/** Max. length of a string argument, longer strings are truncated. */
+static const size_t MAX_STR_LENGTH = 32U;
+
+/** FNV-1a offset basis. */
+static const uint32_t FNV_OFFSET_BASIS = 2166136261UL;
+
+/** FNV-1a prime. */
+static const uint32_t FNV_PRIME = 16777619UL;
+
+/**
+ *  Get the file name of a path, at compile time.
+ *
+ *  @param[in] path Path
+ *  @param[in] last Begin of the last path element found so far.
+ *  @return File name
+ */
+constexpr const char* getFileName(const char* path, const char* last)
+{
+    return ('\0' == *path) ? last : getFileName(path + 1, (('/' == *path) || ('\\' == *path)) ? (path + 1) : last);
+}
+
+/**
+ *  Continue the FNV-1a hash with a string, at compile time.
+ *
+ *  @param[in] str  String
+ *  @param[in] hash Hash so far.
+ *  @return Hash
+ */
+constexpr uint32_t hash(const char* str, uint32_t hash)
+{
+    return ('\0' == *str) ? hash : LogToken::hash(str + 1, (hash ^ static_cast<uint8_t>(*str)) * FNV_PRIME);
+}
+
+/**
+ *  Get the token of a log message, at compile time.
+ *
+ *  @param[in] path     Path of the source file.
+ *  @param[in] format   Format string.
+ *  @return Token
+ */
+constexpr uint32_t getToken(const char* path, const char* format)
+{
+    return hash(format, (hash(getFileName(path, path), FNV_OFFSET_BASIS) ^ static_cast<uint8_t>('|')) * FNV_PRIME);
+}
+
+/**
+ *  Encoder for the log arguments.
+ *  If the arguments don't fit, the remaining ones are skipped.
+ */
+class Encoder
+{
+public:
+
+    /**
+     *  Constructs the encoder.
+     */
+    Encoder() :
+        m_buffer(),
+        m_length(0U)
+    {
+    }
+
+    /**
+     *  Destroys the encoder.
+     */
+    ~Encoder()
+    {
+    }
+
+    /**
+     *  Encode an integer or enumeration argument.
+     *
+     *  @param[in] value    Argument
+     */
+    template < typename T >
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type encode(T value)
+    {
+        bool isSigned = std::is_signed<T>::value;
+
+        if (4U >= sizeof(T))
+        {
+            put((true == isSigned) ? 'i' : 'u', static_cast<uint64_t>(value), 4U);
+        }
+        else
+        {
+            put((true == isSigned) ? 'I' : 'U', static_cast<uint64_t>(value), 8U);
+        }
+    }
+
+    /**
+     *  Encode a floating point argument. It is reduced to 32 bit.
+     *
+     *  @param[in] value    Argument
+     */
+    template < typename T >
+    typename std::enable_if<std::is_floating_point<T>::value>::type encode(T value)
+    {
+        float       single  = static_cast<float>(value);
+        uint32_t    raw     = 0U;
+
+        memcpy(&raw, &single, sizeof(raw));
+        put('f', raw, 4U);
+    }
+
+    /**
+     *  Encode a string argument.
+     *
+     *  @param[in] str  Argument
+     */
+    void encode(const char* str)
+    {
+        size_t length = (nullptr == str) ? 0U : strnlen(str, MAX_STR_LENGTH);
+
+        if (MAX_ARGS_SIZE >= (m_length + 2U + length))
+        {
+            m_buffer[m_length] = 's';
+            ++m_length;
+            m_buffer[m_length] = static_cast<uint8_t>(length);
+            ++m_length;
+
+            if (0U < length)
+            {
+                memcpy(&m_buffer[m_length], str, length);
+                m_length += length;
+            }
+        }
+    }
+
+    /**
+     *  Encode all arguments, one after another.
+     *
+     *  @param[in] value    First argument
+     *  @param[in] args     Remaining arguments
+     */
+    template < typename T, typename... Args >
+    void encodeAll(T value, Args... args)
+    {
+        encode(value);
+        encodeAll(args...);
+    }
+
+    /**
+     *  End of the argument recursion.
+     */
+    void encodeAll()
+    {
+    }
+
+    /**
+     *  Get the encoded arguments.
+     *
+     *  @return Encoded arguments
+     */
+    const uint8_t* getData() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     *  Get the size of the encoded arguments.
+     *
+     *  @return Size in byte
+     */
+    size_t getLength() const
+    {
+        return m_length;
+    }
+
+private:
+
+    /** Encoded arguments. */
+    uint8_t m_buffer[MAX_ARGS_SIZE];
+
+    /** Size of the encoded arguments in byte. */
+    size_t  m_length;
+
+    /**
+     *  Put a tagged value in little endian.
+     *
+     *  @param[in] tag      Type tag
+     *  @param[in] value    Value
+     *  @param[in] size     Value size in byte.
+     */
+    void put(char tag, uint64_t value, size_t size)
+    {
+        if (MAX_ARGS_SIZE >= (m_length + 1U + size))
+        {
+            size_t idx = 0U;
+
+            m_buffer[m_length] = static_cast<uint8_t>(tag);
+            ++m_length;
+
+            for (idx = 0U; idx < size; ++idx)
+            {
+                m_buffer[m_length] = static_cast<uint8_t>(value >> (8U * idx));
+                ++m_length;
+            }
+        }
+    }
+};
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LOG_TOKEN_H_ */
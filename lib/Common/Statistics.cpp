@@ -0,0 +1,332 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming statistics with fixed memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Statistics.h"
+
+#include <math.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void RunningStatistics::record(double value)
+{
+    double delta = value - m_mean;
+
+    ++m_count;
+    m_mean  += delta / static_cast<double>(m_count);
+    m_m2    += delta * (value - m_mean);
+}
+
+void RunningStatistics::clear()
+{
+    m_count = 0U;
+    m_mean  = 0.0;
+    m_m2    = 0.0;
+}
+
+double RunningStatistics::getVariance() const
+{
+    double variance = 0.0;
+
+    if (1U < m_count)
+    {
+        variance = m_m2 / static_cast<double>(m_count - 1U);
+    }
+
+    return variance;
+}
+
+double RunningStatistics::getStdDev() const
+{
+    return sqrt(getVariance());
+}
+
+P2Quantile::P2Quantile(float quantile) :
+    m_quantile(quantile),
+    m_count(0U),
+    m_heights(),
+    m_positions()
+{
+    if (0.0F > m_quantile)
+    {
+        m_quantile = 0.0F;
+    }
+    else if (1.0F < m_quantile)
+    {
+        m_quantile = 1.0F;
+    }
+    else
+    {
+        ;
+    }
+}
+
+void P2Quantile::record(float value)
+{
+    if (MARKERS > m_count)
+    {
+        /* Until all markers are set, the values are kept sorted. */
+        uint8_t idx = static_cast<uint8_t>(m_count);
+
+        while ((0U < idx) && (m_heights[idx - 1U] > value))
+        {
+            m_heights[idx] = m_heights[idx - 1U];
+            --idx;
+        }
+
+        m_heights[idx] = value;
+        ++m_count;
+
+        if (MARKERS == m_count)
+        {
+            for (idx = 0U; idx < MARKERS; ++idx)
+            {
+                m_positions[idx] = idx + 1;
+            }
+        }
+    }
+    else
+    {
+        uint8_t cell    = 0U;
+        uint8_t idx     = 0U;
+
+        /* Find the cell of the value, the outer markers follow min. and max. */
+        if (m_heights[0U] > value)
+        {
+            m_heights[0U] = value;
+        }
+        else if (m_heights[MARKERS - 1U] <= value)
+        {
+            m_heights[MARKERS - 1U] = value;
+            cell = MARKERS - 2U;
+        }
+        else
+        {
+            while (m_heights[cell + 1U] <= value)
+            {
+                ++cell;
+            }
+        }
+
+        for (idx = cell + 1U; idx < MARKERS; ++idx)
+        {
+            ++m_positions[idx];
+        }
+
+        ++m_count;
+
+        /* Move the inner markers towards their desired positions. */
+        for (idx = 1U; idx < (MARKERS - 1U); ++idx)
+        {
+            float d = getDesiredPosition(idx) - static_cast<float>(m_positions[idx]);
+
+            if ((1.0F <= d) && (1 < (m_positions[idx + 1U] - m_positions[idx])))
+            {
+                adjustMarker(idx, 1);
+            }
+            else if ((-1.0F >= d) && (1 < (m_positions[idx] - m_positions[idx - 1U])))
+            {
+                adjustMarker(idx, -1);
+            }
+            else
+            {
+                ;
+            }
+        }
+    }
+}
+
+void P2Quantile::clear()
+{
+    uint8_t idx = 0U;
+
+    for (idx = 0U; idx < MARKERS; ++idx)
+    {
+        m_heights[idx]      = 0.0F;
+        m_positions[idx]    = 0;
+    }
+
+    m_count = 0U;
+}
+
+float P2Quantile::getValue() const
+{
+    float value = 0.0F;
+
+    if (MARKERS < m_count)
+    {
+        value = m_heights[2U];
+    }
+    else if (0U < m_count)
+    {
+        /* The heights are still the sorted values, therefore the quantile is
+         * exact, linear interpolated between the closest ranks.
+         */
+        float   rank    = m_quantile * static_cast<float>(m_count - 1U);
+        uint8_t lower   = static_cast<uint8_t>(rank);
+
+        value = m_heights[lower];
+
+        if ((lower + 1U) < m_count)
+        {
+            value += (rank - static_cast<float>(lower)) * (m_heights[lower + 1U] - m_heights[lower]);
+        }
+    }
+    else
+    {
+        ;
+    }
+
+    return value;
+}
+
+void P2Quantile::getMarkers(Markers& markers) const
+{
+    uint8_t idx = 0U;
+
+    for (idx = 0U; idx < MARKERS; ++idx)
+    {
+        markers.heights[idx] = m_heights[idx];
+    }
+
+    for (idx = 1U; idx < (MARKERS - 1U); ++idx)
+    {
+        markers.positions[idx - 1U] = m_positions[idx];
+    }
+}
+
+void P2Quantile::setMarkers(uint32_t count, const Markers& markers)
+{
+    uint8_t idx = 0U;
+
+    for (idx = 0U; idx < MARKERS; ++idx)
+    {
+        m_heights[idx] = markers.heights[idx];
+    }
+
+    for (idx = 1U; idx < (MARKERS - 1U); ++idx)
+    {
+        m_positions[idx] = markers.positions[idx - 1U];
+    }
+
+    /* The outer markers are at the first and the last value, once all markers are set. */
+    if (MARKERS > count)
+    {
+        m_positions[0U]             = 0;
+        m_positions[MARKERS - 1U]   = 0;
+    }
+    else
+    {
+        m_positions[0U]             = 1;
+        m_positions[MARKERS - 1U]   = static_cast<int32_t>(count);
+    }
+
+    m_count = count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+float P2Quantile::getDesiredPosition(uint8_t idx) const
+{
+    /* Increments of the desired positions per value. */
+    const float increments[MARKERS] =
+    {
+        0.0F, m_quantile / 2.0F, m_quantile, (1.0F + m_quantile) / 2.0F, 1.0F
+    };
+
+    return 1.0F + (static_cast<float>(m_count - 1U) * increments[idx]);
+}
+
+void P2Quantile::adjustMarker(uint8_t idx, int32_t step)
+{
+    float   fStep       = static_cast<float>(step);
+    float   q           = m_heights[idx];
+    float   qPrev       = m_heights[idx - 1U];
+    float   qNext       = m_heights[idx + 1U];
+    float   n           = static_cast<float>(m_positions[idx]);
+    float   nPrev       = static_cast<float>(m_positions[idx - 1U]);
+    float   nNext       = static_cast<float>(m_positions[idx + 1U]);
+    float   parabolic   = q + ((fStep / (nNext - nPrev)) *
+                               ((((n - nPrev) + fStep) * ((qNext - q) / (nNext - n))) +
+                                (((nNext - n) - fStep) * ((q - qPrev) / (n - nPrev)))));
+
+    /* The parabolic prediction is only used, if it keeps the heights in order. */
+    if ((qPrev < parabolic) && (qNext > parabolic))
+    {
+        m_heights[idx] = parabolic;
+    }
+    else
+    {
+        uint8_t neighbour = (0 < step) ? (idx + 1U) : (idx - 1U);
+
+        m_heights[idx] = q + (fStep * ((m_heights[neighbour] - q) / (static_cast<float>(m_positions[neighbour]) - n)));
+    }
+
+    m_positions[idx] += step;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
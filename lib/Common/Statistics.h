@@ -0,0 +1,286 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming statistics with fixed memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Mean and variance of a stream of values, calculated with the algorithm
+ *  of Welford. It is numerically stable and doesn't store the values.
+ */
+class RunningStatistics
+{
+public:
+
+    /**
+     *  State of the accumulators, e.g. to restore it after a value was
+     *  recorded by mistake.
+     */
+    typedef struct
+    {
+        uint32_t    count;  /**< Number of recorded values. */
+        double      mean;   /**< Mean of the recorded values. */
+        double      m2;     /**< Sum of the squared differences to the mean. */
+
+    } State;
+
+    /**
+     *  Constructs the statistics without values.
+     */
+    RunningStatistics() :
+        m_count(0U),
+        m_mean(0.0),
+        m_m2(0.0)
+    {
+    }
+
+    /**
+     *  Destroys the statistics.
+     */
+    ~RunningStatistics()
+    {
+    }
+
+    /**
+     *  Record a single value.
+     *
+     *  @param[in] value    Value
+     */
+    void record(double value);
+
+    /**
+     *  Clear all recorded values.
+     */
+    void clear();
+
+    /**
+     *  Get the number of recorded values.
+     *
+     *  @return Number of values
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     *  Get the mean of all recorded values.
+     *
+     *  @return Mean. If no value is recorded, 0 is returned.
+     */
+    double getMean() const
+    {
+        return m_mean;
+    }
+
+    /**
+     *  Get the sample variance of all recorded values.
+     *
+     *  @return Variance. With less than 2 values, 0 is returned.
+     */
+    double getVariance() const;
+
+    /**
+     *  Get the sample standard deviation of all recorded values.
+     *
+     *  @return Standard deviation. With less than 2 values, 0 is returned.
+     */
+    double getStdDev() const;
+
+    /**
+     *  Get the state of the accumulators.
+     *
+     *  @param[out] state   State
+     */
+    void getState(State& state) const
+    {
+        state.count = m_count;
+        state.mean  = m_mean;
+        state.m2    = m_m2;
+    }
+
+    /**
+     *  Restore the accumulators to a former state.
+     *
+     *  @param[in] state    State
+     */
+    void setState(const State& state)
+    {
+        m_count = state.count;
+        m_mean  = state.mean;
+        m_m2    = state.m2;
+    }
+
+private:
+
+    /** Number of recorded values. */
+    uint32_t    m_count;
+
+    /** Mean of the recorded values. */
+    double      m_mean;
+
+    /** Sum of the squared differences to the mean. */
+    double      m_m2;
+};
+
+/**
+ *  Quantile of a stream of values, estimated with the P2 algorithm of Jain
+ *  and Chlamtac. It keeps only five markers instead of the values, therefore
+ *  the result is an estimation, which is rough for a few values only and
+ *  converges with more values. Up to five values, the result is exact.
+ */
+class P2Quantile
+{
+public:
+
+    /** Number of markers. */
+    static const uint8_t MARKERS = 5U;
+
+    /**
+     *  Markers of the estimator, e.g. to restore them after a value was
+     *  recorded by mistake. The quantile and the number of values are not
+     *  part of it, the positions of the outer markers follow from the
+     *  number of values.
+     */
+    typedef struct
+    {
+        float       heights[MARKERS];           /**< Heights of the markers. */
+        int32_t     positions[MARKERS - 2U];    /**< Actual positions of the inner markers. */
+
+    } Markers;
+
+    /**
+     *  Constructs the estimator without values.
+     *
+     *  @param[in] quantile Quantile in the range [0; 1], e.g. 0.5 for the median.
+     */
+    P2Quantile(float quantile = 0.5F);
+
+    /**
+     *  Destroys the estimator.
+     */
+    ~P2Quantile()
+    {
+    }
+
+    /**
+     *  Record a single value.
+     *
+     *  @param[in] value    Value
+     */
+    void record(float value);
+
+    /**
+     *  Clear all recorded values.
+     */
+    void clear();
+
+    /**
+     *  Get the number of recorded values.
+     *
+     *  @return Number of values
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     *  Get the estimated quantile.
+     *
+     *  @return Quantile. If no value is recorded, 0 is returned.
+     */
+    float getValue() const;
+
+    /**
+     *  Get the markers.
+     *
+     *  @param[out] markers Markers
+     */
+    void getMarkers(Markers& markers) const;
+
+    /**
+     *  Restore the markers to a former state.
+     *
+     *  @param[in] count    Number of recorded values at that state.
+     *  @param[in] markers  Markers
+     */
+    void setMarkers(uint32_t count, const Markers& markers);
+
+private:
+
+    /** Quantile in the range [0; 1]. */
+    float       m_quantile;
+
+    /** Number of recorded values. */
+    uint32_t    m_count;
+
+    /** Heights of the markers. Until all markers are set, the recorded values in ascending order. */
+    float       m_heights[MARKERS];
+
+    /** Actual positions of the markers, starting with 1. */
+    int32_t     m_positions[MARKERS];
+
+    /**
+     *  Get the desired position of a marker.
+     *
+     *  @param[in] idx  Marker index
+     *  @return Desired position
+     */
+    float getDesiredPosition(uint8_t idx) const;
+
+    /**
+     *  Move a marker by one position and adjust its height.
+     *
+     *  @param[in] idx  Marker index, only the inner markers 1 - 3.
+     *  @param[in] step Direction, 1 or -1.
+     */
+    void adjustMarker(uint8_t idx, int32_t step);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* STATISTICS_H_ */
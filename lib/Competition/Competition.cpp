@@ -36,6 +36,7 @@
 #include "Board.h"
 #include "Settings.h"
 
+#include <EventBus.h>
 #include <Log.h>
 
 /******************************************************************************
@@ -50,18 +51,66 @@
  * Types and Classes
  *****************************************************************************/
 
+/** Max. number of groups in the snapshot, the one of the largest event configuration. */
+static const uint8_t    SNAPSHOT_MAX_GROUPS = LargeEventConfig::MAX_GROUPS;
+
+/**
+ * Snapshot of the competition in the RTC memory. Of the lap time statistics
+ * only the mean and the variance fit, which the plausibility check needs.
+ * The markers of the median and the 90th percentile take 64 byte per group.
+ */
+typedef struct
+{
+    uint8_t     version;                            /**< Snapshot layout version. */
+    uint8_t     state;                              /**< Competition state. */
+    uint8_t     activeGroup;                        /**< Released group. */
+    uint8_t     numberOfGroups;                     /**< Number of groups. */
+    uint32_t    runLapTime;                         /**< Lap time in ms of the last run. */
+    uint32_t    trackLapTime;                       /**< Fastest plausible lap time in ms of all groups. */
+    uint32_t    lapTimes[SNAPSHOT_MAX_GROUPS];      /**< Fastest lap times in ms. */
+    float       means[SNAPSHOT_MAX_GROUPS];         /**< Mean of the lap times in ms. */
+    float       m2s[SNAPSHOT_MAX_GROUPS];           /**< Sum of the squared differences of the lap times to their mean. */
+    uint16_t    counts[SNAPSHOT_MAX_GROUPS];        /**< Number of lap times. */
+
+} Snapshot;
+
+static_assert(sizeof(Snapshot) <= Board::RTC_DATA_MAX_SIZE, "The competition snapshot doesn't fit into the RTC memory.");
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Version of the snapshot layout. Increase it on every change of Snapshot. */
+static const uint8_t    SNAPSHOT_VERSION    = 4U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
-bool Competition::begin()
+template <typename Config>
+bool CompetitionT<Config>::begin()
 {
+    Settings::BlindPeriod   blindPeriod;
+    uint8_t                 idx         = 0;
+
+    static_assert(MAX_GROUPS <= Settings::MAX_GROUPS,
+                  "The settings can't store the names of all groups.");
+    static_assert(MAX_GROUP_NAME_LENGTH <= Settings::MAX_GROUP_NAME_LENGTH,
+                  "The settings can't store the group names.");
+
     Settings::getInstance().getNumberOfGroups(m_numberOfGroups);
 
+    /* Older settings have no blind period yet. */
+    if (true == Settings::getInstance().getBlindPeriod(blindPeriod))
+    {
+        if ((MAX_BLIND_PERIOD >= blindPeriod.period) &&
+            (MAX_BLIND_PERIOD_RATIO >= blindPeriod.ratio))
+        {
+            m_minBlindPeriod    = blindPeriod.period;
+            m_blindPeriodRatio  = blindPeriod.ratio;
+        }
+    }
+
     if (MIN_NUMBER_OF_GROUPS > m_numberOfGroups)
     {
         m_numberOfGroups = MIN_NUMBER_OF_GROUPS;
@@ -71,23 +120,26 @@ bool Competition::begin()
         m_numberOfGroups = MAX_GROUPS;
     }
 
-    if (nullptr != m_groups)
+    for(idx = 0; idx < m_numberOfGroups; ++idx)
     {
-        uint8_t idx = 0;
+        Settings::GroupName name;
 
-        for(idx = 0; idx < m_numberOfGroups; ++idx)
-        {
-            String name;
-            Settings::getInstance().getGroupName(idx, name);
+        Settings::getInstance().getGroupName(idx, name);
+        m_groups[idx].setName(name.c_str());
+    }
 
-            m_groups[idx].setName(name);
-        }
+    if (true == restoreSnapshot())
+    {
+        LOG_INFO("Competition restored.");
     }
 
+    updateBlindPeriod();
+
     return true;
 }
 
-bool Competition::handleCompetition(String &outputMessage)
+template <typename Config>
+bool CompetitionT<Config>::handleCompetition()
 {
     bool isSuccess = false;
     uint32_t duration = 0;
@@ -105,9 +157,11 @@ bool Competition::handleCompetition(String &outputMessage)
         if (true == Board::isRobotDetected())
         {
             m_startTimestamp = millis();
-            outputMessage = "EVT;STARTED";
             isSuccess = true;
             m_competitionState = COMPETITION_STATE_STARTED;
+            m_isSnapshotPending = true;
+
+            EventBus::getInstance().publishRunStarted(m_activeGroup);
         }
         break;
 
@@ -115,17 +169,37 @@ bool Competition::handleCompetition(String &outputMessage)
         duration = millis() - m_startTimestamp;
 
         /* React on external sensor. */
-        if (SENSOR_BLIND_PERIOD <= duration)
+        if (m_blindPeriod <= duration)
         {
             if (true == Board::isRobotDetected())
             {
-                outputMessage = "EVT;FINISHED;";
-                outputMessage += duration;
-                outputMessage += ';';
-                outputMessage += m_activeGroup;
+                uint8_t flags = 0U;
+
                 isSuccess = true;
                 m_competitionState = COMPETITION_STATE_FINISHED;
-                updateLapTime(duration);
+                m_runLapTime = duration;
+                ++m_runCounter;
+                m_isRunSuspicious = (false == isLapTimePlausible(duration));
+
+                if (false == m_isRunSuspicious)
+                {
+                    updateLapTime(duration, true);
+                }
+                else if (true == m_isHoldSuspicious)
+                {
+                    /* The operator decides with confirmRun() or rejectRun(). */
+                    flags = EventBus::FLAG_PENDING;
+                    m_isRunPending = true;
+                }
+                else
+                {
+                    flags = EventBus::FLAG_SUSPICIOUS;
+                    updateLapTime(duration, false);
+                }
+
+                m_isSnapshotPending = true;
+
+                EventBus::getInstance().publishRunFinished(m_activeGroup, duration, flags);
             }
         }
         break;
@@ -140,14 +214,23 @@ bool Competition::handleCompetition(String &outputMessage)
         break;
     }
 
+    /* Store the snapshot in a poll without event, to not delay the event. */
+    if ((false == isSuccess) &&
+        (true == m_isSnapshotPending))
+    {
+        saveSnapshot();
+    }
+
     return isSuccess;
 }
 
-bool Competition::setReleasedState(uint8_t activeGroup)
+template <typename Config>
+bool CompetitionT<Config>::setReleasedState(uint8_t activeGroup)
 {
     bool isSuccess = false;
 
-    if ((MAX_GROUPS - 1) > activeGroup)
+    /* Only a configured group can run. */
+    if (m_numberOfGroups > activeGroup)
     {
         m_activeGroup = activeGroup;
 
@@ -156,22 +239,32 @@ bool Competition::setReleasedState(uint8_t activeGroup)
         if ((COMPETITION_STATE_UNRELEASED == m_competitionState) ||
             (COMPETITION_STATE_FINISHED == m_competitionState))
         {
+            if (true == m_isRunPending)
+            {
+                LOG_WARNING("Held lap time %u discarded.", m_runLapTime);
+                m_isRunPending = false;
+            }
+
             isSuccess = true;
             m_competitionState = COMPETITION_STATE_RELEASED;
         }
+
+        m_isSnapshotPending = true;
     }
 
     return isSuccess;
 }
 
-bool Competition::getNumberofGroups(uint8_t &groups)
+template <typename Config>
+bool CompetitionT<Config>::getNumberofGroups(uint8_t &groups)
 {
     groups = m_numberOfGroups;
 
     return true;
 }
 
-bool Competition::setNumberofGroups(uint8_t groups)
+template <typename Config>
+bool CompetitionT<Config>::setNumberofGroups(uint8_t groups)
 {
     uint8_t validGroups = 0;
 
@@ -192,30 +285,38 @@ bool Competition::setNumberofGroups(uint8_t groups)
     {
         Settings::getInstance().setNumberOfGroups(validGroups);
 
-        if ((nullptr != m_groups) &&
-            (validGroups > m_numberOfGroups))
+        if (validGroups > m_numberOfGroups)
         {
             uint8_t idx = 0;
             
             for(idx = m_numberOfGroups; idx < validGroups; ++idx)
             {
                 m_groups[idx].setName("");
-                m_groups[idx].setFastestLapTime(0);
+                m_groups[idx].clearLapTimes();
             }
         }
+        else
+        {
+            /* The runs of the removed groups can't be reverted anymore. */
+            dropJournalEntries(validGroups, MAX_GROUPS - 1);
+        }
 
         m_numberOfGroups = validGroups;
+        m_isSnapshotPending = true;
+
+        calculateRanks();
+        EventBus::getInstance().publishTableChanged();
     }
 
     return true;
 }
 
-uint32_t Competition::getLaptime(uint8_t group)
+template <typename Config>
+uint32_t CompetitionT<Config>::getLaptime(uint8_t group)
 {
     uint32_t result = 0;
 
-    if ((nullptr != m_groups) &&
-        (m_numberOfGroups > group))
+    if (m_numberOfGroups > group)
     {
         result = m_groups[group].getfastestLapTime();
     }
@@ -223,29 +324,55 @@ uint32_t Competition::getLaptime(uint8_t group)
     return result;
 }
 
-bool Competition::clearLaptime(uint8_t group)
+template <typename Config>
+bool CompetitionT<Config>::clearLaptime(uint8_t group)
+{
+    bool isSuccess = false;
+
+    if (m_numberOfGroups > group)
+    {
+        uint32_t previousLapTime = m_groups[group].getfastestLapTime();
+
+        m_groups[group].clearLapTimes();
+        updateRanks(group, previousLapTime);
+
+        /* The runs of the group can't be reverted anymore. */
+        dropJournalEntries(group, group);
+        EventBus::getInstance().publishTableChanged();
+
+        m_isSnapshotPending = true;
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::getLapStatistics(uint8_t group, LapStatistics &statistics)
 {
     bool isSuccess = false;
 
-    if ((nullptr != m_groups) &&
-        (m_numberOfGroups > group))
+    if (m_numberOfGroups > group)
     {
-        m_groups[group].setFastestLapTime(0);
+        statistics = m_groups[group].getStatistics();
         isSuccess = true;
     }
 
     return isSuccess;
 }
 
-bool Competition::setGroupName(uint8_t group, const String &groupName)
+template <typename Config>
+bool CompetitionT<Config>::setGroupName(uint8_t group, const char *groupName)
 {
     bool isSuccess = false;
 
-    if (nullptr != m_groups)
+    if (m_numberOfGroups > group)
     {
         m_groups[group].setName(groupName);
 
-        Settings::getInstance().setGroupName(group, groupName);
+        /* Store the name as the group keeps it, which may be truncated. */
+        Settings::getInstance().setGroupName(group, m_groups[group].getName());
+        EventBus::getInstance().publishTableChanged();
 
         isSuccess = true;
     }
@@ -253,11 +380,12 @@ bool Competition::setGroupName(uint8_t group, const String &groupName)
     return isSuccess;
 }
 
-bool Competition::getGroupName(uint8_t group, String &groupName)
+template <typename Config>
+bool CompetitionT<Config>::getGroupName(uint8_t group, const char *&groupName) const
 {
     bool isSuccess = false;
 
-    if (nullptr != m_groups)
+    if (m_numberOfGroups > group)
     {
         groupName = m_groups[group].getName();
         isSuccess = true;
@@ -266,18 +394,149 @@ bool Competition::getGroupName(uint8_t group, String &groupName)
     return isSuccess;
 }
 
-bool Competition::clearName(uint8_t group)
+template <typename Config>
+bool CompetitionT<Config>::clearName(uint8_t group)
 {
     return setGroupName(group, "");
 }
 
-bool Competition::rejectRun()
+template <typename Config>
+uint8_t CompetitionT<Config>::getRank(uint8_t group)
+{
+    uint8_t rank = 0;
+
+    if (m_numberOfGroups > group)
+    {
+        rank = m_groups[group].getRank();
+    }
+
+    return rank;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::rejectRun()
 {
     bool isSuccess = false;
 
-    if (nullptr != m_groups)
+    if (true == m_isRunPending)
     {
-        m_groups[m_lastRunGroup].setFastestLapTime(m_lastRunLapTime);
+        /* The held lap time was never applied. */
+        m_isRunPending = false;
+        isSuccess = true;
+    }
+    /* Only the last finished run, if it is still applied. A discarded held run
+     * has no journal entry, which protects the run before it.
+     */
+    else if ((0 < m_journalCount) &&
+             (m_journalApplied == m_journalCount) &&
+             (m_runCounter == m_journal[getJournalPosition(m_journalCount - 1)].run))
+    {
+        uint32_t run = 0;
+
+        isSuccess = undoRun(run);
+    }
+    else
+    {
+        ;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::undoRun(uint32_t &run)
+{
+    bool isSuccess = false;
+
+    if (0 < m_journalApplied)
+    {
+        const JournalEntry& entry = m_journal[getJournalPosition(m_journalApplied - 1)];
+
+        revertRun(entry);
+        --m_journalApplied;
+        run = entry.run;
+
+        LOG_INFO("Run %u of group %u undone.", entry.run, entry.group);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::redoRun(uint32_t &run)
+{
+    bool isSuccess = false;
+
+    if (m_journalCount > m_journalApplied)
+    {
+        const JournalEntry& entry = m_journal[getJournalPosition(m_journalApplied)];
+
+        applyRun(entry);
+        ++m_journalApplied;
+        run = entry.run;
+
+        LOG_INFO("Run %u of group %u redone.", entry.run, entry.group);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::getJournalEntry(uint8_t idx, uint32_t &run, uint8_t &group, uint32_t &lapTime, bool &isUndone) const
+{
+    bool isSuccess = false;
+
+    if (m_journalCount > idx)
+    {
+        const JournalEntry& entry = m_journal[getJournalPosition(idx)];
+
+        run         = entry.run;
+        group       = entry.group;
+        lapTime     = entry.lapTime;
+        isUndone    = (m_journalApplied <= idx);
+        isSuccess   = true;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::setBlindPeriod(uint32_t period, uint8_t ratio)
+{
+    bool isSuccess = false;
+
+    if ((MAX_BLIND_PERIOD >= period) &&
+        (MAX_BLIND_PERIOD_RATIO >= ratio))
+    {
+        Settings::BlindPeriod blindPeriod;
+
+        m_minBlindPeriod    = period;
+        m_blindPeriodRatio  = ratio;
+        updateBlindPeriod();
+
+        blindPeriod.period  = period;
+        blindPeriod.ratio   = ratio;
+        Settings::getInstance().setBlindPeriod(blindPeriod);
+
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::confirmRun()
+{
+    bool isSuccess = false;
+
+    if (true == m_isRunPending)
+    {
+        /* Confirmed by the operator, therefore it counts for the track record too. */
+        updateLapTime(m_runLapTime, true);
+        m_isRunPending = false;
+        m_isSnapshotPending = true;
         isSuccess = true;
     }
 
@@ -292,12 +551,33 @@ bool Competition::rejectRun()
  * Private Methods
  *****************************************************************************/
 
-void Competition::updateLapTime(uint32_t lapTime)
+template <typename Config>
+void CompetitionT<Config>::updateLapTime(uint32_t lapTime, bool isPlausible)
 {
-    m_lastRunGroup      = m_activeGroup;
-    m_lastRunLapTime    = m_groups[m_activeGroup].getfastestLapTime();
+    JournalEntry* entry = nullptr;
 
-    m_groups[m_activeGroup].setLapTimeIfFaster(lapTime);
+    /* A new run discards the undone runs and, if the journal is full, the oldest run. */
+    m_journalCount = m_journalApplied;
+
+    if (JOURNAL_SIZE == m_journalCount)
+    {
+        m_journalBegin = getJournalPosition(1);
+        --m_journalCount;
+    }
+
+    entry = &m_journal[getJournalPosition(m_journalCount)];
+    ++m_journalCount;
+    m_journalApplied = m_journalCount;
+
+    entry->run              = m_runCounter;
+    entry->group            = m_activeGroup;
+    entry->isPlausible      = isPlausible;
+    entry->lapTime          = lapTime;
+    entry->fastestLapTime   = m_groups[m_activeGroup].getfastestLapTime();
+    entry->trackLapTime     = m_trackLapTime;
+    m_groups[m_activeGroup].getStatistics().save(entry->statistics);
+
+    applyRun(*entry);
 
     for (uint8_t group = 0; group < m_numberOfGroups; group++)
     {
@@ -305,6 +585,300 @@ void Competition::updateLapTime(uint32_t lapTime)
     }
 }
 
+template <typename Config>
+void CompetitionT<Config>::applyRun(const JournalEntry &entry)
+{
+    uint32_t previousLapTime = m_groups[entry.group].getfastestLapTime();
+
+    m_groups[entry.group].recordLapTime(entry.lapTime);
+    updateRanks(entry.group, previousLapTime);
+
+    if ((true == entry.isPlausible) &&
+        ((0 == m_trackLapTime) || (entry.lapTime < m_trackLapTime)))
+    {
+        m_trackLapTime = entry.lapTime;
+        updateBlindPeriod();
+    }
+
+    m_isSnapshotPending = true;
+    EventBus::getInstance().publishTableChanged();
+}
+
+template <typename Config>
+void CompetitionT<Config>::revertRun(const JournalEntry &entry)
+{
+    uint32_t previousLapTime = m_groups[entry.group].getfastestLapTime();
+
+    m_groups[entry.group].setFastestLapTime(entry.fastestLapTime);
+    m_groups[entry.group].restoreStatistics(entry.statistics);
+    updateRanks(entry.group, previousLapTime);
+
+    /* A later run of a group, whose runs were dropped, may hold it now. */
+    if ((true == entry.isPlausible) &&
+        (entry.lapTime == m_trackLapTime))
+    {
+        m_trackLapTime = entry.trackLapTime;
+    }
+
+    updateBlindPeriod();
+
+    m_isSnapshotPending = true;
+    EventBus::getInstance().publishTableChanged();
+}
+
+template <typename Config>
+void CompetitionT<Config>::dropJournalEntries(uint8_t firstGroup, uint8_t lastGroup)
+{
+    uint8_t idx     = 0;
+    uint8_t count   = 0;
+    uint8_t applied = 0;
+
+    for (idx = 0; idx < m_journalCount; ++idx)
+    {
+        const JournalEntry& entry = m_journal[getJournalPosition(idx)];
+
+        if ((firstGroup > entry.group) ||
+            (lastGroup < entry.group))
+        {
+            /* Move the kept run to the front, it never overwrites a run, which is not visited yet. */
+            if (count != idx)
+            {
+                m_journal[getJournalPosition(count)] = entry;
+            }
+
+            if (m_journalApplied > idx)
+            {
+                ++applied;
+            }
+
+            ++count;
+        }
+    }
+
+    m_journalCount      = count;
+    m_journalApplied    = applied;
+}
+
+template <typename Config>
+void CompetitionT<Config>::updateRanks(uint8_t group, uint32_t previousLapTime)
+{
+    uint32_t    lapTime = m_groups[group].getfastestLapTime();
+    uint8_t     rank    = (0 != lapTime) ? 1 : 0;
+    uint8_t     idx     = 0;
+
+    for (idx = 0; idx < m_numberOfGroups; ++idx)
+    {
+        uint32_t otherLapTime = m_groups[idx].getfastestLapTime();
+
+        if ((group != idx) &&
+            (0 != otherLapTime))
+        {
+            bool wasFaster  = (0 != previousLapTime) && (previousLapTime < otherLapTime);
+            bool isFaster   = (0 != lapTime) && (lapTime < otherLapTime);
+
+            /* The other group moves only, if the group passed it in either direction. */
+            if ((false == wasFaster) && (true == isFaster))
+            {
+                m_groups[idx].setRank(m_groups[idx].getRank() + 1);
+            }
+            else if ((true == wasFaster) && (false == isFaster))
+            {
+                m_groups[idx].setRank(m_groups[idx].getRank() - 1);
+            }
+            else
+            {
+                ;
+            }
+
+            if ((0 != lapTime) &&
+                (otherLapTime < lapTime))
+            {
+                ++rank;
+            }
+        }
+    }
+
+    m_groups[group].setRank(rank);
+}
+
+template <typename Config>
+void CompetitionT<Config>::calculateRanks()
+{
+    uint8_t group = 0;
+
+    for (group = 0; group < m_numberOfGroups; ++group)
+    {
+        uint32_t    lapTime = m_groups[group].getfastestLapTime();
+        uint8_t     rank    = 0;
+        uint8_t     idx     = 0;
+
+        if (0 != lapTime)
+        {
+            rank = 1;
+
+            for (idx = 0; idx < m_numberOfGroups; ++idx)
+            {
+                uint32_t otherLapTime = m_groups[idx].getfastestLapTime();
+
+                if ((0 != otherLapTime) &&
+                    (otherLapTime < lapTime))
+                {
+                    ++rank;
+                }
+            }
+        }
+
+        m_groups[group].setRank(rank);
+    }
+}
+
+template <typename Config>
+bool CompetitionT<Config>::isLapTimePlausible(uint32_t lapTime) const
+{
+    bool                    isPlausible = true;
+    const LapStatistics&    statistics  = m_groups[m_activeGroup].getStatistics();
+    uint64_t                scaled      = static_cast<uint64_t>(lapTime) * 100U;
+
+    /* Much faster than the group usually is, and far outside its spread. */
+    if ((PLAUSIBILITY_MIN_LAPS <= statistics.getCount()) &&
+        ((static_cast<uint64_t>(statistics.getMean()) * PLAUSIBILITY_RATIO) > scaled) &&
+        ((static_cast<uint64_t>(lapTime) + (static_cast<uint64_t>(statistics.getStdDev()) * PLAUSIBILITY_STDDEVS)) < statistics.getMean()))
+    {
+        LOG_WARNING("Lap time %u of group %u is implausible, mean %u.", lapTime, m_activeGroup, statistics.getMean());
+        isPlausible = false;
+    }
+    /* Much faster than any group was before. */
+    else if ((0 != m_trackLapTime) &&
+             ((static_cast<uint64_t>(m_trackLapTime) * PLAUSIBILITY_RATIO) > scaled))
+    {
+        LOG_WARNING("Lap time %u of group %u is implausible, track record %u.", lapTime, m_activeGroup, m_trackLapTime);
+        isPlausible = false;
+    }
+    else
+    {
+        ;
+    }
+
+    return isPlausible;
+}
+
+template <typename Config>
+void CompetitionT<Config>::updateBlindPeriod()
+{
+    uint32_t blindPeriod = m_minBlindPeriod;
+
+    /* Until the first plausible lap, only the min. blind period is known. */
+    if ((0 < m_blindPeriodRatio) &&
+        (0 != m_trackLapTime))
+    {
+        uint32_t adaptive = static_cast<uint32_t>((static_cast<uint64_t>(m_trackLapTime) * m_blindPeriodRatio) / 100U);
+
+        if (blindPeriod < adaptive)
+        {
+            blindPeriod = adaptive;
+        }
+    }
+
+    if (blindPeriod != m_blindPeriod)
+    {
+        LOG_INFO("Blind period: %u ms", blindPeriod);
+        m_blindPeriod = blindPeriod;
+    }
+}
+
+template <typename Config>
+void CompetitionT<Config>::saveSnapshot()
+{
+    Snapshot    snapshot;
+    uint8_t     idx         = 0;
+
+    static_assert(MAX_GROUPS <= SNAPSHOT_MAX_GROUPS, "The snapshot can't keep all groups.");
+
+    memset(&snapshot, 0, sizeof(snapshot));
+
+    snapshot.version        = SNAPSHOT_VERSION;
+    snapshot.state          = static_cast<uint8_t>(m_competitionState);
+    snapshot.activeGroup    = m_activeGroup;
+    snapshot.numberOfGroups = m_numberOfGroups;
+    snapshot.runLapTime     = m_runLapTime;
+    snapshot.trackLapTime   = m_trackLapTime;
+
+    for (idx = 0; idx < m_numberOfGroups; ++idx)
+    {
+        RunningStatistics::State lapTimes;
+
+        m_groups[idx].getStatistics().saveLapTimes(lapTimes);
+
+        snapshot.lapTimes[idx]  = m_groups[idx].getfastestLapTime();
+        snapshot.means[idx]     = static_cast<float>(lapTimes.mean);
+        snapshot.m2s[idx]       = static_cast<float>(lapTimes.m2);
+        snapshot.counts[idx]    = static_cast<uint16_t>((UINT16_MAX < lapTimes.count) ? UINT16_MAX : lapTimes.count);
+    }
+
+    if (false == Board::writeRtcData(&snapshot, sizeof(snapshot)))
+    {
+        LOG_WARNING("Failed to store competition snapshot.");
+    }
+
+    m_isSnapshotPending = false;
+}
+
+template <typename Config>
+bool CompetitionT<Config>::restoreSnapshot()
+{
+    bool        isRestored  = false;
+    Snapshot    snapshot;
+
+    /* A snapshot of other groups, e.g. changed before the restart, is discarded. */
+    if ((true == Board::readRtcData(&snapshot, sizeof(snapshot))) &&
+        (SNAPSHOT_VERSION == snapshot.version) &&
+        (m_numberOfGroups == snapshot.numberOfGroups) &&
+        (COMPETITION_STATE_FINISHED >= snapshot.state) &&
+        (m_numberOfGroups > snapshot.activeGroup))
+    {
+        uint8_t idx = 0;
+
+        for (idx = 0; idx < m_numberOfGroups; ++idx)
+        {
+            RunningStatistics::State lapTimes;
+
+            lapTimes.count  = snapshot.counts[idx];
+            lapTimes.mean   = snapshot.means[idx];
+            lapTimes.m2     = snapshot.m2s[idx];
+
+            m_groups[idx].setFastestLapTime(snapshot.lapTimes[idx]);
+            m_groups[idx].restoreStatistics(lapTimes);
+        }
+
+        m_competitionState  = static_cast<CompetitionState>(snapshot.state);
+        m_activeGroup       = snapshot.activeGroup;
+        m_runLapTime        = snapshot.runLapTime;
+        m_trackLapTime      = snapshot.trackLapTime;
+
+        calculateRanks();
+
+        /* The start timestamp is lost, the run must be released again. */
+        if (COMPETITION_STATE_STARTED == m_competitionState)
+        {
+            LOG_WARNING("Run of group %u was interrupted.", m_activeGroup);
+            m_competitionState = COMPETITION_STATE_UNRELEASED;
+        }
+
+        isRestored = true;
+    }
+
+    return isRestored;
+}
+
+/* The firmware needs only the configuration of its build, the native tools compare all of them. */
+#if defined(NATIVE)
+template class CompetitionT<SmallEventConfig>;
+template class CompetitionT<StandardEventConfig>;
+template class CompetitionT<LargeEventConfig>;
+#else
+template class CompetitionT<EventConfig>;
+#endif
+
 /******************************************************************************
  * External functions
  *****************************************************************************/
@@ -36,6 +36,7 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include "CompetitionConfig.h"
 #include "Group.h"
 
 /******************************************************************************
@@ -48,8 +49,16 @@
 
 /**
  *  Competition Handler Class.
+ *
+ *  It is configured at compile time, see CompetitionConfig.h. The groups
+ *  are part of the competition and all limits are constants, therefore
+ *  the arrays have their exact size and the compiler folds the checks
+ *  against the limits.
+ *
+ *  @tparam Config Configuration, e.g. StandardEventConfig.
  */
-class Competition
+template <typename Config>
+class CompetitionT
 {
 public:
     /**
@@ -64,33 +73,55 @@ public:
 
     } CompetitionState;
 
+    /** Group of this configuration. */
+    typedef GroupT<Config> Group;
+
+    /** Max. number of groups, who can participate. */
+    static const uint8_t MAX_GROUPS = Config::MAX_GROUPS;
+
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t MAX_GROUP_NAME_LENGTH = Group::MAX_NAME_LENGTH;
+
+    /** Max. number of runs in the journal. The oldest run is dropped first. */
+    static const uint8_t JOURNAL_SIZE = Config::JOURNAL_SIZE;
+
     /**
-     * Constructs the competition.
-     * 
-     * @param[in] groups    List of with max. supported groups.
-     * @param[in] maxGroups Max. number of groups in the list.
-     */
-    Competition(Group* groups, size_t maxGroups) :
-        m_groups(groups),
-        MAX_GROUPS(maxGroups),
-        m_lastRunGroup(0),
-        m_lastRunLapTime(0),
+     * Constructs the competition without lap times.
+     */
+    CompetitionT() :
+        m_groups(),
+        m_journal(),
+        m_journalBegin(0),
+        m_journalCount(0),
+        m_journalApplied(0),
+        m_runCounter(0),
+        m_trackLapTime(0),
+        m_blindPeriod(DEFAULT_BLIND_PERIOD),
+        m_minBlindPeriod(DEFAULT_BLIND_PERIOD),
+        m_blindPeriodRatio(0),
+        m_runLapTime(0),
         m_startTimestamp(0),
         m_competitionState(COMPETITION_STATE_UNRELEASED),
         m_numberOfGroups(0),
-        m_activeGroup(0)
+        m_activeGroup(0),
+        m_isSnapshotPending(false),
+        m_isRunSuspicious(false),
+        m_isRunPending(false),
+        m_isHoldSuspicious(false)
     {
     }
 
     /**
      * Destroys the competition.
      */
-    ~Competition()
+    ~CompetitionT()
     {
     }
 
     /**
-     * Initialize the competition by loading settings.
+     * Initialize the competition by loading settings. After a restart the
+     * competition state and the fastest lap times are restored from the
+     * RTC memory.
      * 
      * @return If successful, it will return true otherwise false.
      */
@@ -98,18 +129,18 @@ public:
 
     /**
      *  Handle the competition state machine, depending on the user input 
-     *  from web frontend and sensor input.
+     *  from web frontend and sensor input. The start and the finish of a run
+     *  are published on the event bus.
      * 
-     *  @param[out] outputMessage Message to be sent to Client through Web Socket.
      *  @return If robot is detected during the correct competition state, returns true. Otherwise, false
      */
-    bool handleCompetition(String &outputMessage);
+    bool handleCompetition();
 
     /**
      *  Checks the current Competition state to be either Unreleased or Finished. 
      *  Releases the competition if found in any of these states.
      * 
-     *  @param[in] activeGroup Number of currently Active Group in Client.
+     *  @param[in] activeGroup Number of currently Active Group in Client. It must be one of the configured groups.
      *  @return If competition is released, returns true. Otherwise, false.
      */
     bool setReleasedState(uint8_t activeGroup);
@@ -130,6 +161,26 @@ public:
      */
     bool setNumberofGroups(uint8_t groups);
 
+    /**
+     *  Get the max. number of groups, which can participate.
+     * 
+     *  @return Max. number of groups
+     */
+    uint8_t getMaxNumberOfGroups() const
+    {
+        return static_cast<uint8_t>(MAX_GROUPS);
+    }
+
+    /**
+     *  Get the min. number of groups, which must participate.
+     * 
+     *  @return Min. number of groups
+     */
+    uint8_t getMinNumberOfGroups() const
+    {
+        return MIN_NUMBER_OF_GROUPS;
+    }
+
     /**
      *   Retrieves the laptime from a group.
      *   @param[in] group Number of Group to retrieve value for.
@@ -145,23 +196,32 @@ public:
      */
     bool clearLaptime(uint8_t group);
 
+    /**
+     *  Retrieves the lap time statistics of a group.
+     *
+     *  @param[in] group Number of Group to retrieve the statistics for.
+     *  @param[out] statistics Lap time statistics of the group.
+     *  @return If number of group is valid, returns true. Otherwise, false.
+     */
+    bool getLapStatistics(uint8_t group, LapStatistics &statistics);
+
     /**
      *  Sets the Name of the selected group
      *
      *  @param[in] group Number of Group to set the name for.
-     *  @param[in] groupName Chosen Name of the group
+     *  @param[in] groupName Chosen Name of the group, a longer name than MAX_GROUP_NAME_LENGTH is truncated.
      *  @return If the name of the groups is successfully set, returns true. Otherwise, false.
      */
-    bool setGroupName(uint8_t group, const String &groupName);
+    bool setGroupName(uint8_t group, const char *groupName);
 
     /**
      *  Retrieves the name of the selected group
      *  
      *  @param[in] group Number of Group to get Name for.
-     *  @param[out] groupName Name of selected group.
+     *  @param[out] groupName Name of selected group, valid until the name is changed.
      *  @return  If the name of the groups is successfully retrieved, returns true. Otherwise, false.
      */
-    bool getGroupName(uint8_t group, String &groupName);
+    bool getGroupName(uint8_t group, const char *&groupName) const;
 
     /**
      *  Sets the Name of the selected group to "" as a default value.
@@ -172,42 +232,354 @@ public:
     bool clearName(uint8_t group);
 
     /**
-     *  Rejects the last fastest time of a group, reverting it to its previous fastest time.
+     *  Get the current competition state.
+     * 
+     *  @return Competition state
+     */
+    CompetitionState getState() const
+    {
+        return m_competitionState;
+    }
+
+    /**
+     *  Get the group, which is released for the run.
+     * 
+     *  @return Group index
+     */
+    uint8_t getActiveGroup() const
+    {
+        return m_activeGroup;
+    }
+
+    /**
+     *  Get the measured lap time of the last finished run.
+     * 
+     *  @return Lap time in ms
+     */
+    uint32_t getRunLapTime() const
+    {
+        return m_runLapTime;
+    }
+
+    /**
+     *  Get the rank of a group in the result table, derived from the fastest lap times.
+     *  The ranks are maintained on every change of a fastest lap time, therefore
+     *  it takes constant time.
+     * 
+     *  @param[in] group Number of Group to get the rank for.
+     *  @return Rank, starting with 1. If the group has no lap time yet or is invalid, returns 0.
+     */
+    uint8_t getRank(uint8_t group);
+
+    /**
+     *  Rejects the last run, reverting its group to the state before the run.
+     *  A held lap time is discarded instead. The last run can be rejected
+     *  only once, use undoRun() to revert older runs.
      *  
      *  @return If succesfully rolled back returns true, Otherwise, false.
      */
     bool rejectRun();
 
+    /**
+     *  Undo the latest applied run in the journal. Repeated calls undo the
+     *  runs before it, up to the oldest run in the journal.
+     *
+     *  @param[out] run Number of the undone run.
+     *  @return If a run was undone, returns true. Otherwise, false.
+     */
+    bool undoRun(uint32_t &run);
+
+    /**
+     *  Redo the earliest undone run in the journal. A new run discards all
+     *  undone runs, therefore they can't be redone anymore.
+     *
+     *  @param[out] run Number of the redone run.
+     *  @return If a run was redone, returns true. Otherwise, false.
+     */
+    bool redoRun(uint32_t &run);
+
+    /**
+     *  Get the number of runs in the journal.
+     *
+     *  @return Number of runs
+     */
+    uint8_t getJournalCount() const
+    {
+        return m_journalCount;
+    }
+
+    /**
+     *  Get a run from the journal.
+     *
+     *  @param[in] idx          Index of the run, 0 is the oldest run.
+     *  @param[out] run         Number of the run, counted since start.
+     *  @param[out] group       Group of the run.
+     *  @param[out] lapTime     Lap time in ms.
+     *  @param[out] isUndone    Is the run undone?
+     *  @return If the index is valid, returns true. Otherwise, false.
+     */
+    bool getJournalEntry(uint8_t idx, uint32_t &run, uint8_t &group, uint32_t &lapTime, bool &isUndone) const;
+
+    /**
+     *  Is the lap time of the last run implausible, e.g. because a person
+     *  walked through the sensor right after the start?
+     *
+     *  @return If suspicious, returns true. Otherwise, false.
+     */
+    bool isRunSuspicious() const
+    {
+        return m_isRunSuspicious;
+    }
+
+    /**
+     *  Is the lap time of the last run held, until it is confirmed or rejected?
+     *
+     *  @return If pending, returns true. Otherwise, false.
+     */
+    bool isRunPending() const
+    {
+        return m_isRunPending;
+    }
+
+    /**
+     *  Confirms the held lap time of the last run, which updates the fastest
+     *  lap time of its group.
+     *
+     *  @return If a lap time was pending, returns true. Otherwise, false.
+     */
+    bool confirmRun();
+
+    /**
+     *  Enable or disable holding suspicious lap times. A held lap time is
+     *  only applied after confirmRun(). Otherwise it is applied immediately
+     *  and only marked as suspicious. It is disabled by default.
+     *
+     *  @param[in] isEnabled Hold (true) or apply (false) suspicious lap times.
+     */
+    void setHoldSuspicious(bool isEnabled)
+    {
+        m_isHoldSuspicious = isEnabled;
+    }
+
+    /**
+     *  Are suspicious lap times held?
+     *
+     *  @return If held, returns true. Otherwise, false.
+     */
+    bool isHoldSuspicious() const
+    {
+        return m_isHoldSuspicious;
+    }
+
+    /**
+     *  Configure the blind period of the sensor after the start and store it
+     *  in the settings. In adaptive mode, the blind period is a percentage
+     *  of the track record, but never less than the given period.
+     *
+     *  @param[in] period   Blind period in ms, in adaptive mode the min. blind period.
+     *  @param[in] ratio    Blind period in % of the track record, 0 for a fixed blind period.
+     *  @return If the configuration is valid, returns true. Otherwise, false.
+     */
+    bool setBlindPeriod(uint32_t period, uint8_t ratio);
+
+    /**
+     *  Get the configuration of the blind period.
+     *
+     *  @param[out] period  Blind period in ms, in adaptive mode the min. blind period.
+     *  @param[out] ratio   Blind period in % of the track record, 0 for a fixed blind period.
+     */
+    void getBlindPeriod(uint32_t &period, uint8_t &ratio) const
+    {
+        period  = m_minBlindPeriod;
+        ratio   = m_blindPeriodRatio;
+    }
+
+    /**
+     *  Get the blind period, which is used for the next run.
+     *
+     *  @return Blind period in ms
+     */
+    uint32_t getEffectiveBlindPeriod() const
+    {
+        return m_blindPeriod;
+    }
+
 private:
+    /**
+     *  A run in the journal. It keeps the state of its group before the run,
+     *  therefore an undo restores it and a redo applies the lap time again,
+     *  both without a rescan of the other runs. Of the statistics only the
+     *  accumulators and the markers are kept.
+     */
+    typedef struct
+    {
+        uint32_t                run;            /**< Number of the run, counted since start. */
+        uint8_t                 group;          /**< Group of the run. */
+        bool                    isPlausible;    /**< Does the lap time count for the track record? */
+        uint32_t                lapTime;        /**< Lap time in ms. */
+        uint32_t                fastestLapTime; /**< Fastest lap time in ms of the group, before the run. */
+        uint32_t                trackLapTime;   /**< Track record in ms, before the run. */
+        LapStatistics::Snapshot statistics;     /**< Lap time statistics of the group, before the run. */
+
+    } JournalEntry;
+
     /**
      *  Updates fastest Lap Time of the currently Active Group.
      *
      *  @param[in] lapTime Duration of Competition Lap
+     *  @param[in] isPlausible Only a plausible lap time updates the track record.
      */
-    void updateLapTime(uint32_t lapTime);
+    void updateLapTime(uint32_t lapTime, bool isPlausible);
+
+    /**
+     *  Apply the lap time of a journal entry to its group and to the track record.
+     *
+     *  @param[in] entry Journal entry
+     */
+    void applyRun(const JournalEntry &entry);
+
+    /**
+     *  Revert the group and the track record to the state before a journal entry.
+     *  The track record is only reverted, if the run still holds it.
+     *
+     *  @param[in] entry Journal entry
+     */
+    void revertRun(const JournalEntry &entry);
+
+    /**
+     *  Get the position of a journal entry in the ring buffer.
+     *
+     *  @param[in] idx Index of the entry, 0 is the oldest entry.
+     *  @return Position in the ring buffer
+     */
+    uint8_t getJournalPosition(uint8_t idx) const
+    {
+        return static_cast<uint8_t>((m_journalBegin + idx) % JOURNAL_SIZE);
+    }
+
+    /**
+     *  Drop the runs of a range of groups from the journal, e.g. because
+     *  their lap times were cleared and their runs can't be reverted anymore.
+     *  The runs of the other groups keep their order and their undo state.
+     *
+     *  @param[in] firstGroup   First group, whose runs are dropped.
+     *  @param[in] lastGroup    Last group, whose runs are dropped.
+     */
+    void dropJournalEntries(uint8_t firstGroup, uint8_t lastGroup);
+
+    /**
+     *  Update the ranks after the fastest lap time of a group changed. Only
+     *  the groups between the previous and the new lap time move by one rank.
+     *
+     *  @param[in] group Number of the group, whose fastest lap time changed.
+     *  @param[in] previousLapTime Fastest lap time in ms before the change.
+     */
+    void updateRanks(uint8_t group, uint32_t previousLapTime);
+
+    /**
+     *  Calculate the ranks of all groups, e.g. after the number of groups changed.
+     */
+    void calculateRanks();
+
+    /**
+     *  Checks a lap time of the active group against its previous lap times
+     *  and against the fastest plausible lap time of all groups. It takes
+     *  constant time, because only the statistics are used.
+     *
+     *  @param[in] lapTime Lap time in ms
+     *  @return If plausible, returns true. Otherwise, false.
+     */
+    bool isLapTimePlausible(uint32_t lapTime) const;
+
+    /**
+     *  Derive the blind period from its configuration and the track record.
+     *  It is done whenever one of them changes, therefore the sensor check
+     *  during a run is a single comparison.
+     */
+    void updateBlindPeriod();
+
+    /**
+     *  Store the competition state and the fastest lap times in the RTC
+     *  memory, so they survive a restart.
+     */
+    void saveSnapshot();
+
+    /**
+     *  Restore the competition state and the fastest lap times from the
+     *  RTC memory.
+     *
+     *  @return If a valid snapshot was restored, returns true. Otherwise, false.
+     */
+    bool restoreSnapshot();
 
     /**
      *  After the first detection of the robot with the ext. sensor, this consider
      *  the duration in ms after that the sensor will be considered again.
+     *  It is the default, until a blind period is configured.
      */
-    static const uint32_t SENSOR_BLIND_PERIOD   = 400;
+    static const uint32_t DEFAULT_BLIND_PERIOD  = Config::DEFAULT_BLIND_PERIOD;
+
+    /** Max. blind period in ms. */
+    static const uint32_t MAX_BLIND_PERIOD      = 60000;
+
+    /** Max. blind period in % of the track record. */
+    static const uint8_t MAX_BLIND_PERIOD_RATIO = 90;
 
     /**
      *  Minimum Number of Participating Groups 
      */
-    static const uint8_t MIN_NUMBER_OF_GROUPS   = 1;
+    static const uint8_t MIN_NUMBER_OF_GROUPS   = Config::MIN_GROUPS;
+
+    /**
+     *  Min. number of lap times of a group, before its own lap times are
+     *  used for the plausibility check.
+     */
+    static const uint32_t PLAUSIBILITY_MIN_LAPS = 3;
+
+    /**
+     *  A lap time below this percentage of the group mean or the track
+     *  record is implausible.
+     */
+    static const uint32_t PLAUSIBILITY_RATIO    = 75;
+
+    /**
+     *  A lap time must be additionally this number of standard deviations
+     *  below the group mean, to be implausible.
+     */
+    static const uint32_t PLAUSIBILITY_STDDEVS  = 3;
 
     /** List of max. supported groups. Not all may participate in the competition. */
-    Group*              m_groups;
+    Group               m_groups[MAX_GROUPS];
 
-    /** Max. number of groups, who can participate. */
-    const size_t        MAX_GROUPS;
+    /** Journal of the recent runs, a ring buffer. */
+    JournalEntry        m_journal[JOURNAL_SIZE];
+
+    /** Index of the oldest run in the journal. */
+    uint8_t             m_journalBegin;
+
+    /** Number of runs in the journal. */
+    uint8_t             m_journalCount;
+
+    /** Number of applied runs in the journal, the runs after them are undone. */
+    uint8_t             m_journalApplied;
+
+    /** Number of runs since start. */
+    uint32_t            m_runCounter;
 
-    /** The id of the group which did the last run. */
-    size_t              m_lastRunGroup;
+    /** The track record in ms: the fastest plausible lap time of all groups. */
+    uint32_t            m_trackLapTime;
 
-    /** The lap time in ms of the last run. */
-    uint32_t            m_lastRunLapTime;
+    /** Blind period in ms after the start, derived from the configuration and the track record. */
+    uint32_t            m_blindPeriod;
+
+    /** Configured blind period in ms, in adaptive mode the min. blind period. */
+    uint32_t            m_minBlindPeriod;
+
+    /** Blind period in % of the track record, 0 for a fixed blind period. */
+    uint8_t             m_blindPeriodRatio;
+
+    /** The measured lap time in ms of the last run. */
+    uint32_t            m_runLapTime;
 
     /** Competition start timestamp in ms. */
     uint32_t            m_startTimestamp;
@@ -221,10 +593,40 @@ private:
     /** Group that has been RELEASED for the run */
     uint8_t             m_activeGroup;
 
-    /* Default constructor not allowed. */
-    Competition();
+    /**
+     *  Is a snapshot pending? It is stored deferred, to keep it off the
+     *  path, which sends the competition events.
+     */
+    bool                m_isSnapshotPending;
+
+    /** Is the lap time of the last run implausible? */
+    bool                m_isRunSuspicious;
+
+    /** Is the lap time of the last run held, until it is confirmed or rejected? */
+    bool                m_isRunPending;
+
+    /** Hold suspicious lap times until they are confirmed? */
+    bool                m_isHoldSuspicious;
+
+    /**
+     *  An instance shall not be copied.
+     *
+     *  @param[in] competition Competition instance to copy.
+     */
+    CompetitionT(const CompetitionT& competition);
+
+    /**
+     *  An instance shall not assigned.
+     *
+     *  @param[in] competition Competition instance to assign.
+     *  @return Reference to this instance.
+     */
+    CompetitionT& operator=(const CompetitionT& competition);
 };
 
+/** Competition of the build configuration. */
+typedef CompetitionT<EventConfig> Competition;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
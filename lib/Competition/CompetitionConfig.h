@@ -0,0 +1,131 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compile-time configurations of the competition
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef COMPETITION_CONFIG_H_
+#define COMPETITION_CONFIG_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Configuration for small events, e.g. a class room. It has the lowest
+ *  RAM footprint.
+ */
+struct SmallEventConfig
+{
+    /** Max. number of groups, who can participate. */
+    static const uint8_t    MAX_GROUPS              = 4U;
+
+    /** Min. number of groups, who must participate. */
+    static const uint8_t    MIN_GROUPS              = 1U;
+
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t    MAX_GROUP_NAME_LENGTH   = 19U;
+
+    /** Blind period in ms of the sensor after the start, until one is configured. */
+    static const uint32_t   DEFAULT_BLIND_PERIOD    = 400U;
+
+    /** Max. number of runs in the undo journal. */
+    static const uint8_t    JOURNAL_SIZE            = 4U;
+};
+
+/**
+ *  Configuration for the usual events. Its settings layout in the EEPROM is
+ *  the one of former firmware versions.
+ */
+struct StandardEventConfig
+{
+    /** Max. number of groups, who can participate. */
+    static const uint8_t    MAX_GROUPS              = 10U;
+
+    /** Min. number of groups, who must participate. */
+    static const uint8_t    MIN_GROUPS              = 1U;
+
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t    MAX_GROUP_NAME_LENGTH   = 19U;
+
+    /** Blind period in ms of the sensor after the start, until one is configured. */
+    static const uint32_t   DEFAULT_BLIND_PERIOD    = 400U;
+
+    /** Max. number of runs in the undo journal. */
+    static const uint8_t    JOURNAL_SIZE            = 8U;
+};
+
+/**
+ *  Configuration for large events, e.g. a school championship. The number
+ *  of groups is limited by the group names in the EEPROM.
+ */
+struct LargeEventConfig
+{
+    /** Max. number of groups, who can participate. */
+    static const uint8_t    MAX_GROUPS              = 16U;
+
+    /** Min. number of groups, who must participate. */
+    static const uint8_t    MIN_GROUPS              = 1U;
+
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t    MAX_GROUP_NAME_LENGTH   = 19U;
+
+    /** Blind period in ms of the sensor after the start, until one is configured. */
+    static const uint32_t   DEFAULT_BLIND_PERIOD    = 400U;
+
+    /** Max. number of runs in the undo journal. */
+    static const uint8_t    JOURNAL_SIZE            = 16U;
+};
+
+/**
+ *  Configuration of the build, selected by the build flags
+ *  EVENT_CONFIG_SMALL or EVENT_CONFIG_LARGE. The default is the
+ *  standard configuration.
+ */
+#if defined(EVENT_CONFIG_SMALL)
+typedef SmallEventConfig    EventConfig;
+#elif defined(EVENT_CONFIG_LARGE)
+typedef LargeEventConfig    EventConfig;
+#else
+typedef StandardEventConfig EventConfig;
+#endif
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* COMPETITION_CONFIG_H_ */
@@ -36,6 +36,9 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <FixedString.h>
+#include "CompetitionConfig.h"
+#include "LapStatistics.h"
 
 /******************************************************************************
  * Macros
@@ -48,24 +51,35 @@
 /**
  * A group or in other words a team which takes part in the challenge.
  * It shall contain all group relevant informations.
+ *
+ * @tparam Config Configuration of the competition, e.g. StandardEventConfig.
  */
-class Group
+template <typename Config>
+class GroupT
 {
 public:
 
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t MAX_NAME_LENGTH = Config::MAX_GROUP_NAME_LENGTH;
+
+    /** Name of a group. */
+    typedef FixedString<MAX_NAME_LENGTH> Name;
+
     /**
      * Constructs a group with a empty name.
      */
-    Group() :
+    GroupT() :
         m_name(),
-        m_fastestLapTime(0)
+        m_fastestLapTime(0),
+        m_statistics(),
+        m_rank(0)
     {
     }
 
     /**
      * Destroys the group.
      */
-    ~Group()
+    ~GroupT()
     {
     }
 
@@ -74,17 +88,17 @@ public:
      * 
      * @return Group name 
      */
-    String getName() const
+    const char* getName() const
     {
-        return m_name;
+        return m_name.c_str();
     }
 
     /**
-     * Set the group name.
+     * Set the group name. A longer name is truncated.
      * 
      * @param[in] name  The name of the group.
      */
-    void setName(const String& name)
+    void setName(const char* name)
     {
         m_name = name;
     }
@@ -124,12 +138,90 @@ public:
         }
     }
 
+    /**
+     * Record a lap time in the statistics and set it as fastest lap time,
+     * if it is faster than the current one.
+     * 
+     * @param[in] lapTime   The lap time in ms.
+     */
+    void recordLapTime(uint32_t lapTime)
+    {
+        setLapTimeIfFaster(lapTime);
+        m_statistics.record(lapTime);
+    }
+
+    /**
+     * Clear the fastest lap time and the statistics.
+     */
+    void clearLapTimes()
+    {
+        m_fastestLapTime = 0;
+        m_statistics.clear();
+    }
+
+    /**
+     * Get the statistics of all lap times.
+     * 
+     * @return Lap time statistics
+     */
+    const LapStatistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /**
+     * Restore the statistics of all lap times, e.g. to revert a run.
+     * 
+     * @param[in] snapshot  State of the lap time statistics
+     */
+    void restoreStatistics(const LapStatistics::Snapshot& snapshot)
+    {
+        m_statistics.restore(snapshot);
+    }
+
+    /**
+     * Restore only the mean and the variance of all lap times, e.g. after a
+     * restart.
+     * 
+     * @param[in] lapTimes  State of the mean and the variance
+     */
+    void restoreStatistics(const RunningStatistics::State& lapTimes)
+    {
+        m_statistics.restoreLapTimes(lapTimes);
+    }
+
+    /**
+     * Get the rank in the result table.
+     * 
+     * @return Rank, starting with 1. Without lap time it is 0.
+     */
+    uint8_t getRank() const
+    {
+        return m_rank;
+    }
+
+    /**
+     * Set the rank in the result table. It is maintained by the competition,
+     * whenever a fastest lap time changes.
+     * 
+     * @param[in] rank  Rank, starting with 1. Without lap time it is 0.
+     */
+    void setRank(uint8_t rank)
+    {
+        m_rank = rank;
+    }
+
 private:
 
-    String      m_name;             /**< The name of the group, must not be unique. */
-    uint32_t    m_fastestLapTime;   /**< The fastest lap time in ms. */
+    Name            m_name;             /**< The name of the group, must not be unique. */
+    uint32_t        m_fastestLapTime;   /**< The fastest lap time in ms. */
+    LapStatistics   m_statistics;       /**< Statistics of all lap times. */
+    uint8_t         m_rank;             /**< Rank in the result table, 0 without lap time. */
 };
 
+/** Group of the build configuration. */
+typedef GroupT<EventConfig> Group;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
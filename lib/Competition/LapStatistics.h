@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lap time statistics of a group
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef LAP_STATISTICS_H_
+#define LAP_STATISTICS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <Statistics.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Statistics of all lap times of a group, which show how consistent the
+ * group is. The lap times are not stored, the memory is fixed per group.
+ */
+class LapStatistics
+{
+public:
+
+    /**
+     * State of the statistics, e.g. to revert a run. It keeps only the
+     * accumulators and the markers, not the quantiles, which are fixed.
+     */
+    typedef struct
+    {
+        RunningStatistics::State    lapTimes;   /**< Mean and variance of the lap times. */
+        P2Quantile::Markers         median;     /**< Median of the lap times. */
+        P2Quantile::Markers         p90;        /**< 90th percentile of the lap times. */
+
+    } Snapshot;
+
+    /**
+     * Constructs the statistics without lap times.
+     */
+    LapStatistics() :
+        m_lapTimes(),
+        m_median(0.5F),
+        m_p90(0.9F)
+    {
+    }
+
+    /**
+     * Destroys the statistics.
+     */
+    ~LapStatistics()
+    {
+    }
+
+    /**
+     * Record a lap time.
+     *
+     * @param[in] lapTime   The lap time in ms.
+     */
+    void record(uint32_t lapTime)
+    {
+        m_lapTimes.record(static_cast<double>(lapTime));
+        m_median.record(static_cast<float>(lapTime));
+        m_p90.record(static_cast<float>(lapTime));
+    }
+
+    /**
+     * Clear all lap times.
+     */
+    void clear()
+    {
+        m_lapTimes.clear();
+        m_median.clear();
+        m_p90.clear();
+    }
+
+    /**
+     * Get the number of laps.
+     *
+     * @return Number of laps
+     */
+    uint32_t getCount() const
+    {
+        return m_lapTimes.getCount();
+    }
+
+    /**
+     * Get the mean lap time in ms.
+     *
+     * @return Lap time in ms
+     */
+    uint32_t getMean() const
+    {
+        return toMs(m_lapTimes.getMean());
+    }
+
+    /**
+     * Get the standard deviation of the lap times in ms.
+     *
+     * @return Standard deviation in ms
+     */
+    uint32_t getStdDev() const
+    {
+        return toMs(m_lapTimes.getStdDev());
+    }
+
+    /**
+     * Get the estimated median lap time in ms.
+     *
+     * @return Lap time in ms
+     */
+    uint32_t getMedian() const
+    {
+        return toMs(m_median.getValue());
+    }
+
+    /**
+     * Get the estimated 90th percentile of the lap times in ms.
+     *
+     * @return Lap time in ms
+     */
+    uint32_t getP90() const
+    {
+        return toMs(m_p90.getValue());
+    }
+
+    /**
+     * Save the state of the statistics.
+     *
+     * @param[out] snapshot State of the statistics
+     */
+    void save(Snapshot& snapshot) const
+    {
+        m_lapTimes.getState(snapshot.lapTimes);
+        m_median.getMarkers(snapshot.median);
+        m_p90.getMarkers(snapshot.p90);
+    }
+
+    /**
+     * Restore the statistics to a saved state.
+     *
+     * @param[in] snapshot  State of the statistics
+     */
+    void restore(const Snapshot& snapshot)
+    {
+        m_lapTimes.setState(snapshot.lapTimes);
+        m_median.setMarkers(snapshot.lapTimes.count, snapshot.median);
+        m_p90.setMarkers(snapshot.lapTimes.count, snapshot.p90);
+    }
+
+    /**
+     * Save only the state of the mean and the variance, e.g. for a compact
+     * snapshot.
+     *
+     * @param[out] lapTimes State of the mean and the variance
+     */
+    void saveLapTimes(RunningStatistics::State& lapTimes) const
+    {
+        m_lapTimes.getState(lapTimes);
+    }
+
+    /**
+     * Restore only the mean and the variance. The median and the 90th
+     * percentile are estimated again from the following lap times.
+     *
+     * @param[in] lapTimes  State of the mean and the variance
+     */
+    void restoreLapTimes(const RunningStatistics::State& lapTimes)
+    {
+        m_lapTimes.setState(lapTimes);
+        m_median.clear();
+        m_p90.clear();
+    }
+
+private:
+
+    RunningStatistics   m_lapTimes; /**< Mean and variance of the lap times. */
+    P2Quantile          m_median;   /**< Median of the lap times. */
+    P2Quantile          m_p90;      /**< 90th percentile of the lap times. */
+
+    /**
+     * Round a time to full ms.
+     *
+     * @param[in] value Time in ms
+     * @return Time in full ms
+     */
+    static uint32_t toMs(double value)
+    {
+        return static_cast<uint32_t>(value + 0.5);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LAP_STATISTICS_H_ */
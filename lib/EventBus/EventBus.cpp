@@ -0,0 +1,135 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Typed event bus between the competition and its transports
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EventBus.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool EventBus::subscribe(Listener& listener)
+{
+    bool    isSuccess   = true;
+    uint8_t idx         = 0U;
+
+    while ((m_listenerCount > idx) && (&listener != m_listeners[idx]))
+    {
+        ++idx;
+    }
+
+    if (m_listenerCount == idx)
+    {
+        if (MAX_LISTENERS <= m_listenerCount)
+        {
+            isSuccess = false;
+        }
+        else
+        {
+            m_listeners[m_listenerCount] = &listener;
+            ++m_listenerCount;
+        }
+    }
+
+    return isSuccess;
+}
+
+void EventBus::unsubscribe(Listener& listener)
+{
+    uint8_t idx = 0U;
+
+    while ((m_listenerCount > idx) && (&listener != m_listeners[idx]))
+    {
+        ++idx;
+    }
+
+    if (m_listenerCount > idx)
+    {
+        /* Keep the order of the remaining listeners. */
+        --m_listenerCount;
+
+        while (m_listenerCount > idx)
+        {
+            m_listeners[idx] = m_listeners[idx + 1U];
+            ++idx;
+        }
+
+        m_listeners[m_listenerCount] = nullptr;
+    }
+}
+
+void EventBus::publish(const Event& event)
+{
+    uint8_t idx = 0U;
+
+    for (idx = 0U; idx < m_listenerCount; ++idx)
+    {
+        m_listeners[idx]->onEvent(event);
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,240 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Typed event bus between the competition and its transports
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef EVENT_BUS_H_
+#define EVENT_BUS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Event bus, which delivers the competition events to its listeners.
+ *
+ *  The events are plain structs and the listeners are registered in a
+ *  fixed list, therefore publishing never allocates memory. The publisher
+ *  doesn't know the protocols: every listener serialises an event itself
+ *  and only if it has someone to send it to.
+ *
+ *  The listeners are called synchronously in the context of the publisher,
+ *  which is the time critical sensor task for the run events. A listener
+ *  shall defer expensive work, e.g. by setting a flag.
+ */
+class EventBus
+{
+public:
+
+    /** Event types. */
+    typedef enum
+    {
+        EVENT_RUN_STARTED = 0,  /**< The robot passed the start. */
+        EVENT_RUN_FINISHED,     /**< The robot passed the finish. */
+        EVENT_TABLE_CHANGED     /**< A lap time, rank or group name changed. */
+
+    } EventType;
+
+    /** The lap time of the finished run is implausible. */
+    static const uint8_t FLAG_SUSPICIOUS    = 0x01U;
+
+    /** The lap time of the finished run is held, until it is confirmed or rejected. */
+    static const uint8_t FLAG_PENDING       = 0x02U;
+
+    /** Event, which is delivered to the listeners. */
+    typedef struct
+    {
+        EventType   type;       /**< Event type. */
+        uint8_t     group;      /**< Group of the run, not used by EVENT_TABLE_CHANGED. */
+        uint8_t     flags;      /**< Flags of the finished run, see FLAG_SUSPICIOUS and FLAG_PENDING. */
+        uint32_t    lapTime;    /**< Lap time in ms of the finished run. */
+
+    } Event;
+
+    /**
+     *  Listener, which receives the events.
+     */
+    class Listener
+    {
+    public:
+
+        /**
+         *  Destroys the listener.
+         */
+        virtual ~Listener()
+        {
+        }
+
+        /**
+         *  Handle a event.
+         *
+         *  @param[in] event    Event
+         */
+        virtual void onEvent(const Event& event) = 0;
+    };
+
+    /**
+     *  Get the event bus instance.
+     *
+     *  @return Event bus instance
+     */
+    static EventBus& getInstance()
+    {
+        static EventBus instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     *  Register a listener. A listener, which is already registered, is not
+     *  registered twice.
+     *
+     *  @param[in] listener Listener
+     *
+     *  @return If registered, it will return true. If the list is full, it will return false.
+     */
+    bool subscribe(Listener& listener);
+
+    /**
+     *  Remove a listener.
+     *
+     *  @param[in] listener Listener
+     */
+    void unsubscribe(Listener& listener);
+
+    /**
+     *  Deliver a event to all listeners, in the order they registered.
+     *
+     *  @param[in] event    Event
+     */
+    void publish(const Event& event);
+
+    /**
+     *  Publish that the robot passed the start.
+     *
+     *  @param[in] group    Group of the run.
+     */
+    void publishRunStarted(uint8_t group)
+    {
+        Event event = { EVENT_RUN_STARTED, group, 0U, 0U };
+
+        publish(event);
+    }
+
+    /**
+     *  Publish that the robot passed the finish.
+     *
+     *  @param[in] group    Group of the run.
+     *  @param[in] lapTime  Lap time in ms.
+     *  @param[in] flags    Flags, see FLAG_SUSPICIOUS and FLAG_PENDING.
+     */
+    void publishRunFinished(uint8_t group, uint32_t lapTime, uint8_t flags)
+    {
+        Event event = { EVENT_RUN_FINISHED, group, flags, lapTime };
+
+        publish(event);
+    }
+
+    /**
+     *  Publish that the result table changed.
+     */
+    void publishTableChanged()
+    {
+        Event event = { EVENT_TABLE_CHANGED, 0U, 0U, 0U };
+
+        publish(event);
+    }
+
+    /**
+     *  Get the number of registered listeners.
+     *
+     *  @return Number of listeners
+     */
+    uint8_t getListenerCount() const
+    {
+        return m_listenerCount;
+    }
+
+private:
+
+    /** Max. number of listeners. */
+    static const uint8_t MAX_LISTENERS = 4U;
+
+    /** Registered listeners, the first m_listenerCount are valid. */
+    Listener*   m_listeners[MAX_LISTENERS];
+
+    /** Number of registered listeners. */
+    uint8_t     m_listenerCount;
+
+    /**
+     * Constructs the event bus without listeners.
+     */
+    EventBus() :
+        m_listeners(),
+        m_listenerCount(0U)
+    {
+    }
+
+    /**
+     * Destroys the event bus.
+     */
+    ~EventBus()
+    {
+    }
+
+    /**
+     *  An instance shall not be copied.
+     *
+     *  @param[in] bus Event bus instance to copy.
+     */
+    EventBus(const EventBus& bus);
+
+    /**
+     *  An instance shall not assigned.
+     *
+     *  @param[in] bus Event bus instance to assign.
+     *  @return Reference to this instance.
+     */
+    EventBus& operator=(const EventBus& bus);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* EVENT_BUS_H_ */
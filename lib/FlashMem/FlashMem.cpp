@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "FlashMem.h"
+#include <Trace.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -50,12 +51,20 @@
  * Prototypes
  *****************************************************************************/
 
+static bool commit();
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
-/** Size of the EEPROM destined to store credentials*/
-static const uint16_t EEPROM_SIZE = 512;
+/** Number of nested transactions. If not 0, commits are deferred until the outermost transaction ends. */
+static uint8_t gTransactionDepth = 0U;
+
+/** Is deferred commit enabled? If yes, commits are deferred until flush(). */
+static bool gIsCommitDeferred = false;
+
+/** Are there uncommitted writes, which were deferred by a transaction or by deferred commit? */
+static bool gIsCommitPending = false;
 
 /******************************************************************************
  * Public Methods
@@ -65,7 +74,7 @@ bool FlashMem::begin()
 {
     bool isSuccess = true;
     
-    EEPROM.begin(EEPROM_SIZE);
+    EEPROM.begin(FlashMem::EEPROM_SIZE);
     return isSuccess;
 }
 
@@ -88,11 +97,39 @@ void FlashMem::getString(const uint16_t &address, const uint8_t &maxLength, Stri
     }
 }
 
+void FlashMem::getString(const uint16_t &address, const uint8_t &maxLength, char *output, size_t size)
+{
+    size_t length = 0;
+
+    if ((nullptr != output) && (0 < size))
+    {
+        while ((length < maxLength) && ((length + 1) < size))
+        {
+            char temp = EEPROM.read(address + length);
+
+            if (0x00 == temp)
+            {
+                break;
+            }
+
+            output[length] = temp;
+            ++length;
+        }
+
+        output[length] = '\0';
+    }
+}
+
 bool FlashMem::setString(const uint16_t &address, const uint8_t &maxLength, const String &input)
+{
+    return setString(address, maxLength, input.c_str());
+}
+
+bool FlashMem::setString(const uint16_t &address, const uint8_t &maxLength, const char *input)
 {
     bool isSuccess = false;
 
-    for (uint8_t memoryPosition = 0; memoryPosition < maxLength; memoryPosition++)
+    for (uint8_t memoryPosition = 0; (nullptr != input) && (memoryPosition < maxLength); memoryPosition++)
     {
         EEPROM.write(address + memoryPosition, input[memoryPosition]);
         if (0x00 == input[memoryPosition])
@@ -104,10 +141,7 @@ bool FlashMem::setString(const uint16_t &address, const uint8_t &maxLength, cons
 
     if (true == isSuccess)
     {
-        if (false == EEPROM.commit())
-        {
-            isSuccess = false;
-        }
+        isSuccess = commit();
     }
 
     return isSuccess;
@@ -122,13 +156,77 @@ bool FlashMem::getUInt8(const uint16_t &address, uint8_t &value)
 
 bool FlashMem::setUInt8(const uint16_t &address, uint8_t value)
 {
-    bool isSuccess = false;
-
     EEPROM.write(address, value);
 
-    if (true == EEPROM.commit())
+    return commit();
+}
+
+void FlashMem::getBlock(const uint16_t &address, uint8_t *data, const uint16_t &size)
+{
+    uint16_t idx = 0;
+
+    for (idx = 0; idx < size; ++idx)
     {
-        isSuccess = true;
+        data[idx] = EEPROM.read(address + idx);
+    }
+}
+
+bool FlashMem::setBlock(const uint16_t &address, const uint8_t *data, const uint16_t &size)
+{
+    uint16_t idx = 0;
+
+    for (idx = 0; idx < size; ++idx)
+    {
+        EEPROM.write(address + idx, data[idx]);
+    }
+
+    return commit();
+}
+
+void FlashMem::beginTransaction()
+{
+    ++gTransactionDepth;
+}
+
+bool FlashMem::commitTransaction()
+{
+    bool isSuccess = true;
+
+    if (0U < gTransactionDepth)
+    {
+        --gTransactionDepth;
+    }
+
+    /* A nested transaction is part of the enclosing one. */
+    if ((0U == gTransactionDepth) &&
+        (false == gIsCommitDeferred))
+    {
+        isSuccess = flush();
+    }
+
+    return isSuccess;
+}
+
+void FlashMem::setDeferredCommit(bool isDeferred)
+{
+    gIsCommitDeferred = isDeferred;
+}
+
+bool FlashMem::isCommitPending()
+{
+    return gIsCommitPending;
+}
+
+bool FlashMem::flush()
+{
+    bool isSuccess = true;
+
+    if (true == gIsCommitPending)
+    {
+        TRACE_SCOPE(Trace::ID_FLASH_COMMIT);
+
+        gIsCommitPending = false;
+        isSuccess = EEPROM.commit();
     }
 
     return isSuccess;
@@ -148,4 +246,30 @@ bool FlashMem::setUInt8(const uint16_t &address, uint8_t value)
 
 /******************************************************************************
  * Local Functions
- *****************************************************************************/
\ No newline at end of file
+ *****************************************************************************/
+
+/**
+ *  Commits the EEPROM RAM mirror to flash, unless a transaction is active or
+ *  deferred commit is enabled. In the latter case the commit is deferred
+ *  until the transaction ends or until flush() is called.
+ *
+ *  @return If successful committed or deferred, returns true. Otherwise false.
+ */
+static bool commit()
+{
+    bool isSuccess = true;
+
+    if ((0U < gTransactionDepth) ||
+        (true == gIsCommitDeferred))
+    {
+        gIsCommitPending = true;
+    }
+    else
+    {
+        TRACE_SCOPE(Trace::ID_FLASH_COMMIT);
+
+        isSuccess = EEPROM.commit();
+    }
+
+    return isSuccess;
+}
\ No newline at end of file
@@ -48,6 +48,9 @@
 
 namespace FlashMem
 {
+    /** Size of the EEPROM destined to store credentials*/
+    static const uint16_t EEPROM_SIZE = 512;
+
     /**
      *  Initialization of the EEPROM module.
      * 
@@ -64,6 +67,16 @@ namespace FlashMem
      */
     void getString(const uint16_t &address, const uint8_t &maxLength, String &output);
 
+    /**
+     *  Retrieves a Null-terminated String from the EEPROM, without allocating memory.
+     *
+     *  @param[in] address Address where the String is saved.
+     *  @param[in] maxLength Maximum Length of the String.
+     *  @param[out] output Buffer to save the String to, it is always terminated.
+     *  @param[in] size Size of the buffer in byte.
+     */
+    void getString(const uint16_t &address, const uint8_t &maxLength, char *output, size_t size);
+
     /**
      *  Saves a Null-terminated String in the EEPROM.
      *
@@ -74,6 +87,16 @@ namespace FlashMem
      */
     bool setString(const uint16_t &address, const uint8_t &maxLength, const String &input);
 
+    /**
+     *  Saves a Null-terminated String in the EEPROM.
+     *
+     *  @param[in] address Address where the String will be saved.
+     *  @param[in] maxLength Maximum Length of the String.
+     *  @param[in] input Null-terminated String to save in EEPROM.
+     *  @return If string written in EEPROM, returns true. Otherwise false.
+     */
+    bool setString(const uint16_t &address, const uint8_t &maxLength, const char *input);
+
     /**
      *  Retrieves an 8-bit Unsigned Integer from the EEPROM.
      *
@@ -93,6 +116,64 @@ namespace FlashMem
      */
     bool setUInt8(const uint16_t &address, uint8_t value);
 
+    /**
+     *  Retrieves a block of raw data from the EEPROM.
+     *
+     *  @param[in] address Address where the block is saved.
+     *  @param[out] data Buffer to save the block to.
+     *  @param[in] size Size of the block in byte.
+     */
+    void getBlock(const uint16_t &address, uint8_t *data, const uint16_t &size);
+
+    /**
+     *  Saves a block of raw data in the EEPROM.
+     *
+     *  @param[in] address Address where the block will be saved.
+     *  @param[in] data Block to save in EEPROM.
+     *  @param[in] size Size of the block in byte.
+     *  @return If block written in EEPROM, returns true. Otherwise false.
+     */
+    bool setBlock(const uint16_t &address, const uint8_t *data, const uint16_t &size);
+
+    /**
+     *  Starts a transaction. All following writes are kept in the RAM mirror
+     *  of the EEPROM and committed to flash only once by commitTransaction().
+     *  Transactions can be nested, then only the outermost commits.
+     */
+    void beginTransaction();
+
+    /**
+     *  Finishes a transaction and commits all writes since beginTransaction()
+     *  with a single flash write. A nested transaction commits nothing, its
+     *  writes are committed with the outermost transaction.
+     *
+     *  @return If the changes are written to flash or nothing was changed, returns true. Otherwise false.
+     */
+    bool commitTransaction();
+
+    /**
+     *  Enables or disables the deferred commit. If enabled, writes are kept
+     *  in the RAM mirror of the EEPROM and committed to flash only by flush().
+     *  This allows to choose the moment of the time consuming flash write.
+     *
+     *  @param[in] isDeferred Enable (true) or disable (false) deferred commit.
+     */
+    void setDeferredCommit(bool isDeferred);
+
+    /**
+     *  Is a commit pending?
+     *
+     *  @return If writes are not committed to flash yet, returns true. Otherwise false.
+     */
+    bool isCommitPending();
+
+    /**
+     *  Commits all pending writes to flash. A active transaction is not considered.
+     *
+     *  @return If the changes are written to flash or nothing was pending, returns true. Otherwise false.
+     */
+    bool flush();
+
 };
 
 /******************************************************************************
@@ -51,6 +51,10 @@
  * Prototypes
  *****************************************************************************/
 
+static uint32_t readUInt32(const uint8_t* buffer);
+static void writeUInt32(uint8_t* buffer, uint32_t value);
+static uint16_t getGroupNameAddress(uint8_t idx);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -85,14 +89,62 @@ static const uint8_t NVM_GROUPS_LENGTH = 1;
 /** Address of the saved group names in EEPROM. */
 static const uint16_t NVM_GROUP_NAMES_ADDRESS = NVM_GROUPS_ADDRESS + NVM_GROUPS_LENGTH;
 
-/** Max. number of groups. */
-static const uint8_t NVM_MAX_GROUPS = 10;
+/** Number of group names in front of the other settings, like in former firmware versions. */
+static const uint8_t NVM_GROUP_NAMES_COUNT = 10;
 
 /** Max. length of group name, including string termination. */
-static const uint8_t NVM_MAX_GROUP_NAME_SIZE = 20;
+static const uint8_t NVM_MAX_GROUP_NAME_SIZE = Settings::MAX_GROUP_NAME_LENGTH + 1U;
 
 /** Length of saved group names in EEPROM. */
-static const uint8_t NVM_GROUP_NAMES_LENGTH = NVM_MAX_GROUPS * NVM_MAX_GROUP_NAME_SIZE;
+static const uint16_t NVM_GROUP_NAMES_LENGTH = NVM_GROUP_NAMES_COUNT * NVM_MAX_GROUP_NAME_SIZE;
+
+/** Address of the WiFi fast connect parameters in EEPROM. */
+static const uint16_t NVM_WIFI_FAST_CONNECT_ADDRESS = NVM_GROUP_NAMES_ADDRESS + NVM_GROUP_NAMES_LENGTH;
+
+/**
+ * Length of the WiFi fast connect parameters in EEPROM:
+ * valid marker, BSSID, channel, local IP, gateway IP, subnet mask and DNS IP.
+ */
+static const uint8_t NVM_WIFI_FAST_CONNECT_LENGTH = 1 + Settings::BSSID_LENGTH + 1 + 4 * 4;
+
+/**
+ * Marks valid WiFi fast connect parameters. The area was added later and
+ * may contain anything on devices with older settings.
+ */
+static const uint8_t NVM_WIFI_FAST_CONNECT_VALID = 0xA5;
+
+/** Address of the blind period in EEPROM. */
+static const uint16_t NVM_BLIND_PERIOD_ADDRESS = NVM_WIFI_FAST_CONNECT_ADDRESS + NVM_WIFI_FAST_CONNECT_LENGTH;
+
+/** Length of the blind period in EEPROM: valid marker, period and ratio. */
+static const uint8_t NVM_BLIND_PERIOD_LENGTH = 1 + 4 + 1;
+
+/**
+ * Marks a valid blind period. The area was added later and may contain
+ * anything on devices with older settings.
+ */
+static const uint8_t NVM_BLIND_PERIOD_VALID = 0x5A;
+
+/** Address of the further group names in EEPROM: valid marker and names. */
+static const uint16_t NVM_MORE_GROUP_NAMES_ADDRESS = NVM_BLIND_PERIOD_ADDRESS + NVM_BLIND_PERIOD_LENGTH;
+
+/** Length of the further group names in EEPROM. */
+static const uint16_t NVM_MORE_GROUP_NAMES_LENGTH = 1 + (Settings::MAX_GROUPS - NVM_GROUP_NAMES_COUNT) * NVM_MAX_GROUP_NAME_SIZE;
+
+/**
+ * Marks valid further group names. The area was added later and may contain
+ * anything on devices with older settings.
+ */
+static const uint8_t NVM_MORE_GROUP_NAMES_VALID = 0xC3;
+
+/*
+ * The layout is the same in every event configuration, therefore a device
+ * keeps its settings, if a firmware with another configuration is flashed.
+ */
+static_assert(NVM_GROUP_NAMES_COUNT <= Settings::MAX_GROUPS,
+              "The group names in front of the other settings exceed the max. number of groups.");
+static_assert((NVM_MORE_GROUP_NAMES_ADDRESS + NVM_MORE_GROUP_NAMES_LENGTH) <= FlashMem::EEPROM_SIZE,
+              "The settings don't fit into the EEPROM.");
 
 /******************************************************************************
  * Public Methods
@@ -114,15 +166,43 @@ bool Settings::begin()
             uint8_t idx = 0;
 
             /* Restore factory settings. */
+            beginTransaction();
             (void)FlashMem::setString(NVM_METADATA_ADDRESS, NVM_METADATA_MAX_LENGTH, NVM_METADATA_VALID);
             setWiFiSSID("");
             setWiFiPassphrase("");
+            clearWiFiFastConnect();
             setNumberOfGroups(3);
             
-            for(idx = 0; idx < NVM_MAX_GROUPS; ++idx)
+            (void)FlashMem::setUInt8(NVM_MORE_GROUP_NAMES_ADDRESS, NVM_MORE_GROUP_NAMES_VALID);
+
+            for(idx = 0; idx < MAX_GROUPS; ++idx)
             {
                 setGroupName(idx, "");
             }
+
+            isSuccess = commitTransaction();
+        }
+        else
+        {
+            uint8_t marker = 0;
+
+            FlashMem::getUInt8(NVM_MORE_GROUP_NAMES_ADDRESS, marker);
+
+            /* Older settings have no further group names yet. */
+            if (NVM_MORE_GROUP_NAMES_VALID != marker)
+            {
+                uint8_t idx = 0;
+
+                beginTransaction();
+                (void)FlashMem::setUInt8(NVM_MORE_GROUP_NAMES_ADDRESS, NVM_MORE_GROUP_NAMES_VALID);
+
+                for(idx = NVM_GROUP_NAMES_COUNT; idx < MAX_GROUPS; ++idx)
+                {
+                    setGroupName(idx, "");
+                }
+
+                isSuccess = commitTransaction();
+            }
         }
     }
 
@@ -136,7 +216,10 @@ void Settings::getWiFiSSD(String& ssid)
 
 void Settings::setWiFiSSID(const String& ssid)
 {
+    beginTransaction();
     (void)FlashMem::setString(NVM_SSID_ADDRESS, NVM_SSID_MAX_LENGTH, ssid);
+    clearWiFiFastConnect();
+    (void)commitTransaction();
 }
 
 void Settings::getWiFiPassphrase(String& passphrase)
@@ -146,7 +229,99 @@ void Settings::getWiFiPassphrase(String& passphrase)
 
 void Settings::setWiFiPassphrase(const String& passphrase)
 {
+    beginTransaction();
     (void)FlashMem::setString(NVM_PASSWORD_ADDRESS, NVM_PASSWORD_MAX_LENGTH, passphrase);
+    clearWiFiFastConnect();
+    (void)commitTransaction();
+}
+
+bool Settings::getWiFiFastConnect(WiFiFastConnect& fastConnect)
+{
+    bool    isValid = false;
+    uint8_t data[NVM_WIFI_FAST_CONNECT_LENGTH];
+
+    FlashMem::getBlock(NVM_WIFI_FAST_CONNECT_ADDRESS, data, NVM_WIFI_FAST_CONNECT_LENGTH);
+
+    if (NVM_WIFI_FAST_CONNECT_VALID == data[0])
+    {
+        uint8_t idx = 1;
+
+        memcpy(fastConnect.bssid, &data[idx], BSSID_LENGTH);
+        idx += BSSID_LENGTH;
+        fastConnect.channel = data[idx];
+        ++idx;
+        fastConnect.localIP = readUInt32(&data[idx]);
+        idx += 4;
+        fastConnect.gatewayIP = readUInt32(&data[idx]);
+        idx += 4;
+        fastConnect.subnetMask = readUInt32(&data[idx]);
+        idx += 4;
+        fastConnect.dnsIP = readUInt32(&data[idx]);
+
+        /* Valid channels are 1 - 14. */
+        if ((0 < fastConnect.channel) &&
+            (14 >= fastConnect.channel))
+        {
+            isValid = true;
+        }
+    }
+
+    return isValid;
+}
+
+void Settings::setWiFiFastConnect(const WiFiFastConnect& fastConnect)
+{
+    uint8_t data[NVM_WIFI_FAST_CONNECT_LENGTH];
+    uint8_t idx = 0;
+
+    data[idx] = NVM_WIFI_FAST_CONNECT_VALID;
+    ++idx;
+    memcpy(&data[idx], fastConnect.bssid, BSSID_LENGTH);
+    idx += BSSID_LENGTH;
+    data[idx] = fastConnect.channel;
+    ++idx;
+    writeUInt32(&data[idx], fastConnect.localIP);
+    idx += 4;
+    writeUInt32(&data[idx], fastConnect.gatewayIP);
+    idx += 4;
+    writeUInt32(&data[idx], fastConnect.subnetMask);
+    idx += 4;
+    writeUInt32(&data[idx], fastConnect.dnsIP);
+
+    (void)FlashMem::setBlock(NVM_WIFI_FAST_CONNECT_ADDRESS, data, NVM_WIFI_FAST_CONNECT_LENGTH);
+}
+
+void Settings::clearWiFiFastConnect()
+{
+    (void)FlashMem::setUInt8(NVM_WIFI_FAST_CONNECT_ADDRESS, 0);
+}
+
+bool Settings::getBlindPeriod(BlindPeriod& blindPeriod)
+{
+    bool    isValid = false;
+    uint8_t data[NVM_BLIND_PERIOD_LENGTH];
+
+    FlashMem::getBlock(NVM_BLIND_PERIOD_ADDRESS, data, NVM_BLIND_PERIOD_LENGTH);
+
+    if (NVM_BLIND_PERIOD_VALID == data[0])
+    {
+        blindPeriod.period  = readUInt32(&data[1]);
+        blindPeriod.ratio   = data[5];
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+void Settings::setBlindPeriod(const BlindPeriod& blindPeriod)
+{
+    uint8_t data[NVM_BLIND_PERIOD_LENGTH];
+
+    data[0] = NVM_BLIND_PERIOD_VALID;
+    writeUInt32(&data[1], blindPeriod.period);
+    data[5] = blindPeriod.ratio;
+
+    (void)FlashMem::setBlock(NVM_BLIND_PERIOD_ADDRESS, data, NVM_BLIND_PERIOD_LENGTH);
 }
 
 void Settings::getNumberOfGroups(uint8_t& numberOfGroups)
@@ -159,14 +334,53 @@ void Settings::setNumberOfGroups(uint8_t numberOfGroups)
     (void)FlashMem::setUInt8(NVM_GROUPS_ADDRESS, numberOfGroups);
 }
 
-void Settings::getGroupName(uint8_t idx, String& name)
+void Settings::getGroupName(uint8_t idx, GroupName& name)
+{
+    char buffer[NVM_MAX_GROUP_NAME_SIZE];
+
+    /* A group out of the layout has no name, instead of the one of the next setting. */
+    buffer[0] = '\0';
+
+    if (MAX_GROUPS > idx)
+    {
+        FlashMem::getString(getGroupNameAddress(idx), NVM_MAX_GROUP_NAME_SIZE, buffer, sizeof(buffer));
+    }
+
+    name = buffer;
+}
+
+void Settings::setGroupName(uint8_t idx, const char* name)
+{
+    /* Never overwrite the settings behind the group names. */
+    if (MAX_GROUPS > idx)
+    {
+        (void)FlashMem::setString(getGroupNameAddress(idx), NVM_MAX_GROUP_NAME_SIZE, name);
+    }
+}
+
+void Settings::beginTransaction()
+{
+    FlashMem::beginTransaction();
+}
+
+bool Settings::commitTransaction()
+{
+    return FlashMem::commitTransaction();
+}
+
+void Settings::setDeferredWrite(bool isDeferred)
+{
+    FlashMem::setDeferredCommit(isDeferred);
+}
+
+bool Settings::isWritePending()
 {
-    FlashMem::getString(NVM_GROUP_NAMES_ADDRESS + idx * NVM_MAX_GROUP_NAME_SIZE, NVM_MAX_GROUP_NAME_SIZE, name);
+    return FlashMem::isCommitPending();
 }
 
-void Settings::setGroupName(uint8_t idx, const String& name)
+bool Settings::flush()
 {
-    (void)FlashMem::setString(NVM_GROUP_NAMES_ADDRESS + idx * NVM_MAX_GROUP_NAME_SIZE, NVM_MAX_GROUP_NAME_SIZE, name);
+    return FlashMem::flush();
 }
 
 /******************************************************************************
@@ -183,4 +397,57 @@ void Settings::setGroupName(uint8_t idx, const String& name)
 
 /******************************************************************************
  * Local Functions
- *****************************************************************************/
\ No newline at end of file
+ *****************************************************************************/
+
+/**
+ * Read a 32-bit unsigned integer in little endian byte order.
+ * 
+ * @param[in] buffer    Source with at least 4 bytes.
+ * 
+ * @return Value
+ */
+static uint32_t readUInt32(const uint8_t* buffer)
+{
+    return  (static_cast<uint32_t>(buffer[0]) <<  0U) |
+            (static_cast<uint32_t>(buffer[1]) <<  8U) |
+            (static_cast<uint32_t>(buffer[2]) << 16U) |
+            (static_cast<uint32_t>(buffer[3]) << 24U);
+}
+
+/**
+ * Write a 32-bit unsigned integer in little endian byte order.
+ * 
+ * @param[out] buffer   Destination with at least 4 bytes.
+ * @param[in] value     Value
+ */
+static void writeUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >>  0U);
+    buffer[1] = static_cast<uint8_t>(value >>  8U);
+    buffer[2] = static_cast<uint8_t>(value >> 16U);
+    buffer[3] = static_cast<uint8_t>(value >> 24U);
+}
+
+/**
+ * Get the address of a group name in EEPROM. The first names are in front of
+ * the other settings, the further ones behind them.
+ * 
+ * @param[in] idx   Group index, less than Settings::MAX_GROUPS.
+ * 
+ * @return Address
+ */
+static uint16_t getGroupNameAddress(uint8_t idx)
+{
+    uint16_t address = 0;
+
+    if (NVM_GROUP_NAMES_COUNT > idx)
+    {
+        address = NVM_GROUP_NAMES_ADDRESS + idx * NVM_MAX_GROUP_NAME_SIZE;
+    }
+    else
+    {
+        address = NVM_MORE_GROUP_NAMES_ADDRESS + 1 + (idx - NVM_GROUP_NAMES_COUNT) * NVM_MAX_GROUP_NAME_SIZE;
+    }
+
+    return address;
+}
@@ -36,6 +36,8 @@
  * Includes
  *****************************************************************************/
 #include "FlashMem.h"
+#include <CompetitionConfig.h>
+#include <FixedString.h>
 
 /******************************************************************************
  * Macros
@@ -50,6 +52,47 @@ class Settings
 {
 public:
 
+    /**
+     * Max. number of groups, whose names are stored. The layout is the one
+     * of the largest event configuration, independent of the build.
+     */
+    static const uint8_t MAX_GROUPS = LargeEventConfig::MAX_GROUPS;
+
+    /** Max. length of a group name, without string termination. */
+    static const uint8_t MAX_GROUP_NAME_LENGTH = LargeEventConfig::MAX_GROUP_NAME_LENGTH;
+
+    /** Group name, which is read without allocating memory. */
+    typedef FixedString<MAX_GROUP_NAME_LENGTH> GroupName;
+
+    /** BSSID length in byte. */
+    static const uint8_t BSSID_LENGTH = 6;
+
+    /**
+     * Parameters of the last successful station connection. They allow a
+     * directed connect without scanning and without waiting for DHCP.
+     */
+    typedef struct
+    {
+        uint8_t     bssid[BSSID_LENGTH];    /**< BSSID of the access point. */
+        uint8_t     channel;                /**< WiFi channel. */
+        uint32_t    localIP;                /**< Local IP address. */
+        uint32_t    gatewayIP;              /**< Gateway IP address. */
+        uint32_t    subnetMask;             /**< Subnet mask. */
+        uint32_t    dnsIP;                  /**< DNS server IP address. */
+
+    } WiFiFastConnect;
+
+    /**
+     * Blind period of the sensor after the start. It is either fixed or
+     * derived from the track record, which suits short and long tracks.
+     */
+    typedef struct
+    {
+        uint32_t    period;                 /**< Blind period in ms. In adaptive mode it is the min. blind period. */
+        uint8_t     ratio;                  /**< Blind period in % of the track record, 0 for a fixed blind period. */
+
+    } BlindPeriod;
+
     /**
      * Get the settings instance.
      * 
@@ -97,6 +140,44 @@ public:
      */
     void setWiFiPassphrase(const String& passphrase);
 
+    /**
+     * Get the parameters of the last successful station connection.
+     * 
+     * @param[out] fastConnect  Connection parameters
+     * 
+     * @return If valid parameters are available, it will return true otherwise false.
+     */
+    bool getWiFiFastConnect(WiFiFastConnect& fastConnect);
+
+    /**
+     * Set the parameters of the last successful station connection.
+     * 
+     * @param[in] fastConnect   Connection parameters
+     */
+    void setWiFiFastConnect(const WiFiFastConnect& fastConnect);
+
+    /**
+     * Invalidate the parameters of the last successful station connection.
+     * This is necessary whenever the credentials change.
+     */
+    void clearWiFiFastConnect();
+
+    /**
+     * Get the blind period of the sensor after the start.
+     * 
+     * @param[out] blindPeriod  Blind period
+     * 
+     * @return If a blind period is stored, it will return true otherwise false.
+     */
+    bool getBlindPeriod(BlindPeriod& blindPeriod);
+
+    /**
+     * Set the blind period of the sensor after the start.
+     * 
+     * @param[in] blindPeriod   Blind period
+     */
+    void setBlindPeriod(const BlindPeriod& blindPeriod);
+
     /**
      * Get number of groups.
      * 
@@ -113,19 +194,57 @@ public:
 
     /**
      * Get name of specific group.
+     * A group index of MAX_GROUPS or above results in an empty name.
      * 
      * @param[in] idx   Group index
      * @param[out] name Group name
      */
-    void getGroupName(uint8_t idx, String& name);
+    void getGroupName(uint8_t idx, GroupName& name);
 
     /**
      * Set name of specific group.
+     * A group index of MAX_GROUPS or above is ignored.
      * 
      * @param[in] idx   Group index
-     * @param[in] name Group name
+     * @param[in] name Group name, with max. MAX_GROUP_NAME_LENGTH characters.
+     */
+    void setGroupName(uint8_t idx, const char* name);
+
+    /**
+     * Start a transaction. All following changes are written to persistent
+     * memory at once, when the transaction is committed. Transactions can be
+     * nested, then the outermost one writes them.
+     */
+    void beginTransaction();
+
+    /**
+     * Commit all changes since beginTransaction() to persistent memory.
+     * 
+     * @return If successful, it will return true otherwise false.
+     */
+    bool commitTransaction();
+
+    /**
+     * Enable or disable the deferred write of changes to persistent memory.
+     * If enabled, changes are only written by flush().
+     * 
+     * @param[in] isDeferred    Enable (true) or disable (false)
+     */
+    void setDeferredWrite(bool isDeferred);
+
+    /**
+     * Are changes pending, which are not written to persistent memory yet?
+     * 
+     * @return If changes are pending, it will return true otherwise false.
+     */
+    bool isWritePending();
+
+    /**
+     * Write all pending changes to persistent memory.
+     * 
+     * @return If successful, it will return true otherwise false.
      */
-    void setGroupName(uint8_t idx, const String& name);
+    bool flush();
 
 private:
 
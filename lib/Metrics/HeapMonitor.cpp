@@ -0,0 +1,235 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap and fragmentation monitor with high-water marks
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HeapMonitor.h"
+
+#include <Log.h>
+
+#if defined(NATIVE)
+#include <NativeHAL.h>
+#endif  /* defined(NATIVE) */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Names of the subsystems, in the order of HeapMonitor::Tag. */
+static const char*  gTagNames[HeapMonitor::TAG_MAX] =
+{
+    "webServer",
+    "webSocket",
+    "string"
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void HeapMonitor::sample()
+{
+    uint32_t    freeHeap        = 0U;
+    uint32_t    maxFreeBlock    = 0U;
+    uint8_t     fragmentation   = 0U;
+
+    /* All at once, which walks the heap only one time. */
+    ESP.getHeapStats(&freeHeap, &maxFreeBlock, &fragmentation);
+
+    m_freeHeap      = freeHeap;
+    m_maxFreeBlock  = maxFreeBlock;
+    m_fragmentation = fragmentation;
+
+    if ((0U == m_minFreeHeap) || (m_minFreeHeap > freeHeap))
+    {
+        m_minFreeHeap = freeHeap;
+    }
+
+    if ((0U == m_minMaxFreeBlock) || (m_minMaxFreeBlock > maxFreeBlock))
+    {
+        m_minMaxFreeBlock = maxFreeBlock;
+    }
+
+    if (m_maxFragmentation < fragmentation)
+    {
+        m_maxFragmentation = fragmentation;
+    }
+
+    if (true == checkThreshold(m_minFreeThreshold > freeHeap, m_isFreeHeapLow))
+    {
+        LOG_WARNING("Free heap %u byte is below %u byte.", freeHeap, m_minFreeThreshold);
+    }
+
+    if (true == checkThreshold(m_minBlockThreshold > maxFreeBlock, m_isMaxFreeBlockLow))
+    {
+        LOG_WARNING("Largest free heap block %u byte is below %u byte.", maxFreeBlock, m_minBlockThreshold);
+    }
+
+    if (true == checkThreshold(m_maxFragmentationThreshold < fragmentation, m_isFragmented))
+    {
+        LOG_WARNING("Heap fragmentation %u %% is above %u %%.", fragmentation, m_maxFragmentationThreshold);
+    }
+}
+
+const char* HeapMonitor::getTagName(Tag tag)
+{
+    const char* name = "unknown";
+
+    if (TAG_MAX > tag)
+    {
+        name = gTagNames[tag];
+    }
+
+    return name;
+}
+
+void HeapMonitor::enter(ScopeState& state)
+{
+    state.freeHeap = ESP.getFreeHeap();
+
+#if defined(NATIVE)
+    {
+        NativeHAL::HeapUsage usage;
+
+        NativeHAL::getHeapUsage(usage);
+
+        state.allocations       = usage.allocations;
+        state.liveBytes         = usage.liveBytes;
+        state.outerPeakBytes    = usage.peakBytes;
+
+        /* Measure the peak of this scope from now on. */
+        NativeHAL::setHeapPeak(0U);
+    }
+#else
+    state.allocations       = 0U;
+    state.liveBytes         = 0U;
+    state.outerPeakBytes    = 0U;
+#endif  /* defined(NATIVE) */
+}
+
+void HeapMonitor::leave(Tag tag, const ScopeState& state)
+{
+    TagUsage&   tagUsage    = m_tagUsages[tag];
+    int32_t     keptBytes   = static_cast<int32_t>(state.freeHeap - ESP.getFreeHeap());
+    uint32_t    peakBytes   = (0 < keptBytes) ? static_cast<uint32_t>(keptBytes) : 0U;
+
+#if defined(NATIVE)
+    {
+        NativeHAL::HeapUsage usage;
+
+        NativeHAL::getHeapUsage(usage);
+
+        tagUsage.allocations += static_cast<uint32_t>(usage.allocations - state.allocations);
+
+        if (usage.peakBytes > state.liveBytes)
+        {
+            peakBytes = static_cast<uint32_t>(usage.peakBytes - state.liveBytes);
+        }
+
+        /* The enclosing scope sees the peak of this one too. */
+        NativeHAL::setHeapPeak((state.outerPeakBytes > usage.peakBytes) ? state.outerPeakBytes : usage.peakBytes);
+    }
+#endif  /* defined(NATIVE) */
+
+    ++tagUsage.scopes;
+    tagUsage.keptBytes += keptBytes;
+
+    if (tagUsage.peakBytes < peakBytes)
+    {
+        tagUsage.peakBytes = peakBytes;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+HeapMonitor::HeapMonitor() :
+    m_freeHeap(0U),
+    m_maxFreeBlock(0U),
+    m_fragmentation(0U),
+    m_minFreeHeap(0U),
+    m_minMaxFreeBlock(0U),
+    m_maxFragmentation(0U),
+    m_minFreeThreshold(HEAP_MONITOR_MIN_FREE),
+    m_minBlockThreshold(HEAP_MONITOR_MIN_BLOCK),
+    m_maxFragmentationThreshold(HEAP_MONITOR_MAX_FRAGMENTATION),
+    m_isFreeHeapLow(false),
+    m_isMaxFreeBlockLow(false),
+    m_isFragmented(false),
+    m_warningCount(0U),
+    m_tagUsages()
+{
+}
+
+bool HeapMonitor::checkThreshold(bool isCrossed, bool& wasCrossed)
+{
+    bool isWarning = false;
+
+    if ((true == isCrossed) && (false == wasCrossed))
+    {
+        ++m_warningCount;
+        isWarning = true;
+    }
+
+    wasCrossed = isCrossed;
+
+    return isWarning;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,395 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap and fragmentation monitor with high-water marks
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef HEAP_MONITOR_H_
+#define HEAP_MONITOR_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Warning threshold: min. free heap in byte. */
+#ifndef HEAP_MONITOR_MIN_FREE
+#define HEAP_MONITOR_MIN_FREE           8192U
+#endif
+
+/** Warning threshold: min. largest free heap block in byte. */
+#ifndef HEAP_MONITOR_MIN_BLOCK
+#define HEAP_MONITOR_MIN_BLOCK          4096U
+#endif
+
+/** Warning threshold: max. heap fragmentation in percent. */
+#ifndef HEAP_MONITOR_MAX_FRAGMENTATION
+#define HEAP_MONITOR_MAX_FRAGMENTATION  50U
+#endif
+
+/** Concatenate two tokens, after their expansion. */
+#define HEAP_MONITOR_CONCAT_(a, b)      a##b
+
+/** Concatenate two tokens. */
+#define HEAP_MONITOR_CONCAT(a, b)       HEAP_MONITOR_CONCAT_(a, b)
+
+/** Account the heap usage of the current scope to a subsystem. */
+#define HEAP_SCOPE(tag)                 HeapMonitor::Scope HEAP_MONITOR_CONCAT(heapScope, __LINE__)(tag)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Heap and fragmentation monitor.
+ *
+ *  The free heap, the largest free block and the fragmentation are sampled
+ *  every cycle and their worst values since boot are kept. If a value
+ *  crosses its threshold, a warning is logged once, until it recovers.
+ *
+ *  The heap usage of the subsystems is measured by tagged scopes, see
+ *  HEAP_SCOPE(). Every subsystem keeps the high-water mark of the heap a
+ *  single scope took and the heap all its scopes kept. On the device the
+ *  heap is only read at the begin and the end of a scope, therefore the
+ *  high-water mark is what the scope kept. The native build counts every
+ *  allocation, which provides the real peak and the number of allocations.
+ *  Nested scopes are accounted to all of them.
+ */
+class HeapMonitor
+{
+public:
+
+    /** Subsystems, which are monitored. */
+    typedef enum
+    {
+        TAG_WEB_SERVER = 0, /**< HTTP client handling, including the server-sent events. */
+        TAG_WEB_SOCKET,     /**< Websocket client handling and command dispatch. */
+        TAG_STRING,         /**< String based text: metrics, trace and credentials. */
+        TAG_MAX             /**< Number of subsystems. */
+
+    } Tag;
+
+    /** Heap usage of a subsystem. */
+    typedef struct
+    {
+        uint32_t    scopes;         /**< Number of scopes. */
+        uint32_t    allocations;    /**< Number of allocations. Only counted by the native build. */
+        uint32_t    peakBytes;      /**< High-water mark of the heap a single scope took in byte. */
+        int32_t     keptBytes;      /**< Heap all scopes kept in byte, negative if they released more. */
+
+    } TagUsage;
+
+    /** State of a scope at its begin. */
+    typedef struct
+    {
+        uint32_t    freeHeap;       /**< Free heap in byte. */
+        uint64_t    allocations;    /**< Number of allocations, only native. */
+        size_t      liveBytes;      /**< Allocated bytes, only native. */
+        size_t      outerPeakBytes; /**< Peak of the enclosing measurement, only native. */
+
+    } ScopeState;
+
+    /**
+     *  Get the heap monitor instance.
+     *
+     *  @return Heap monitor instance
+     */
+    static HeapMonitor& getInstance()
+    {
+        static HeapMonitor instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     *  Sample the heap and check the thresholds. Call it every cycle.
+     */
+    void sample();
+
+    /**
+     *  Set the warning thresholds.
+     *
+     *  @param[in] minFree          Min. free heap in byte.
+     *  @param[in] minBlock         Min. largest free heap block in byte.
+     *  @param[in] maxFragmentation Max. heap fragmentation in percent.
+     */
+    void setThresholds(uint32_t minFree, uint32_t minBlock, uint8_t maxFragmentation)
+    {
+        m_minFreeThreshold          = minFree;
+        m_minBlockThreshold         = minBlock;
+        m_maxFragmentationThreshold = maxFragmentation;
+    }
+
+    /**
+     *  Get the free heap of the last sample.
+     *
+     *  @return Free heap in byte.
+     */
+    uint32_t getFreeHeap() const
+    {
+        return m_freeHeap;
+    }
+
+    /**
+     *  Get the largest free heap block of the last sample.
+     *
+     *  @return Block size in byte.
+     */
+    uint32_t getMaxFreeBlock() const
+    {
+        return m_maxFreeBlock;
+    }
+
+    /**
+     *  Get the heap fragmentation of the last sample.
+     *
+     *  @return Fragmentation in percent.
+     */
+    uint8_t getFragmentation() const
+    {
+        return m_fragmentation;
+    }
+
+    /**
+     *  Get the min. free heap since boot.
+     *
+     *  @return Free heap in byte. 0 if not sampled yet.
+     */
+    uint32_t getMinFreeHeap() const
+    {
+        return m_minFreeHeap;
+    }
+
+    /**
+     *  Get the min. largest free heap block since boot.
+     *
+     *  @return Block size in byte. 0 if not sampled yet.
+     */
+    uint32_t getMinMaxFreeBlock() const
+    {
+        return m_minMaxFreeBlock;
+    }
+
+    /**
+     *  Get the max. heap fragmentation since boot.
+     *
+     *  @return Fragmentation in percent.
+     */
+    uint8_t getMaxFragmentation() const
+    {
+        return m_maxFragmentation;
+    }
+
+    /**
+     *  Get the number of threshold crossings since boot.
+     *
+     *  @return Number of warnings
+     */
+    uint32_t getWarningCount() const
+    {
+        return m_warningCount;
+    }
+
+    /**
+     *  Get the heap usage of a subsystem.
+     *
+     *  @param[in] tag  Subsystem
+     *
+     *  @return Heap usage
+     */
+    const TagUsage& getTagUsage(Tag tag) const
+    {
+        return m_tagUsages[tag];
+    }
+
+    /**
+     *  Get the name of a subsystem.
+     *
+     *  @param[in] tag  Subsystem
+     *
+     *  @return Name
+     */
+    static const char* getTagName(Tag tag);
+
+    /**
+     *  Begin the measurement of a scope.
+     *
+     *  @param[out] state   State at the begin.
+     */
+    void enter(ScopeState& state);
+
+    /**
+     *  End the measurement of a scope and account it to its subsystem.
+     *
+     *  @param[in] tag      Subsystem
+     *  @param[in] state    State at the begin.
+     */
+    void leave(Tag tag, const ScopeState& state);
+
+    /**
+     * Accounts the heap usage of its lifetime to a subsystem.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Begins the measurement.
+         *
+         * @param[in] tag   Subsystem
+         */
+        explicit Scope(Tag tag) :
+            m_tag(tag),
+            m_state()
+        {
+            HeapMonitor::getInstance().enter(m_state);
+        }
+
+        /**
+         * Ends the measurement.
+         */
+        ~Scope()
+        {
+            HeapMonitor::getInstance().leave(m_tag, m_state);
+        }
+
+    private:
+
+        Tag         m_tag;      /**< Subsystem */
+        ScopeState  m_state;    /**< State at the begin. */
+
+        /* Default constructor not allowed. */
+        Scope();
+
+        /**
+         *  An instance shall not be copied.
+         *
+         *  @param[in] scope Scope instance to copy.
+         */
+        Scope(const Scope& scope);
+
+        /**
+         *  An instance shall not assigned.
+         *
+         *  @param[in] scope Scope instance to assign.
+         *  @return Reference to this instance.
+         */
+        Scope& operator=(const Scope& scope);
+    };
+
+private:
+
+    /** Free heap of the last sample in byte. */
+    uint32_t    m_freeHeap;
+
+    /** Largest free heap block of the last sample in byte. */
+    uint32_t    m_maxFreeBlock;
+
+    /** Heap fragmentation of the last sample in percent. */
+    uint8_t     m_fragmentation;
+
+    /** Min. free heap since boot in byte. */
+    uint32_t    m_minFreeHeap;
+
+    /** Min. largest free heap block since boot in byte. */
+    uint32_t    m_minMaxFreeBlock;
+
+    /** Max. heap fragmentation since boot in percent. */
+    uint8_t     m_maxFragmentation;
+
+    /** Threshold of the free heap in byte. */
+    uint32_t    m_minFreeThreshold;
+
+    /** Threshold of the largest free heap block in byte. */
+    uint32_t    m_minBlockThreshold;
+
+    /** Threshold of the heap fragmentation in percent. */
+    uint8_t     m_maxFragmentationThreshold;
+
+    /** Is the free heap below its threshold? */
+    bool        m_isFreeHeapLow;
+
+    /** Is the largest free heap block below its threshold? */
+    bool        m_isMaxFreeBlockLow;
+
+    /** Is the heap fragmentation above its threshold? */
+    bool        m_isFragmented;
+
+    /** Number of threshold crossings since boot. */
+    uint32_t    m_warningCount;
+
+    /** Heap usage of the subsystems. */
+    TagUsage    m_tagUsages[TAG_MAX];
+
+    /**
+     * Constructs the heap monitor.
+     */
+    HeapMonitor();
+
+    /**
+     * Destroys the heap monitor.
+     */
+    ~HeapMonitor()
+    {
+    }
+
+    /**
+     *  Log a warning, when a value crosses its threshold.
+     *
+     *  @param[in]      isCrossed   Is the threshold crossed now?
+     *  @param[in,out]  wasCrossed  Was it crossed at the last sample?
+     *
+     *  @return If a warning shall be logged, it will return true otherwise false.
+     */
+    bool checkThreshold(bool isCrossed, bool& wasCrossed);
+
+    /**
+     *  An instance shall not be copied.
+     *
+     *  @param[in] monitor Heap monitor instance to copy.
+     */
+    HeapMonitor(const HeapMonitor& monitor);
+
+    /**
+     *  An instance shall not assigned.
+     *
+     *  @param[in] monitor Heap monitor instance to assign.
+     *  @return Reference to this instance.
+     */
+    HeapMonitor& operator=(const HeapMonitor& monitor);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* HEAP_MONITOR_H_ */
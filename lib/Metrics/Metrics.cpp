@@ -0,0 +1,517 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Runtime metrics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Metrics.h"
+#include "HeapMonitor.h"
+
+#include <Log.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+/** Sections of the Prometheus text, after the loop period and the task runtimes. */
+typedef enum
+{
+    SECTION_OVERRUNS = 0,   /**< Task budget overruns. */
+    SECTION_LATENCY,        /**< Event latency. */
+    SECTION_HEAP_FREE,      /**< Free heap. */
+    SECTION_HEAP_MAX_BLOCK, /**< Largest free heap block. */
+    SECTION_HEAP_MONITOR,   /**< Worst heap values and heap usage of the subsystems. */
+    SECTION_WS_CLIENTS,     /**< Websocket clients. */
+    SECTION_BOOT            /**< Boot phases. */
+
+} Section;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+const uint32_t Metrics::HEAP_BOUNDS[] =
+{
+    2048U, 4096U, 8192U, 12288U, 16384U, 20480U, 24576U, 32768U, 40960U, 49152U
+};
+
+const uint32_t Metrics::CLIENT_BOUNDS[] =
+{
+    0U, 1U, 2U, 3U, 4U, 5U, 6U, 8U
+};
+
+const char* Metrics::PREFIX = "laptimer_";
+
+void Metrics::sample(uint8_t wsClients)
+{
+    m_heapFree.record(ESP.getFreeHeap());
+    m_heapMaxBlock.record(ESP.getMaxFreeBlockSize());
+    m_wsClients.record(wsClients);
+}
+
+void Metrics::recordBootPhase(const char* name)
+{
+    uint32_t timestamp = micros();
+
+    if (MAX_BOOT_PHASES > m_bootPhaseCount)
+    {
+        m_bootPhases[m_bootPhaseCount].name         = name;
+        m_bootPhases[m_bootPhaseCount].timestamp    = timestamp;
+        ++m_bootPhaseCount;
+    }
+
+    LOG_INFO("Boot phase %s done after %u us.", name, timestamp);
+}
+
+bool Metrics::getPrometheusSection(uint8_t idx, String& text) const
+{
+    bool    isAvailable = true;
+    uint8_t taskCount   = getTaskCount();
+
+    if (0U == idx)
+    {
+        if (nullptr != m_scheduler)
+        {
+            appendHeader(text, "loop_period_microseconds", "Time between two scheduler cycles.", "histogram");
+            appendHistogram(text, "loop_period_microseconds", nullptr, m_scheduler->getLoopPeriods());
+        }
+    }
+    else if (taskCount >= idx)
+    {
+        const Scheduler::Task* task = getTask(idx - 1U);
+
+        /* All tasks belong to the same metric, therefore the header is only once required. */
+        if (1U == idx)
+        {
+            appendHeader(text, "task_runtime_microseconds", "Runtime of a single task run.", "histogram");
+        }
+
+        if (nullptr != task)
+        {
+            appendHistogram(text, "task_runtime_microseconds", task->name, task->runtimes);
+        }
+    }
+    else
+    {
+        switch (idx - taskCount - 1U)
+        {
+        case SECTION_OVERRUNS:
+            if (0U < taskCount)
+            {
+                uint8_t taskIdx = 0U;
+
+                appendHeader(text, "task_overruns_total", "Task runs, which exceeded the time budget.", "counter");
+
+                for (taskIdx = 0U; taskIdx < taskCount; ++taskIdx)
+                {
+                    const Scheduler::Task* task = getTask(taskIdx);
+
+                    text += PREFIX;
+                    text += "task_overruns_total{task=\"";
+                    text += task->name;
+                    text += "\"} ";
+                    text += task->overrunCount;
+                    text += '\n';
+                }
+            }
+            break;
+
+        case SECTION_LATENCY:
+            appendHeader(text, "event_latency_microseconds", "Time between sensor event and its broadcast.", "histogram");
+            appendHistogram(text, "event_latency_microseconds", nullptr, m_eventLatencies);
+            break;
+
+        case SECTION_HEAP_FREE:
+            appendHeader(text, "heap_free_bytes", "Free heap.", "histogram");
+            appendHistogram(text, "heap_free_bytes", nullptr, m_heapFree);
+            break;
+
+        case SECTION_HEAP_MAX_BLOCK:
+            appendHeader(text, "heap_max_block_bytes", "Largest free heap block.", "histogram");
+            appendHistogram(text, "heap_max_block_bytes", nullptr, m_heapMaxBlock);
+            break;
+
+        case SECTION_HEAP_MONITOR:
+            appendHeapMonitor(text);
+            break;
+
+        case SECTION_WS_CLIENTS:
+            appendHeader(text, "websocket_clients", "Connected websocket clients.", "histogram");
+            appendHistogram(text, "websocket_clients", nullptr, m_wsClients);
+            break;
+
+        case SECTION_BOOT:
+            {
+                uint8_t phaseIdx = 0U;
+
+                appendHeader(text, "boot_phase_end_microseconds", "Time since boot, when a boot phase ended.", "gauge");
+
+                for (phaseIdx = 0U; phaseIdx < m_bootPhaseCount; ++phaseIdx)
+                {
+                    text += PREFIX;
+                    text += "boot_phase_end_microseconds{phase=\"";
+                    text += m_bootPhases[phaseIdx].name;
+                    text += "\"} ";
+                    text += m_bootPhases[phaseIdx].timestamp;
+                    text += '\n';
+                }
+
+                appendHeader(text, "boot_to_armed_microseconds", "Time since boot, until the sensor timing was armed.", "gauge");
+                text += PREFIX;
+                text += "boot_to_armed_microseconds ";
+                text += m_bootToArmed;
+                text += '\n';
+
+                appendHeader(text, "boot_to_ready_microseconds", "Time since boot, until all services were started.", "gauge");
+                text += PREFIX;
+                text += "boot_to_ready_microseconds ";
+                text += m_bootToReady;
+                text += '\n';
+            }
+            break;
+
+        default:
+            isAvailable = false;
+            break;
+        }
+    }
+
+    return isAvailable;
+}
+
+void Metrics::getSummary(String& text) const
+{
+    uint8_t taskCount   = getTaskCount();
+    uint8_t idx         = 0U;
+
+    if (nullptr != m_scheduler)
+    {
+        appendSummary(text, "loop", m_scheduler->getLoopPeriods());
+    }
+
+    for (idx = 0U; idx < taskCount; ++idx)
+    {
+        const Scheduler::Task* task = getTask(idx);
+
+        appendSummary(text, task->name, task->runtimes);
+    }
+
+    appendSummary(text, "latency", m_eventLatencies);
+    appendSummary(text, "heap", m_heapFree);
+    appendSummary(text, "heap_block", m_heapMaxBlock);
+    appendSummary(text, "ws_clients", m_wsClients);
+    appendHeapSummary(text);
+    appendSummary(text, "boot_armed", m_bootToArmed);
+    appendSummary(text, "boot_ready", m_bootToReady);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+Metrics::Metrics() :
+    m_scheduler(nullptr),
+    m_eventLatencies(),
+    m_heapFree(HEAP_BOUNDS, sizeof(HEAP_BOUNDS) / sizeof(HEAP_BOUNDS[0])),
+    m_heapMaxBlock(HEAP_BOUNDS, sizeof(HEAP_BOUNDS) / sizeof(HEAP_BOUNDS[0])),
+    m_wsClients(CLIENT_BOUNDS, sizeof(CLIENT_BOUNDS) / sizeof(CLIENT_BOUNDS[0])),
+    m_bootPhases(),
+    m_bootPhaseCount(0U),
+    m_bootToArmed(0U),
+    m_bootToReady(0U)
+{
+}
+
+uint8_t Metrics::getTaskCount() const
+{
+    uint8_t count = 0U;
+
+    if (nullptr != m_scheduler)
+    {
+        count = m_scheduler->getTaskCount() + 1U;
+    }
+
+    return count;
+}
+
+const Scheduler::Task* Metrics::getTask(uint8_t idx) const
+{
+    const Scheduler::Task* task = nullptr;
+
+    if (nullptr != m_scheduler)
+    {
+        if (0U == idx)
+        {
+            task = &m_scheduler->getSensorTask();
+        }
+        else
+        {
+            task = m_scheduler->getTask(idx - 1U);
+        }
+    }
+
+    return task;
+}
+
+void Metrics::appendHeader(String& text, const char* name, const char* help, const char* type)
+{
+    text += "# HELP ";
+    text += PREFIX;
+    text += name;
+    text += ' ';
+    text += help;
+    text += "\n# TYPE ";
+    text += PREFIX;
+    text += name;
+    text += ' ';
+    text += type;
+    text += '\n';
+}
+
+void Metrics::appendHistogram(String& text, const char* name, const char* task, const Histogram& histogram)
+{
+    uint8_t     idx         = 0U;
+    uint32_t    cumulated   = 0U;
+    String      labels;
+    String      sumLabels;
+
+    if (nullptr != task)
+    {
+        labels      = "task=\"";
+        labels     += task;
+        labels     += "\"";
+        sumLabels   = "{" + labels + "}";
+        labels     += ',';
+    }
+
+    for (idx = 0U; idx < histogram.getBucketCount(); ++idx)
+    {
+        cumulated += histogram.getBucketCounter(idx);
+
+        text += PREFIX;
+        text += name;
+        text += "_bucket{";
+        text += labels;
+        text += "le=\"";
+
+        if ((histogram.getBucketCount() - 1U) == idx)
+        {
+            text += "+Inf";
+        }
+        else
+        {
+            text += histogram.getBound(idx);
+        }
+
+        text += "\"} ";
+        text += cumulated;
+        text += '\n';
+    }
+
+    text += PREFIX;
+    text += name;
+    text += "_sum";
+    text += sumLabels;
+    text += ' ';
+    text += String(static_cast<double>(histogram.getSum()), 0);
+    text += '\n';
+
+    text += PREFIX;
+    text += name;
+    text += "_count";
+    text += sumLabels;
+    text += ' ';
+    text += histogram.getCount();
+    text += '\n';
+}
+
+void Metrics::appendSummary(String& text, const char* name, const Histogram& histogram)
+{
+    uint32_t mean = 0U;
+
+    if (0U < histogram.getCount())
+    {
+        mean = static_cast<uint32_t>(histogram.getSum() / histogram.getCount());
+    }
+
+    if (0U < text.length())
+    {
+        text += ';';
+    }
+
+    text += name;
+    text += ':';
+    text += histogram.getCount();
+    text += ':';
+    text += mean;
+    text += ':';
+    text += histogram.getPercentileBound(99U);
+    text += ':';
+    text += histogram.getMax();
+}
+
+void Metrics::appendHeapMonitor(String& text)
+{
+    const HeapMonitor&  monitor = HeapMonitor::getInstance();
+    uint8_t             tag     = 0U;
+
+    appendGauge(text, "heap_free_min_bytes", "Min. free heap since boot.", monitor.getMinFreeHeap());
+    appendGauge(text, "heap_max_block_min_bytes", "Min. largest free heap block since boot.", monitor.getMinMaxFreeBlock());
+    appendGauge(text, "heap_fragmentation_percent", "Heap fragmentation.", monitor.getFragmentation());
+    appendGauge(text, "heap_fragmentation_max_percent", "Max. heap fragmentation since boot.", monitor.getMaxFragmentation());
+
+    appendHeader(text, "heap_warnings_total", "Heap values, which crossed their threshold.", "counter");
+    text += PREFIX;
+    text += "heap_warnings_total ";
+    text += monitor.getWarningCount();
+    text += '\n';
+
+    appendHeader(text, "heap_subsystem_peak_bytes", "High-water mark of the heap a single scope of the subsystem took.", "gauge");
+
+    for (tag = 0U; tag < HeapMonitor::TAG_MAX; ++tag)
+    {
+        appendSubsystemLabel(text, "heap_subsystem_peak_bytes", static_cast<HeapMonitor::Tag>(tag));
+        text += monitor.getTagUsage(static_cast<HeapMonitor::Tag>(tag)).peakBytes;
+        text += '\n';
+    }
+
+    appendHeader(text, "heap_subsystem_kept_bytes", "Heap all scopes of the subsystem kept.", "gauge");
+
+    for (tag = 0U; tag < HeapMonitor::TAG_MAX; ++tag)
+    {
+        appendSubsystemLabel(text, "heap_subsystem_kept_bytes", static_cast<HeapMonitor::Tag>(tag));
+        text += monitor.getTagUsage(static_cast<HeapMonitor::Tag>(tag)).keptBytes;
+        text += '\n';
+    }
+
+    appendHeader(text, "heap_subsystem_allocations_total", "Allocations of the subsystem, only counted by the native build.", "counter");
+
+    for (tag = 0U; tag < HeapMonitor::TAG_MAX; ++tag)
+    {
+        appendSubsystemLabel(text, "heap_subsystem_allocations_total", static_cast<HeapMonitor::Tag>(tag));
+        text += monitor.getTagUsage(static_cast<HeapMonitor::Tag>(tag)).allocations;
+        text += '\n';
+    }
+}
+
+void Metrics::appendGauge(String& text, const char* name, const char* help, uint32_t value)
+{
+    appendHeader(text, name, help, "gauge");
+    text += PREFIX;
+    text += name;
+    text += ' ';
+    text += value;
+    text += '\n';
+}
+
+void Metrics::appendSubsystemLabel(String& text, const char* name, HeapMonitor::Tag tag)
+{
+    text += PREFIX;
+    text += name;
+    text += "{subsystem=\"";
+    text += HeapMonitor::getTagName(tag);
+    text += "\"} ";
+}
+
+void Metrics::appendHeapSummary(String& text)
+{
+    const HeapMonitor&  monitor = HeapMonitor::getInstance();
+    uint8_t             tag     = 0U;
+
+    appendSummary(text, "heap_min", monitor.getMinFreeHeap());
+    appendSummary(text, "heap_block_min", monitor.getMinMaxFreeBlock());
+    appendSummary(text, "heap_frag_max", monitor.getMaxFragmentation());
+
+    for (tag = 0U; tag < HeapMonitor::TAG_MAX; ++tag)
+    {
+        const HeapMonitor::TagUsage& usage = monitor.getTagUsage(static_cast<HeapMonitor::Tag>(tag));
+
+        /* Same format as a histogram: scopes, kept bytes per scope, peak and peak. */
+        if (0U < text.length())
+        {
+            text += ';';
+        }
+
+        text += "heap_";
+        text += HeapMonitor::getTagName(static_cast<HeapMonitor::Tag>(tag));
+        text += ':';
+        text += usage.scopes;
+        text += ':';
+        text += (0U < usage.scopes) ? (usage.keptBytes / static_cast<int32_t>(usage.scopes)) : 0;
+        text += ':';
+        text += usage.peakBytes;
+        text += ':';
+        text += usage.peakBytes;
+    }
+}
+
+void Metrics::appendSummary(String& text, const char* name, uint32_t value)
+{
+    if (0U < text.length())
+    {
+        text += ';';
+    }
+
+    text += name;
+    text += ':';
+    text += (0U < value) ? 1U : 0U;
+    text += ':';
+    text += value;
+    text += ':';
+    text += value;
+    text += ':';
+    text += value;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,323 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Runtime metrics
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "Histogram.h"
+#include "Scheduler.h"
+#include "HeapMonitor.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Runtime metrics of the lap timer.
+ *
+ *  All values are recorded into histograms with fixed buckets, therefore the
+ *  memory consumption is constant and recording is cheap enough to stay
+ *  enabled during a competition. The loop period and the task runtimes are
+ *  taken from the scheduler, the other values are recorded here.
+ *
+ *  The metrics are provided in the Prometheus text format, split into
+ *  sections to keep the heap usage low, and as a compact summary.
+ */
+class Metrics
+{
+public:
+
+    /**
+     *  Get the metrics instance.
+     *
+     *  @return Metrics instance
+     */
+    static Metrics& getInstance()
+    {
+        static Metrics instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     *  Set the scheduler, which provides the loop period and the task runtimes.
+     *
+     *  @param[in] scheduler    Scheduler
+     */
+    void setScheduler(const Scheduler* scheduler)
+    {
+        m_scheduler = scheduler;
+    }
+
+    /**
+     *  Record the latency between the event of the sensor task, which
+     *  detected the robot, and its broadcast to all clients.
+     *
+     *  @param[in] latency  Latency in us.
+     */
+    void recordEventLatency(uint32_t latency)
+    {
+        m_eventLatencies.record(latency);
+    }
+
+    /**
+     *  Sample the heap and the number of websocket clients.
+     *
+     *  @param[in] wsClients    Number of connected websocket clients.
+     */
+    void sample(uint8_t wsClients);
+
+    /**
+     *  Record the end of a boot phase, timestamped since boot.
+     *  Phases beyond MAX_BOOT_PHASES are only logged.
+     *
+     *  @param[in] name Phase name, must be a string literal.
+     */
+    void recordBootPhase(const char* name);
+
+    /**
+     *  Record the time since boot, when the sensor timing is armed.
+     */
+    void recordArmed()
+    {
+        m_bootToArmed = micros();
+    }
+
+    /**
+     *  Record the time since boot, when all services are started.
+     */
+    void recordReady()
+    {
+        m_bootToReady = micros();
+    }
+
+    /**
+     *  Get a section of the metrics in the Prometheus text format.
+     *  Call it with increasing index, starting with 0, until it returns false.
+     *
+     *  @param[in]  idx     Section index.
+     *  @param[out] text    Section text. It is appended.
+     *  @return If the section exists, returns true. Otherwise, false.
+     */
+    bool getPrometheusSection(uint8_t idx, String& text) const;
+
+    /**
+     *  Get a compact summary of all metrics.
+     *  Every metric is separated by ';' and has the format
+     *  <name>:<count>:<mean>:<p99>:<max>, where p99 is the upper bound of
+     *  the bucket with the 99th percentile.
+     *
+     *  @param[out] text    Summary. It is appended, with a leading ';' if not empty.
+     */
+    void getSummary(String& text) const;
+
+private:
+
+    /** Boot phase */
+    typedef struct
+    {
+        const char* name;       /**< Phase name. */
+        uint32_t    timestamp;  /**< Time in us since boot, when the phase ended. */
+
+    } BootPhase;
+
+    /** Max. number of recorded boot phases. */
+    static const uint8_t MAX_BOOT_PHASES = 8U;
+
+    /** Bucket bounds in byte for the heap. */
+    static const uint32_t HEAP_BOUNDS[];
+
+    /** Bucket bounds for the number of websocket clients. */
+    static const uint32_t CLIENT_BOUNDS[];
+
+    /** Prefix of all metric names. */
+    static const char* PREFIX;
+
+    /** Scheduler, which provides the loop period and the task runtimes. */
+    const Scheduler*    m_scheduler;
+
+    /** Latency in us between sensor poll and event broadcast. */
+    Histogram           m_eventLatencies;
+
+    /** Free heap in byte. */
+    Histogram           m_heapFree;
+
+    /** Largest free heap block in byte. */
+    Histogram           m_heapMaxBlock;
+
+    /** Number of connected websocket clients. */
+    Histogram           m_wsClients;
+
+    /** Boot phases in the order they ended. */
+    BootPhase           m_bootPhases[MAX_BOOT_PHASES];
+
+    /** Number of recorded boot phases. */
+    uint8_t             m_bootPhaseCount;
+
+    /** Time in us since boot, until the sensor timing was armed. 0 if not armed yet. */
+    uint32_t            m_bootToArmed;
+
+    /** Time in us since boot, until all services were started. 0 if not ready yet. */
+    uint32_t            m_bootToReady;
+
+    /**
+     * Constructs the metrics.
+     */
+    Metrics();
+
+    /**
+     * Destroys the metrics.
+     */
+    ~Metrics()
+    {
+    }
+
+    /**
+     *  Get the number of scheduler tasks, including the sensor task.
+     *
+     *  @return Number of tasks
+     */
+    uint8_t getTaskCount() const;
+
+    /**
+     *  Get a scheduler task by index, the sensor task has index 0.
+     *
+     *  @param[in] idx  Task index
+     *  @return Task. If the index is invalid, nullptr is returned.
+     */
+    const Scheduler::Task* getTask(uint8_t idx) const;
+
+    /**
+     *  Append the HELP and TYPE lines of a metric in the Prometheus text format.
+     *
+     *  @param[out] text    Text to append to.
+     *  @param[in]  name    Metric name, without prefix.
+     *  @param[in]  help    Help text.
+     *  @param[in]  type    Metric type, e.g. "histogram".
+     */
+    static void appendHeader(String& text, const char* name, const char* help, const char* type);
+
+    /**
+     *  Append a histogram in the Prometheus text format.
+     *  The buckets are cumulative there.
+     *
+     *  @param[out] text        Text to append to.
+     *  @param[in]  name        Metric name, without prefix.
+     *  @param[in]  task        Task name, used as label. Use nullptr for no label.
+     *  @param[in]  histogram   Histogram.
+     */
+    static void appendHistogram(String& text, const char* name, const char* task, const Histogram& histogram);
+
+    /**
+     *  Append a histogram to the compact summary.
+     *
+     *  @param[out] text        Text to append to.
+     *  @param[in]  name        Metric name.
+     *  @param[in]  histogram   Histogram.
+     */
+    static void appendSummary(String& text, const char* name, const Histogram& histogram);
+
+    /**
+     *  Append a single value to the compact summary, in the same format as a
+     *  histogram with one sample. A value of 0 means not recorded.
+     *
+     *  @param[out] text    Text to append to.
+     *  @param[in]  name    Metric name.
+     *  @param[in]  value   Value
+     */
+    static void appendSummary(String& text, const char* name, uint32_t value);
+
+    /**
+     *  Append the worst heap values and the heap usage of the subsystems
+     *  of the heap monitor in the Prometheus text format.
+     *
+     *  @param[out] text    Text to append to.
+     */
+    static void appendHeapMonitor(String& text);
+
+    /**
+     *  Append a gauge with its HELP and TYPE lines in the Prometheus text format.
+     *
+     *  @param[out] text    Text to append to.
+     *  @param[in]  name    Metric name, without prefix.
+     *  @param[in]  help    Help text.
+     *  @param[in]  value   Value
+     */
+    static void appendGauge(String& text, const char* name, const char* help, uint32_t value);
+
+    /**
+     *  Append the name and the subsystem label of a metric in the Prometheus
+     *  text format. The value follows.
+     *
+     *  @param[out] text    Text to append to.
+     *  @param[in]  name    Metric name, without prefix.
+     *  @param[in]  tag     Subsystem, used as label.
+     */
+    static void appendSubsystemLabel(String& text, const char* name, HeapMonitor::Tag tag);
+
+    /**
+     *  Append the worst heap values and the heap usage of the subsystems
+     *  to the compact summary. A subsystem has the format
+     *  heap_<subsystem>:<scopes>:<kept bytes per scope>:<peak>:<peak>.
+     *
+     *  @param[out] text    Text to append to.
+     */
+    static void appendHeapSummary(String& text);
+
+    /** 
+     *  An instance shall not be copied. 
+     *  
+     *  @param[in] metrics Metrics instance to copy.
+     */
+    Metrics(const Metrics& metrics);
+
+    /** 
+     *  An instance shall not assigned.
+     *   
+     *  @param[in] metrics Metrics instance to assign.
+     *  @return Reference to this instance.
+     */
+    Metrics& operator=(const Metrics& metrics);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* METRICS_H_ */
@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino core API for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <functional>
+#include <algorithm>
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Digital level low. */
+#define LOW             0
+
+/** Digital level high. */
+#define HIGH            1
+
+/** Pin mode: Input */
+#define INPUT           0x00
+
+/** Pin mode: Output */
+#define OUTPUT          0x01
+
+/** Pin mode: Input with pull-up */
+#define INPUT_PULLUP    0x02
+
+/** Strings are in RAM on the host. */
+#ifndef F
+#define F(str)          (str)
+#endif
+
+/** Strings are in RAM on the host. */
+#ifndef PSTR
+#define PSTR(str)       (str)
+#endif
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Arduino boolean type. */
+typedef bool boolean;
+
+/** Arduino byte type. */
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Get the time since start.
+ *
+ * @return Time in ms, it wraps around after 32 bit.
+ */
+unsigned long millis();
+
+/**
+ * Get the time since start.
+ *
+ * @return Time in us, it wraps around after 32 bit.
+ */
+unsigned long micros();
+
+/**
+ * Wait the given time.
+ *
+ * @param[in] ms    Time in ms.
+ */
+void delay(unsigned long ms);
+
+/**
+ * Wait the given time.
+ *
+ * @param[in] us    Time in us.
+ */
+void delayMicroseconds(unsigned int us);
+
+/**
+ * Pass control to other tasks.
+ */
+void yield();
+
+/**
+ * Configure a digital pin.
+ *
+ * @param[in] pin   Pin number.
+ * @param[in] mode  Pin mode.
+ */
+void pinMode(uint8_t pin, uint8_t mode);
+
+/**
+ * Read a digital pin.
+ *
+ * @param[in] pin   Pin number.
+ *
+ * @return Level, LOW or HIGH.
+ */
+int digitalRead(uint8_t pin);
+
+/**
+ * Write a digital pin.
+ *
+ * @param[in] pin   Pin number.
+ * @param[in] val   Level, LOW or HIGH.
+ */
+void digitalWrite(uint8_t pin, uint8_t val);
+
+/**
+ * Setup the system, implemented by the application.
+ */
+void setup();
+
+/**
+ * Main loop, implemented by the application.
+ */
+void loop();
+
+#endif /* ARDUINO_H_ */
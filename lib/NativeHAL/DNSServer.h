@@ -0,0 +1,90 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  DNS server stub for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef DNS_SERVER_H_
+#define DNS_SERVER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "IPAddress.h"
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  DNS server of the captive portal. The host has no captive portal,
+ *  therefore it does nothing.
+ */
+class DNSServer
+{
+public:
+
+    /**
+     *  Start the server.
+     *
+     *  @param[in] port         Port
+     *  @param[in] domainName   Domain name
+     *  @param[in] resolvedIP   Address, which is returned for the domain.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool start(uint16_t port, const String& domainName, const IPAddress& resolvedIP)
+    {
+        (void)port;
+        (void)domainName;
+        (void)resolvedIP;
+
+        return true;
+    }
+
+    /**
+     *  Process the pending requests.
+     */
+    void processNextRequest()
+    {
+    }
+
+    /**
+     *  Stop the server.
+     */
+    void stop()
+    {
+    }
+};
+
+#endif /* DNS_SERVER_H_ */
@@ -0,0 +1,179 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  File backed EEPROM emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "EEPROM.h"
+#include "NativeHAL.h"
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Value of erased flash. */
+static const uint8_t ERASED = 0xFFU;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void EEPROMClass::begin(size_t size)
+{
+    FILE* file = fopen(NativeHAL::getEepromFile(), "rb");
+
+    m_data.assign(size, ERASED);
+    m_isDirty = false;
+
+    if (nullptr != file)
+    {
+        (void)fread(&m_data[0], 1U, size, file);
+        (void)fclose(file);
+    }
+}
+
+uint8_t EEPROMClass::read(int address)
+{
+    uint8_t value = 0U;
+
+    if ((0 <= address) && (m_data.size() > static_cast<size_t>(address)))
+    {
+        value = m_data[address];
+    }
+
+    return value;
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+    if ((0 <= address) && (m_data.size() > static_cast<size_t>(address)) && (value != m_data[address]))
+    {
+        m_data[address] = value;
+        m_isDirty = true;
+    }
+}
+
+bool EEPROMClass::commit()
+{
+    bool isSuccess = true;
+
+    if (true == m_data.empty())
+    {
+        isSuccess = false;
+    }
+    else if (true == m_isDirty)
+    {
+        FILE* file = fopen(NativeHAL::getEepromFile(), "wb");
+
+        if (nullptr == file)
+        {
+            isSuccess = false;
+        }
+        else
+        {
+            if (m_data.size() != fwrite(&m_data[0], 1U, m_data.size(), file))
+            {
+                isSuccess = false;
+            }
+
+            if (0 != fclose(file))
+            {
+                isSuccess = false;
+            }
+        }
+
+        if (true == isSuccess)
+        {
+            m_isDirty = false;
+            ++m_writeCount;
+        }
+    }
+
+    return isSuccess;
+}
+
+bool EEPROMClass::end()
+{
+    bool isSuccess = commit();
+
+    m_data.clear();
+
+    return isSuccess;
+}
+
+uint8_t* EEPROMClass::getDataPtr()
+{
+    uint8_t* data = nullptr;
+
+    if (false == m_data.empty())
+    {
+        m_isDirty = true;
+        data = &m_data[0];
+    }
+
+    return data;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/** EEPROM */
+EEPROMClass EEPROM;
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
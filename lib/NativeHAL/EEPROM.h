@@ -0,0 +1,165 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  File backed EEPROM emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  EEPROM emulation, which behaves like the flash backed one of the ESP8266
+ *  core: begin() reads the whole content into RAM, write() only changes RAM
+ *  and commit() writes the content to the backing file, if it was changed.
+ *  A missing file reads as erased flash (0xFF).
+ */
+class EEPROMClass
+{
+public:
+
+    /**
+     *  Constructs the EEPROM.
+     */
+    EEPROMClass() :
+        m_data(),
+        m_isDirty(false),
+        m_writeCount(0U)
+    {
+    }
+
+    /**
+     *  Destroys the EEPROM.
+     */
+    ~EEPROMClass()
+    {
+    }
+
+    /**
+     *  Read the content from the backing file.
+     *
+     *  @param[in] size Size in byte.
+     */
+    void begin(size_t size);
+
+    /**
+     *  Read a byte.
+     *
+     *  @param[in] address  Address
+     *  @return Byte. If the address is invalid, 0 is returned.
+     */
+    uint8_t read(int address);
+
+    /**
+     *  Write a byte.
+     *
+     *  @param[in] address  Address. If invalid, nothing happens.
+     *  @param[in] value    Byte
+     */
+    void write(int address, uint8_t value);
+
+    /**
+     *  Write the content to the backing file, if it was changed.
+     *
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool commit();
+
+    /**
+     *  Commit and release the content.
+     *
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool end();
+
+    /**
+     *  Get the size.
+     *
+     *  @return Size in byte.
+     */
+    size_t length() const
+    {
+        return m_data.size();
+    }
+
+    /**
+     *  Get the content.
+     *
+     *  @return Content. It is nullptr before begin().
+     */
+    uint8_t* getDataPtr();
+
+    /**
+     *  Get the number of writes to the backing file, which stand for the
+     *  flash writes of the device.
+     *
+     *  @return Number of writes
+     */
+    uint32_t getWriteCount() const
+    {
+        return m_writeCount;
+    }
+
+private:
+
+    /** Content */
+    std::vector<uint8_t>    m_data;
+
+    /** Was the content changed since the last commit? */
+    bool                    m_isDirty;
+
+    /** Number of writes to the backing file. */
+    uint32_t                m_writeCount;
+
+    /* Not allowed. */
+    EEPROMClass(const EEPROMClass& eeprom);
+    EEPROMClass& operator=(const EEPROMClass& eeprom);
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** EEPROM */
+extern EEPROMClass EEPROM;
+
+#endif /* EEPROM_H_ */
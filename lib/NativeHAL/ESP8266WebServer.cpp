@@ -0,0 +1,692 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ESP8266WebServer.h"
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static String urlDecode(const String& text);
+static const char* getReasonPhrase(int code);
+static const char* getContentType(const String& path);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Empty string, returned for not available arguments. */
+static const String EMPTY_STRING;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ESP8266WebServer::ESP8266WebServer(uint16_t port) :
+    m_server(port),
+    m_handlers(),
+    m_notFoundHandler(),
+    m_client(),
+    m_request(),
+    m_requestTimestamp(0U),
+    m_method(HTTP_ANY),
+    m_uri(),
+    m_args(),
+    m_responseHeaders(),
+    m_contentLength(CONTENT_LENGTH_NOT_SET),
+    m_isChunked(false)
+{
+}
+
+void ESP8266WebServer::begin()
+{
+    (void)m_server.begin();
+}
+
+void ESP8266WebServer::close()
+{
+    finishRequest();
+    m_server.close();
+}
+
+void ESP8266WebServer::handleClient()
+{
+    if (0U == m_client.connected())
+    {
+        finishRequest();
+
+        m_client = m_server.accept();
+        m_requestTimestamp = millis();
+    }
+
+    if (0U != m_client.connected())
+    {
+        if (true == receiveRequest())
+        {
+            if (true == parseRequest())
+            {
+                dispatchRequest();
+            }
+            else
+            {
+                send(400, "text/plain", "Bad Request");
+            }
+
+            finishRequest();
+        }
+        else if (REQUEST_TIMEOUT_MS <= (millis() - m_requestTimestamp))
+        {
+            finishRequest();
+        }
+        else
+        {
+            ;
+        }
+    }
+}
+
+void ESP8266WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler)
+{
+    Handler entry;
+
+    entry.uri       = uri;
+    entry.method    = method;
+    entry.handler   = handler;
+    entry.fs        = nullptr;
+
+    m_handlers.push_back(entry);
+}
+
+void ESP8266WebServer::serveStatic(const char* uri, fs::FS& fs, const char* path, const char* cacheHeader)
+{
+    Handler entry;
+
+    entry.uri           = uri;
+    entry.method        = HTTP_GET;
+    entry.fs            = &fs;
+    entry.path          = path;
+    entry.cacheHeader   = cacheHeader;
+
+    m_handlers.push_back(entry);
+}
+
+const String& ESP8266WebServer::arg(int index) const
+{
+    const String* value = &EMPTY_STRING;
+
+    if ((0 <= index) && (m_args.size() > static_cast<size_t>(index)))
+    {
+        value = &m_args[index].value;
+    }
+
+    return *value;
+}
+
+const String& ESP8266WebServer::arg(const String& name) const
+{
+    const String*                           value   = &EMPTY_STRING;
+    std::vector<Argument>::const_iterator   it;
+
+    for (it = m_args.begin(); it != m_args.end(); ++it)
+    {
+        if (it->name == name)
+        {
+            value = &it->value;
+            break;
+        }
+    }
+
+    return *value;
+}
+
+const String& ESP8266WebServer::argName(int index) const
+{
+    const String* name = &EMPTY_STRING;
+
+    if ((0 <= index) && (m_args.size() > static_cast<size_t>(index)))
+    {
+        name = &m_args[index].name;
+    }
+
+    return *name;
+}
+
+bool ESP8266WebServer::hasArg(const String& name) const
+{
+    bool                                    isAvailable = false;
+    std::vector<Argument>::const_iterator   it;
+
+    for (it = m_args.begin(); (it != m_args.end()) && (false == isAvailable); ++it)
+    {
+        isAvailable = (it->name == name);
+    }
+
+    return isAvailable;
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first)
+{
+    String header = name + ": " + value + "\r\n";
+
+    if (true == first)
+    {
+        m_responseHeaders = header + m_responseHeaders;
+    }
+    else
+    {
+        m_responseHeaders += header;
+    }
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const String& content)
+{
+    String response = "HTTP/1.1 ";
+
+    response += code;
+    response += " ";
+    response += getReasonPhrase(code);
+    response += "\r\n";
+    response += "Content-Type: ";
+    response += (nullptr == contentType) ? "text/html" : contentType;
+    response += "\r\n";
+
+    if (CONTENT_LENGTH_UNKNOWN == m_contentLength)
+    {
+        response += "Transfer-Encoding: chunked\r\n";
+        m_isChunked = true;
+    }
+    else
+    {
+        response += "Content-Length: ";
+        response += (CONTENT_LENGTH_NOT_SET == m_contentLength) ? content.length() : m_contentLength;
+        response += "\r\n";
+    }
+
+    response += "Connection: close\r\n";
+    response += m_responseHeaders;
+    response += "\r\n";
+
+    m_responseHeaders.clear();
+    m_contentLength = CONTENT_LENGTH_NOT_SET;
+
+    (void)m_client.write(reinterpret_cast<const uint8_t*>(response.c_str()), response.length());
+
+    if (false == content.isEmpty())
+    {
+        sendContent(content);
+    }
+}
+
+void ESP8266WebServer::sendContent(const String& content)
+{
+    if (true == m_isChunked)
+    {
+        String chunk(content.length(), 16U);
+
+        chunk += "\r\n";
+        chunk += content;
+        chunk += "\r\n";
+
+        /* The empty chunk finishes the response. */
+        if (true == content.isEmpty())
+        {
+            chunk += "\r\n";
+            m_isChunked = false;
+        }
+
+        (void)m_client.write(reinterpret_cast<const uint8_t*>(chunk.c_str()), chunk.length());
+    }
+    else
+    {
+        (void)m_client.write(reinterpret_cast<const uint8_t*>(content.c_str()), content.length());
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool ESP8266WebServer::receiveRequest()
+{
+    bool    isComplete  = false;
+    uint8_t buffer[512];
+    int     count       = 0;
+
+    do
+    {
+        count = m_client.read(buffer, std::min(sizeof(buffer), MAX_REQUEST_SIZE - m_request.length()));
+
+        if (0 < count)
+        {
+            (void)m_request.concat(reinterpret_cast<const char*>(buffer), count);
+        }
+    }
+    while ((0 < count) && (MAX_REQUEST_SIZE > m_request.length()));
+
+    int headerEnd = m_request.indexOf("\r\n\r\n");
+
+    if (0 <= headerEnd)
+    {
+        int     lengthIdx       = m_request.indexOf("Content-Length:");
+        long    contentLength   = 0;
+
+        if ((0 <= lengthIdx) && (headerEnd > lengthIdx))
+        {
+            contentLength = m_request.substring(lengthIdx + 15).toInt();
+        }
+
+        isComplete = (static_cast<long>(m_request.length()) >= (headerEnd + 4 + contentLength));
+    }
+
+    /* A too large request is handled with what is there, which results in a error response. */
+    if (MAX_REQUEST_SIZE <= m_request.length())
+    {
+        isComplete = true;
+    }
+
+    return isComplete;
+}
+
+bool ESP8266WebServer::parseRequest()
+{
+    bool    isValid     = false;
+    int     lineEnd     = m_request.indexOf("\r\n");
+    int     headerEnd   = m_request.indexOf("\r\n\r\n");
+    String  requestLine = m_request.substring(0, lineEnd);
+    int     methodEnd   = requestLine.indexOf(' ');
+    int     uriEnd      = requestLine.indexOf(' ', methodEnd + 1);
+
+    m_args.clear();
+
+    if ((0 < methodEnd) && (methodEnd < uriEnd) && (0 <= headerEnd))
+    {
+        String  methodStr   = requestLine.substring(0, methodEnd);
+        String  url         = requestLine.substring(methodEnd + 1, uriEnd);
+        int     queryIdx    = url.indexOf('?');
+        String  body        = m_request.substring(headerEnd + 4);
+
+        isValid = true;
+
+        if (methodStr == "GET")
+        {
+            m_method = HTTP_GET;
+        }
+        else if (methodStr == "HEAD")
+        {
+            m_method = HTTP_HEAD;
+        }
+        else if (methodStr == "POST")
+        {
+            m_method = HTTP_POST;
+        }
+        else if (methodStr == "PUT")
+        {
+            m_method = HTTP_PUT;
+        }
+        else if (methodStr == "PATCH")
+        {
+            m_method = HTTP_PATCH;
+        }
+        else if (methodStr == "DELETE")
+        {
+            m_method = HTTP_DELETE;
+        }
+        else if (methodStr == "OPTIONS")
+        {
+            m_method = HTTP_OPTIONS;
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (0 <= queryIdx)
+        {
+            m_uri = urlDecode(url.substring(0, queryIdx));
+            parseArguments(url.substring(queryIdx + 1));
+        }
+        else
+        {
+            m_uri = urlDecode(url);
+        }
+
+        /* Like the core, a form body provides arguments, any other body is the argument "plain". */
+        if (false == body.isEmpty())
+        {
+            String headers = m_request.substring(0, headerEnd);
+
+            if (0 <= headers.indexOf("application/x-www-form-urlencoded"))
+            {
+                parseArguments(body);
+            }
+            else
+            {
+                Argument argument;
+
+                argument.name   = "plain";
+                argument.value  = body;
+                m_args.push_back(argument);
+            }
+        }
+    }
+
+    return isValid;
+}
+
+void ESP8266WebServer::parseArguments(const String& data)
+{
+    unsigned int start = 0U;
+
+    while (data.length() > start)
+    {
+        int     end     = data.indexOf('&', start);
+        String  pair    = data.substring(start, (0 > end) ? data.length() : end);
+        int     equal   = pair.indexOf('=');
+
+        if (false == pair.isEmpty())
+        {
+            Argument argument;
+
+            if (0 > equal)
+            {
+                argument.name = urlDecode(pair);
+            }
+            else
+            {
+                argument.name   = urlDecode(pair.substring(0, equal));
+                argument.value  = urlDecode(pair.substring(equal + 1));
+            }
+
+            m_args.push_back(argument);
+        }
+
+        start = (0 > end) ? data.length() : (end + 1);
+    }
+}
+
+void ESP8266WebServer::dispatchRequest()
+{
+    bool                                isHandled   = false;
+    std::vector<Handler>::iterator      it;
+
+    for (it = m_handlers.begin(); (it != m_handlers.end()) && (false == isHandled); ++it)
+    {
+        if (nullptr == it->fs)
+        {
+            if ((m_uri == it->uri) &&
+                ((HTTP_ANY == it->method) || (m_method == it->method)))
+            {
+                it->handler();
+                isHandled = true;
+            }
+        }
+        else if ((HTTP_GET == m_method) && (true == m_uri.startsWith(it->uri)))
+        {
+            /* Like the core 3.1, a not existing file is left to the next handler. */
+            isHandled = serveFile(*it);
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    if (false == isHandled)
+    {
+        if (nullptr != m_notFoundHandler)
+        {
+            m_notFoundHandler();
+        }
+        else
+        {
+            send(404, "text/plain", "Not found");
+        }
+    }
+}
+
+bool ESP8266WebServer::serveFile(const Handler& handler)
+{
+    bool    isServed    = false;
+    String  path        = handler.path + m_uri.substring(handler.uri.length());
+    File    file;
+
+    if (true == path.endsWith("/"))
+    {
+        path += "index.htm";
+    }
+
+    path.replace("//", "/");
+    file = handler.fs->open(path, "r");
+
+    if (file)
+    {
+        size_t  size    = file.size();
+        uint8_t buffer[1024];
+        size_t  count   = 0U;
+
+        if (false == handler.cacheHeader.isEmpty())
+        {
+            sendHeader("Cache-Control", handler.cacheHeader);
+        }
+
+        setContentLength(size);
+        send(200, getContentType(path), "");
+
+        do
+        {
+            count = file.read(buffer, sizeof(buffer));
+
+            if (0U < count)
+            {
+                (void)m_client.write(buffer, count);
+            }
+        }
+        while (0U < count);
+
+        file.close();
+        isServed = true;
+    }
+
+    return isServed;
+}
+
+void ESP8266WebServer::finishRequest()
+{
+    /* A copy of the client, kept by a handler, keeps the connection open. */
+    m_client = WiFiClient();
+    m_request.clear();
+    m_args.clear();
+    m_uri.clear();
+    m_responseHeaders.clear();
+    m_contentLength = CONTENT_LENGTH_NOT_SET;
+    m_isChunked     = false;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Decode a URL encoded text.
+ *
+ * @param[in] text  URL encoded text
+ *
+ * @return Decoded text
+ */
+static String urlDecode(const String& text)
+{
+    String          result;
+    unsigned int    idx     = 0U;
+
+    while (text.length() > idx)
+    {
+        char c = text[idx];
+
+        if ('+' == c)
+        {
+            result += ' ';
+        }
+        else if (('%' == c) && (text.length() > (idx + 2U)))
+        {
+            char hex[3] = { text[idx + 1U], text[idx + 2U], '\0' };
+
+            result += static_cast<char>(strtol(hex, nullptr, 16));
+            idx += 2U;
+        }
+        else
+        {
+            result += c;
+        }
+
+        ++idx;
+    }
+
+    return result;
+}
+
+/**
+ * Get the reason phrase of a HTTP status code.
+ *
+ * @param[in] code  HTTP status code
+ *
+ * @return Reason phrase
+ */
+static const char* getReasonPhrase(int code)
+{
+    const char* phrase = "";
+
+    switch (code)
+    {
+    case 200:
+        phrase = "OK";
+        break;
+
+    case 400:
+        phrase = "Bad Request";
+        break;
+
+    case 404:
+        phrase = "Not Found";
+        break;
+
+    case 405:
+        phrase = "Method Not Allowed";
+        break;
+
+    case 500:
+        phrase = "Internal Server Error";
+        break;
+
+    case 503:
+        phrase = "Service Unavailable";
+        break;
+
+    default:
+        break;
+    }
+
+    return phrase;
+}
+
+/**
+ * Get the content type by the file extension.
+ *
+ * @param[in] path  File path
+ *
+ * @return Content type
+ */
+static const char* getContentType(const String& path)
+{
+    const char* contentType = "application/octet-stream";
+
+    if ((true == path.endsWith(".html")) || (true == path.endsWith(".htm")))
+    {
+        contentType = "text/html";
+    }
+    else if (true == path.endsWith(".css"))
+    {
+        contentType = "text/css";
+    }
+    else if (true == path.endsWith(".js"))
+    {
+        contentType = "application/javascript";
+    }
+    else if (true == path.endsWith(".json"))
+    {
+        contentType = "application/json";
+    }
+    else if (true == path.endsWith(".png"))
+    {
+        contentType = "image/png";
+    }
+    else if (true == path.endsWith(".ico"))
+    {
+        contentType = "image/x-icon";
+    }
+    else if (true == path.endsWith(".svg"))
+    {
+        contentType = "image/svg+xml";
+    }
+    else if (true == path.endsWith(".txt"))
+    {
+        contentType = "text/plain";
+    }
+    else
+    {
+        ;
+    }
+
+    return contentType;
+}
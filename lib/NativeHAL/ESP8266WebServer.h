@@ -0,0 +1,403 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HTTP server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef ESP8266_WEB_SERVER_H_
+#define ESP8266_WEB_SERVER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "WString.h"
+#include "WiFiClient.h"
+#include "FS.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Content length of a chunked response. */
+#define CONTENT_LENGTH_UNKNOWN  ((size_t) -1)
+
+/** Content length is taken from the content. */
+#define CONTENT_LENGTH_NOT_SET  ((size_t) -2)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** HTTP methods */
+typedef enum
+{
+    HTTP_ANY,       /**< Any method, only used for handler registration. */
+    HTTP_GET,       /**< GET */
+    HTTP_HEAD,      /**< HEAD */
+    HTTP_POST,      /**< POST */
+    HTTP_PUT,       /**< PUT */
+    HTTP_PATCH,     /**< PATCH */
+    HTTP_DELETE,    /**< DELETE */
+    HTTP_OPTIONS    /**< OPTIONS */
+
+} HTTPMethod;
+
+/**
+ *  HTTP server, which serves one request at a time like the one of the
+ *  ESP8266 core. The request is received without blocking over several
+ *  handleClient() calls and dispatched when it is complete. After the
+ *  handler the server drops its reference to the client, therefore the
+ *  connection is closed unless the handler kept a copy of the client.
+ */
+class ESP8266WebServer
+{
+public:
+
+    /** Request handler */
+    typedef std::function<void(void)> THandlerFunction;
+
+    /**
+     *  Constructs the server.
+     *
+     *  @param[in] port Device port
+     */
+    explicit ESP8266WebServer(uint16_t port = 80U);
+
+    /**
+     *  Destroys the server.
+     */
+    ~ESP8266WebServer()
+    {
+    }
+
+    /**
+     *  Start listening.
+     */
+    void begin();
+
+    /**
+     *  Stop listening.
+     */
+    void close();
+
+    /** @copydoc close() */
+    void stop()
+    {
+        close();
+    }
+
+    /**
+     *  Receive and handle requests.
+     */
+    void handleClient();
+
+    /**
+     *  Register a request handler.
+     *
+     *  @param[in] uri      URI
+     *  @param[in] method   HTTP method
+     *  @param[in] handler  Handler
+     */
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+
+    /** @copydoc on() */
+    void on(const String& uri, THandlerFunction handler)
+    {
+        on(uri, HTTP_ANY, handler);
+    }
+
+    /**
+     *  Register the handler for not handled requests.
+     *
+     *  @param[in] handler  Handler
+     */
+    void onNotFound(THandlerFunction handler)
+    {
+        m_notFoundHandler = handler;
+    }
+
+    /**
+     *  Serve files of a filesystem. A URI with trailing '/' serves index.htm.
+     *
+     *  @param[in] uri          URI prefix
+     *  @param[in] fs           Filesystem
+     *  @param[in] path         Path prefix in the filesystem.
+     *  @param[in] cacheHeader  Value of the Cache-Control header, may be nullptr.
+     */
+    void serveStatic(const char* uri, fs::FS& fs, const char* path, const char* cacheHeader = nullptr);
+
+    /**
+     *  Get the method of the current request.
+     *
+     *  @return HTTP method
+     */
+    HTTPMethod method() const
+    {
+        return m_method;
+    }
+
+    /**
+     *  Get the URI of the current request.
+     *
+     *  @return URI without arguments.
+     */
+    const String& uri() const
+    {
+        return m_uri;
+    }
+
+    /**
+     *  Get the number of arguments of the current request.
+     *
+     *  @return Number of arguments.
+     */
+    int args() const
+    {
+        return static_cast<int>(m_args.size());
+    }
+
+    /**
+     *  Get a argument value.
+     *
+     *  @param[in] index    Argument index
+     *  @return Value. If the index is invalid, it is empty.
+     */
+    const String& arg(int index) const;
+
+    /**
+     *  Get a argument value.
+     *
+     *  @param[in] name Argument name
+     *  @return Value. If not found, it is empty.
+     */
+    const String& arg(const String& name) const;
+
+    /**
+     *  Get a argument name.
+     *
+     *  @param[in] index    Argument index
+     *  @return Name. If the index is invalid, it is empty.
+     */
+    const String& argName(int index) const;
+
+    /**
+     *  Has the current request the argument?
+     *
+     *  @param[in] name Argument name
+     *  @return If available, returns true. Otherwise, false.
+     */
+    bool hasArg(const String& name) const;
+
+    /**
+     *  Get the client of the current request.
+     *
+     *  @return Client
+     */
+    WiFiClient& client()
+    {
+        return m_client;
+    }
+
+    /**
+     *  Add a header to the response.
+     *
+     *  @param[in] name     Header name
+     *  @param[in] value    Header value
+     *  @param[in] first    Add it as first (true) or last (false) header.
+     */
+    void sendHeader(const String& name, const String& value, bool first = false);
+
+    /**
+     *  Set the content length of the next send(). CONTENT_LENGTH_UNKNOWN
+     *  starts a chunked response, which is finished by a empty sendContent().
+     *
+     *  @param[in] contentLength    Content length in byte.
+     */
+    void setContentLength(size_t contentLength)
+    {
+        m_contentLength = contentLength;
+    }
+
+    /**
+     *  Send the response.
+     *
+     *  @param[in] code         HTTP status code
+     *  @param[in] contentType  Content type
+     *  @param[in] content      Content
+     */
+    void send(int code, const char* contentType, const String& content);
+
+    /** @copydoc send(int, const char*, const String&) */
+    void send(int code, const String& contentType, const String& content)
+    {
+        send(code, contentType.c_str(), content);
+    }
+
+    /** @copydoc send(int, const char*, const String&) */
+    void send(int code, const char* contentType, const char* content)
+    {
+        send(code, contentType, String(content));
+    }
+
+    /**
+     *  Send further content. In a chunked response it is sent as chunk,
+     *  otherwise as it is.
+     *
+     *  @param[in] content  Content
+     */
+    void sendContent(const String& content);
+
+    /** @copydoc sendContent(const String&) */
+    void sendContent(const char* content)
+    {
+        sendContent(String(content));
+    }
+
+    /**
+     *  Send further content, see sendContent(const String&).
+     *
+     *  @param[in] content  Content
+     *  @param[in] size     Content size in byte.
+     */
+    void sendContent(const char* content, size_t size)
+    {
+        sendContent(String(content, static_cast<unsigned int>(size)));
+    }
+
+private:
+
+    /** Registered request handler. */
+    typedef struct
+    {
+        String              uri;        /**< URI or URI prefix */
+        HTTPMethod          method;     /**< HTTP method */
+        THandlerFunction    handler;    /**< Handler, not set for static files. */
+        fs::FS*             fs;         /**< Filesystem of static files. */
+        String              path;       /**< Path prefix of static files. */
+        String              cacheHeader;/**< Cache-Control of static files. */
+
+    } Handler;
+
+    /** Request argument */
+    typedef struct
+    {
+        String  name;   /**< Name */
+        String  value;  /**< Value */
+
+    } Argument;
+
+    /** Maximum request size in byte. */
+    static const size_t     MAX_REQUEST_SIZE    = 4096U;
+
+    /** Time in ms, a client has to send the whole request. */
+    static const uint32_t   REQUEST_TIMEOUT_MS  = 5000U;
+
+    /** Listening socket */
+    WiFiServer              m_server;
+
+    /** Registered handlers */
+    std::vector<Handler>    m_handlers;
+
+    /** Handler for not handled requests. */
+    THandlerFunction        m_notFoundHandler;
+
+    /** Client of the current request. */
+    WiFiClient              m_client;
+
+    /** Received part of the current request. */
+    String                  m_request;
+
+    /** Timestamp of the accepted connection in ms. */
+    uint32_t                m_requestTimestamp;
+
+    /** Method of the current request. */
+    HTTPMethod              m_method;
+
+    /** URI of the current request. */
+    String                  m_uri;
+
+    /** Arguments of the current request. */
+    std::vector<Argument>   m_args;
+
+    /** Additional response headers. */
+    String                  m_responseHeaders;
+
+    /** Content length of the next response. */
+    size_t                  m_contentLength;
+
+    /** Is the current response chunked? */
+    bool                    m_isChunked;
+
+    /**
+     *  Receive the pending request.
+     *
+     *  @return If the request is complete, returns true. Otherwise, false.
+     */
+    bool receiveRequest();
+
+    /**
+     *  Parse the complete request.
+     *
+     *  @return If valid, returns true. Otherwise, false.
+     */
+    bool parseRequest();
+
+    /**
+     *  Parse URL encoded arguments.
+     *
+     *  @param[in] data URL encoded arguments, e.g. "a=1&b=2".
+     */
+    void parseArguments(const String& data);
+
+    /**
+     *  Dispatch the request to the matching handler.
+     */
+    void dispatchRequest();
+
+    /**
+     *  Serve a static file.
+     *
+     *  @param[in] handler  Static file handler
+     *  @return If the file was found, returns true. Otherwise, false.
+     */
+    bool serveFile(const Handler& handler);
+
+    /**
+     *  Drop the current request and its client.
+     */
+    void finishRequest();
+
+    /* Not allowed. */
+    ESP8266WebServer(const ESP8266WebServer& server);
+    ESP8266WebServer& operator=(const ESP8266WebServer& server);
+};
+
+#endif /* ESP8266_WEB_SERVER_H_ */
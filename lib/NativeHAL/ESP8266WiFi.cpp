@@ -0,0 +1,252 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  WiFi emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ESP8266WiFi.h"
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** BSSID of the emulated access point. */
+static const uint8_t    AP_BSSID[6]     = { 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U };
+
+/** Loopback address, which all sockets are reachable with. */
+static const IPAddress  LOOPBACK(127U, 0U, 0U, 1U);
+
+/** Subnet mask of the loopback network. */
+static const IPAddress  LOOPBACK_MASK(255U, 0U, 0U, 0U);
+
+/** Signal strength of the emulated access point in dBm. */
+static const int32_t    AP_RSSI         = -55;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool ESP8266WiFiClass::mode(WiFiMode_t mode)
+{
+    if ((WIFI_STA != mode) && (WIFI_AP_STA != mode))
+    {
+        m_isConnecting = false;
+    }
+
+    m_mode = mode;
+
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::begin(const String& ssid, const String& passphrase, int32_t channel, const uint8_t* bssid, bool connect)
+{
+    (void)passphrase;
+
+    if ((WIFI_STA != m_mode) && (WIFI_AP_STA != m_mode))
+    {
+        m_mode = (WIFI_AP == m_mode) ? WIFI_AP_STA : WIFI_STA;
+    }
+
+    m_isConnecting      = (true == connect) && (false == ssid.isEmpty());
+    m_connectTimestamp  = millis();
+    m_isApMatching      = ((0 == channel) || (m_apChannel == channel)) &&
+                          ((nullptr == bssid) || (0 == memcmp(bssid, AP_BSSID, sizeof(AP_BSSID))));
+
+    /* Known channel and BSSID skip the scan, a static IP skips DHCP. */
+    if ((0 != channel) &&
+        (nullptr != bssid) &&
+        (0U != m_staticIP))
+    {
+        m_connectTime = FAST_CONNECT_TIME_MS;
+    }
+    else
+    {
+        m_connectTime = CONNECT_TIME_MS;
+    }
+
+    return status();
+}
+
+bool ESP8266WiFiClass::config(const IPAddress& localIP, const IPAddress& gateway, const IPAddress& subnet, const IPAddress& dns1, const IPAddress& dns2)
+{
+    (void)gateway;
+    (void)subnet;
+    (void)dns1;
+    (void)dns2;
+
+    m_staticIP = localIP;
+
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::status()
+{
+    wl_status_t status = WL_DISCONNECTED;
+
+    if (false == m_isConnecting)
+    {
+        status = WL_IDLE_STATUS;
+    }
+    else if ((false == m_isApInRange) || (false == m_isApMatching))
+    {
+        status = WL_NO_SSID_AVAIL;
+    }
+    else if (m_connectTime <= (millis() - m_connectTimestamp))
+    {
+        status = WL_CONNECTED;
+    }
+
+    return status;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifiOff)
+{
+    m_isConnecting = false;
+
+    if (true == wifiOff)
+    {
+        m_mode = (WIFI_AP_STA == m_mode) ? WIFI_AP : WIFI_OFF;
+    }
+
+    return true;
+}
+
+bool ESP8266WiFiClass::softAP(const String& ssid, const String& passphrase)
+{
+    (void)ssid;
+    (void)passphrase;
+
+    if ((WIFI_AP != m_mode) && (WIFI_AP_STA != m_mode))
+    {
+        m_mode = (WIFI_STA == m_mode) ? WIFI_AP_STA : WIFI_AP;
+    }
+
+    return true;
+}
+
+IPAddress ESP8266WiFiClass::softAPIP() const
+{
+    IPAddress address;
+
+    if ((WIFI_AP == m_mode) || (WIFI_AP_STA == m_mode))
+    {
+        address = LOOPBACK;
+    }
+
+    return address;
+}
+
+IPAddress ESP8266WiFiClass::localIP()
+{
+    IPAddress address;
+
+    if (WL_CONNECTED == status())
+    {
+        address = LOOPBACK;
+    }
+
+    return address;
+}
+
+IPAddress ESP8266WiFiClass::gatewayIP()
+{
+    return localIP();
+}
+
+IPAddress ESP8266WiFiClass::subnetMask()
+{
+    IPAddress mask;
+
+    if (WL_CONNECTED == status())
+    {
+        mask = LOOPBACK_MASK;
+    }
+
+    return mask;
+}
+
+IPAddress ESP8266WiFiClass::dnsIP(uint8_t index)
+{
+    (void)index;
+
+    return localIP();
+}
+
+const uint8_t* ESP8266WiFiClass::BSSID()
+{
+    return (WL_CONNECTED == status()) ? AP_BSSID : nullptr;
+}
+
+int32_t ESP8266WiFiClass::channel()
+{
+    return (WL_CONNECTED == status()) ? m_apChannel : 0;
+}
+
+int32_t ESP8266WiFiClass::RSSI()
+{
+    return (WL_CONNECTED == status()) ? AP_RSSI : 0;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/** WiFi */
+ESP8266WiFiClass WiFi;
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
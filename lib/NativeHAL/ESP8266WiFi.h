@@ -0,0 +1,314 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  WiFi emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef ESP8266_WIFI_H_
+#define ESP8266_WIFI_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** WiFi operation modes, same values as the device. */
+typedef enum
+{
+    WIFI_OFF    = 0,    /**< WiFi off */
+    WIFI_STA    = 1,    /**< Station */
+    WIFI_AP     = 2,    /**< Access point */
+    WIFI_AP_STA = 3     /**< Access point and station */
+
+} WiFiMode_t;
+
+/** WiFi station status, same values as the device. */
+typedef enum
+{
+    WL_IDLE_STATUS      = 0,    /**< Idle */
+    WL_NO_SSID_AVAIL    = 1,    /**< SSID not available */
+    WL_SCAN_COMPLETED   = 2,    /**< Scan completed */
+    WL_CONNECTED        = 3,    /**< Connected */
+    WL_CONNECT_FAILED   = 4,    /**< Connect failed */
+    WL_CONNECTION_LOST  = 5,    /**< Connection lost */
+    WL_WRONG_PASSWORD   = 6,    /**< Wrong password */
+    WL_DISCONNECTED     = 7     /**< Disconnected */
+
+} wl_status_t;
+
+/**
+ *  WiFi emulation. There is exactly one emulated access point in range,
+ *  every station connect with non-empty credentials succeeds after a
+ *  connect time, which is shorter if the channel and BSSID of the access
+ *  point are given, like on the device. A connect with a channel or BSSID,
+ *  which doesn't match, never succeeds. All addresses are the loopback
+ *  address, because the sockets are bound to the host.
+ *
+ *  The tests move the access point out of range or to another channel, to
+ *  run the failure paths of the connection state machine.
+ */
+class ESP8266WiFiClass
+{
+public:
+
+    /** Station connect time with scan and DHCP in ms. */
+    static const uint32_t   CONNECT_TIME_MS         = 2500U;
+
+    /** Station connect time with known channel and BSSID in ms. */
+    static const uint32_t   FAST_CONNECT_TIME_MS    = 300U;
+
+    /** Channel of the emulated access point, until it is moved. */
+    static const int32_t    AP_CHANNEL              = 6;
+
+    /**
+     *  Constructs the WiFi.
+     */
+    ESP8266WiFiClass() :
+        m_mode(WIFI_OFF),
+        m_isConnecting(false),
+        m_connectTimestamp(0U),
+        m_connectTime(0U),
+        m_staticIP(0U),
+        m_isApInRange(true),
+        m_apChannel(AP_CHANNEL),
+        m_isApMatching(true)
+    {
+    }
+
+    /**
+     *  Destroys the WiFi.
+     */
+    ~ESP8266WiFiClass()
+    {
+    }
+
+    /**
+     *  Store the configuration in flash. It is ignored.
+     *
+     *  @param[in] persistent   Store (true) or not (false).
+     */
+    void persistent(bool persistent)
+    {
+        (void)persistent;
+    }
+
+    /**
+     *  Set the operation mode.
+     *
+     *  @param[in] mode Operation mode
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool mode(WiFiMode_t mode);
+
+    /**
+     *  Get the operation mode.
+     *
+     *  @return Operation mode
+     */
+    WiFiMode_t getMode() const
+    {
+        return m_mode;
+    }
+
+    /**
+     *  Start to connect as station.
+     *
+     *  @param[in] ssid         SSID
+     *  @param[in] passphrase   Passphrase
+     *  @param[in] channel      Channel. 0 means unknown.
+     *  @param[in] bssid        BSSID. nullptr means unknown.
+     *  @param[in] connect      Connect (true) or only configure (false).
+     *  @return Status
+     */
+    wl_status_t begin(const String& ssid, const String& passphrase, int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true);
+
+    /**
+     *  Configure a static IP. All addresses 0 enable DHCP.
+     *
+     *  @param[in] localIP  Local IP address
+     *  @param[in] gateway  Gateway IP address
+     *  @param[in] subnet   Subnet mask
+     *  @param[in] dns1     Primary DNS server
+     *  @param[in] dns2     Secondary DNS server
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool config(const IPAddress& localIP, const IPAddress& gateway, const IPAddress& subnet, const IPAddress& dns1 = IPAddress(), const IPAddress& dns2 = IPAddress());
+
+    /**
+     *  Get the station status.
+     *
+     *  @return Status
+     */
+    wl_status_t status();
+
+    /**
+     *  Disconnect the station.
+     *
+     *  @param[in] wifiOff  Switch station mode off (true) or not (false).
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool disconnect(bool wifiOff = false);
+
+    /**
+     *  Start the access point.
+     *
+     *  @param[in] ssid         SSID
+     *  @param[in] passphrase   Passphrase
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool softAP(const String& ssid, const String& passphrase);
+
+    /**
+     *  Get the IP address of the access point.
+     *
+     *  @return IP address
+     */
+    IPAddress softAPIP() const;
+
+    /**
+     *  Get the IP address of the station.
+     *
+     *  @return IP address
+     */
+    IPAddress localIP();
+
+    /**
+     *  Get the gateway IP address of the station.
+     *
+     *  @return IP address
+     */
+    IPAddress gatewayIP();
+
+    /**
+     *  Get the subnet mask of the station.
+     *
+     *  @return Subnet mask
+     */
+    IPAddress subnetMask();
+
+    /**
+     *  Get the DNS server IP address of the station.
+     *
+     *  @param[in] index    DNS server index.
+     *  @return IP address
+     */
+    IPAddress dnsIP(uint8_t index = 0U);
+
+    /**
+     *  Get the BSSID of the connected access point.
+     *
+     *  @return BSSID. If not connected, nullptr is returned.
+     */
+    const uint8_t* BSSID();
+
+    /**
+     *  Get the channel of the connected access point.
+     *
+     *  @return Channel
+     */
+    int32_t channel();
+
+    /**
+     *  Get the signal strength.
+     *
+     *  @return RSSI in dBm.
+     */
+    int32_t RSSI();
+
+    /**
+     *  Move the emulated access point in or out of range. Out of range, a
+     *  connected station loses its connection and a connecting one doesn't
+     *  find the SSID. Emulation only.
+     *
+     *  @param[in] isInRange    In range (true) or not (false).
+     */
+    void setApInRange(bool isInRange)
+    {
+        m_isApInRange = isInRange;
+    }
+
+    /**
+     *  Move the emulated access point to another channel, like after a
+     *  restart of a router with automatic channel selection. Emulation only.
+     *
+     *  @param[in] channel  Channel
+     */
+    void setApChannel(int32_t channel)
+    {
+        m_apChannel = channel;
+    }
+
+private:
+
+    /** Operation mode */
+    WiFiMode_t  m_mode;
+
+    /** Is the station connecting or connected? */
+    bool        m_isConnecting;
+
+    /** Timestamp of the connect start in ms. */
+    uint32_t    m_connectTimestamp;
+
+    /** Duration of the current connect in ms. */
+    uint32_t    m_connectTime;
+
+    /** Static IP address, 0 if DHCP is used. */
+    uint32_t    m_staticIP;
+
+    /** Is the access point in range? */
+    bool        m_isApInRange;
+
+    /** Channel of the access point. */
+    int32_t     m_apChannel;
+
+    /** Does the channel and BSSID of the current connect match the access point? */
+    bool        m_isApMatching;
+
+    /* Not allowed. */
+    ESP8266WiFiClass(const ESP8266WiFiClass& wifi);
+    ESP8266WiFiClass& operator=(const ESP8266WiFiClass& wifi);
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** WiFi */
+extern ESP8266WiFiClass WiFi;
+
+#endif /* ESP8266_WIFI_H_ */
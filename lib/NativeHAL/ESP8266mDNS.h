@@ -0,0 +1,104 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  mDNS responder stub for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef ESP8266_MDNS_H_
+#define ESP8266_MDNS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  mDNS responder. The host is reached via localhost, therefore nothing is
+ *  announced.
+ */
+class MDNSResponder
+{
+public:
+
+    /**
+     *  Start the responder.
+     *
+     *  @param[in] hostname Hostname
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool begin(const String& hostname)
+    {
+        (void)hostname;
+
+        return true;
+    }
+
+    /**
+     *  Process the responder.
+     *
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool update()
+    {
+        return true;
+    }
+
+    /**
+     *  Announce a service.
+     *
+     *  @param[in] service  Service name
+     *  @param[in] protocol Protocol, e.g. "tcp".
+     *  @param[in] port     Port
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool addService(const String& service, const String& protocol, uint16_t port)
+    {
+        (void)service;
+        (void)protocol;
+        (void)port;
+
+        return true;
+    }
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** mDNS responder */
+extern MDNSResponder MDNS;
+
+#endif /* ESP8266_MDNS_H_ */
@@ -0,0 +1,178 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  ESP8266 system functions for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Esp.h"
+#include "NativeHAL.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t getUsedHeap();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Free heap of the device after boot in byte. */
+static const uint32_t   FREE_HEAP       = 40000U;
+
+/** Largest free heap block of the device after boot in byte. */
+static const uint32_t   MAX_FREE_BLOCK  = 32000U;
+
+/** CPU frequency in MHz. */
+static const uint32_t   CPU_FREQ_MHZ    = 80U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void EspClass::restart()
+{
+    NativeHAL::restart();
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return FREE_HEAP - getUsedHeap();
+}
+
+uint32_t EspClass::getMaxFreeBlockSize()
+{
+    uint32_t used = getUsedHeap();
+
+    return (MAX_FREE_BLOCK > used) ? (MAX_FREE_BLOCK - used) : 0U;
+}
+
+uint8_t EspClass::getHeapFragmentation()
+{
+    uint8_t frag = 0U;
+
+    getHeapStats(nullptr, nullptr, &frag);
+
+    return frag;
+}
+
+void EspClass::getHeapStats(uint32_t* free, uint32_t* max, uint8_t* frag)
+{
+    uint32_t freeHeap   = getFreeHeap();
+    uint32_t maxBlock   = getMaxFreeBlockSize();
+
+    if (nullptr != free)
+    {
+        *free = freeHeap;
+    }
+
+    if (nullptr != max)
+    {
+        *max = maxBlock;
+    }
+
+    if (nullptr != frag)
+    {
+        /* Without free heap, nothing is fragmented. */
+        *frag = (0U == freeHeap) ? 0U : static_cast<uint8_t>(100U - ((maxBlock * 100U) / freeHeap));
+    }
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    return static_cast<uint32_t>(NativeHAL::getTime() * CPU_FREQ_MHZ);
+}
+
+uint32_t EspClass::getChipId()
+{
+    return 0x00C0FFEEU;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size)
+{
+    return NativeHAL::readRtcMemory(offset, data, size);
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size)
+{
+    return NativeHAL::writeRtcMemory(offset, data, size);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/** ESP8266 system functions. */
+EspClass ESP;
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the heap, which the firmware allocated since the HAL began.
+ *
+ * @return Used heap in byte, at most the free heap after boot.
+ */
+static uint32_t getUsedHeap()
+{
+    NativeHAL::HeapUsage    usage;
+    size_t                  used    = 0U;
+
+    NativeHAL::getHeapUsage(usage);
+
+    if (usage.liveBytes > usage.bootBytes)
+    {
+        used = usage.liveBytes - usage.bootBytes;
+    }
+
+    return (FREE_HEAP < used) ? FREE_HEAP : static_cast<uint32_t>(used);
+}
@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  ESP8266 system functions for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef ESP_H_
+#define ESP_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  ESP8266 system functions. The heap is a model of the device heap: the
+ *  free heap after boot minus the bytes the firmware allocated since then,
+ *  counted by the allocator of the HAL. The largest free block shrinks
+ *  the same way, therefore the fragmentation rises with the heap usage.
+ *  Without the counting allocator the values after boot are provided.
+ */
+class EspClass
+{
+public:
+
+    /**
+     *  Restart the system, which restarts the process.
+     */
+    void restart();
+
+    /**
+     *  Get the free heap.
+     *
+     *  @return Free heap in byte.
+     */
+    uint32_t getFreeHeap();
+
+    /**
+     *  Get the largest free heap block.
+     *
+     *  @return Block size in byte.
+     */
+    uint32_t getMaxFreeBlockSize();
+
+    /**
+     *  Get the heap fragmentation.
+     *
+     *  @return Fragmentation in percent.
+     */
+    uint8_t getHeapFragmentation();
+
+    /**
+     *  Get the free heap, the largest free block and the fragmentation at once.
+     *
+     *  @param[out] free    Free heap in byte. Use nullptr if not required.
+     *  @param[out] max     Largest free block in byte. Use nullptr if not required.
+     *  @param[out] frag    Fragmentation in percent. Use nullptr if not required.
+     */
+    void getHeapStats(uint32_t* free, uint32_t* max, uint8_t* frag);
+
+    /**
+     *  Get the CPU cycle counter, which runs with 80 MHz.
+     *
+     *  @return Cycle counter
+     */
+    uint32_t getCycleCount();
+
+    /**
+     *  Get the chip id.
+     *
+     *  @return Chip id
+     */
+    uint32_t getChipId();
+
+    /**
+     *  Read from the RTC user memory, which survives a restart.
+     *
+     *  @param[in]  offset  Offset in 32-bit blocks.
+     *  @param[out] data    Buffer
+     *  @param[in]  size    Number of bytes to read.
+     *
+     *  @return If the range is valid, returns true. Otherwise, false.
+     */
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+
+    /**
+     *  Write to the RTC user memory, which survives a restart.
+     *
+     *  @param[in] offset   Offset in 32-bit blocks.
+     *  @param[in] data     Data
+     *  @param[in] size     Number of bytes to write.
+     *
+     *  @return If the range is valid, returns true. Otherwise, false.
+     */
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** ESP8266 system functions. */
+extern EspClass ESP;
+
+#endif /* ESP_H_ */
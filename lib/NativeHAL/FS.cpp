@@ -0,0 +1,239 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Directory backed filesystem emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FS.h"
+#include "LittleFS.h"
+#include "NativeHAL.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void closeFile(FILE* file);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+fs::File::File(FILE* file, const String& name) :
+    Print(),
+    m_file(file, closeFile),
+    m_name(name)
+{
+}
+
+size_t fs::File::write(uint8_t data)
+{
+    return write(&data, 1U);
+}
+
+size_t fs::File::write(const uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+
+    if (nullptr != m_file)
+    {
+        count = fwrite(buffer, 1U, size, m_file.get());
+    }
+
+    return count;
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+
+    if (nullptr != m_file)
+    {
+        count = fread(buffer, 1U, size, m_file.get());
+    }
+
+    return count;
+}
+
+int fs::File::available()
+{
+    int count = 0;
+
+    if (nullptr != m_file)
+    {
+        long position = ftell(m_file.get());
+
+        count = static_cast<int>(static_cast<long>(size()) - position);
+    }
+
+    return count;
+}
+
+size_t fs::File::size()
+{
+    size_t      fileSize = 0U;
+    struct stat info;
+
+    if ((nullptr != m_file) &&
+        (0 == fstat(fileno(m_file.get()), &info)))
+    {
+        fileSize = static_cast<size_t>(info.st_size);
+    }
+
+    return fileSize;
+}
+
+bool fs::FS::begin()
+{
+    struct stat info;
+
+    m_isMounted = (0 == stat(NativeHAL::getFsRoot(), &info)) && (0 != S_ISDIR(info.st_mode));
+
+    return m_isMounted;
+}
+
+bool fs::FS::exists(const String& path)
+{
+    bool    isExisting  = false;
+    String  hostPath    = getHostPath(path);
+
+    if (false == hostPath.isEmpty())
+    {
+        struct stat info;
+
+        isExisting = (0 == stat(hostPath.c_str(), &info));
+    }
+
+    return isExisting;
+}
+
+fs::File fs::FS::open(const String& path, const char* mode)
+{
+    File    file;
+    String  hostPath    = getHostPath(path);
+
+    if (false == hostPath.isEmpty())
+    {
+        struct stat info;
+
+        /* Directories can't be read like files. */
+        if ((0 != stat(hostPath.c_str(), &info)) ||
+            (0 == S_ISDIR(info.st_mode)))
+        {
+            FILE* hostFile = fopen(hostPath.c_str(), mode);
+
+            if (nullptr != hostFile)
+            {
+                file = File(hostFile, path);
+            }
+        }
+    }
+
+    return file;
+}
+
+bool fs::FS::remove(const String& path)
+{
+    bool    isSuccess   = false;
+    String  hostPath    = getHostPath(path);
+
+    if (false == hostPath.isEmpty())
+    {
+        isSuccess = (0 == unlink(hostPath.c_str()));
+    }
+
+    return isSuccess;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+String fs::FS::getHostPath(const String& path) const
+{
+    String hostPath;
+
+    /* Paths outside of the backing directory are rejected. */
+    if ((true == m_isMounted) &&
+        (true == path.startsWith("/")) &&
+        (0 > path.indexOf("..")))
+    {
+        hostPath = NativeHAL::getFsRoot();
+        hostPath += path;
+    }
+
+    return hostPath;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/** LittleFS */
+fs::FS LittleFS;
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Close a host file, used as deleter of the shared file.
+ *
+ * @param[in] file  Host file
+ */
+static void closeFile(FILE* file)
+{
+    if (nullptr != file)
+    {
+        (void)fclose(file);
+    }
+}
@@ -0,0 +1,280 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Directory backed filesystem emulation for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef FS_H_
+#define FS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <memory>
+#include "Print.h"
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+namespace fs
+{
+
+/**
+ *  File of the filesystem. Copies refer to the same opened file, which is
+ *  closed with the last copy or by close().
+ */
+class File : public Print
+{
+public:
+
+    /**
+     *  Constructs a not opened file.
+     */
+    File() :
+        Print(),
+        m_file(),
+        m_name()
+    {
+    }
+
+    /**
+     *  Constructs a opened file.
+     *
+     *  @param[in] file Host file
+     *  @param[in] name File name in the filesystem.
+     */
+    File(FILE* file, const String& name);
+
+    /**
+     *  Constructs a copy of a file.
+     *
+     *  @param[in] file File
+     */
+    File(const File& file) :
+        Print(),
+        m_file(file.m_file),
+        m_name(file.m_name)
+    {
+    }
+
+    /**
+     *  Destroys the file.
+     */
+    ~File()
+    {
+    }
+
+    /**
+     *  Assign a file.
+     *
+     *  @param[in] file File
+     *  @return This file
+     */
+    File& operator=(const File& file)
+    {
+        if (this != &file)
+        {
+            m_file = file.m_file;
+            m_name = file.m_name;
+        }
+
+        return *this;
+    }
+
+    /**
+     *  Is the file opened?
+     *
+     *  @return If opened, returns true. Otherwise, false.
+     */
+    operator bool() const
+    {
+        return nullptr != m_file;
+    }
+
+    /**
+     *  Write a single byte.
+     *
+     *  @param[in] data Byte
+     *  @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     *  Write a block of bytes.
+     *
+     *  @param[in] buffer   Bytes
+     *  @param[in] size     Number of bytes.
+     *  @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    /**
+     *  Read a block of bytes.
+     *
+     *  @param[out] buffer  Buffer
+     *  @param[in]  size    Buffer size in byte.
+     *  @return Number of read bytes.
+     */
+    size_t read(uint8_t* buffer, size_t size);
+
+    /**
+     *  Get the number of bytes, which can be read.
+     *
+     *  @return Number of bytes.
+     */
+    int available();
+
+    /**
+     *  Get the file size.
+     *
+     *  @return Size in byte.
+     */
+    size_t size();
+
+    /**
+     *  Get the file name.
+     *
+     *  @return File name
+     */
+    const char* name() const
+    {
+        return m_name.c_str();
+    }
+
+    /**
+     *  Close the file.
+     */
+    void close()
+    {
+        m_file.reset();
+    }
+
+private:
+
+    /** Host file */
+    std::shared_ptr<FILE>   m_file;
+
+    /** File name in the filesystem. */
+    String                  m_name;
+};
+
+/**
+ *  Filesystem, which is backed by a host directory.
+ */
+class FS
+{
+public:
+
+    /**
+     *  Constructs the filesystem.
+     */
+    FS() :
+        m_isMounted(false)
+    {
+    }
+
+    /**
+     *  Destroys the filesystem.
+     */
+    ~FS()
+    {
+    }
+
+    /**
+     *  Mount the filesystem.
+     *
+     *  @return If the backing directory exists, returns true. Otherwise, false.
+     */
+    bool begin();
+
+    /**
+     *  Unmount the filesystem.
+     */
+    void end()
+    {
+        m_isMounted = false;
+    }
+
+    /**
+     *  Does the file exist?
+     *
+     *  @param[in] path Absolute path in the filesystem.
+     *  @return If the file exists, returns true. Otherwise, false.
+     */
+    bool exists(const String& path);
+
+    /**
+     *  Open a file.
+     *
+     *  @param[in] path Absolute path in the filesystem.
+     *  @param[in] mode Mode like fopen(), e.g. "r" or "w".
+     *  @return File, which is not opened on failure.
+     */
+    File open(const String& path, const char* mode);
+
+    /**
+     *  Remove a file.
+     *
+     *  @param[in] path Absolute path in the filesystem.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool remove(const String& path);
+
+private:
+
+    /** Is the filesystem mounted? */
+    bool m_isMounted;
+
+    /**
+     *  Get the host path.
+     *
+     *  @param[in] path Absolute path in the filesystem.
+     *  @return Host path. It is empty, if the path is invalid.
+     */
+    String getHostPath(const String& path) const;
+
+    /* Not allowed. */
+    FS(const FS& fs);
+    FS& operator=(const FS& fs);
+};
+
+};
+
+using fs::FS;
+using fs::File;
+
+#endif /* FS_H_ */
@@ -0,0 +1,125 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino serial interface for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef HARDWARE_SERIAL_H_
+#define HARDWARE_SERIAL_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Print.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Serial interface, which writes to the standard output of the process.
+ */
+class HardwareSerial : public Print
+{
+public:
+
+    /**
+     *  Constructs the serial interface.
+     */
+    HardwareSerial()
+    {
+    }
+
+    /**
+     *  Destroys the serial interface.
+     */
+    ~HardwareSerial()
+    {
+    }
+
+    /**
+     *  Start the serial interface. The baudrate is ignored.
+     *
+     *  @param[in] baudrate Baudrate
+     */
+    void begin(unsigned long baudrate)
+    {
+        (void)baudrate;
+    }
+
+    /**
+     *  Write a single byte.
+     *
+     *  @param[in] data Byte
+     *  @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     *  Write a block of bytes.
+     *
+     *  @param[in] buffer   Bytes
+     *  @param[in] size     Number of bytes.
+     *  @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    /**
+     *  Get the number of bytes, which can be written without blocking.
+     *  It reports the free space of the UART FIFO on the device.
+     *
+     *  @return Number of bytes.
+     */
+    int availableForWrite() override;
+
+    /**
+     *  Wait until all data is written.
+     */
+    void flush() override;
+
+private:
+
+    /* Not allowed. */
+    HardwareSerial(const HardwareSerial& serial);
+    HardwareSerial& operator=(const HardwareSerial& serial);
+};
+
+/******************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/** Serial interface */
+extern HardwareSerial Serial;
+
+#endif /* HARDWARE_SERIAL_H_ */
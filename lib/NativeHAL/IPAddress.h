@@ -0,0 +1,149 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  IPv4 address for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef IP_ADDRESS_H_
+#define IP_ADDRESS_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  IPv4 address. Like on the device, the 32-bit value is in network byte
+ *  order, which means the first octet is the least significant byte on a
+ *  little endian host.
+ */
+class IPAddress
+{
+public:
+
+    /**
+     *  Constructs the address 0.0.0.0.
+     */
+    IPAddress() :
+        m_address(0U)
+    {
+    }
+
+    /**
+     *  Constructs a address from its 32-bit value.
+     *
+     *  @param[in] address  Address in network byte order.
+     */
+    IPAddress(uint32_t address) :
+        m_address(address)
+    {
+    }
+
+    /**
+     *  Constructs a address from its octets.
+     *
+     *  @param[in] first    First octet
+     *  @param[in] second   Second octet
+     *  @param[in] third    Third octet
+     *  @param[in] fourth   Fourth octet
+     */
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) :
+        m_address(static_cast<uint32_t>(first) |
+                  (static_cast<uint32_t>(second) << 8U) |
+                  (static_cast<uint32_t>(third) << 16U) |
+                  (static_cast<uint32_t>(fourth) << 24U))
+    {
+    }
+
+    /**
+     *  Get the 32-bit value.
+     *
+     *  @return Address in network byte order.
+     */
+    operator uint32_t() const
+    {
+        return m_address;
+    }
+
+    /**
+     *  Get a octet.
+     *
+     *  @param[in] index    Index, 0 is the first octet.
+     *  @return Octet
+     */
+    uint8_t operator[](int index) const
+    {
+        return static_cast<uint8_t>(m_address >> (8 * (index & 3)));
+    }
+
+    /**
+     *  Is the address set?
+     *
+     *  @return If set, returns true. Otherwise, false.
+     */
+    bool isSet() const
+    {
+        return 0U != m_address;
+    }
+
+    /**
+     *  Get the address in dot-decimal notation.
+     *
+     *  @return Address
+     */
+    String toString() const
+    {
+        String result;
+
+        result += (*this)[0];
+        result += '.';
+        result += (*this)[1];
+        result += '.';
+        result += (*this)[2];
+        result += '.';
+        result += (*this)[3];
+
+        return result;
+    }
+
+private:
+
+    /** Address in network byte order. */
+    uint32_t m_address;
+};
+
+#endif /* IP_ADDRESS_H_ */
@@ -0,0 +1,707 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native hardware abstraction, which runs the firmware as Linux process
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "NativeHAL.h"
+#include <Arduino.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/* The address sanitizer replaces the allocator itself. */
+#if defined(__SANITIZE_ADDRESS__)
+#define NATIVE_HAL_HEAP_COUNTING    0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define NATIVE_HAL_HEAP_COUNTING    0
+#endif
+#endif
+
+#ifndef NATIVE_HAL_HEAP_COUNTING
+#define NATIVE_HAL_HEAP_COUNTING    1
+#endif
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A single step of the sensor script. */
+typedef struct
+{
+    uint64_t    time;   /**< Time in us, when the level is set. */
+    uint8_t     pin;    /**< Pin number. */
+    int         level;  /**< Pin level. */
+
+} ScriptStep;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint64_t getHostTime();
+static void loadRtcMemory();
+static void saveRtcMemory();
+static void applySensorScript();
+static void onSignal(int signal);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Time in us, the process sleeps after every loop() call in real time. */
+static const uint32_t   REAL_TIME_IDLE_SLEEP    = 100U;
+
+/** Command line arguments, used for restart. */
+static char**           gArgv                   = nullptr;
+
+/** Is the process running? */
+static volatile bool    gIsRunning              = true;
+
+/** Is the virtual time enabled? */
+static bool             gIsVirtualTime          = false;
+
+/** Virtual time in us. */
+static uint64_t         gVirtualTime            = 0U;
+
+/** Host time in us, which corresponds to the time 0 in real time. */
+static uint64_t         gRealTimeBase           = 0U;
+
+/** Virtual time per loop() call in us. */
+static uint32_t         gLoopTime               = 100U;
+
+/** Time in us, after that the process stops. 0 means never. */
+static uint64_t         gDuration               = 0U;
+
+/** Levels of the digital pins. */
+static int              gPins[NativeHAL::PIN_COUNT];
+
+/** Sensor script. */
+static std::vector<ScriptStep>  gSensorScript;
+
+/** Index of the next sensor script step. */
+static size_t           gSensorScriptIdx        = 0U;
+
+/** File, which backs the EEPROM. */
+static const char*      gEepromFile             = "eeprom.bin";
+
+/** Directory, which backs LittleFS. */
+static const char*      gFsRoot                 = "data";
+
+/** Offset, which is added to all ports. */
+static uint16_t         gPortOffset             = 0U;
+
+/** File, which keeps the RTC memory during a restart. */
+static const char*      gRtcFile                = "rtc.bin";
+
+/** Environment variable, which marks a restart. Otherwise it is a power-on. */
+static const char*      WARM_START_ENV          = "NATIVE_HAL_WARM_START";
+
+/** RTC user memory */
+static uint8_t          gRtcMemory[NativeHAL::RTC_USER_MEMORY_SIZE];
+
+/** Heap usage, which is counted by the allocator. It is used before any constructor runs. */
+static NativeHAL::HeapUsage gHeapUsage;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+bool NativeHAL::begin(int argc, char** argv)
+{
+    bool        isSuccess   = true;
+    const char* sensorFile  = nullptr;
+    int         idx         = 0;
+
+    gArgv                   = argv;
+    gRealTimeBase           = getHostTime();
+    gHeapUsage.bootBytes    = gHeapUsage.liveBytes;
+
+    for (idx = 1; (idx < argc) && (true == isSuccess); ++idx)
+    {
+        String      option  = argv[idx];
+        const char* value   = ((idx + 1) < argc) ? argv[idx + 1] : nullptr;
+
+        if (option == "--virtual-time")
+        {
+            gIsVirtualTime = true;
+        }
+        else if (nullptr == value)
+        {
+            fprintf(stderr, "Missing value or unknown option: %s\n", option.c_str());
+            isSuccess = false;
+        }
+        else
+        {
+            if (option == "--eeprom")
+            {
+                gEepromFile = value;
+            }
+            else if (option == "--fs")
+            {
+                gFsRoot = value;
+            }
+            else if (option == "--port-offset")
+            {
+                gPortOffset = static_cast<uint16_t>(atoi(value));
+            }
+            else if (option == "--sensor")
+            {
+                sensorFile = value;
+            }
+            else if (option == "--loop-time")
+            {
+                gLoopTime = static_cast<uint32_t>(atol(value));
+            }
+            else if (option == "--duration")
+            {
+                gDuration = static_cast<uint64_t>(atoll(value)) * 1000U;
+            }
+            else if (option == "--rtc")
+            {
+                gRtcFile = value;
+            }
+            else
+            {
+                fprintf(stderr, "Unknown option: %s\n", option.c_str());
+                isSuccess = false;
+            }
+
+            ++idx;
+        }
+    }
+
+    if ((true == isSuccess) &&
+        (nullptr != sensorFile))
+    {
+        isSuccess = loadSensorScript(sensorFile);
+    }
+
+    loadRtcMemory();
+
+    (void)signal(SIGINT, onSignal);
+    (void)signal(SIGTERM, onSignal);
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    return isSuccess;
+}
+
+void NativeHAL::process()
+{
+    if (true == gIsVirtualTime)
+    {
+        gVirtualTime += gLoopTime;
+    }
+    else
+    {
+        (void)usleep(REAL_TIME_IDLE_SLEEP);
+    }
+
+    applySensorScript();
+
+    if ((0U < gDuration) &&
+        (gDuration <= getTime()))
+    {
+        stop();
+    }
+}
+
+bool NativeHAL::isRunning()
+{
+    return gIsRunning;
+}
+
+void NativeHAL::stop()
+{
+    gIsRunning = false;
+}
+
+void NativeHAL::restart()
+{
+    (void)fflush(stdout);
+
+    saveRtcMemory();
+
+    if (nullptr != gArgv)
+    {
+        (void)setenv(WARM_START_ENV, "1", 1);
+        (void)execv("/proc/self/exe", gArgv);
+    }
+
+    /* Only reached, if the restart failed. */
+    perror("Restart failed");
+    exit(EXIT_FAILURE);
+}
+
+void NativeHAL::setVirtualTime(bool isEnabled)
+{
+    if (isEnabled != gIsVirtualTime)
+    {
+        if (true == isEnabled)
+        {
+            gVirtualTime = getTime();
+        }
+        else
+        {
+            gRealTimeBase = getHostTime() - gVirtualTime;
+        }
+
+        gIsVirtualTime = isEnabled;
+    }
+}
+
+bool NativeHAL::isVirtualTime()
+{
+    return gIsVirtualTime;
+}
+
+void NativeHAL::setLoopTime(uint32_t loopTime)
+{
+    gLoopTime = loopTime;
+}
+
+void NativeHAL::advanceTime(uint64_t duration)
+{
+    if (true == gIsVirtualTime)
+    {
+        gVirtualTime += duration;
+    }
+}
+
+uint64_t NativeHAL::getTime()
+{
+    uint64_t time = gVirtualTime;
+
+    if (false == gIsVirtualTime)
+    {
+        time = getHostTime() - gRealTimeBase;
+    }
+
+    return time;
+}
+
+void NativeHAL::setPin(uint8_t pin, int level)
+{
+    if (PIN_COUNT > pin)
+    {
+        gPins[pin] = level;
+    }
+}
+
+int NativeHAL::getPin(uint8_t pin)
+{
+    int level = LOW;
+
+    if (PIN_COUNT > pin)
+    {
+        applySensorScript();
+        level = gPins[pin];
+    }
+
+    return level;
+}
+
+bool NativeHAL::loadSensorScript(const char* fileName)
+{
+    bool    isSuccess   = true;
+    FILE*   file        = fopen(fileName, "r");
+
+    if (nullptr == file)
+    {
+        perror(fileName);
+        isSuccess = false;
+    }
+    else
+    {
+        uint64_t    start       = getTime();
+        char        line[128];
+        size_t      lineNumber  = 0U;
+
+        gSensorScript.clear();
+        gSensorScriptIdx = 0U;
+
+        while ((true == isSuccess) && (nullptr != fgets(line, sizeof(line), file)))
+        {
+            unsigned long long  time    = 0U;
+            int                 level   = 0;
+            unsigned int        pin     = NativeHAL::SENSOR_PIN;
+            int                 fields  = 0;
+
+            ++lineNumber;
+
+            if (('#' == line[0]) || ('\n' == line[0]) || ('\r' == line[0]))
+            {
+                continue;
+            }
+
+            fields = sscanf(line, "%llu %d %u", &time, &level, &pin);
+
+            if ((2 > fields) || (PIN_COUNT <= pin))
+            {
+                fprintf(stderr, "%s:%zu: Invalid step.\n", fileName, lineNumber);
+                isSuccess = false;
+            }
+            else
+            {
+                ScriptStep step;
+
+                step.time   = start + (static_cast<uint64_t>(time) * 1000U);
+                step.pin    = static_cast<uint8_t>(pin);
+                step.level  = (0 == level) ? LOW : HIGH;
+
+                gSensorScript.push_back(step);
+            }
+        }
+
+        (void)fclose(file);
+    }
+
+    return isSuccess;
+}
+
+bool NativeHAL::readRtcMemory(uint32_t offset, uint32_t* data, size_t size)
+{
+    bool isValid = false;
+
+    if ((nullptr != data) &&
+        (0U < size) &&
+        (RTC_USER_MEMORY_SIZE >= ((offset * sizeof(uint32_t)) + size)))
+    {
+        memcpy(data, &gRtcMemory[offset * sizeof(uint32_t)], size);
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+bool NativeHAL::writeRtcMemory(uint32_t offset, const uint32_t* data, size_t size)
+{
+    bool isValid = false;
+
+    if ((nullptr != data) &&
+        (0U < size) &&
+        (RTC_USER_MEMORY_SIZE >= ((offset * sizeof(uint32_t)) + size)))
+    {
+        memcpy(&gRtcMemory[offset * sizeof(uint32_t)], data, size);
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+const char* NativeHAL::getEepromFile()
+{
+    return gEepromFile;
+}
+
+const char* NativeHAL::getFsRoot()
+{
+    return gFsRoot;
+}
+
+uint16_t NativeHAL::getHostPort(uint16_t port)
+{
+    return port + gPortOffset;
+}
+
+bool NativeHAL::isHeapCounted()
+{
+    return (0 != NATIVE_HAL_HEAP_COUNTING);
+}
+
+void NativeHAL::getHeapUsage(HeapUsage& usage)
+{
+    usage = gHeapUsage;
+}
+
+void NativeHAL::setHeapPeak(size_t peakBytes)
+{
+    gHeapUsage.peakBytes = (gHeapUsage.liveBytes > peakBytes) ? gHeapUsage.liveBytes : peakBytes;
+}
+
+unsigned long millis()
+{
+    /* The device counts with 32 bit, therefore it wraps around the same way. */
+    return static_cast<uint32_t>(NativeHAL::getTime() / 1000U);
+}
+
+unsigned long micros()
+{
+    return static_cast<uint32_t>(NativeHAL::getTime());
+}
+
+void delay(unsigned long ms)
+{
+    delayMicroseconds(ms * 1000U);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    if (true == NativeHAL::isVirtualTime())
+    {
+        NativeHAL::advanceTime(us);
+    }
+    else
+    {
+        (void)usleep(us);
+    }
+}
+
+void yield()
+{
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return NativeHAL::getPin(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    NativeHAL::setPin(pin, val);
+}
+
+#if (0 != NATIVE_HAL_HEAP_COUNTING)
+
+/**
+ * Allocate memory and count it. Every block starts with its size, which is
+ * padded to keep the alignment.
+ *
+ * @param[in] size  Size in byte.
+ *
+ * @return Memory
+ */
+void* operator new(size_t size)
+{
+    size_t* block = static_cast<size_t*>(malloc(sizeof(max_align_t) + size));
+
+    if (nullptr == block)
+    {
+        throw std::bad_alloc();
+    }
+
+    *block = size;
+
+    ++gHeapUsage.allocations;
+    ++gHeapUsage.liveBlocks;
+    gHeapUsage.liveBytes += size;
+
+    if (gHeapUsage.peakBytes < gHeapUsage.liveBytes)
+    {
+        gHeapUsage.peakBytes = gHeapUsage.liveBytes;
+    }
+
+    return reinterpret_cast<uint8_t*>(block) + sizeof(max_align_t);
+}
+
+/**
+ * Allocate memory for a array and count it.
+ *
+ * @param[in] size  Size in byte.
+ *
+ * @return Memory
+ */
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+/**
+ * Release memory, which was allocated by operator new.
+ *
+ * @param[in] ptr   Memory
+ */
+void operator delete(void* ptr) noexcept
+{
+    if (nullptr != ptr)
+    {
+        size_t* block = reinterpret_cast<size_t*>(static_cast<uint8_t*>(ptr) - sizeof(max_align_t));
+
+        ++gHeapUsage.frees;
+        --gHeapUsage.liveBlocks;
+        gHeapUsage.liveBytes -= *block;
+
+        free(block);
+    }
+}
+
+/**
+ * Release memory of a array, which was allocated by operator new[].
+ *
+ * @param[in] ptr   Memory
+ */
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+/**
+ * Release memory with known size, which was allocated by operator new.
+ *
+ * @param[in] ptr   Memory
+ * @param[in] size  Size in byte, not used because the block knows it.
+ */
+void operator delete(void* ptr, size_t size) noexcept
+{
+    (void)size;
+    operator delete(ptr);
+}
+
+/**
+ * Release memory of a array with known size, which was allocated by operator new[].
+ *
+ * @param[in] ptr   Memory
+ * @param[in] size  Size in byte, not used because the block knows it.
+ */
+void operator delete[](void* ptr, size_t size) noexcept
+{
+    (void)size;
+    operator delete(ptr);
+}
+
+#endif  /* (0 != NATIVE_HAL_HEAP_COUNTING) */
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the monotonic host time.
+ *
+ * @return Host time in us.
+ */
+static uint64_t getHostTime()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000U) + (static_cast<uint64_t>(now.tv_nsec) / 1000U);
+}
+
+/**
+ * Load the RTC memory after a restart. After a power-on its content is
+ * undefined, like on the device.
+ */
+static void loadRtcMemory()
+{
+    FILE* file = nullptr;
+
+    memset(gRtcMemory, 0xA5, sizeof(gRtcMemory));
+
+    if (nullptr != getenv(WARM_START_ENV))
+    {
+        (void)unsetenv(WARM_START_ENV);
+
+        file = fopen(gRtcFile, "rb");
+    }
+
+    if (nullptr != file)
+    {
+        (void)fread(gRtcMemory, 1U, sizeof(gRtcMemory), file);
+        (void)fclose(file);
+    }
+}
+
+/**
+ * Save the RTC memory before a restart.
+ */
+static void saveRtcMemory()
+{
+    FILE* file = fopen(gRtcFile, "wb");
+
+    if (nullptr == file)
+    {
+        perror(gRtcFile);
+    }
+    else
+    {
+        (void)fwrite(gRtcMemory, 1U, sizeof(gRtcMemory), file);
+        (void)fclose(file);
+    }
+}
+
+/**
+ * Apply all due steps of the sensor script.
+ */
+static void applySensorScript()
+{
+    uint64_t now = NativeHAL::getTime();
+
+    while ((gSensorScript.size() > gSensorScriptIdx) &&
+           (gSensorScript[gSensorScriptIdx].time <= now))
+    {
+        gPins[gSensorScript[gSensorScriptIdx].pin] = gSensorScript[gSensorScriptIdx].level;
+        ++gSensorScriptIdx;
+    }
+}
+
+/**
+ * Signal handler, which stops the process gracefully.
+ *
+ * @param[in] signal    Signal number.
+ */
+static void onSignal(int signal)
+{
+    (void)signal;
+
+    NativeHAL::stop();
+}
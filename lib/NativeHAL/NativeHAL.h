@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Native hardware abstraction, which runs the firmware as Linux process
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef NATIVE_HAL_H_
+#define NATIVE_HAL_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Native hardware abstraction.
+ *
+ *  It controls the emulated hardware: the clock, the digital pins and where
+ *  the persistent data is stored on the host. The clock runs either in real
+ *  time or in virtual time. In virtual time it only advances by delay(),
+ *  by advanceTime() and by a fixed step after every loop() call, therefore
+ *  a run is deterministic and independent of the host speed.
+ *
+ *  Command line options:
+ *  --eeprom <file>         File, which backs the EEPROM. Default: eeprom.bin
+ *  --fs <directory>        Directory, which backs LittleFS. Default: data
+ *  --port-offset <offset>  Offset added to all TCP/UDP ports, e.g. 8000 to
+ *                          run without root privileges. Default: 0
+ *  --sensor <file>         Sensor script, see loadSensorScript().
+ *  --virtual-time          Run in virtual time instead of real time.
+ *  --loop-time <us>        Virtual time per loop() call. Default: 100
+ *  --duration <ms>         Stop after the given time. Default: run forever.
+ *  --rtc <file>            File, which keeps the RTC memory during a restart.
+ *                          Default: rtc.bin
+ *
+ *  The RTC memory survives a restart() like on the device, but a new start
+ *  of the process is a power-on and clears it.
+ *
+ *  The global operator new and delete are replaced by a counting allocator,
+ *  which provides the heap usage of the firmware, see getHeapUsage(). With
+ *  the address sanitizer it is disabled, because the sanitizer replaces
+ *  them itself.
+ */
+namespace NativeHAL
+{
+
+/** Number of emulated digital pins. */
+static const uint8_t PIN_COUNT  = 17U;
+
+/** Heap usage, which is counted by the allocator. */
+typedef struct
+{
+    uint64_t    allocations;    /**< Number of allocations since the start of the process. */
+    uint64_t    frees;          /**< Number of releases since the start of the process. */
+    size_t      liveBlocks;     /**< Number of allocated blocks. */
+    size_t      liveBytes;      /**< Allocated bytes. */
+    size_t      peakBytes;      /**< Max. allocated bytes since the last setHeapPeak(). */
+    size_t      bootBytes;      /**< Allocated bytes, when the HAL began. They belong to the host. */
+
+} HeapUsage;
+
+/** Pin of the sensor, which is used by default in the sensor script. */
+static const uint8_t SENSOR_PIN = 5U;
+
+/** Size of the RTC user memory in byte. */
+static const uint16_t RTC_USER_MEMORY_SIZE = 512U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Initialize the HAL with the command line options.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool begin(int argc, char** argv);
+
+/**
+ * Process the HAL after every loop() call. In virtual time the clock
+ * advances by the loop time, in real time the process sleeps shortly to
+ * not burn a whole host core.
+ */
+void process();
+
+/**
+ * Is the process still running?
+ *
+ * @return If running, it will return true otherwise false.
+ */
+bool isRunning();
+
+/**
+ * Request to stop the process after the current loop() call.
+ */
+void stop();
+
+/**
+ * Restart the process, like the device restarts. It never returns.
+ */
+void restart();
+
+/**
+ * Enable or disable the virtual time. Switching keeps the current time.
+ *
+ * @param[in] isEnabled Virtual time (true) or real time (false).
+ */
+void setVirtualTime(bool isEnabled);
+
+/**
+ * Is the virtual time enabled?
+ *
+ * @return If virtual time is enabled, it will return true otherwise false.
+ */
+bool isVirtualTime();
+
+/**
+ * Set the virtual time per loop() call.
+ *
+ * @param[in] loopTime  Time in us.
+ */
+void setLoopTime(uint32_t loopTime);
+
+/**
+ * Advance the virtual time. In real time, nothing happens.
+ *
+ * @param[in] duration  Duration in us.
+ */
+void advanceTime(uint64_t duration);
+
+/**
+ * Get the time since start.
+ *
+ * @return Time in us.
+ */
+uint64_t getTime();
+
+/**
+ * Set the level of a digital input pin.
+ *
+ * @param[in] pin   Pin number.
+ * @param[in] level Level, LOW or HIGH.
+ */
+void setPin(uint8_t pin, int level);
+
+/**
+ * Get the level of a digital pin.
+ *
+ * @param[in] pin   Pin number.
+ *
+ * @return Level, LOW or HIGH.
+ */
+int getPin(uint8_t pin);
+
+/**
+ * Load a sensor script, which sets the pin levels at given times.
+ * Every line has the format "<time ms> <level> [<pin>]", the default pin
+ * is the sensor pin 5. Lines starting with '#' are comments. The times are
+ * relative to the time the script is loaded and must be ascending.
+ *
+ * @param[in] fileName  Name of the script file.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool loadSensorScript(const char* fileName);
+
+/**
+ * Read from the RTC user memory.
+ *
+ * @param[in]  offset    Offset in 32-bit blocks.
+ * @param[out] data      Buffer
+ * @param[in]  size      Number of bytes to read.
+ *
+ * @return If the range is valid, it will return true otherwise false.
+ */
+bool readRtcMemory(uint32_t offset, uint32_t* data, size_t size);
+
+/**
+ * Write to the RTC user memory.
+ *
+ * @param[in] offset    Offset in 32-bit blocks.
+ * @param[in] data      Data
+ * @param[in] size      Number of bytes to write.
+ *
+ * @return If the range is valid, it will return true otherwise false.
+ */
+bool writeRtcMemory(uint32_t offset, const uint32_t* data, size_t size);
+
+/**
+ * Get the file, which backs the EEPROM.
+ *
+ * @return File name
+ */
+const char* getEepromFile();
+
+/**
+ * Get the directory, which backs LittleFS.
+ *
+ * @return Directory
+ */
+const char* getFsRoot();
+
+/**
+ * Map a device port to the host port.
+ *
+ * @param[in] port  Device port.
+ *
+ * @return Host port
+ */
+uint16_t getHostPort(uint16_t port);
+
+/**
+ * Is the heap counted? Not if the address sanitizer replaces the allocator.
+ *
+ * @return If the heap is counted, it will return true otherwise false.
+ */
+bool isHeapCounted();
+
+/**
+ * Get the heap usage.
+ *
+ * @param[out] usage    Heap usage. All zero if the heap is not counted.
+ */
+void getHeapUsage(HeapUsage& usage);
+
+/**
+ * Set the peak of the allocated bytes, e.g. to measure the peak of a
+ * section. It is at least the number of allocated bytes, therefore 0
+ * restarts the measurement from now.
+ *
+ * @param[in] peakBytes Peak in byte.
+ */
+void setHeapPeak(size_t peakBytes);
+
+};
+
+#endif /* NATIVE_HAL_H_ */
@@ -0,0 +1,117 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Entry point of the firmware as Linux process
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <ESP8266mDNS.h>
+#include "NativeHAL.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/** mDNS responder */
+MDNSResponder MDNS;
+
+/* Unit tests and native tools, like the race simulator, provide their own main(). */
+#if !defined(UNIT_TEST) && !defined(NATIVE_NO_MAIN)
+
+/**
+ * Entry point, which runs setup() and loop() like the ESP8266 core.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments, see NativeHAL.
+ *
+ * @return Exit status
+ */
+int main(int argc, char** argv)
+{
+    int status = EXIT_SUCCESS;
+
+    if (false == NativeHAL::begin(argc, argv))
+    {
+        status = EXIT_FAILURE;
+    }
+    else
+    {
+        setup();
+
+        while (true == NativeHAL::isRunning())
+        {
+            loop();
+            NativeHAL::process();
+        }
+
+        Serial.flush();
+    }
+
+    return status;
+}
+
+#endif  /* !defined(UNIT_TEST) && !defined(NATIVE_NO_MAIN) */
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
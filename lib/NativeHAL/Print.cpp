@@ -0,0 +1,179 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Print for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Print.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+
+    while ((size > count) && (1U == write(buffer[count])))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+size_t Print::write(const char* str)
+{
+    size_t count = 0U;
+
+    if (nullptr != str)
+    {
+        count = write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+    }
+
+    return count;
+}
+
+size_t Print::printf(const char* format, ...)
+{
+    va_list args;
+    char    buffer[256];
+    int     length  = 0;
+    size_t  count   = 0U;
+
+    va_start(args, format);
+    length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (static_cast<int>(sizeof(buffer)) > length)
+    {
+        count = write(reinterpret_cast<const uint8_t*>(buffer), length);
+    }
+    else if (0 < length)
+    {
+        /* Too long for the stack buffer, use the heap like the core does. */
+        char* heapBuffer = new char[length + 1];
+
+        va_start(args, format);
+        (void)vsnprintf(heapBuffer, length + 1, format, args);
+        va_end(args);
+
+        count = write(reinterpret_cast<const uint8_t*>(heapBuffer), length);
+
+        delete[] heapBuffer;
+    }
+
+    return count;
+}
+
+size_t Print::print(const String& value)
+{
+    return write(reinterpret_cast<const uint8_t*>(value.c_str()), value.length());
+}
+
+size_t Print::print(const char* value)
+{
+    return write(value);
+}
+
+size_t Print::print(char value)
+{
+    return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(int value)
+{
+    return print(String(value));
+}
+
+size_t Print::print(unsigned int value)
+{
+    return print(String(value));
+}
+
+size_t Print::print(long value)
+{
+    return print(String(value));
+}
+
+size_t Print::print(unsigned long value)
+{
+    return print(String(value));
+}
+
+size_t Print::print(double value)
+{
+    return print(String(value));
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
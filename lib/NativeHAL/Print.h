@@ -0,0 +1,178 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino Print for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef PRINT_H_
+#define PRINT_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "WString.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Base class of all character outputs.
+ */
+class Print
+{
+public:
+
+    /**
+     *  Constructs the output.
+     */
+    Print()
+    {
+    }
+
+    /**
+     *  Destroys the output.
+     */
+    virtual ~Print()
+    {
+    }
+
+    /**
+     *  Write a single byte.
+     *
+     *  @param[in] data Byte
+     *  @return Number of written bytes.
+     */
+    virtual size_t write(uint8_t data) = 0;
+
+    /**
+     *  Write a block of bytes.
+     *
+     *  @param[in] buffer   Bytes
+     *  @param[in] size     Number of bytes.
+     *  @return Number of written bytes.
+     */
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    /**
+     *  Write a C string.
+     *
+     *  @param[in] str  C string
+     *  @return Number of written bytes.
+     */
+    size_t write(const char* str);
+
+    /**
+     *  Get the number of bytes, which can be written without blocking.
+     *
+     *  @return Number of bytes.
+     */
+    virtual int availableForWrite()
+    {
+        return 0;
+    }
+
+    /**
+     *  Wait until all data is written.
+     */
+    virtual void flush()
+    {
+    }
+
+    /**
+     *  Print formatted.
+     *
+     *  @param[in] format   Format, like printf().
+     *  @return Number of written bytes.
+     */
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     *  Print a value.
+     *
+     *  @param[in] value    Value
+     *  @return Number of written bytes.
+     */
+    size_t print(const String& value);
+
+    /** @copydoc print(const String&) */
+    size_t print(const char* value);
+
+    /** @copydoc print(const String&) */
+    size_t print(char value);
+
+    /** @copydoc print(const String&) */
+    size_t print(int value);
+
+    /** @copydoc print(const String&) */
+    size_t print(unsigned int value);
+
+    /** @copydoc print(const String&) */
+    size_t print(long value);
+
+    /** @copydoc print(const String&) */
+    size_t print(unsigned long value);
+
+    /** @copydoc print(const String&) */
+    size_t print(double value);
+
+    /**
+     *  Print a line break.
+     *
+     *  @return Number of written bytes.
+     */
+    size_t println();
+
+    /**
+     *  Print a value, followed by a line break.
+     *
+     *  @param[in] value    Value
+     *  @return Number of written bytes.
+     */
+    template < typename T >
+    size_t println(const T& value)
+    {
+        size_t count = print(value);
+
+        return count + println();
+    }
+
+private:
+
+    /* Not allowed. */
+    Print(const Print& print);
+    Print& operator=(const Print& print);
+};
+
+#endif /* PRINT_H_ */
@@ -0,0 +1,542 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino String for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WString.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static std::string toString(unsigned long long value, unsigned char base, bool isNegative);
+static std::string toString(double value, unsigned char decimalPlaces);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+String::String(const char* cstr) :
+    m_buffer((nullptr == cstr) ? "" : cstr)
+{
+}
+
+String::String(const char* cstr, unsigned int length) :
+    m_buffer((nullptr == cstr) ? "" : std::string(cstr, length))
+{
+}
+
+String::String(char c) :
+    m_buffer(1U, c)
+{
+}
+
+String::String(unsigned char value, unsigned char base) :
+    m_buffer(toString(value, base, false))
+{
+}
+
+String::String(int value, unsigned char base) :
+    m_buffer(String(static_cast<long long>(value), base).c_str())
+{
+}
+
+String::String(unsigned int value, unsigned char base) :
+    m_buffer(toString(value, base, false))
+{
+}
+
+String::String(long value, unsigned char base) :
+    m_buffer(String(static_cast<long long>(value), base).c_str())
+{
+}
+
+String::String(unsigned long value, unsigned char base) :
+    m_buffer(toString(value, base, false))
+{
+}
+
+String::String(long long value, unsigned char base) :
+    m_buffer()
+{
+    /* Like the core, only decimal numbers are signed. */
+    if ((10U == base) && (0 > value))
+    {
+        m_buffer = toString(0ULL - static_cast<unsigned long long>(value), base, true);
+    }
+    else
+    {
+        m_buffer = toString(static_cast<unsigned long long>(value), base, false);
+    }
+}
+
+String::String(unsigned long long value, unsigned char base) :
+    m_buffer(toString(value, base, false))
+{
+}
+
+String::String(float value, unsigned char decimalPlaces) :
+    m_buffer(toString(value, decimalPlaces))
+{
+}
+
+String::String(double value, unsigned char decimalPlaces) :
+    m_buffer(toString(value, decimalPlaces))
+{
+}
+
+bool String::reserve(unsigned int size)
+{
+    m_buffer.reserve(size);
+
+    return true;
+}
+
+bool String::concat(const char* cstr, unsigned int length)
+{
+    bool isSuccess = false;
+
+    if (nullptr != cstr)
+    {
+        m_buffer.append(cstr, length);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+bool String::concat(const String& value)
+{
+    m_buffer.append(value.m_buffer);
+
+    return true;
+}
+
+bool String::concat(const char* value)
+{
+    bool isSuccess = false;
+
+    if (nullptr != value)
+    {
+        m_buffer.append(value);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+bool String::concat(char value)
+{
+    m_buffer.push_back(value);
+
+    return true;
+}
+
+bool String::concat(unsigned char value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(int value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(unsigned int value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(long value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(unsigned long value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(long long value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(unsigned long long value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(float value)
+{
+    return concat(String(value));
+}
+
+bool String::concat(double value)
+{
+    return concat(String(value));
+}
+
+int String::compareTo(const String& str) const
+{
+    return strcmp(c_str(), str.c_str());
+}
+
+bool String::equals(const String& str) const
+{
+    return m_buffer == str.m_buffer;
+}
+
+bool String::equals(const char* str) const
+{
+    return 0 == strcmp(c_str(), (nullptr == str) ? "" : str);
+}
+
+bool String::equalsIgnoreCase(const String& str) const
+{
+    return (length() == str.length()) && (0 == strcasecmp(c_str(), str.c_str()));
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const
+{
+    bool isStarting = false;
+
+    if ((offset <= length()) &&
+        (prefix.length() <= (length() - offset)))
+    {
+        isStarting = (0 == m_buffer.compare(offset, prefix.length(), prefix.m_buffer));
+    }
+
+    return isStarting;
+}
+
+bool String::endsWith(const String& suffix) const
+{
+    bool isEnding = false;
+
+    if (suffix.length() <= length())
+    {
+        isEnding = (0 == m_buffer.compare(length() - suffix.length(), suffix.length(), suffix.m_buffer));
+    }
+
+    return isEnding;
+}
+
+char String::charAt(unsigned int index) const
+{
+    char c = '\0';
+
+    if (length() > index)
+    {
+        c = m_buffer[index];
+    }
+
+    return c;
+}
+
+void String::setCharAt(unsigned int index, char c)
+{
+    if (length() > index)
+    {
+        m_buffer[index] = c;
+    }
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const
+{
+    if ((nullptr != buf) && (0U < bufsize))
+    {
+        unsigned int count = 0U;
+
+        if (length() > index)
+        {
+            count = std::min(bufsize - 1U, length() - index);
+            memcpy(buf, &m_buffer[index], count);
+        }
+
+        buf[count] = '\0';
+    }
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const
+{
+    int                     index   = -1;
+    std::string::size_type  pos     = m_buffer.find(c, fromIndex);
+
+    if (std::string::npos != pos)
+    {
+        index = static_cast<int>(pos);
+    }
+
+    return index;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const
+{
+    int                     index   = -1;
+    std::string::size_type  pos     = m_buffer.find(str.m_buffer, fromIndex);
+
+    if (std::string::npos != pos)
+    {
+        index = static_cast<int>(pos);
+    }
+
+    return index;
+}
+
+int String::lastIndexOf(char c) const
+{
+    int                     index   = -1;
+    std::string::size_type  pos     = m_buffer.rfind(c);
+
+    if (std::string::npos != pos)
+    {
+        index = static_cast<int>(pos);
+    }
+
+    return index;
+}
+
+int String::lastIndexOf(const String& str) const
+{
+    int                     index   = -1;
+    std::string::size_type  pos     = m_buffer.rfind(str.m_buffer);
+
+    if (std::string::npos != pos)
+    {
+        index = static_cast<int>(pos);
+    }
+
+    return index;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    String result;
+
+    /* Like the core, swapped indices are accepted. */
+    if (beginIndex > endIndex)
+    {
+        unsigned int tmp = beginIndex;
+
+        beginIndex  = endIndex;
+        endIndex    = tmp;
+    }
+
+    if (length() < endIndex)
+    {
+        endIndex = length();
+    }
+
+    if (beginIndex < endIndex)
+    {
+        result.m_buffer = m_buffer.substr(beginIndex, endIndex - beginIndex);
+    }
+
+    return result;
+}
+
+void String::replace(char find, char replace)
+{
+    std::replace(m_buffer.begin(), m_buffer.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace)
+{
+    if (false == find.isEmpty())
+    {
+        std::string::size_type pos = m_buffer.find(find.m_buffer);
+
+        while (std::string::npos != pos)
+        {
+            m_buffer.replace(pos, find.length(), replace.m_buffer);
+            pos = m_buffer.find(find.m_buffer, pos + replace.length());
+        }
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (length() > index)
+    {
+        m_buffer.erase(index, count);
+    }
+}
+
+void String::toLowerCase()
+{
+    std::string::iterator it;
+
+    for (it = m_buffer.begin(); it != m_buffer.end(); ++it)
+    {
+        *it = static_cast<char>(tolower(static_cast<unsigned char>(*it)));
+    }
+}
+
+void String::toUpperCase()
+{
+    std::string::iterator it;
+
+    for (it = m_buffer.begin(); it != m_buffer.end(); ++it)
+    {
+        *it = static_cast<char>(toupper(static_cast<unsigned char>(*it)));
+    }
+}
+
+void String::trim()
+{
+    const char*             whitespace  = " \t\r\n\v\f";
+    std::string::size_type  begin       = m_buffer.find_first_not_of(whitespace);
+
+    if (std::string::npos == begin)
+    {
+        m_buffer.clear();
+    }
+    else
+    {
+        std::string::size_type end = m_buffer.find_last_not_of(whitespace);
+
+        m_buffer = m_buffer.substr(begin, end - begin + 1U);
+    }
+}
+
+long String::toInt() const
+{
+    return atol(c_str());
+}
+
+float String::toFloat() const
+{
+    return static_cast<float>(atof(c_str()));
+}
+
+double String::toDouble() const
+{
+    return atof(c_str());
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+String operator+(const char* lhs, const String& rhs)
+{
+    String result(lhs);
+
+    (void)result.concat(rhs);
+
+    return result;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a unsigned number to a string.
+ *
+ * @param[in] value         Absolute value.
+ * @param[in] base          Number base, 2 to 36.
+ * @param[in] isNegative    Prepend a minus sign.
+ *
+ * @return String
+ */
+static std::string toString(unsigned long long value, unsigned char base, bool isNegative)
+{
+    static const char   DIGITS[]    = "0123456789abcdefghijklmnopqrstuvwxyz";
+    std::string         result;
+
+    if ((2U > base) || (36U < base))
+    {
+        base = 10U;
+    }
+
+    do
+    {
+        result.insert(result.begin(), DIGITS[value % base]);
+        value /= base;
+    }
+    while (0U < value);
+
+    if (true == isNegative)
+    {
+        result.insert(result.begin(), '-');
+    }
+
+    return result;
+}
+
+/**
+ * Convert a floating point number to a string.
+ *
+ * @param[in] value         Number
+ * @param[in] decimalPlaces Number of decimal places.
+ *
+ * @return String
+ */
+static std::string toString(double value, unsigned char decimalPlaces)
+{
+    char buffer[64];
+
+    (void)snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimalPlaces), value);
+
+    return std::string(buffer);
+}
@@ -0,0 +1,488 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Arduino String for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef WSTRING_H_
+#define WSTRING_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <algorithm>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Arduino String, which behaves like the one of the ESP8266 core.
+ *  Positions are unsigned int and a not found position is -1.
+ */
+class String
+{
+public:
+
+    /**
+     *  Constructs a string from a C string.
+     *
+     *  @param[in] cstr C string, nullptr is handled as empty string.
+     */
+    String(const char* cstr = "");
+
+    /**
+     *  Constructs a string from a part of a C string.
+     *
+     *  @param[in] cstr     C string.
+     *  @param[in] length   Number of characters.
+     */
+    String(const char* cstr, unsigned int length);
+
+    /**
+     *  Constructs a string from a single character.
+     *
+     *  @param[in] c    Character
+     */
+    explicit String(char c);
+
+    /**
+     *  Constructs a string from a number.
+     *
+     *  @param[in] value    Number
+     *  @param[in] base     Number base, e.g. 10 or 16.
+     */
+    explicit String(unsigned char value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(int value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(unsigned int value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(long value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(unsigned long value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(long long value, unsigned char base = 10);
+
+    /** @copydoc String(unsigned char, unsigned char) */
+    explicit String(unsigned long long value, unsigned char base = 10);
+
+    /**
+     *  Constructs a string from a floating point number.
+     *
+     *  @param[in] value            Number
+     *  @param[in] decimalPlaces    Number of decimal places.
+     */
+    explicit String(float value, unsigned char decimalPlaces = 2);
+
+    /** @copydoc String(float, unsigned char) */
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    /**
+     *  Destroys the string.
+     */
+    ~String()
+    {
+    }
+
+    /**
+     *  Reserve memory, to avoid reallocations.
+     *
+     *  @param[in] size Number of characters.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool reserve(unsigned int size);
+
+    /**
+     *  Get the number of characters.
+     *
+     *  @return Length
+     */
+    unsigned int length() const
+    {
+        return static_cast<unsigned int>(m_buffer.length());
+    }
+
+    /**
+     *  Is the string empty?
+     *
+     *  @return If empty, returns true. Otherwise, false.
+     */
+    bool isEmpty() const
+    {
+        return m_buffer.empty();
+    }
+
+    /**
+     *  Get the C string.
+     *
+     *  @return C string
+     */
+    const char* c_str() const
+    {
+        return m_buffer.c_str();
+    }
+
+    /**
+     *  Append characters.
+     *
+     *  @param[in] cstr     Characters
+     *  @param[in] length   Number of characters.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool concat(const char* cstr, unsigned int length);
+
+    /**
+     *  Append a value, with the same format as the constructors.
+     *
+     *  @param[in] value    Value
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool concat(const String& value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(const char* value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(char value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(unsigned char value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(int value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(unsigned int value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(long value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(unsigned long value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(long long value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(unsigned long long value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(float value);
+
+    /** @copydoc concat(const String&) */
+    bool concat(double value);
+
+    /**
+     *  Append a value.
+     *
+     *  @param[in] value    Value
+     *  @return This string
+     */
+    template < typename T >
+    String& operator+=(const T& value)
+    {
+        (void)concat(value);
+        return *this;
+    }
+
+    /**
+     *  Compare with another string.
+     *
+     *  @param[in] str  String
+     *  @return Like strcmp().
+     */
+    int compareTo(const String& str) const;
+
+    /**
+     *  Is it equal to another string?
+     *
+     *  @param[in] str  String
+     *  @return If equal, returns true. Otherwise, false.
+     */
+    bool equals(const String& str) const;
+
+    /** @copydoc equals(const String&) */
+    bool equals(const char* str) const;
+
+    /**
+     *  Is it equal to another string, ignoring the case?
+     *
+     *  @param[in] str  String
+     *  @return If equal, returns true. Otherwise, false.
+     */
+    bool equalsIgnoreCase(const String& str) const;
+
+    /**
+     *  Does the string start with the prefix?
+     *
+     *  @param[in] prefix   Prefix
+     *  @param[in] offset   Position, where the prefix is expected.
+     *  @return If it starts with the prefix, returns true. Otherwise, false.
+     */
+    bool startsWith(const String& prefix, unsigned int offset = 0U) const;
+
+    /**
+     *  Does the string end with the suffix?
+     *
+     *  @param[in] suffix   Suffix
+     *  @return If it ends with the suffix, returns true. Otherwise, false.
+     */
+    bool endsWith(const String& suffix) const;
+
+    /**
+     *  Get a character.
+     *
+     *  @param[in] index    Position
+     *  @return Character. If the position is invalid, 0 is returned.
+     */
+    char charAt(unsigned int index) const;
+
+    /**
+     *  Set a character.
+     *
+     *  @param[in] index    Position. If invalid, nothing happens.
+     *  @param[in] c        Character
+     */
+    void setCharAt(unsigned int index, char c);
+
+    /** @copydoc charAt() */
+    char operator[](unsigned int index) const
+    {
+        return charAt(index);
+    }
+
+    /**
+     *  Copy the characters to a buffer, which is always terminated.
+     *
+     *  @param[out] buf     Buffer
+     *  @param[in]  bufsize Buffer size in byte.
+     *  @param[in]  index   Position of the first character.
+     */
+    void getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0U) const;
+
+    /** @copydoc getBytes() */
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0U) const
+    {
+        getBytes(reinterpret_cast<unsigned char*>(buf), bufsize, index);
+    }
+
+    /**
+     *  Find the first position of a character or string.
+     *
+     *  @param[in] c            Character or string to find.
+     *  @param[in] fromIndex    Position, where the search starts.
+     *  @return Position. If not found, -1 is returned.
+     */
+    int indexOf(char c, unsigned int fromIndex = 0U) const;
+
+    /** @copydoc indexOf(char, unsigned int) const */
+    int indexOf(const String& str, unsigned int fromIndex = 0U) const;
+
+    /** @copydoc indexOf(char, unsigned int) const */
+    int indexOf(const char* str, unsigned int fromIndex = 0U) const
+    {
+        return indexOf(String(str), fromIndex);
+    }
+
+    /**
+     *  Find the last position of a character or string.
+     *
+     *  @param[in] c    Character or string to find.
+     *  @return Position. If not found, -1 is returned.
+     */
+    int lastIndexOf(char c) const;
+
+    /** @copydoc lastIndexOf(char) const */
+    int lastIndexOf(const String& str) const;
+
+    /**
+     *  Get a part of the string.
+     *
+     *  @param[in] beginIndex   Position of the first character.
+     *  @param[in] endIndex     Position after the last character.
+     *  @return Part of the string.
+     */
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    /** @copydoc substring(unsigned int, unsigned int) const */
+    String substring(unsigned int beginIndex) const
+    {
+        return substring(beginIndex, length());
+    }
+
+    /**
+     *  Replace all occurrences.
+     *
+     *  @param[in] find     Character or string to find.
+     *  @param[in] replace  Replacement
+     */
+    void replace(char find, char replace);
+
+    /** @copydoc replace(char, char) */
+    void replace(const String& find, const String& replace);
+
+    /**
+     *  Remove characters.
+     *
+     *  @param[in] index    Position of the first character.
+     *  @param[in] count    Number of characters.
+     */
+    void remove(unsigned int index, unsigned int count = static_cast<unsigned int>(-1));
+
+    /**
+     *  Convert to lower case.
+     */
+    void toLowerCase();
+
+    /**
+     *  Convert to upper case.
+     */
+    void toUpperCase();
+
+    /**
+     *  Remove leading and trailing whitespace.
+     */
+    void trim();
+
+    /**
+     *  Clear the string.
+     */
+    void clear()
+    {
+        m_buffer.clear();
+    }
+
+    /**
+     *  Convert to a integer number.
+     *
+     *  @return Number. If invalid, 0 is returned.
+     */
+    long toInt() const;
+
+    /**
+     *  Convert to a floating point number.
+     *
+     *  @return Number. If invalid, 0 is returned.
+     */
+    float toFloat() const;
+
+    /** @copydoc toFloat() */
+    double toDouble() const;
+
+private:
+
+    /** Characters */
+    std::string m_buffer;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ *  Concatenate a string and a value.
+ *
+ *  @param[in] lhs  String
+ *  @param[in] rhs  Value
+ *  @return Concatenated string
+ */
+template < typename T >
+String operator+(const String& lhs, const T& rhs)
+{
+    String result(lhs);
+
+    (void)result.concat(rhs);
+
+    return result;
+}
+
+/**
+ *  Concatenate a C string and a string.
+ *
+ *  @param[in] lhs  C string
+ *  @param[in] rhs  String
+ *  @return Concatenated string
+ */
+String operator+(const char* lhs, const String& rhs);
+
+/**
+ *  Compare two strings.
+ *
+ *  @param[in] lhs  String
+ *  @param[in] rhs  String
+ *  @return If equal, returns true. Otherwise, false.
+ */
+inline bool operator==(const String& lhs, const String& rhs)
+{
+    return lhs.equals(rhs);
+}
+
+/** @copydoc operator==(const String&, const String&) */
+inline bool operator==(const String& lhs, const char* rhs)
+{
+    return lhs.equals(rhs);
+}
+
+/** @copydoc operator==(const String&, const String&) */
+inline bool operator==(const char* lhs, const String& rhs)
+{
+    return rhs.equals(lhs);
+}
+
+/** @copydoc operator==(const String&, const String&) */
+inline bool operator!=(const String& lhs, const String& rhs)
+{
+    return !lhs.equals(rhs);
+}
+
+/** @copydoc operator==(const String&, const String&) */
+inline bool operator!=(const String& lhs, const char* rhs)
+{
+    return !lhs.equals(rhs);
+}
+
+/** @copydoc operator==(const String&, const String&) */
+inline bool operator<(const String& lhs, const String& rhs)
+{
+    return 0 > lhs.compareTo(rhs);
+}
+
+#endif /* WSTRING_H_ */
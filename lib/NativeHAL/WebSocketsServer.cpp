@@ -0,0 +1,766 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  WebSocket server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WebSocketsServer.h"
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** WebSocket opcodes */
+typedef enum
+{
+    OPCODE_CONTINUATION = 0x00U,    /**< Continuation frame */
+    OPCODE_TEXT         = 0x01U,    /**< Text frame */
+    OPCODE_BINARY       = 0x02U,    /**< Binary frame */
+    OPCODE_CLOSE        = 0x08U,    /**< Close frame */
+    OPCODE_PING         = 0x09U,    /**< Ping frame */
+    OPCODE_PONG         = 0x0AU     /**< Pong frame */
+
+} Opcode;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static String getAcceptKey(const String& key);
+static void sha1(const uint8_t* data, size_t length, uint8_t digest[20]);
+static String base64Encode(const uint8_t* data, size_t length);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** GUID, which is appended to the client key, see RFC 6455. */
+static const char*  WEBSOCKET_GUID      = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+/** Maximum size of the handshake request in byte. */
+static const size_t MAX_HANDSHAKE_SIZE  = 2048U;
+
+/** Last started server, which receives the injected events. */
+static WebSocketsServer*    gInjectionServer    = nullptr;
+
+/** Observer of the text frames, which are sent to a single client. */
+static WebSocketsServer::TextObserver   gTextObserver;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WebSocketsServer::WebSocketsServer(uint16_t port, const String& origin, const String& protocol) :
+    m_server(port),
+    m_clients(),
+    m_eventHandler()
+{
+    uint8_t num = 0U;
+
+    (void)origin;
+    (void)protocol;
+
+    for (num = 0U; WEBSOCKETS_SERVER_CLIENT_MAX > num; ++num)
+    {
+        m_clients[num].state        = STATE_NOT_CONNECTED;
+        m_clients[num].timestamp    = 0U;
+    }
+}
+
+void WebSocketsServer::begin()
+{
+    (void)m_server.begin();
+
+    gInjectionServer = this;
+}
+
+void WebSocketsServer::close()
+{
+    uint8_t num = 0U;
+
+    for (num = 0U; WEBSOCKETS_SERVER_CLIENT_MAX > num; ++num)
+    {
+        disconnect(num);
+    }
+
+    m_server.close();
+
+    if (this == gInjectionServer)
+    {
+        gInjectionServer = nullptr;
+    }
+}
+
+void WebSocketsServer::loop()
+{
+    uint8_t num = 0U;
+
+    acceptClient();
+
+    for (num = 0U; WEBSOCKETS_SERVER_CLIENT_MAX > num; ++num)
+    {
+        if (STATE_NOT_CONNECTED != m_clients[num].state)
+        {
+            handleClient(num);
+        }
+    }
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, uint8_t* payload, size_t length, bool headerToPayload)
+{
+    (void)headerToPayload;
+
+    return sendTXT(num, static_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, const uint8_t* payload, size_t length)
+{
+    if (0U == length)
+    {
+        length = strlen(reinterpret_cast<const char*>(payload));
+    }
+
+    if (nullptr != gTextObserver)
+    {
+        gTextObserver(num, payload, length);
+    }
+
+    return sendFrame(num, OPCODE_TEXT, payload, length);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, char* payload, size_t length, bool headerToPayload)
+{
+    (void)headerToPayload;
+
+    return sendTXT(num, reinterpret_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, const char* payload, size_t length)
+{
+    return sendTXT(num, reinterpret_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, String& payload)
+{
+    return sendTXT(num, reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length());
+}
+
+bool WebSocketsServer::broadcastTXT(uint8_t* payload, size_t length, bool headerToPayload)
+{
+    (void)headerToPayload;
+
+    return broadcastTXT(static_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::broadcastTXT(const uint8_t* payload, size_t length)
+{
+    bool    isSuccess   = true;
+    uint8_t num         = 0U;
+
+    if (0U == length)
+    {
+        length = strlen(reinterpret_cast<const char*>(payload));
+    }
+
+    for (num = 0U; WEBSOCKETS_SERVER_CLIENT_MAX > num; ++num)
+    {
+        if ((STATE_CONNECTED == m_clients[num].state) &&
+            (false == sendFrame(num, OPCODE_TEXT, payload, length)))
+        {
+            isSuccess = false;
+        }
+    }
+
+    return isSuccess;
+}
+
+bool WebSocketsServer::broadcastTXT(char* payload, size_t length, bool headerToPayload)
+{
+    (void)headerToPayload;
+
+    return broadcastTXT(reinterpret_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::broadcastTXT(const char* payload, size_t length)
+{
+    return broadcastTXT(reinterpret_cast<const uint8_t*>(payload), length);
+}
+
+bool WebSocketsServer::broadcastTXT(String& payload)
+{
+    return broadcastTXT(reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length());
+}
+
+void WebSocketsServer::disconnect(uint8_t num)
+{
+    if ((WEBSOCKETS_SERVER_CLIENT_MAX > num) &&
+        (STATE_NOT_CONNECTED != m_clients[num].state))
+    {
+        if (STATE_CONNECTED == m_clients[num].state)
+        {
+            (void)sendFrame(num, OPCODE_CLOSE, nullptr, 0U);
+        }
+
+        dropClient(num);
+    }
+}
+
+int WebSocketsServer::connectedClients(bool ping)
+{
+    int     count   = 0;
+    uint8_t num     = 0U;
+
+    (void)ping;
+
+    for (num = 0U; WEBSOCKETS_SERVER_CLIENT_MAX > num; ++num)
+    {
+        if (STATE_CONNECTED == m_clients[num].state)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+bool WebSocketsServer::injectEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
+{
+    bool isSuccess = false;
+
+    if ((nullptr != gInjectionServer) &&
+        (nullptr != gInjectionServer->m_eventHandler))
+    {
+        gInjectionServer->m_eventHandler(num, type, payload, length);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+void WebSocketsServer::observeText(TextObserver observer)
+{
+    gTextObserver = observer;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void WebSocketsServer::acceptClient()
+{
+    WiFiClient client = m_server.accept();
+
+    if (0U != client.connected())
+    {
+        uint8_t num = 0U;
+
+        while ((WEBSOCKETS_SERVER_CLIENT_MAX > num) && (STATE_NOT_CONNECTED != m_clients[num].state))
+        {
+            ++num;
+        }
+
+        /* Like the library, a client without free slot is rejected. */
+        if (WEBSOCKETS_SERVER_CLIENT_MAX <= num)
+        {
+            static const char REJECT[] = "HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\n\r\n";
+
+            (void)client.write(reinterpret_cast<const uint8_t*>(REJECT), sizeof(REJECT) - 1U);
+            client.stop();
+        }
+        else
+        {
+            client.setNoDelay(true);
+
+            m_clients[num].state        = STATE_HANDSHAKE;
+            m_clients[num].client       = client;
+            m_clients[num].timestamp    = millis();
+            m_clients[num].rxBuffer.clear();
+        }
+    }
+}
+
+void WebSocketsServer::handleClient(uint8_t num)
+{
+    Client& client  = m_clients[num];
+    uint8_t buffer[512];
+    int     count   = 0;
+
+    do
+    {
+        count = client.client.read(buffer, sizeof(buffer));
+
+        if (0 < count)
+        {
+            client.rxBuffer.insert(client.rxBuffer.end(), buffer, buffer + count);
+        }
+    }
+    while (0 < count);
+
+    if (STATE_HANDSHAKE == client.state)
+    {
+        handleHandshake(num);
+    }
+
+    if (STATE_CONNECTED == client.state)
+    {
+        handleFrames(num);
+    }
+
+    /* The client may be dropped already while processing. */
+    if ((STATE_NOT_CONNECTED != client.state) &&
+        (0U == client.client.connected()))
+    {
+        dropClient(num);
+    }
+}
+
+void WebSocketsServer::handleHandshake(uint8_t num)
+{
+    Client& client  = m_clients[num];
+    String  request(reinterpret_cast<const char*>(client.rxBuffer.data()), client.rxBuffer.size());
+    int     end     = request.indexOf("\r\n\r\n");
+
+    if (0 <= end)
+    {
+        int     keyIdx  = request.indexOf("Sec-WebSocket-Key:");
+        int     urlIdx  = request.indexOf(' ');
+        String  url     = request.substring(urlIdx + 1, request.indexOf(' ', urlIdx + 1));
+
+        if ((0 > keyIdx) || (end < keyIdx) || (0 > urlIdx))
+        {
+            static const char REJECT[] = "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n";
+
+            (void)client.client.write(reinterpret_cast<const uint8_t*>(REJECT), sizeof(REJECT) - 1U);
+            client.client.stop();
+            client.state = STATE_NOT_CONNECTED;
+        }
+        else
+        {
+            String key      = request.substring(keyIdx + 18, request.indexOf("\r\n", keyIdx));
+            String response = "HTTP/1.1 101 Switching Protocols\r\n"
+                              "Server: arduino-WebSocketsServer\r\n"
+                              "Upgrade: websocket\r\n"
+                              "Connection: Upgrade\r\n"
+                              "Sec-WebSocket-Version: 13\r\n"
+                              "Sec-WebSocket-Accept: ";
+
+            key.trim();
+            response += getAcceptKey(key);
+            response += "\r\n\r\n";
+
+            (void)client.client.write(reinterpret_cast<const uint8_t*>(response.c_str()), response.length());
+
+            client.rxBuffer.erase(client.rxBuffer.begin(), client.rxBuffer.begin() + end + 4);
+            client.state = STATE_CONNECTED;
+
+            notify(num, WStype_CONNECTED, reinterpret_cast<uint8_t*>(const_cast<char*>(url.c_str())), url.length());
+        }
+    }
+    else if ((MAX_HANDSHAKE_SIZE <= client.rxBuffer.size()) ||
+             (HANDSHAKE_TIMEOUT_MS <= (millis() - client.timestamp)))
+    {
+        client.client.stop();
+        client.state = STATE_NOT_CONNECTED;
+    }
+    else
+    {
+        ;
+    }
+}
+
+void WebSocketsServer::handleFrames(uint8_t num)
+{
+    Client& client      = m_clients[num];
+    bool    isComplete  = true;
+
+    while ((STATE_CONNECTED == client.state) && (true == isComplete))
+    {
+        std::vector<uint8_t>&   rx          = client.rxBuffer;
+        size_t                  headerSize  = 2U;
+        uint64_t                length      = 0U;
+        bool                    isMasked    = false;
+
+        isComplete = (headerSize <= rx.size());
+
+        if (true == isComplete)
+        {
+            isMasked    = (0U != (rx[1] & 0x80U));
+            length      = rx[1] & 0x7FU;
+
+            if (126U == length)
+            {
+                headerSize += 2U;
+            }
+            else if (127U == length)
+            {
+                headerSize += 8U;
+            }
+            else
+            {
+                ;
+            }
+
+            if (true == isMasked)
+            {
+                headerSize += 4U;
+            }
+
+            isComplete = (headerSize <= rx.size());
+        }
+
+        if (true == isComplete)
+        {
+            size_t idx = 0U;
+
+            if (126U == (rx[1] & 0x7FU))
+            {
+                length = (static_cast<uint64_t>(rx[2]) << 8U) | rx[3];
+            }
+            else if (127U == (rx[1] & 0x7FU))
+            {
+                length = 0U;
+
+                for (idx = 0U; 8U > idx; ++idx)
+                {
+                    length = (length << 8U) | rx[2U + idx];
+                }
+            }
+            else
+            {
+                ;
+            }
+
+            /* Clients have to mask, too large frames are not supported by the device. */
+            if ((false == isMasked) || (WEBSOCKETS_MAX_DATA_SIZE < length))
+            {
+                disconnect(num);
+                isComplete = false;
+            }
+            else
+            {
+                isComplete = ((headerSize + length) <= rx.size());
+            }
+        }
+
+        if (true == isComplete)
+        {
+            bool                    isFin   = (0U != (rx[0] & 0x80U));
+            uint8_t                 opcode  = rx[0] & 0x0FU;
+            const uint8_t*          mask    = &rx[headerSize - 4U];
+            std::vector<uint8_t>    payload(static_cast<size_t>(length) + 1U, 0U);
+            size_t                  idx     = 0U;
+
+            /* The payload is terminated for text, like the library does. */
+            for (idx = 0U; length > idx; ++idx)
+            {
+                payload[idx] = rx[headerSize + idx] ^ mask[idx % 4U];
+            }
+
+            rx.erase(rx.begin(), rx.begin() + headerSize + static_cast<size_t>(length));
+
+            switch (opcode)
+            {
+            case OPCODE_TEXT:
+                notify(num, (true == isFin) ? WStype_TEXT : WStype_FRAGMENT_TEXT_START, payload.data(), length);
+                break;
+
+            case OPCODE_BINARY:
+                notify(num, (true == isFin) ? WStype_BIN : WStype_FRAGMENT_BIN_START, payload.data(), length);
+                break;
+
+            case OPCODE_CONTINUATION:
+                notify(num, (true == isFin) ? WStype_FRAGMENT_FIN : WStype_FRAGMENT, payload.data(), length);
+                break;
+
+            case OPCODE_PING:
+                (void)sendFrame(num, OPCODE_PONG, payload.data(), length);
+                notify(num, WStype_PING, payload.data(), length);
+                break;
+
+            case OPCODE_PONG:
+                notify(num, WStype_PONG, payload.data(), length);
+                break;
+
+            case OPCODE_CLOSE:
+                disconnect(num);
+                break;
+
+            default:
+                disconnect(num);
+                break;
+            }
+        }
+    }
+}
+
+bool WebSocketsServer::sendFrame(uint8_t num, uint8_t opcode, const uint8_t* payload, size_t length)
+{
+    bool isSuccess = false;
+
+    if ((WEBSOCKETS_SERVER_CLIENT_MAX > num) &&
+        (STATE_CONNECTED == m_clients[num].state))
+    {
+        std::vector<uint8_t> frame;
+
+        frame.reserve(length + 4U);
+        frame.push_back(0x80U | opcode);
+
+        if (126U > length)
+        {
+            frame.push_back(static_cast<uint8_t>(length));
+        }
+        else if (0xFFFFU >= length)
+        {
+            frame.push_back(126U);
+            frame.push_back(static_cast<uint8_t>(length >> 8U));
+            frame.push_back(static_cast<uint8_t>(length));
+        }
+        else
+        {
+            size_t idx = 0U;
+
+            frame.push_back(127U);
+
+            for (idx = 0U; 8U > idx; ++idx)
+            {
+                frame.push_back(static_cast<uint8_t>(static_cast<uint64_t>(length) >> (56U - (8U * idx))));
+            }
+        }
+
+        if (0U < length)
+        {
+            frame.insert(frame.end(), payload, payload + length);
+        }
+
+        isSuccess = (frame.size() == m_clients[num].client.write(frame.data(), frame.size()));
+    }
+
+    return isSuccess;
+}
+
+void WebSocketsServer::dropClient(uint8_t num)
+{
+    ClientState state = m_clients[num].state;
+
+    m_clients[num].client.stop();
+    m_clients[num].client = WiFiClient();
+    m_clients[num].rxBuffer.clear();
+    m_clients[num].state = STATE_NOT_CONNECTED;
+
+    if (STATE_CONNECTED == state)
+    {
+        notify(num, WStype_DISCONNECTED, nullptr, 0U);
+    }
+}
+
+void WebSocketsServer::notify(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
+{
+    if (nullptr != m_eventHandler)
+    {
+        m_eventHandler(num, type, payload, length);
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Calculate the accept key of the handshake response, see RFC 6455.
+ *
+ * @param[in] key   Key of the handshake request.
+ *
+ * @return Accept key
+ */
+static String getAcceptKey(const String& key)
+{
+    String  text    = key + WEBSOCKET_GUID;
+    uint8_t digest[20];
+
+    sha1(reinterpret_cast<const uint8_t*>(text.c_str()), text.length(), digest);
+
+    return base64Encode(digest, sizeof(digest));
+}
+
+/**
+ * Calculate the SHA-1 digest, see RFC 3174.
+ *
+ * @param[in]  data     Data
+ * @param[in]  length   Data length in byte.
+ * @param[out] digest   Digest
+ */
+static void sha1(const uint8_t* data, size_t length, uint8_t digest[20])
+{
+    uint32_t                h[5]    = { 0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U, 0xC3D2E1F0U };
+    std::vector<uint8_t>    message(data, data + length);
+    uint64_t                bitLen  = static_cast<uint64_t>(length) * 8U;
+    size_t                  block   = 0U;
+    size_t                  idx     = 0U;
+
+    /* Padding: 0x80, zeros and the message length in bit as 64-bit big endian. */
+    message.push_back(0x80U);
+
+    while (56U != (message.size() % 64U))
+    {
+        message.push_back(0x00U);
+    }
+
+    for (idx = 0U; 8U > idx; ++idx)
+    {
+        message.push_back(static_cast<uint8_t>(bitLen >> (56U - (8U * idx))));
+    }
+
+    for (block = 0U; message.size() > block; block += 64U)
+    {
+        uint32_t w[80];
+        uint32_t a = h[0];
+        uint32_t b = h[1];
+        uint32_t c = h[2];
+        uint32_t d = h[3];
+        uint32_t e = h[4];
+
+        for (idx = 0U; 16U > idx; ++idx)
+        {
+            w[idx] = (static_cast<uint32_t>(message[block + (4U * idx)]) << 24U) |
+                     (static_cast<uint32_t>(message[block + (4U * idx) + 1U]) << 16U) |
+                     (static_cast<uint32_t>(message[block + (4U * idx) + 2U]) << 8U) |
+                     static_cast<uint32_t>(message[block + (4U * idx) + 3U]);
+        }
+
+        for (idx = 16U; 80U > idx; ++idx)
+        {
+            uint32_t value = w[idx - 3U] ^ w[idx - 8U] ^ w[idx - 14U] ^ w[idx - 16U];
+
+            w[idx] = (value << 1U) | (value >> 31U);
+        }
+
+        for (idx = 0U; 80U > idx; ++idx)
+        {
+            uint32_t f;
+            uint32_t k;
+            uint32_t temp;
+
+            if (20U > idx)
+            {
+                f = (b & c) | ((~b) & d);
+                k = 0x5A827999U;
+            }
+            else if (40U > idx)
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1U;
+            }
+            else if (60U > idx)
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDCU;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6U;
+            }
+
+            temp    = ((a << 5U) | (a >> 27U)) + f + e + k + w[idx];
+            e       = d;
+            d       = c;
+            c       = (b << 30U) | (b >> 2U);
+            b       = a;
+            a       = temp;
+        }
+
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for (idx = 0U; 20U > idx; ++idx)
+    {
+        digest[idx] = static_cast<uint8_t>(h[idx / 4U] >> (24U - (8U * (idx % 4U))));
+    }
+}
+
+/**
+ * Encode data with base64, see RFC 4648.
+ *
+ * @param[in] data      Data
+ * @param[in] length    Data length in byte.
+ *
+ * @return Base64 encoded data
+ */
+static String base64Encode(const uint8_t* data, size_t length)
+{
+    static const char   ALPHABET[]  = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    String              result;
+    size_t              idx         = 0U;
+
+    for (idx = 0U; length > idx; idx += 3U)
+    {
+        uint32_t    value   = static_cast<uint32_t>(data[idx]) << 16U;
+        size_t      count   = std::min(static_cast<size_t>(3U), length - idx);
+
+        if (1U < count)
+        {
+            value |= static_cast<uint32_t>(data[idx + 1U]) << 8U;
+        }
+
+        if (2U < count)
+        {
+            value |= data[idx + 2U];
+        }
+
+        result += ALPHABET[(value >> 18U) & 0x3FU];
+        result += ALPHABET[(value >> 12U) & 0x3FU];
+        result += (1U < count) ? ALPHABET[(value >> 6U) & 0x3FU] : '=';
+        result += (2U < count) ? ALPHABET[value & 0x3FU] : '=';
+    }
+
+    return result;
+}
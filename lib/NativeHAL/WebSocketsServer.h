@@ -0,0 +1,305 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  WebSocket server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef WEB_SOCKETS_SERVER_H_
+#define WEB_SOCKETS_SERVER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "WString.h"
+#include "WiFiClient.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Maximum number of clients, same as the library on the ESP8266. */
+#define WEBSOCKETS_SERVER_CLIENT_MAX    (5)
+
+/** Maximum payload size of a received frame, same as the library on the ESP8266. */
+#define WEBSOCKETS_MAX_DATA_SIZE        (15 * 1024)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** WebSocket event types, same as the links2004 WebSockets library. */
+typedef enum
+{
+    WStype_ERROR,               /**< Error */
+    WStype_DISCONNECTED,        /**< Client disconnected */
+    WStype_CONNECTED,           /**< Client connected, the payload is the URL. */
+    WStype_TEXT,                /**< Text frame */
+    WStype_BIN,                 /**< Binary frame */
+    WStype_FRAGMENT_TEXT_START, /**< First fragment of a text message */
+    WStype_FRAGMENT_BIN_START,  /**< First fragment of a binary message */
+    WStype_FRAGMENT,            /**< Further fragment */
+    WStype_FRAGMENT_FIN,        /**< Last fragment */
+    WStype_PING,                /**< Ping received, the pong is sent automatically. */
+    WStype_PONG                 /**< Pong received */
+
+} WStype_t;
+
+/**
+ *  WebSocket server with the API of the links2004 WebSockets library.
+ *  Sending blocks until the frame is written, like the library does.
+ */
+class WebSocketsServer
+{
+public:
+
+    /** Event handler */
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+
+    /** Observer of the sent text frames. */
+    typedef std::function<void(uint8_t num, const uint8_t* payload, size_t length)> TextObserver;
+
+    /**
+     *  Constructs the server.
+     *
+     *  @param[in] port     Device port
+     *  @param[in] origin   Allowed origin, ignored.
+     *  @param[in] protocol Sub protocol, ignored.
+     */
+    explicit WebSocketsServer(uint16_t port, const String& origin = "", const String& protocol = "arduino");
+
+    /**
+     *  Destroys the server.
+     */
+    ~WebSocketsServer()
+    {
+        close();
+    }
+
+    /**
+     *  Start listening.
+     */
+    void begin();
+
+    /**
+     *  Disconnect all clients and stop listening.
+     */
+    void close();
+
+    /**
+     *  Accept clients and receive frames.
+     */
+    void loop();
+
+    /**
+     *  Set the event handler.
+     *
+     *  @param[in] handler  Event handler
+     */
+    void onEvent(WebSocketServerEvent handler)
+    {
+        m_eventHandler = handler;
+    }
+
+    /**
+     *  Send a text frame to a client.
+     *
+     *  @param[in] num      Client number
+     *  @param[in] payload  Text
+     *  @param[in] length   Text length. 0 means the length of the C string.
+     *  @param[in] headerToPayload  Ignored, only for API compatibility.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool sendTXT(uint8_t num, uint8_t* payload, size_t length = 0U, bool headerToPayload = false);
+
+    /** @copydoc sendTXT(uint8_t, uint8_t*, size_t, bool) */
+    bool sendTXT(uint8_t num, const uint8_t* payload, size_t length = 0U);
+
+    /** @copydoc sendTXT(uint8_t, uint8_t*, size_t, bool) */
+    bool sendTXT(uint8_t num, char* payload, size_t length = 0U, bool headerToPayload = false);
+
+    /** @copydoc sendTXT(uint8_t, uint8_t*, size_t, bool) */
+    bool sendTXT(uint8_t num, const char* payload, size_t length = 0U);
+
+    /** @copydoc sendTXT(uint8_t, uint8_t*, size_t, bool) */
+    bool sendTXT(uint8_t num, String& payload);
+
+    /**
+     *  Send a text frame to all clients.
+     *
+     *  @param[in] payload  Text
+     *  @param[in] length   Text length. 0 means the length of the C string.
+     *  @param[in] headerToPayload  Ignored, only for API compatibility.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool broadcastTXT(uint8_t* payload, size_t length = 0U, bool headerToPayload = false);
+
+    /** @copydoc broadcastTXT(uint8_t*, size_t, bool) */
+    bool broadcastTXT(const uint8_t* payload, size_t length = 0U);
+
+    /** @copydoc broadcastTXT(uint8_t*, size_t, bool) */
+    bool broadcastTXT(char* payload, size_t length = 0U, bool headerToPayload = false);
+
+    /** @copydoc broadcastTXT(uint8_t*, size_t, bool) */
+    bool broadcastTXT(const char* payload, size_t length = 0U);
+
+    /** @copydoc broadcastTXT(uint8_t*, size_t, bool) */
+    bool broadcastTXT(String& payload);
+
+    /**
+     *  Disconnect a client.
+     *
+     *  @param[in] num  Client number
+     */
+    void disconnect(uint8_t num);
+
+    /**
+     *  Get the number of connected clients.
+     *
+     *  @param[in] ping Ping the clients before, ignored.
+     *  @return Number of clients.
+     */
+    int connectedClients(bool ping = false);
+
+    /**
+     *  Deliver an event to the handler of the last started server, like it
+     *  was received from a client. Only available on the native platform,
+     *  it is used by the tests and the fuzzer to bypass the sockets.
+     *
+     *  @param[in] num      Client number
+     *  @param[in] type     Event type
+     *  @param[in] payload  Payload
+     *  @param[in] length   Payload length
+     *  @return If a server with event handler is started, returns true. Otherwise, false.
+     */
+    static bool injectEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+
+    /**
+     *  Observe every text frame, which is sent to a single client, even if
+     *  the client is not connected. Only available on the native platform,
+     *  it is used by the tests to check the replies to injected events.
+     *
+     *  @param[in] observer Observer, nullptr to stop observing.
+     */
+    static void observeText(TextObserver observer);
+
+private:
+
+    /** Client connection states */
+    typedef enum
+    {
+        STATE_NOT_CONNECTED = 0,    /**< Slot is free. */
+        STATE_HANDSHAKE,            /**< Waiting for the handshake request. */
+        STATE_CONNECTED             /**< Handshake done. */
+
+    } ClientState;
+
+    /** Client */
+    typedef struct
+    {
+        ClientState             state;      /**< Connection state */
+        WiFiClient              client;     /**< Connection */
+        std::vector<uint8_t>    rxBuffer;   /**< Received, not processed data. */
+        uint32_t                timestamp;  /**< Timestamp of the connect in ms. */
+
+    } Client;
+
+    /** Time in ms, a client has to send the handshake request. */
+    static const uint32_t   HANDSHAKE_TIMEOUT_MS    = 5000U;
+
+    /** Listening socket */
+    WiFiServer              m_server;
+
+    /** Clients */
+    Client                  m_clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+    /** Event handler */
+    WebSocketServerEvent    m_eventHandler;
+
+    /**
+     *  Accept a pending connection.
+     */
+    void acceptClient();
+
+    /**
+     *  Receive and process the data of a client.
+     *
+     *  @param[in] num  Client number
+     */
+    void handleClient(uint8_t num);
+
+    /**
+     *  Process the handshake request.
+     *
+     *  @param[in] num  Client number
+     */
+    void handleHandshake(uint8_t num);
+
+    /**
+     *  Process all complete frames.
+     *
+     *  @param[in] num  Client number
+     */
+    void handleFrames(uint8_t num);
+
+    /**
+     *  Send a frame.
+     *
+     *  @param[in] num      Client number
+     *  @param[in] opcode   Opcode
+     *  @param[in] payload  Payload
+     *  @param[in] length   Payload length
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool sendFrame(uint8_t num, uint8_t opcode, const uint8_t* payload, size_t length);
+
+    /**
+     *  Close the connection of a client and report it.
+     *
+     *  @param[in] num  Client number
+     */
+    void dropClient(uint8_t num);
+
+    /**
+     *  Report a event.
+     *
+     *  @param[in] num      Client number
+     *  @param[in] type     Event type
+     *  @param[in] payload  Payload
+     *  @param[in] length   Payload length
+     */
+    void notify(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+
+    /* Not allowed. */
+    WebSocketsServer(const WebSocketsServer& server);
+    WebSocketsServer& operator=(const WebSocketsServer& server);
+};
+
+#endif /* WEB_SOCKETS_SERVER_H_ */
@@ -0,0 +1,369 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TCP client and server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WiFiClient.h"
+#include "NativeHAL.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/sockios.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Connection, which closes the socket with the last client copy. */
+struct WiFiClient::Context
+{
+    /** Socket */
+    int fd;
+
+    /**
+     *  Constructs the connection.
+     *
+     *  @param[in] socketFd Socket
+     */
+    explicit Context(int socketFd) :
+        fd(socketFd)
+    {
+    }
+
+    /**
+     *  Closes the socket.
+     */
+    ~Context()
+    {
+        close();
+    }
+
+    /**
+     *  Close the socket. Sent data is still delivered to the peer.
+     */
+    void close()
+    {
+        if (0 <= fd)
+        {
+            (void)shutdown(fd, SHUT_WR);
+            (void)::close(fd);
+            fd = -1;
+        }
+    }
+
+private:
+
+    /* Not allowed. */
+    Context(const Context& context);
+    Context& operator=(const Context& context);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool setNonBlocking(int fd);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of pending connections of a listening socket. */
+static const int LISTEN_BACKLOG = 8;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WiFiClient::WiFiClient(int fd) :
+    Print(),
+    m_context(),
+    m_timeout(DEFAULT_TIMEOUT)
+{
+    if (0 <= fd)
+    {
+        m_context = std::make_shared<Context>(fd);
+    }
+}
+
+uint8_t WiFiClient::connected()
+{
+    uint8_t isConnected = 0U;
+    int     fd          = getFd();
+
+    if (0 <= fd)
+    {
+        uint8_t data    = 0U;
+        ssize_t result  = recv(fd, &data, sizeof(data), MSG_PEEK | MSG_DONTWAIT);
+
+        if ((0 < result) ||
+            ((0 > result) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))))
+        {
+            isConnected = 1U;
+        }
+    }
+
+    return isConnected;
+}
+
+int WiFiClient::available()
+{
+    int count   = 0;
+    int fd      = getFd();
+
+    if ((0 <= fd) &&
+        (0 != ioctl(fd, FIONREAD, &count)))
+    {
+        count = 0;
+    }
+
+    return count;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size)
+{
+    int count   = 0;
+    int fd      = getFd();
+
+    if (0 <= fd)
+    {
+        ssize_t result = recv(fd, buffer, size, MSG_DONTWAIT);
+
+        if (0 < result)
+        {
+            count = static_cast<int>(result);
+        }
+    }
+
+    return count;
+}
+
+size_t WiFiClient::write(uint8_t data)
+{
+    return write(&data, 1U);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size)
+{
+    size_t  count       = 0U;
+    int     fd          = getFd();
+    bool    isFailed    = (0 > fd);
+
+    while ((size > count) && (false == isFailed))
+    {
+        ssize_t result = send(fd, &buffer[count], size - count, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (0 < result)
+        {
+            count += static_cast<size_t>(result);
+        }
+        else if ((0 > result) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+        {
+            struct pollfd pollFd;
+
+            pollFd.fd       = fd;
+            pollFd.events   = POLLOUT;
+            pollFd.revents  = 0;
+
+            if (0 >= poll(&pollFd, 1U, m_timeout))
+            {
+                isFailed = true;
+            }
+        }
+        else
+        {
+            isFailed = true;
+        }
+    }
+
+    return count;
+}
+
+int WiFiClient::availableForWrite()
+{
+    int count   = 0;
+    int fd      = getFd();
+
+    if (0 <= fd)
+    {
+        struct pollfd   pollFd;
+        int             queued  = 0;
+
+        pollFd.fd       = fd;
+        pollFd.events   = POLLOUT;
+        pollFd.revents  = 0;
+
+        if ((1 == poll(&pollFd, 1U, 0)) &&
+            (0 != (pollFd.revents & POLLOUT)) &&
+            (0 == ioctl(fd, SIOCOUTQ, &queued)) &&
+            (TCP_SND_BUF > queued))
+        {
+            count = TCP_SND_BUF - queued;
+        }
+    }
+
+    return count;
+}
+
+void WiFiClient::setNoDelay(bool noDelay)
+{
+    int fd = getFd();
+
+    if (0 <= fd)
+    {
+        int value = (true == noDelay) ? 1 : 0;
+
+        (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+    }
+}
+
+void WiFiClient::stop()
+{
+    if (nullptr != m_context)
+    {
+        m_context->close();
+        m_context.reset();
+    }
+}
+
+bool WiFiServer::begin()
+{
+    bool isSuccess = false;
+
+    close();
+
+    m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (0 <= m_fd)
+    {
+        struct sockaddr_in  address;
+        int                 reuse   = 1;
+
+        (void)setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port        = htons(NativeHAL::getHostPort(m_port));
+
+        if ((0 == bind(m_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) &&
+            (0 == listen(m_fd, LISTEN_BACKLOG)) &&
+            (true == setNonBlocking(m_fd)))
+        {
+            isSuccess = true;
+        }
+        else
+        {
+            fprintf(stderr, "Port %u: ", NativeHAL::getHostPort(m_port));
+            perror("Listen failed");
+            close();
+        }
+    }
+
+    return isSuccess;
+}
+
+WiFiClient WiFiServer::accept()
+{
+    int fd = -1;
+
+    if (0 <= m_fd)
+    {
+        fd = accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+
+        if ((0 <= fd) &&
+            (false == setNonBlocking(fd)))
+        {
+            (void)::close(fd);
+            fd = -1;
+        }
+    }
+
+    return WiFiClient(fd);
+}
+
+void WiFiServer::close()
+{
+    if (0 <= m_fd)
+    {
+        (void)::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int WiFiClient::getFd() const
+{
+    return (nullptr == m_context) ? -1 : m_context->fd;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Switch a socket to non-blocking mode.
+ *
+ * @param[in] fd    Socket
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool setNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+
+    return (0 <= flags) && (0 == fcntl(fd, F_SETFL, flags | O_NONBLOCK));
+}
@@ -0,0 +1,279 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TCP client and server over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef WIFI_CLIENT_H_
+#define WIFI_CLIENT_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <memory>
+#include "Print.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  TCP client. Like on the device, copies share the same connection, which
+ *  is closed by stop() or when the last copy is destroyed.
+ */
+class WiFiClient : public Print
+{
+public:
+
+    /** Size of the TCP send buffer of the device (2 * TCP_MSS). */
+    static const int    TCP_SND_BUF     = 2920;
+
+    /** Default timeout of blocking writes in ms. */
+    static const int    DEFAULT_TIMEOUT = 5000;
+
+    /**
+     *  Constructs a not connected client.
+     */
+    WiFiClient() :
+        Print(),
+        m_context(),
+        m_timeout(DEFAULT_TIMEOUT)
+    {
+    }
+
+    /**
+     *  Constructs a client for a accepted socket.
+     *
+     *  @param[in] fd   Socket
+     */
+    explicit WiFiClient(int fd);
+
+    /**
+     *  Constructs a copy, which shares the connection.
+     *
+     *  @param[in] client   Client
+     */
+    WiFiClient(const WiFiClient& client) :
+        Print(),
+        m_context(client.m_context),
+        m_timeout(client.m_timeout)
+    {
+    }
+
+    /**
+     *  Destroys the client.
+     */
+    ~WiFiClient()
+    {
+    }
+
+    /**
+     *  Assign a client, which shares the connection.
+     *
+     *  @param[in] client   Client
+     *  @return This client
+     */
+    WiFiClient& operator=(const WiFiClient& client)
+    {
+        if (this != &client)
+        {
+            m_context = client.m_context;
+            m_timeout = client.m_timeout;
+        }
+
+        return *this;
+    }
+
+    /**
+     *  Is the client connected? Like on the device, a closed connection with
+     *  pending received data is still connected.
+     *
+     *  @return If connected, returns non-zero. Otherwise, 0.
+     */
+    uint8_t connected();
+
+    /**
+     *  Is the client valid?
+     *
+     *  @return If valid, returns true. Otherwise, false.
+     */
+    operator bool()
+    {
+        return 0U != connected();
+    }
+
+    /**
+     *  Get the number of bytes, which can be read without blocking.
+     *
+     *  @return Number of bytes.
+     */
+    int available();
+
+    /**
+     *  Read a block of bytes without blocking.
+     *
+     *  @param[out] buffer  Buffer
+     *  @param[in]  size    Buffer size in byte.
+     *  @return Number of read bytes.
+     */
+    int read(uint8_t* buffer, size_t size);
+
+    /**
+     *  Write a single byte.
+     *
+     *  @param[in] data Byte
+     *  @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     *  Write a block of bytes. Like on the device, it blocks until all
+     *  bytes are sent or the timeout elapsed.
+     *
+     *  @param[in] buffer   Bytes
+     *  @param[in] size     Number of bytes.
+     *  @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    /**
+     *  Get the number of bytes, which can be written without blocking. It is
+     *  limited to the send buffer size of the device, to behave the same
+     *  with slow peers.
+     *
+     *  @return Number of bytes.
+     */
+    int availableForWrite() override;
+
+    /**
+     *  Set the timeout of blocking writes.
+     *
+     *  @param[in] timeout  Timeout in ms.
+     */
+    void setTimeout(int timeout)
+    {
+        m_timeout = timeout;
+    }
+
+    /**
+     *  Enable or disable the Nagle algorithm.
+     *
+     *  @param[in] noDelay  Disable Nagle (true) or enable it (false).
+     */
+    void setNoDelay(bool noDelay);
+
+    /**
+     *  Close the connection for all copies.
+     */
+    void stop();
+
+private:
+
+    /** Connection, which is shared by all copies. */
+    struct Context;
+
+    /** Connection */
+    std::shared_ptr<Context>    m_context;
+
+    /** Timeout of blocking writes in ms. */
+    int                         m_timeout;
+
+    /**
+     *  Get the socket.
+     *
+     *  @return Socket. If not connected, -1 is returned.
+     */
+    int getFd() const;
+};
+
+/**
+ *  TCP server, which listens on the host port of the device port.
+ */
+class WiFiServer
+{
+public:
+
+    /**
+     *  Constructs the server.
+     *
+     *  @param[in] port Device port, see NativeHAL::getHostPort().
+     */
+    explicit WiFiServer(uint16_t port) :
+        m_port(port),
+        m_fd(-1)
+    {
+    }
+
+    /**
+     *  Destroys the server.
+     */
+    ~WiFiServer()
+    {
+        close();
+    }
+
+    /**
+     *  Start listening.
+     *
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool begin();
+
+    /**
+     *  Accept a pending connection without blocking.
+     *
+     *  @return Client, which is not connected if there is no pending connection.
+     */
+    WiFiClient accept();
+
+    /**
+     *  Stop listening.
+     */
+    void close();
+
+private:
+
+    /** Device port */
+    uint16_t    m_port;
+
+    /** Listening socket */
+    int         m_fd;
+
+    /* Not allowed. */
+    WiFiServer(const WiFiServer& server);
+    WiFiServer& operator=(const WiFiServer& server);
+};
+
+#endif /* WIFI_CLIENT_H_ */
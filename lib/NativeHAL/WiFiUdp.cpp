@@ -0,0 +1,184 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  UDP over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "WiFiUdp.h"
+#include "NativeHAL.h"
+#include <algorithm>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Maximum datagram size, like the MTU of the device. */
+static const size_t MAX_DATAGRAM_SIZE = 1472U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+int WiFiUDP::beginPacketMulticast(const IPAddress& multicastAddress, uint16_t port, const IPAddress& interfaceAddress, int ttl)
+{
+    (void)interfaceAddress;
+
+    return (true == open(ttl)) ? beginPacket(multicastAddress, port) : 0;
+}
+
+int WiFiUDP::beginPacket(const IPAddress& address, uint16_t port)
+{
+    int isSuccess = 0;
+
+    if (true == open(1))
+    {
+        m_address   = address;
+        m_port      = port;
+        m_packet.clear();
+        isSuccess   = 1;
+    }
+
+    return isSuccess;
+}
+
+size_t WiFiUDP::write(uint8_t data)
+{
+    return write(&data, 1U);
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+
+    if (MAX_DATAGRAM_SIZE > m_packet.size())
+    {
+        count = std::min(size, MAX_DATAGRAM_SIZE - m_packet.size());
+        m_packet.insert(m_packet.end(), buffer, buffer + count);
+    }
+
+    return count;
+}
+
+int WiFiUDP::endPacket()
+{
+    int isSuccess = 0;
+
+    if ((0 <= m_fd) && (0U < m_port))
+    {
+        struct sockaddr_in  destination;
+        ssize_t             result;
+
+        destination.sin_family      = AF_INET;
+        destination.sin_addr.s_addr = static_cast<uint32_t>(m_address); /* Already in network byte order. */
+        destination.sin_port        = htons(NativeHAL::getHostPort(m_port));
+
+        result = sendto(m_fd, m_packet.data(), m_packet.size(), MSG_DONTWAIT,
+                        reinterpret_cast<struct sockaddr*>(&destination), sizeof(destination));
+
+        if (static_cast<ssize_t>(m_packet.size()) == result)
+        {
+            isSuccess = 1;
+        }
+    }
+
+    m_packet.clear();
+
+    return isSuccess;
+}
+
+void WiFiUDP::stop()
+{
+    if (0 <= m_fd)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool WiFiUDP::open(int ttl)
+{
+    if (0 > m_fd)
+    {
+        m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+        if (0 <= m_fd)
+        {
+            struct in_addr  interface;
+            unsigned char   multicastTtl    = static_cast<unsigned char>(ttl);
+            unsigned char   loop            = 1U;
+
+            /* Local listeners on the host shall receive the datagrams. */
+            interface.s_addr = htonl(INADDR_LOOPBACK);
+
+            (void)setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface));
+            (void)setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_TTL, &multicastTtl, sizeof(multicastTtl));
+            (void)setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        }
+    }
+
+    return 0 <= m_fd;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
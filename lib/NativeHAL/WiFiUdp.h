@@ -0,0 +1,157 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  UDP over POSIX sockets for the native platform
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef WIFI_UDP_H_
+#define WIFI_UDP_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <vector>
+#include "Print.h"
+#include "IPAddress.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  UDP sender. Multicast datagrams are sent via the loopback interface,
+ *  the destination port is mapped like all other ports.
+ */
+class WiFiUDP : public Print
+{
+public:
+
+    /**
+     *  Constructs the UDP sender.
+     */
+    WiFiUDP() :
+        Print(),
+        m_fd(-1),
+        m_address(),
+        m_port(0U),
+        m_packet()
+    {
+    }
+
+    /**
+     *  Destroys the UDP sender.
+     */
+    ~WiFiUDP()
+    {
+        stop();
+    }
+
+    /**
+     *  Start a multicast datagram.
+     *
+     *  @param[in] multicastAddress Multicast group
+     *  @param[in] port             Destination port
+     *  @param[in] interfaceAddress Address of the sending interface, ignored.
+     *  @param[in] ttl              Time to live
+     *  @return If successful, returns 1. Otherwise, 0.
+     */
+    int beginPacketMulticast(const IPAddress& multicastAddress, uint16_t port, const IPAddress& interfaceAddress, int ttl = 1);
+
+    /**
+     *  Start a unicast datagram.
+     *
+     *  @param[in] address  Destination address
+     *  @param[in] port     Destination port
+     *  @return If successful, returns 1. Otherwise, 0.
+     */
+    int beginPacket(const IPAddress& address, uint16_t port);
+
+    /**
+     *  Append a single byte to the datagram.
+     *
+     *  @param[in] data Byte
+     *  @return Number of written bytes.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     *  Append bytes to the datagram.
+     *
+     *  @param[in] buffer   Bytes
+     *  @param[in] size     Number of bytes.
+     *  @return Number of written bytes.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    using Print::write;
+
+    /**
+     *  Send the datagram.
+     *
+     *  @return If successful, returns 1. Otherwise, 0.
+     */
+    int endPacket();
+
+    /**
+     *  Close the socket.
+     */
+    void stop();
+
+private:
+
+    /** Socket */
+    int                     m_fd;
+
+    /** Destination address */
+    IPAddress               m_address;
+
+    /** Destination port */
+    uint16_t                m_port;
+
+    /** Datagram */
+    std::vector<uint8_t>    m_packet;
+
+    /**
+     *  Open the socket, if not already done.
+     *
+     *  @param[in] ttl  Multicast time to live
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool open(int ttl);
+
+    /* Not allowed. */
+    WiFiUDP(const WiFiUDP& udp);
+    WiFiUDP& operator=(const WiFiUDP& udp);
+};
+
+#endif /* WIFI_UDP_H_ */
@@ -0,0 +1,199 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cooperative task scheduler.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Scheduler.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool Scheduler::setSensorTask(const char* name, TaskFunc func, uint32_t budget)
+{
+    bool isSuccess = false;
+
+    if (nullptr != func)
+    {
+        initTask(m_sensorTask, name, func, 0U, budget, 0U);
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+bool Scheduler::addTask(const char* name, TaskFunc func, uint32_t period, uint32_t budget, uint8_t priority)
+{
+    bool isSuccess = false;
+
+    if ((nullptr != func) &&
+        (MAX_TASKS > m_taskCount))
+    {
+        uint8_t idx = m_taskCount;
+
+        /* Keep the tasks sorted by priority. Tasks with the same priority run in the order they were added. */
+        while ((0U < idx) && (m_tasks[idx - 1U].priority > priority))
+        {
+            m_tasks[idx] = m_tasks[idx - 1U];
+            --idx;
+        }
+
+        initTask(m_tasks[idx], name, func, period, budget, priority);
+        ++m_taskCount;
+
+        isSuccess = true;
+    }
+
+    return isSuccess;
+}
+
+bool Scheduler::process()
+{
+    bool        isSuccess   = true;
+    uint8_t     idx         = 0;
+    uint32_t    timestamp   = m_timeSource();
+
+    if (0U != m_lastProcessTimestamp)
+    {
+        m_loopPeriods.record(timestamp - m_lastProcessTimestamp);
+    }
+
+    m_lastProcessTimestamp = timestamp;
+
+    for (idx = 0; idx < m_taskCount; ++idx)
+    {
+        Task&       task    = m_tasks[idx];
+        uint32_t    now     = m_timeSource();
+
+        if ((0U == task.period) ||
+            (task.period <= (now - task.lastRun)))
+        {
+            /* The sensor is polled before every task, to keep the latency low. */
+            if ((nullptr != m_sensorTask.func) &&
+                (false == runTask(m_sensorTask)))
+            {
+                isSuccess = false;
+            }
+
+            if (false == runTask(task))
+            {
+                isSuccess = false;
+            }
+        }
+    }
+
+    /* The sensor task runs at least once per cycle. */
+    if ((nullptr != m_sensorTask.func) &&
+        (false == runTask(m_sensorTask)))
+    {
+        isSuccess = false;
+    }
+
+    return isSuccess;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Scheduler::initTask(Task& task, const char* name, TaskFunc func, uint32_t period, uint32_t budget, uint8_t priority)
+{
+    task.name           = name;
+    task.func           = func;
+    task.period         = period;
+    task.budget         = budget;
+    task.priority       = priority;
+    task.lastRun        = m_timeSource() - period; /* Due at once. */
+    task.runCount       = 0U;
+    task.overrunCount   = 0U;
+    task.lastRuntime    = 0U;
+    task.maxRuntime     = 0U;
+    task.totalRuntime   = 0U;
+    task.runtimes.clear();
+}
+
+bool Scheduler::runTask(Task& task)
+{
+    uint32_t    start       = m_timeSource();
+    bool        isSuccess   = task.func();
+    uint32_t    runtime     = m_timeSource() - start;
+
+    task.lastRun        = start;
+    task.lastRuntime    = runtime;
+    task.totalRuntime  += runtime;
+    task.runtimes.record(runtime);
+    ++task.runCount;
+
+    if (task.maxRuntime < runtime)
+    {
+        task.maxRuntime = runtime;
+    }
+
+    if (task.budget < runtime)
+    {
+        ++task.overrunCount;
+    }
+
+    return isSuccess;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
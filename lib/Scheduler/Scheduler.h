@@ -0,0 +1,260 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cooperative task scheduler.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include "Histogram.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Cooperative task scheduler for the main loop.
+ *
+ *  Tasks are registered with a period, a priority and a time budget. Every
+ *  call to process() runs the due tasks in the order of their priority.
+ *  The sensor task is special: it runs before every other task, because the
+ *  accuracy of the lap time depends on how fast the sensor is polled.
+ *
+ *  The runtime of every task is measured, runs which exceed the time budget
+ *  are counted as overrun. The time source can be replaced, e.g. by a
+ *  virtual clock for testing.
+ */
+class Scheduler
+{
+public:
+
+    /**
+     *  Task function.
+     *
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    typedef bool (*TaskFunc)();
+
+    /**
+     *  Time source, which provides a free running timestamp in us.
+     *
+     *  @return Timestamp in us.
+     */
+    typedef unsigned long (*TimeSource)();
+
+    /** Task and its runtime statistics. */
+    typedef struct
+    {
+        const char* name;           /**< Task name. */
+        TaskFunc    func;           /**< Task function. */
+        uint32_t    period;         /**< Period in us. 0 means the task runs every cycle. */
+        uint32_t    budget;         /**< Time budget for a single run in us. */
+        uint8_t     priority;       /**< Priority, 0 is the highest. */
+        uint32_t    lastRun;        /**< Timestamp in us of the last run. */
+        uint32_t    runCount;       /**< Number of runs. */
+        uint32_t    overrunCount;   /**< Number of runs, which exceeded the time budget. */
+        uint32_t    lastRuntime;    /**< Runtime of the last run in us. */
+        uint32_t    maxRuntime;     /**< Max. runtime of a single run in us. */
+        uint64_t    totalRuntime;   /**< Accumulated runtime of all runs in us. */
+        Histogram   runtimes;       /**< Distribution of the runtimes in us. */
+
+    } Task;
+
+    /** Max. number of tasks, without the sensor task. */
+    static const uint8_t MAX_TASKS = 8U;
+
+    /**
+     *  Constructs the scheduler.
+     *
+     *  @param[in] timeSource   Time source in us.
+     */
+    explicit Scheduler(TimeSource timeSource = micros) :
+        m_timeSource(timeSource),
+        m_sensorTask(),
+        m_tasks(),
+        m_taskCount(0),
+        m_lastProcessTimestamp(0),
+        m_loopPeriods()
+    {
+    }
+
+    /**
+     *  Destroys the scheduler.
+     */
+    ~Scheduler()
+    {
+    }
+
+    /**
+     *  Set the sensor task, which runs before every other task.
+     *
+     *  @param[in] name     Task name.
+     *  @param[in] func     Task function.
+     *  @param[in] budget   Time budget for a single run in us.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool setSensorTask(const char* name, TaskFunc func, uint32_t budget);
+
+    /**
+     *  Add a task.
+     *
+     *  @param[in] name     Task name.
+     *  @param[in] func     Task function.
+     *  @param[in] period   Period in us. 0 means the task runs every cycle.
+     *  @param[in] budget   Time budget for a single run in us.
+     *  @param[in] priority Priority, 0 is the highest.
+     *  @return If successful, returns true. Otherwise, false.
+     */
+    bool addTask(const char* name, TaskFunc func, uint32_t period, uint32_t budget, uint8_t priority);
+
+    /**
+     *  Run all due tasks once, in the order of their priority.
+     *
+     *  @return If all tasks were successful, returns true. Otherwise, false.
+     */
+    bool process();
+
+    /**
+     *  Get the sensor task.
+     *
+     *  @return Sensor task
+     */
+    const Task& getSensorTask() const
+    {
+        return m_sensorTask;
+    }
+
+    /**
+     *  Get the number of tasks, without the sensor task.
+     *
+     *  @return Number of tasks
+     */
+    uint8_t getTaskCount() const
+    {
+        return m_taskCount;
+    }
+
+    /**
+     *  Get a task by index. The tasks are sorted by priority.
+     *
+     *  @param[in] idx  Task index
+     *  @return Task. If the index is invalid, nullptr is returned.
+     */
+    const Task* getTask(uint8_t idx) const
+    {
+        const Task* task = nullptr;
+
+        if (m_taskCount > idx)
+        {
+            task = &m_tasks[idx];
+        }
+
+        return task;
+    }
+
+    /**
+     *  Get the distribution of the loop periods, which is the time in us
+     *  between two consecutive calls of process().
+     *
+     *  @return Loop period histogram
+     */
+    const Histogram& getLoopPeriods() const
+    {
+        return m_loopPeriods;
+    }
+
+private:
+
+    /** Time source in us. */
+    TimeSource  m_timeSource;
+
+    /** Sensor task, which runs before every other task. */
+    Task        m_sensorTask;
+
+    /** Tasks, sorted by priority. */
+    Task        m_tasks[MAX_TASKS];
+
+    /** Number of tasks. */
+    uint8_t     m_taskCount;
+
+    /** Timestamp in us of the last call of process(). 0 means not called yet. */
+    uint32_t    m_lastProcessTimestamp;
+
+    /** Distribution of the loop periods in us. */
+    Histogram   m_loopPeriods;
+
+    /**
+     *  Initialize a task.
+     *
+     *  @param[out] task        Task to initialize.
+     *  @param[in]  name        Task name.
+     *  @param[in]  func        Task function.
+     *  @param[in]  period      Period in us.
+     *  @param[in]  budget      Time budget for a single run in us.
+     *  @param[in]  priority    Priority, 0 is the highest.
+     */
+    void initTask(Task& task, const char* name, TaskFunc func, uint32_t period, uint32_t budget, uint8_t priority);
+
+    /**
+     *  Run a task and update its runtime statistics.
+     *
+     *  @param[in,out] task Task to run.
+     *  @return If the task was successful, returns true. Otherwise, false.
+     */
+    bool runTask(Task& task);
+
+    /** 
+     *  An instance shall not be copied. 
+     *  
+     *  @param[in] scheduler Scheduler instance to copy.
+     */
+    Scheduler(const Scheduler& scheduler);
+
+    /** 
+     *  An instance shall not assigned.
+     *   
+     *  @param[in] scheduler Scheduler instance to assign.
+     *  @return Reference to this instance.
+     */
+    Scheduler& operator=(const Scheduler& scheduler);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SCHEDULER_H_ */
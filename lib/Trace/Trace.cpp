@@ -0,0 +1,158 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Event timeline tracer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Trace.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+/** Ring buffer with the recorded events. */
+static Trace::Event     gEvents[TRACE_BUFFER_EVENTS];
+
+/** Index of the next event to write. */
+static size_t           gWriteIdx   = 0U;
+
+/** Number of recorded events in the ring buffer. */
+static size_t           gCount      = 0U;
+
+/** Is the recording enabled? */
+static bool             gIsEnabled  = true;
+
+/** Names of the trace points, in the order of Trace::Id. */
+static const char*      gNames[Trace::ID_MAX] =
+{
+    "competition",
+    "webServer",
+    "webSocket",
+    "mdns",
+    "wifi",
+    "wifiConnect",
+    "wifiState",
+    "flashCommit",
+    "runStarted",
+    "runFinished"
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+void Trace::record(Trace::Type type, Trace::Id id, uint16_t arg)
+{
+    if (true == gIsEnabled)
+    {
+        Trace::Event& event = gEvents[gWriteIdx];
+
+        event.timestamp = micros();
+        event.type      = static_cast<uint8_t>(type);
+        event.id        = static_cast<uint8_t>(id);
+        event.arg       = arg;
+
+        gWriteIdx = (gWriteIdx + 1U) % TRACE_BUFFER_EVENTS;
+
+        if (TRACE_BUFFER_EVENTS > gCount)
+        {
+            ++gCount;
+        }
+    }
+}
+
+void Trace::setEnabled(bool isEnabled)
+{
+    gIsEnabled = isEnabled;
+}
+
+size_t Trace::getCount()
+{
+    return gCount;
+}
+
+bool Trace::getEvent(size_t idx, Trace::Event& event)
+{
+    bool isAvailable = false;
+
+    if (gCount > idx)
+    {
+        /* The oldest event is at the write index, as soon as the ring buffer is full. */
+        size_t oldestIdx = (gWriteIdx + TRACE_BUFFER_EVENTS - gCount) % TRACE_BUFFER_EVENTS;
+
+        event       = gEvents[(oldestIdx + idx) % TRACE_BUFFER_EVENTS];
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+const char* Trace::getName(uint8_t id)
+{
+    const char* name = "unknown";
+
+    if (Trace::ID_MAX > id)
+    {
+        name = gNames[id];
+    }
+
+    return name;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Event timeline tracer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Tracing is enabled by default. Set it to 0 to remove all trace points. */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED           1
+#endif
+
+/** Number of events in the trace ring buffer. Every event needs 8 byte. */
+#ifndef TRACE_BUFFER_EVENTS
+#define TRACE_BUFFER_EVENTS     256U
+#endif
+
+/** Concatenate two tokens, after their expansion. */
+#define TRACE_CONCAT_(a, b)     a##b
+
+/** Concatenate two tokens. */
+#define TRACE_CONCAT(a, b)      TRACE_CONCAT_(a, b)
+
+#if (0 != TRACE_ENABLED)
+
+/** Trace the current scope with a begin and a end event. */
+#define TRACE_SCOPE(id)         Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(id)
+
+/** Trace a instant event with a argument. */
+#define TRACE_INSTANT(id, arg)  Trace::record(Trace::TYPE_INSTANT, (id), (arg))
+
+#else
+
+#define TRACE_SCOPE(id)         ((void)0)
+#define TRACE_INSTANT(id, arg)  ((void)0)
+
+#endif
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Event timeline tracer.
+ *
+ *  Begin, end and instant events are recorded with a timestamp in us into
+ *  a fixed-size ring buffer. If it is full, the oldest events are
+ *  overwritten, therefore it always contains the latest history.
+ */
+namespace Trace
+{
+
+/** Event types. */
+typedef enum
+{
+    TYPE_BEGIN = 0, /**< Begin of a duration. */
+    TYPE_END,       /**< End of a duration. */
+    TYPE_INSTANT    /**< Instant event. */
+
+} Type;
+
+/** Trace points. */
+typedef enum
+{
+    ID_COMPETITION = 0, /**< Competition handling, which polls the sensor. */
+    ID_WEB_SERVER,      /**< HTTP client handling. */
+    ID_WEB_SOCKET,      /**< Websocket client handling. */
+    ID_MDNS,            /**< mDNS responder. */
+    ID_WIFI,            /**< Wi-Fi state machine. */
+    ID_WIFI_CONNECT,    /**< Start of a Wi-Fi station connect. */
+    ID_WIFI_STATE,      /**< Wi-Fi state change, the argument is the new state. */
+    ID_FLASH_COMMIT,    /**< Write of the settings to flash. */
+    ID_RUN_STARTED,     /**< Run started, the argument is the group. */
+    ID_RUN_FINISHED,    /**< Run finished, the argument is the group. */
+    ID_MAX              /**< Number of trace points. */
+
+} Id;
+
+/** A single recorded event. */
+typedef struct
+{
+    uint32_t    timestamp;  /**< Timestamp in us. */
+    uint8_t     type;       /**< Event type, see Type. */
+    uint8_t     id;         /**< Trace point, see Id. */
+    uint16_t    arg;        /**< Argument of instant events. */
+
+} Event;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Record a event.
+ * 
+ * @param[in] type  Event type.
+ * @param[in] id    Trace point.
+ * @param[in] arg   Argument, only used by instant events.
+ */
+void record(Type type, Id id, uint16_t arg);
+
+/**
+ * Enable or disable the recording, e.g. to read a consistent timeline.
+ * 
+ * @param[in] isEnabled Enable (true) or disable (false).
+ */
+void setEnabled(bool isEnabled);
+
+/**
+ * Get the number of recorded events in the ring buffer.
+ * 
+ * @return Number of events
+ */
+size_t getCount();
+
+/**
+ * Get a recorded event, the oldest one has index 0.
+ * 
+ * @param[in]   idx     Event index.
+ * @param[out]  event   Event.
+ * 
+ * @return If the event exists, returns true. Otherwise, false.
+ */
+bool getEvent(size_t idx, Event& event);
+
+/**
+ * Get the name of a trace point.
+ * 
+ * @param[in] id    Trace point.
+ * 
+ * @return Name
+ */
+const char* getName(uint8_t id);
+
+/**
+ * Records a begin event on construction and a end event on destruction.
+ */
+class Scope
+{
+public:
+
+    /**
+     * Records the begin event.
+     * 
+     * @param[in] id    Trace point.
+     */
+    explicit Scope(Id id) :
+        m_id(id)
+    {
+        record(TYPE_BEGIN, m_id, 0U);
+    }
+
+    /**
+     * Records the end event.
+     */
+    ~Scope()
+    {
+        record(TYPE_END, m_id, 0U);
+    }
+
+private:
+
+    /** Trace point. */
+    Id m_id;
+
+    /* Default constructor not allowed. */
+    Scope();
+
+    /** 
+     *  An instance shall not be copied. 
+     *  
+     *  @param[in] scope Scope instance to copy.
+     */
+    Scope(const Scope& scope);
+
+    /** 
+     *  An instance shall not assigned.
+     *   
+     *  @param[in] scope Scope instance to assign.
+     *  @return Reference to this instance.
+     */
+    Scope& operator=(const Scope& scope);
+};
+
+};
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,130 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Timing event feed via UDP multicast.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "UdpEventFeed.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt32(uint8_t *buffer, uint32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Organization-local scope multicast group, see RFC 2365. */
+const uint8_t UdpEventFeed::MULTICAST_ADDRESS[4] = { 239U, 255U, 76U, 84U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void UdpEventFeed::publish(EventType type, uint8_t group, uint8_t rank, uint32_t lapTime)
+{
+    uint8_t     datagram[DATAGRAM_SIZE];
+    IPAddress   interfaceAddress;
+
+    datagram[0]     = 'R';
+    datagram[1]     = 'L';
+    datagram[2]     = PROTOCOL_VERSION;
+    datagram[3]     = static_cast<uint8_t>(type);
+    writeUInt32(&datagram[4], m_sequenceNumber);
+    writeUInt32(&datagram[8], millis());
+    datagram[12]    = group;
+    datagram[13]    = rank;
+    writeUInt32(&datagram[14], lapTime);
+
+    ++m_sequenceNumber;
+
+    /* Station interface has priority, otherwise the access point interface is used. */
+    if (WL_CONNECTED == WiFi.status())
+    {
+        interfaceAddress = WiFi.localIP();
+    }
+    else
+    {
+        interfaceAddress = WiFi.softAPIP();
+    }
+
+    if (0 != m_udp.beginPacketMulticast(IPAddress(MULTICAST_ADDRESS[0], MULTICAST_ADDRESS[1], MULTICAST_ADDRESS[2], MULTICAST_ADDRESS[3]),
+                                        MULTICAST_PORT,
+                                        interfaceAddress))
+    {
+        (void)m_udp.write(datagram, DATAGRAM_SIZE);
+        (void)m_udp.endPacket();
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ *  Write a 32-bit unsigned integer in network byte order.
+ *
+ *  @param[out] buffer  Destination with at least 4 bytes.
+ *  @param[in]  value   Value to write.
+ */
+static void writeUInt32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 24U);
+    buffer[1] = static_cast<uint8_t>(value >> 16U);
+    buffer[2] = static_cast<uint8_t>(value >> 8U);
+    buffer[3] = static_cast<uint8_t>(value);
+}
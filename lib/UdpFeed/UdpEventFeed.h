@@ -0,0 +1,180 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Timing event feed via UDP multicast.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef UDP_EVENT_FEED_H_
+#define UDP_EVENT_FEED_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ *  Publishes the timing events as compact fixed-format UDP multicast datagrams.
+ *  Any number of listeners (scoreboards, commentary PCs) can subscribe to the
+ *  multicast group, without additional cost on the device.
+ *
+ *  Datagram layout, all values in network byte order (big endian):
+ *
+ *  | Offset | Size | Description                                          |
+ *  |--------|------|------------------------------------------------------|
+ *  | 0      | 2    | Magic "RL"                                           |
+ *  | 2      | 1    | Protocol version                                     |
+ *  | 3      | 1    | Event type, see EventType                            |
+ *  | 4      | 4    | Sequence number, incremented by every datagram       |
+ *  | 8      | 4    | Device timestamp in ms                               |
+ *  | 12     | 1    | Group index                                          |
+ *  | 13     | 1    | Rank of the group (1 based), 0 if not ranked         |
+ *  | 14     | 4    | Lap time in ms, 0 if not available                   |
+ */
+class UdpEventFeed
+{
+public:
+
+    /** Event types. */
+    typedef enum
+    {
+        EVENT_TYPE_STARTED      = 1,    /**< Run started. Group only. */
+        EVENT_TYPE_FINISHED     = 2,    /**< Run finished. Group and measured lap time. */
+        EVENT_TYPE_LEADERBOARD  = 3     /**< Leaderboard entry. Group, rank and fastest lap time. */
+
+    } EventType;
+
+    /** Multicast group address. */
+    static const uint8_t    MULTICAST_ADDRESS[4];
+
+    /** Multicast port. */
+    static const uint16_t   MULTICAST_PORT      = 7684U;
+
+    /** Protocol version. */
+    static const uint8_t    PROTOCOL_VERSION    = 1U;
+
+    /** Datagram size in byte. */
+    static const size_t     DATAGRAM_SIZE       = 18U;
+
+    /**
+     *  Constructs the event feed.
+     */
+    UdpEventFeed() :
+        m_udp(),
+        m_sequenceNumber(0)
+    {
+    }
+
+    /**
+     *  Destroys the event feed.
+     */
+    ~UdpEventFeed()
+    {
+    }
+
+    /**
+     *  Publish that a run of a group started.
+     *
+     *  @param[in] group    Group index.
+     */
+    void publishStarted(uint8_t group)
+    {
+        publish(EVENT_TYPE_STARTED, group, 0U, 0U);
+    }
+
+    /**
+     *  Publish that a run of a group finished.
+     *
+     *  @param[in] group    Group index.
+     *  @param[in] lapTime  Measured lap time in ms.
+     */
+    void publishFinished(uint8_t group, uint32_t lapTime)
+    {
+        publish(EVENT_TYPE_FINISHED, group, 0U, lapTime);
+    }
+
+    /**
+     *  Publish a single leaderboard entry.
+     *
+     *  @param[in] group    Group index.
+     *  @param[in] rank     Rank of the group, 1 based. 0 if the group has no lap time.
+     *  @param[in] lapTime  Fastest lap time in ms.
+     */
+    void publishLeaderboard(uint8_t group, uint8_t rank, uint32_t lapTime)
+    {
+        publish(EVENT_TYPE_LEADERBOARD, group, rank, lapTime);
+    }
+
+private:
+
+    /** UDP socket. */
+    WiFiUDP     m_udp;
+
+    /** Sequence number of the next datagram. Listeners use it to detect lost datagrams. */
+    uint32_t    m_sequenceNumber;
+
+    /**
+     *  Serialize the event and send it to the multicast group.
+     *  If the network is not available, the datagram is dropped.
+     *
+     *  @param[in] type     Event type.
+     *  @param[in] group    Group index.
+     *  @param[in] rank     Rank of the group.
+     *  @param[in] lapTime  Lap time in ms.
+     */
+    void publish(EventType type, uint8_t group, uint8_t rank, uint32_t lapTime);
+
+    /** 
+     *  An instance shall not be copied. 
+     *  
+     *  @param[in] feed Feed instance to copy.
+     */
+    UdpEventFeed(const UdpEventFeed &feed);
+
+    /** 
+     *  An instance shall not assigned.
+     *   
+     *  @param[in] feed Feed instance to assign.
+     *  @return Reference to this instance.
+     */
+    UdpEventFeed &operator=(const UdpEventFeed &feed);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* UDP_EVENT_FEED_H_ */
@@ -36,6 +36,7 @@
 #include "Settings.h"
 
 #include <Log.h>
+#include <Trace.h>
 
 /******************************************************************************
  * Macros
@@ -58,7 +59,16 @@
  *****************************************************************************/
 
 WIFI::WIFI() :
-    m_isStaAvailable(false),
+    m_state(STATE_IDLE),
+    m_stateTimestamp(0),
+    m_backOffPeriod(0),
+    m_failedAttempts(0),
+    m_wasStaConnected(false),
+    m_isApActive(false),
+    m_isFastConnect(false),
+    m_isFastConnectFailed(false),
+    m_connectTimestamp(0),
+    m_connectDuration(0),
     m_apSSID(AP_MODE_SSID_DEFAULT),
     m_apPassword(AP_MODE_PASSWORD_DEFAULT),
     m_staSSID(),
@@ -78,57 +88,103 @@ bool WIFI::begin()
     Settings::getInstance().getWiFiSSD(m_staSSID);
     Settings::getInstance().getWiFiPassphrase(m_staPassword);
 
+    /* The credentials are managed by the settings, avoid additional flash writes. */
+    WiFi.persistent(false);
+
     if ((0 < m_staSSID.length()) &&
         (0 < m_staPassword.length()))
     {
         WiFi.mode(WIFI_STA);
-        WiFi.begin(m_staSSID, m_staPassword);
-
-        if (connectStation())
-        {
-            m_localIP = WiFi.localIP();
-            m_isStaAvailable = true;
-        }
-        else
-        {
-            LOG_INFO("Network not in range or invalid credentials.");
-            LOG_INFO("Starting AP...");
-
-            WiFi.mode(WIFI_AP);
-            WiFi.softAP(m_apSSID, m_apPassword);
-            m_localIP = WiFi.softAPIP();
-        }
-
-            isSuccess = true;
-        }
+        startStationConnect();
+    }
     else
     {
         LOG_INFO("No stored STA Credentials!");
-        LOG_INFO("Starting AP");
 
-        WiFi.mode(WIFI_AP);
-        WiFi.softAP(m_apSSID, m_apPassword);
-        m_localIP = WiFi.softAPIP();
-
-        isSuccess = true;
+        startAccessPoint(false);
+        m_state = STATE_AP;
     }
 
-    LOG_INFO(getIPAddress().toString());
-
     return isSuccess;
 }
 
 bool WIFI::runCycle()
 {
-    bool isSuccess = true;
+    bool    isSuccess   = true;
+    State   state       = m_state;
+
+    TRACE_SCOPE(Trace::ID_WIFI);
 
-    if (m_isStaAvailable)
+    switch (m_state)
     {
+    case STATE_IDLE:
+        /* Not started yet. */
+        break;
+
+    case STATE_STA_CONNECTING:
+        if (WL_CONNECTED == WiFi.status())
+        {
+            onStationConnected();
+        }
+        else if ((true == m_isFastConnect) &&
+                 (FAST_CONNECT_TIMEOUT_MS <= (millis() - m_stateTimestamp)))
+        {
+            LOG_INFO("Fast connect failed.");
+
+            /* Access point may have changed, fall back to full connect with scan at once. */
+            m_isFastConnectFailed = true;
+            startStationConnect();
+        }
+        else if (WIFI_TIMEOUT_MS <= (millis() - m_stateTimestamp))
+        {
+            onStationConnectFailed();
+        }
+        else
+        {
+            /* Connection is still in progress. */
+            ;
+        }
+        break;
+
+    case STATE_STA_CONNECTED:
         if (WL_CONNECTED != WiFi.status())
         {
-            isSuccess = connectStation();
+            LOG_WARNING("Connection lost.");
+
+            m_failedAttempts = 0;
+            startStationConnect();
+        }
+        break;
+
+    case STATE_STA_BACKOFF:
+        if (WL_CONNECTED == WiFi.status())
+        {
+            onStationConnected();
+        }
+        else if (m_backOffPeriod <= (millis() - m_stateTimestamp))
+        {
+            startStationConnect();
         }
+        else
+        {
+            /* Wait for the next attempt. */
+            ;
+        }
+        break;
+
+    case STATE_AP:
+        /* Nothing to do. */
+        break;
+
+    default:
+        break;
+    }
+
+    if (state != m_state)
+    {
+        TRACE_INSTANT(Trace::ID_WIFI_STATE, m_state);
     }
+
     return isSuccess;
 }
 
@@ -145,25 +201,167 @@ const IPAddress &WIFI::getIPAddress(void)
  * Private Methods
  *****************************************************************************/
 
-bool WIFI::connectStation()
+void WIFI::startStationConnect()
 {
-    bool isSuccess = false;
-    unsigned long startAttempTime = millis();
+    Settings::WiFiFastConnect fastConnect;
+
+    TRACE_SCOPE(Trace::ID_WIFI_CONNECT);
 
-    LOG_INFO(String("Connecting to \"") + m_staSSID + "\"...");
-    while ((WiFi.status() != WL_CONNECTED) && ((millis() - startAttempTime) < WIFI_TIMEOUT_MS))
+    /* A fallback from fast to full connect continues the current connection. */
+    if (STATE_STA_CONNECTING != m_state)
     {
-        delay(100);
+        m_connectTimestamp = millis();
     }
 
-    if (WL_CONNECTED == WiFi.status())
+    /* WiFi.begin() returns immediately, the result is polled in runCycle(). */
+    if ((false == m_isFastConnectFailed) &&
+        (true == Settings::getInstance().getWiFiFastConnect(fastConnect)))
+    {
+        LOG_INFO("Fast connecting to \"%s\" on channel %u...", m_staSSID.c_str(), fastConnect.channel);
+
+        /* Reuse the IP configuration of the last connection, instead of waiting for DHCP. */
+        (void)WiFi.config(IPAddress(fastConnect.localIP),
+                          IPAddress(fastConnect.gatewayIP),
+                          IPAddress(fastConnect.subnetMask),
+                          IPAddress(fastConnect.dnsIP));
+        (void)WiFi.begin(m_staSSID, m_staPassword, fastConnect.channel, fastConnect.bssid);
+
+        m_isFastConnect = true;
+    }
+    else
+    {
+        LOG_INFO("Connecting to \"%s\"...", m_staSSID.c_str());
+
+        /* A IP address of 0.0.0.0 enables DHCP. */
+        (void)WiFi.config(IPAddress(0U), IPAddress(0U), IPAddress(0U));
+        (void)WiFi.begin(m_staSSID, m_staPassword);
+
+        m_isFastConnect = false;
+    }
+
+    m_state             = STATE_STA_CONNECTING;
+    m_stateTimestamp    = millis();
+}
+
+void WIFI::onStationConnected()
+{
+    m_connectDuration = millis() - m_connectTimestamp;
+
+    LOG_INFO("Connected Succesfully after %lu ms (%s connect), %lu ms after boot.",
+        m_connectDuration,
+        (true == m_isFastConnect) ? "fast" : "full",
+        millis());
+
+    m_state                 = STATE_STA_CONNECTED;
+    m_stateTimestamp        = millis();
+    m_failedAttempts        = 0;
+    m_wasStaConnected       = true;
+    m_isFastConnectFailed   = false;
+
+    if (false == m_isFastConnect)
+    {
+        storeFastConnect();
+    }
+
+    /* If the access point runs as fallback, it stays, because operators may be connected to it. */
+    if (false == m_isApActive)
     {
-        LOG_INFO("Connected Succesfully.");
-        isSuccess = true;
         m_localIP = WiFi.localIP();
     }
 
-    return isSuccess;
+    LOG_INFO("IP: %s", WiFi.localIP().toString().c_str());
+}
+
+void WIFI::storeFastConnect()
+{
+    Settings::WiFiFastConnect   current;
+    Settings::WiFiFastConnect   stored;
+    const uint8_t*              bssid   = WiFi.BSSID();
+
+    if (nullptr != bssid)
+    {
+        memcpy(current.bssid, bssid, Settings::BSSID_LENGTH);
+        current.channel     = static_cast<uint8_t>(WiFi.channel());
+        current.localIP     = WiFi.localIP();
+        current.gatewayIP   = WiFi.gatewayIP();
+        current.subnetMask  = WiFi.subnetMask();
+        current.dnsIP       = WiFi.dnsIP();
+
+        /* Avoid flash wear, if nothing changed. */
+        if ((false == Settings::getInstance().getWiFiFastConnect(stored)) ||
+            (0 != memcmp(current.bssid, stored.bssid, Settings::BSSID_LENGTH)) ||
+            (current.channel != stored.channel) ||
+            (current.localIP != stored.localIP) ||
+            (current.gatewayIP != stored.gatewayIP) ||
+            (current.subnetMask != stored.subnetMask) ||
+            (current.dnsIP != stored.dnsIP))
+        {
+            LOG_INFO("Store fast connect parameters.");
+            Settings::getInstance().setWiFiFastConnect(current);
+        }
+    }
+}
+
+void WIFI::onStationConnectFailed()
+{
+    uint8_t shift = 0;
+
+    if (UINT8_MAX > m_failedAttempts)
+    {
+        ++m_failedAttempts;
+    }
+
+    LOG_INFO("Network not in range or invalid credentials.");
+
+    /* Stop the ongoing attempt, so the access point is not disturbed by scanning during back-off. */
+    (void)WiFi.disconnect();
+
+    /* If the station was never connected since boot, the access point is
+     * started immediately, like the user may need it to fix the credentials.
+     * Otherwise it is started after several failed attempts in a row.
+     */
+    if ((false == m_isApActive) &&
+        ((false == m_wasStaConnected) || (AP_FALLBACK_ATTEMPTS <= m_failedAttempts)))
+    {
+        startAccessPoint(true);
+    }
+
+    /* Exponential back-off: BACKOFF_MIN_MS, 2 * BACKOFF_MIN_MS, 4 * BACKOFF_MIN_MS, ... */
+    shift = m_failedAttempts - 1U;
+
+    if ((BACKOFF_SHIFT_LIMIT <= shift) ||
+        ((BACKOFF_MAX_MS >> shift) < BACKOFF_MIN_MS))
+    {
+        m_backOffPeriod = BACKOFF_MAX_MS;
+    }
+    else
+    {
+        m_backOffPeriod = BACKOFF_MIN_MS << shift;
+    }
+
+    m_state             = STATE_STA_BACKOFF;
+    m_stateTimestamp    = millis();
+}
+
+void WIFI::startAccessPoint(bool isStaRequired)
+{
+    LOG_INFO("Starting AP...");
+
+    if (true == isStaRequired)
+    {
+        WiFi.mode(WIFI_AP_STA);
+    }
+    else
+    {
+        WiFi.mode(WIFI_AP);
+    }
+
+    (void)WiFi.softAP(m_apSSID, m_apPassword);
+
+    m_isApActive    = true;
+    m_localIP       = WiFi.softAPIP();
+
+    LOG_INFO("IP: %s", m_localIP.toString().c_str());
 }
 
 /******************************************************************************
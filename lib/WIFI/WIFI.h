@@ -71,6 +71,7 @@ public:
 
     /**
      *  Executes WIFI Connection Check.
+     *  It advances the connection state machine by one step and never blocks.
      * 
      *  @return success.
      */
@@ -83,27 +84,129 @@ public:
      */
     const IPAddress &getIPAddress(void);
 
-private:
+    /**
+     *  Get the duration of the last successful station connection, measured
+     *  from the start of the connection attempt until the link was up.
+     * 
+     *  @return Connection duration in ms. 0 if never connected.
+     */
+    unsigned long getConnectDuration() const
+    {
+        return m_connectDuration;
+    }
 
     /**
-     *  Connect to Wireless Access Point.
+     *  Was the last successful station connection established by the fast connect?
      * 
-     *  @return If the device is succesfully connected to the Wireless Network, 
-     *  returns true. Otherwise false.
+     *  @return If fast connected, returns true. Otherwise, false.
      */
-    bool connectStation();
+    bool isFastConnected() const
+    {
+        return m_isFastConnect;
+    }
+
+private:
 
-    /** Timeout for WiFi connection. */
+    /**
+     *  Connection states.
+     */
+    typedef enum
+    {
+        STATE_IDLE = 0,         /**< Not started yet. */
+        STATE_STA_CONNECTING,   /**< Station connection is in progress. */
+        STATE_STA_CONNECTED,    /**< Station is connected. */
+        STATE_STA_BACKOFF,      /**< Waiting before the next station connection attempt. */
+        STATE_AP                /**< Access point only, because no station credentials are available. */
+
+    } State;
+
+    /**
+     *  Start a station connection attempt. It doesn't wait for the result.
+     */
+    void startStationConnect();
+
+    /**
+     *  Handle a established station connection.
+     *  After a full connect, the connection parameters are stored for the next fast connect.
+     */
+    void onStationConnected();
+
+    /**
+     *  Store the parameters of the current station connection for the next fast connect.
+     *  They are only written, if they changed.
+     */
+    void storeFastConnect();
+
+    /**
+     *  Handle a failed station connection attempt.
+     *  The next attempt is delayed by a exponential back-off.
+     */
+    void onStationConnectFailed();
+
+    /**
+     *  Start the access point.
+     *
+     *  @param[in] isStaRequired    If station mode shall be kept in parallel, set to true.
+     */
+    void startAccessPoint(bool isStaRequired);
+
+    /** Timeout for a single WiFi connection attempt. */
     static const unsigned long      WIFI_TIMEOUT_MS         = 30000;
 
+    /**
+     *  Timeout for a fast connect attempt with the stored BSSID, channel and
+     *  IP configuration. It usually takes less than a second, because neither
+     *  a scan nor DHCP is necessary.
+     */
+    static const unsigned long      FAST_CONNECT_TIMEOUT_MS = 5000;
+
+    /** Back-off period after the first failed connection attempt. It doubles with every further failed attempt. */
+    static const unsigned long      BACKOFF_MIN_MS          = 1000;
+
+    /** Max. back-off period between two connection attempts. */
+    static const unsigned long      BACKOFF_MAX_MS          = 60000;
+
+    /** Limits the back-off shift, to avoid a shift beyond the width of the period type. */
+    static const uint8_t            BACKOFF_SHIFT_LIMIT     = 16;
+
+    /** Number of failed connection attempts in a row, after which the access point is started as fallback. */
+    static const uint8_t            AP_FALLBACK_ATTEMPTS    = 3;
+
     /** Default SSID for access point mode. */
     static constexpr const char*   AP_MODE_SSID_DEFAULT     = "RacingLapTimer";
 
     /** Default password for access point mode. */
     static constexpr const char*   AP_MODE_PASSWORD_DEFAULT = "let me in";
 
-    /** true if system is connected in STA mode to a Network. */
-    bool m_isStaAvailable;
+    /** Current connection state. */
+    State m_state;
+
+    /** Timestamp in ms of the last state change. */
+    unsigned long m_stateTimestamp;
+
+    /** Back-off period in ms, before the next connection attempt. */
+    unsigned long m_backOffPeriod;
+
+    /** Number of failed connection attempts in a row. */
+    uint8_t m_failedAttempts;
+
+    /** true if the station was connected at least once since boot. */
+    bool m_wasStaConnected;
+
+    /** true if the access point is running. */
+    bool m_isApActive;
+
+    /** true if the current or last connection attempt is a fast connect. */
+    bool m_isFastConnect;
+
+    /** true if the fast connect failed, so the next attempt is a full connect with scan. */
+    bool m_isFastConnectFailed;
+
+    /** Timestamp in ms when the current connection was started, including a fallback from fast to full connect. */
+    unsigned long m_connectTimestamp;
+
+    /** Duration in ms of the last successful connection. */
+    unsigned long m_connectDuration;
 
     /** WiFi AP SSID. */
     String m_apSSID;
@@ -34,6 +34,9 @@
  *****************************************************************************/
 #include "LapTriggerWebServer.h"
 #include "Settings.h"
+#include "Metrics.h"
+#include "HeapMonitor.h"
+#include <Trace.h>
 
 #include <Log.h>
 
@@ -49,6 +52,9 @@
  * Prototypes
  *****************************************************************************/
 
+static bool toUInt8(const char *str, size_t length, uint8_t &value);
+static bool toUInt32(const char *str, size_t length, uint32_t &value);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -59,12 +65,26 @@
 
 LapTriggerWebServer::LapTriggerWebServer(Competition &goalLine) : m_laptrigger(&goalLine),
                                                                   m_webServer(WEBSERVER_PORT),
-                                                                  m_webSocketSrv(WEBSOCKET_PORT)
+                                                                  m_webSocketSrv(WEBSOCKET_PORT),
+                                                                  m_sseClients(),
+                                                                  m_sseKeepAliveTimestamp(0),
+                                                                  m_udpFeed(),
+                                                                  m_isStarted(false),
+                                                                  m_isTableChanged(false),
+                                                                  m_eventQueue(),
+                                                                  m_eventQueueHead(0U),
+                                                                  m_eventQueueCount(0U)
 {
+    if (false == EventBus::getInstance().subscribe(*this))
+    {
+        LOG_ERROR("Failed to subscribe to competition events.");
+    }
 }
 
 LapTriggerWebServer::~LapTriggerWebServer()
 {
+    EventBus::getInstance().unsubscribe(*this);
+
     /* Unmount Filesystem */
     LittleFS.end();
 }
@@ -86,6 +106,18 @@ bool LapTriggerWebServer::begin()
         m_webServer.on("/settings.html", HTTP_POST, [this]() {
             this->handleCredentials();
         });
+        m_webServer.on("/events", HTTP_GET, [this]() {
+            this->handleEvents();
+        });
+        m_webServer.on("/metrics", HTTP_GET, [this]() {
+            this->handleMetricsRequest();
+        });
+        m_webServer.on("/trace", HTTP_GET, [this]() {
+            this->handleTraceRequest();
+        });
+        m_webServer.on("/results", HTTP_GET, [this]() {
+            this->handleResultsRequest();
+        });
         m_webServer.onNotFound(
             [this]() {
                 this->m_webServer.send(404, "text/plain", "File not found.");
@@ -98,28 +130,116 @@ bool LapTriggerWebServer::begin()
                 this->webSocketEvent(num, type, payload, length);
             });
         m_webSocketSrv.begin();
+
+        m_isStarted = true;
     }
 
     return isSuccess;
 }
 
-bool LapTriggerWebServer::runCycle()
+bool LapTriggerWebServer::handleCompetition()
 {
-    bool isSuccess = false;
-    String outputMessage = "";
+    TRACE_SCOPE(Trace::ID_COMPETITION);
+
+    /* The events are only queued by the listeners, they are sent by the
+     * websocket and the web server task.
+     */
+    (void)m_laptrigger->handleCompetition();
+
+    return true;
+}
 
-    if (m_laptrigger->handleCompetition(outputMessage))
+void LapTriggerWebServer::onEvent(const EventBus::Event& event)
+{
+    switch (event.type)
     {
-        m_webSocketSrv.broadcastTXT(outputMessage);
+    case EventBus::EVENT_RUN_STARTED:
+        TRACE_INSTANT(Trace::ID_RUN_STARTED, event.group);
+        queueEvent(event);
+        break;
+
+    case EventBus::EVENT_RUN_FINISHED:
+        TRACE_INSTANT(Trace::ID_RUN_FINISHED, event.group);
+        queueEvent(event);
+        break;
+
+    case EventBus::EVENT_TABLE_CHANGED:
+        /* Several changes, e.g. of a batch, are sent once. */
+        m_isTableChanged = true;
+        break;
+
+    default:
+        break;
     }
+}
 
-    isSuccess = MDNS.update();
-    m_webServer.handleClient();
-    m_webSocketSrv.loop();
+bool LapTriggerWebServer::handleWebServer()
+{
+    sendQueuedEvents();
+
+    if (true == m_isStarted)
+    {
+        HEAP_SCOPE(HeapMonitor::TAG_WEB_SERVER);
+
+        {
+            TRACE_SCOPE(Trace::ID_WEB_SERVER);
+
+            m_webServer.handleClient();
+        }
+
+        if (true == m_isTableChanged)
+        {
+            m_isTableChanged = false;
+            notifyTableChanged();
+        }
+
+        /* Keep the server-sent event connections alive and detect dead ones. */
+        if (SSE_KEEP_ALIVE_PERIOD <= (millis() - m_sseKeepAliveTimestamp))
+        {
+            m_sseKeepAliveTimestamp = millis();
+            sendSseEvent("");
+        }
+    }
+
+    return true;
+}
+
+bool LapTriggerWebServer::handleWebSocket()
+{
+    sendQueuedEvents();
+
+    if (true == m_isStarted)
+    {
+        TRACE_SCOPE(Trace::ID_WEB_SOCKET);
+        HEAP_SCOPE(HeapMonitor::TAG_WEB_SOCKET);
+
+        m_webSocketSrv.loop();
+    }
+
+    return true;
+}
+
+bool LapTriggerWebServer::handleMDNS()
+{
+    bool isSuccess = true;
+
+    if (true == m_isStarted)
+    {
+        TRACE_SCOPE(Trace::ID_MDNS);
+
+        isSuccess = MDNS.update();
+    }
 
     return isSuccess;
 }
 
+bool LapTriggerWebServer::handleMetrics()
+{
+    Metrics::getInstance().sample(m_webSocketSrv.connectedClients());
+
+    return true;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -145,7 +265,7 @@ void LapTriggerWebServer::webSocketEvent(uint8_t clientId, WStype_t type, const
         break;
 
     case WStype_TEXT:
-        parseWSTextEvent(clientId, type, payload, length);
+        parseWSTextEvent(clientId, payload, length);
         break;
 
     case WStype_BIN:
@@ -183,6 +303,8 @@ void LapTriggerWebServer::webSocketEvent(uint8_t clientId, WStype_t type, const
 
 void LapTriggerWebServer::handleCredentials()
 {
+    HEAP_SCOPE(HeapMonitor::TAG_STRING);
+
     if (m_webServer.method() != HTTP_POST)
     {
         m_webServer.send(405, "text/plain", "Method Not Allowed");
@@ -212,24 +334,430 @@ void LapTriggerWebServer::handleCredentials()
                 message += " " + m_webServer.argName(i) + ": " + m_webServer.arg(i) + "\n";
             }
             m_webServer.send(200, "text/plain", message);
-            LOG_WARNING(message);
+            LOG_WARNING("%s", message.c_str());
         }
         else
         {
             Settings::getInstance().setWiFiSSID(ssidInput);
             Settings::getInstance().setWiFiPassphrase(passwordInput);
 
+            /* The device restarts, therefore pending changes must be written now. */
+            (void)Settings::getInstance().flush();
+
             m_webServer.send(200, "text/plain", "Credentials Accepted.\nRestarting...");
             delay(3000);
+            Log::flush();
             ESP.restart();
         }
     }
 }
 
-void LapTriggerWebServer::parseWSTextEvent(const uint8_t clientId, const WStype_t type, const uint8_t *payload, const size_t length)
+void LapTriggerWebServer::handleEvents()
 {
-    String cmd = "";
-    String par = "";
+    WiFiClient  client  = m_webServer.client();
+    uint8_t     idx     = 0;
+
+    /* Find a free slot. */
+    while ((SSE_MAX_CLIENTS > idx) && (0 != m_sseClients[idx].connected()))
+    {
+        ++idx;
+    }
+
+    if (SSE_MAX_CLIENTS <= idx)
+    {
+        m_webServer.send(503, "text/plain", "Too many spectators.");
+    }
+    else if (SSE_MIN_FREE_HEAP > ESP.getFreeHeap())
+    {
+        m_webServer.send(503, "text/plain", "Not enough memory for more spectators.");
+    }
+    else
+    {
+        static const char   HEADER[]    = "HTTP/1.1 200 OK\r\n"
+                                          "Content-Type: text/event-stream\r\n"
+                                          "Cache-Control: no-cache\r\n"
+                                          "Connection: keep-alive\r\n"
+                                          "Access-Control-Allow-Origin: *\r\n"
+                                          "\r\n";
+
+        LOG_INFO("Sse client (%u) connected.", idx);
+
+        client.setNoDelay(true);
+
+        /* The stream goes on forever, therefore the header is written to the
+         * client itself and the server neither sends nor finalizes a response.
+         */
+        (void)client.write(reinterpret_cast<const uint8_t *>(HEADER), sizeof(HEADER) - 1U);
+
+        /* Keeping a copy of the client keeps the connection open. */
+        m_sseClients[idx] = client;
+
+        sendSseTable(m_sseClients[idx]);
+    }
+}
+
+void LapTriggerWebServer::handleMetricsRequest()
+{
+    uint8_t idx     = 0U;
+    HEAP_SCOPE(HeapMonitor::TAG_STRING);
+    String  section;
+
+    m_webServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    m_webServer.send(200, "text/plain; version=0.0.4", "");
+
+    while (true == Metrics::getInstance().getPrometheusSection(idx, section))
+    {
+        if (0U < section.length())
+        {
+            m_webServer.sendContent(section);
+            section.clear();
+        }
+
+        ++idx;
+    }
+
+    /* Terminate the chunked transfer. */
+    m_webServer.sendContent("");
+}
+
+void LapTriggerWebServer::handleTraceRequest()
+{
+    /* Number of events, which are sent in a single chunk. */
+    const size_t    EVENTS_PER_CHUNK    = 32U;
+    size_t          idx                 = 0U;
+    size_t          count               = 0U;
+    Trace::Event    event;
+    HEAP_SCOPE(HeapMonitor::TAG_STRING);
+    String          chunk;
+
+    /* The request handling itself is traced as well, which would overwrite the oldest events. */
+    Trace::setEnabled(false);
+    count = Trace::getCount();
+
+    m_webServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    m_webServer.send(200, "text/plain", "");
+
+    chunk = "# RacingLapTimer trace v1\n";
+
+    for (idx = 0U; idx < count; ++idx)
+    {
+        if (true == Trace::getEvent(idx, event))
+        {
+            chunk += event.timestamp;
+            chunk += ' ';
+            chunk += (Trace::TYPE_BEGIN == event.type) ? 'B' : ((Trace::TYPE_END == event.type) ? 'E' : 'I');
+            chunk += ' ';
+            chunk += Trace::getName(event.id);
+            chunk += ' ';
+            chunk += event.arg;
+            chunk += '\n';
+        }
+
+        if ((EVENTS_PER_CHUNK - 1U) == (idx % EVENTS_PER_CHUNK))
+        {
+            m_webServer.sendContent(chunk);
+            chunk.clear();
+        }
+    }
+
+    if (0U < chunk.length())
+    {
+        m_webServer.sendContent(chunk);
+    }
+
+    /* Terminate the chunked transfer. */
+    m_webServer.sendContent("");
+
+    Trace::setEnabled(true);
+}
+
+void LapTriggerWebServer::handleResultsRequest()
+{
+    uint8_t numberOfGroups  = 0U;
+    uint8_t group           = 0U;
+
+    (void)m_laptrigger->getNumberofGroups(numberOfGroups);
+
+    m_webServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    m_webServer.sendHeader("Content-Disposition", "attachment; filename=\"results.csv\"");
+    m_webServer.send(200, "text/csv", "");
+    m_webServer.sendContent("group,name,fastest_ms,rank,laps,mean_ms,stddev_ms,median_ms,p90_ms\n");
+
+    /* One chunk per group, to keep the heap usage low. */
+    for (group = 0U; group < numberOfGroups; ++group)
+    {
+        Message     line;
+        const char  *name   = "";
+
+        (void)m_laptrigger->getGroupName(group, name);
+
+        line += group;
+        line += ",\"";
+
+        /* Quotes in the name are escaped by doubling them. */
+        while ('\0' != *name)
+        {
+            if ('"' == *name)
+            {
+                line += '"';
+            }
+
+            line += *name;
+            ++name;
+        }
+
+        line += "\",";
+        line += m_laptrigger->getLaptime(group);
+        line += ',';
+        line += m_laptrigger->getRank(group);
+        line += ',';
+        (void)getStatistics(group, line, ',');
+        line += '\n';
+
+        m_webServer.sendContent(line.c_str(), line.length());
+    }
+
+    /* Terminate the chunked transfer. */
+    m_webServer.sendContent("");
+}
+
+void LapTriggerWebServer::queueEvent(const EventBus::Event& event)
+{
+    /* Only copied, the serialisation happens outside of the timing path. */
+    if (EVENT_QUEUE_SIZE > m_eventQueueCount)
+    {
+        QueuedEvent& entry = m_eventQueue[(m_eventQueueHead + m_eventQueueCount) % EVENT_QUEUE_SIZE];
+
+        entry.event     = event;
+        entry.timestamp = micros();
+        ++m_eventQueueCount;
+    }
+    else
+    {
+        /* The clients get at least the result table, which contains the run. */
+        m_isTableChanged = true;
+    }
+}
+
+void LapTriggerWebServer::sendQueuedEvents()
+{
+    while (0U < m_eventQueueCount)
+    {
+        const QueuedEvent& entry = m_eventQueue[m_eventQueueHead];
+
+        sendEvent(entry.event);
+        Metrics::getInstance().recordEventLatency(micros() - entry.timestamp);
+
+        m_eventQueueHead = (m_eventQueueHead + 1U) % EVENT_QUEUE_SIZE;
+        --m_eventQueueCount;
+    }
+}
+
+void LapTriggerWebServer::sendEvent(const EventBus::Event& event)
+{
+    Message msg;
+
+    switch (event.type)
+    {
+    case EventBus::EVENT_RUN_STARTED:
+        broadcastEvent("EVT;STARTED");
+        m_udpFeed.publishStarted(event.group);
+        break;
+
+    case EventBus::EVENT_RUN_FINISHED:
+        /* Formatted on the stack, without heap. */
+        msg = "EVT;FINISHED;";
+        msg += event.lapTime;
+        msg += ';';
+        msg += event.group;
+
+        if (0U != (event.flags & EventBus::FLAG_PENDING))
+        {
+            msg += ";PENDING";
+        }
+        else if (0U != (event.flags & EventBus::FLAG_SUSPICIOUS))
+        {
+            msg += ";SUSPICIOUS";
+        }
+        else
+        {
+            ;
+        }
+
+        broadcastEvent(msg.c_str());
+        m_udpFeed.publishFinished(event.group, event.lapTime);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void LapTriggerWebServer::broadcastEvent(const char *msg)
+{
+    uint8_t idx = 0;
+
+    if (0 < m_webSocketSrv.connectedClients())
+    {
+        m_webSocketSrv.broadcastTXT(msg, strlen(msg));
+    }
+
+    while ((SSE_MAX_CLIENTS > idx) && (0 == m_sseClients[idx].connected()))
+    {
+        ++idx;
+    }
+
+    if (SSE_MAX_CLIENTS > idx)
+    {
+        sendSseEvent(msg);
+    }
+}
+
+void LapTriggerWebServer::sendSseEvent(const char *msg)
+{
+    uint8_t idx = 0;
+
+    for (idx = 0; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        if (0 != m_sseClients[idx].connected())
+        {
+            sendSseEvent(m_sseClients[idx], msg);
+
+            if (0 == m_sseClients[idx].connected())
+            {
+                LOG_INFO("Sse client (%u) disconnected.", idx);
+            }
+        }
+    }
+}
+
+void LapTriggerWebServer::sendSseEvent(WiFiClient &client, const char *msg)
+{
+    SseFrame frame;
+
+    /* A empty message is sent as comment, which is ignored by the client. */
+    if ('\0' == msg[0])
+    {
+        frame = ":\n\n";
+    }
+    else
+    {
+        frame = "data: ";
+        frame += msg;
+        frame += "\n\n";
+    }
+
+    /* Writing more than the TCP send buffer can take would block the loop.
+     * A slow spectator is dropped instead, the browser will reconnect automatically.
+     */
+    if (static_cast<int>(frame.length()) > client.availableForWrite())
+    {
+        client.stop();
+    }
+    else
+    {
+        (void)client.write(reinterpret_cast<const uint8_t *>(frame.c_str()), frame.length());
+    }
+}
+
+void LapTriggerWebServer::sendSseTable()
+{
+    uint8_t idx = 0;
+
+    for (idx = 0; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        if (0 != m_sseClients[idx].connected())
+        {
+            sendSseTable(m_sseClients[idx]);
+        }
+    }
+}
+
+void LapTriggerWebServer::notifyTableChanged()
+{
+    sendSseTable();
+    publishLeaderboard();
+}
+
+void LapTriggerWebServer::publishLeaderboard()
+{
+    uint8_t numberOfGroups = 0;
+
+    if (true == m_laptrigger->getNumberofGroups(numberOfGroups))
+    {
+        uint8_t group = 0;
+
+        for (group = 0; group < numberOfGroups; ++group)
+        {
+            m_udpFeed.publishLeaderboard(group, m_laptrigger->getRank(group), m_laptrigger->getLaptime(group));
+        }
+    }
+}
+
+void LapTriggerWebServer::sendSseTable(WiFiClient &client)
+{
+    uint8_t numberOfGroups = 0;
+
+    if (true == m_laptrigger->getNumberofGroups(numberOfGroups))
+    {
+        uint8_t group = 0;
+        Message entry;
+
+        for (group = 0; (group < numberOfGroups) && (0 != client.connected()); ++group)
+        {
+            getTableEntry(group, entry);
+            sendSseEvent(client, entry.c_str());
+        }
+    }
+}
+
+void LapTriggerWebServer::getTableEntry(uint8_t group, Message &output)
+{
+    const char *selectedName = nullptr;
+
+    output = "EVT;TABLE;";
+    output += group;
+    output += ';';
+    output += m_laptrigger->getLaptime(group);
+    output += ';';
+
+    if (m_laptrigger->getGroupName(group, selectedName))
+    {
+        output += selectedName;
+    }
+    else
+    {
+        output += "Group ";
+        output += (char)(group + 65);
+    }
+}
+
+bool LapTriggerWebServer::getStatistics(uint8_t group, Message &output, char separator)
+{
+    LapStatistics   statistics;
+    bool            isSuccess   = m_laptrigger->getLapStatistics(group, statistics);
+
+    if (true == isSuccess)
+    {
+        output += statistics.getCount();
+        output += separator;
+        output += statistics.getMean();
+        output += separator;
+        output += statistics.getStdDev();
+        output += separator;
+        output += statistics.getMedian();
+        output += separator;
+        output += statistics.getP90();
+    }
+
+    return isSuccess;
+}
+
+void LapTriggerWebServer::parseWSTextEvent(const uint8_t clientId, const uint8_t *payload, const size_t length)
+{
+    Command cmd;
+    Message par;
+    Message outputMessage;
     size_t index = 0;
 
     const char *strPayload = reinterpret_cast<const char *>(payload);
@@ -264,41 +792,56 @@ void LapTriggerWebServer::parseWSTextEvent(const uint8_t clientId, const WStype_
 
     LOG_INFO("Ws client (%u): %s", clientId, cmd.c_str());
 
-    if (cmd.equals("RELEASE"))
+    /* A truncated command or parameter is invalid, it must not match a shorter one. */
+    if ((true == cmd.isTruncated()) ||
+        (true == par.isTruncated()))
+    {
+        outputMessage = "NACK";
+    }
+    /* All group numbers are checked strictly, because toInt() truncates e.g. 256 to group 0. */
+    else if (cmd.equals("RELEASE"))
     {
-        if (m_laptrigger->setReleasedState(par.toInt()))
+        uint8_t group = 0;
+
+        if ((true == toUInt8(par.c_str(), par.length(), group)) &&
+            (true == m_laptrigger->setReleasedState(group)))
         {
-            m_webSocketSrv.sendTXT(clientId, "ACK");
+            outputMessage = "ACK";
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
     else if (cmd.equals("GET_GROUPS"))
     {
-        /* Client requests the number of Groups */
+        /* Client requests the number of Groups and the max. number, which depends on the build. */
         uint8_t groups = 0;
 
         if (true == m_laptrigger->getNumberofGroups(groups))
         {
-            String outputMessage = "ACK;GET_GROUPS;" + String(groups);
-            m_webSocketSrv.sendTXT(clientId, outputMessage);
+            outputMessage = "ACK;GET_GROUPS;";
+            outputMessage += groups;
+            outputMessage += ';';
+            outputMessage += m_laptrigger->getMaxNumberOfGroups();
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
     else if (cmd.equals("SET_GROUPS"))
     {
-        if (m_laptrigger->setNumberofGroups(par.toInt()))
+        uint8_t groups = 0;
+
+        if ((true == toUInt8(par.c_str(), par.length(), groups)) &&
+            (true == m_laptrigger->setNumberofGroups(groups)))
         {
-            m_webSocketSrv.sendTXT(clientId, "ACK;SET_GROUPS");
+            outputMessage = "ACK;SET_GROUPS";
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
     else if (cmd.equals("GET_TABLE"))
@@ -307,115 +850,442 @@ void LapTriggerWebServer::parseWSTextEvent(const uint8_t clientId, const WStype_
 
         if (m_laptrigger->getNumberofGroups(numberOfGroups))
         {
-            String outputMessage = "ACK;GET_TABLE;" + String(numberOfGroups);
-            m_webSocketSrv.sendTXT(clientId, outputMessage);
+            outputMessage = "ACK;GET_TABLE;";
+            outputMessage += numberOfGroups;
+            m_webSocketSrv.sendTXT(clientId, outputMessage.c_str(), outputMessage.length());
 
             for (uint8_t currentGroup = 0; currentGroup < numberOfGroups; currentGroup++)
             {
-                uint32_t groupLaptime = 0;
-                String output = "";
-
-                groupLaptime = m_laptrigger->getLaptime(currentGroup);
-
-                output = "EVT;TABLE;";
-                output += currentGroup;
-                output += ';';
-                output += groupLaptime;
-                output += ';';
-
-                String selectedName = "";
+                getTableEntry(currentGroup, outputMessage);
 
-                if (m_laptrigger->getGroupName(currentGroup, selectedName))
-                {
-                    output += selectedName;
-                }
-                else
-                {
-                    output += "Group ";
-                    output += (char)(currentGroup + 65);
-                }
-
-                m_webSocketSrv.sendTXT(clientId, output);
+                m_webSocketSrv.sendTXT(clientId, outputMessage.c_str(), outputMessage.length());
             }
+
+            /* All replies are sent. */
+            outputMessage.clear();
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
+        }
+    }
+    else if (cmd.equals("GET_STATS"))
+    {
+        uint8_t group = 0;
+
+        outputMessage = "ACK;GET_STATS;";
+        outputMessage += par;
+        outputMessage += ';';
+
+        if ((false == toUInt8(par.c_str(), par.length(), group)) ||
+            (false == getStatistics(group, outputMessage, ';')))
+        {
+            outputMessage = "NACK";
         }
     }
     else if (cmd.equals("CLEAR"))
     {
-        if (m_laptrigger->clearLaptime(par.toInt()))
+        uint8_t group = 0;
+
+        if ((true == toUInt8(par.c_str(), par.length(), group)) &&
+            (true == m_laptrigger->clearLaptime(group)))
         {
-            String outputMessage = "ACK;CLEAR;" + par;
-            m_webSocketSrv.sendTXT(clientId, outputMessage);
+            outputMessage = "ACK;CLEAR;";
+            outputMessage += par;
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
     else if (cmd.equals("SET_NAME"))
     {
-        uint8_t selectedGroup = par.toInt();
-        uint8_t namePos = par.indexOf(":");
-        String selectedName = par.substring(namePos + 1);
-        String outputMessage = "NACK";
+        uint8_t selectedGroup = 0;
+        const char *namePos = strchr(par.c_str(), ':');
 
-        if (true == m_laptrigger->setGroupName(selectedGroup, selectedName))
+        outputMessage = "NACK";
+
+        /* A longer name would be stored without termination. */
+        if ((nullptr != namePos) &&
+            (par.c_str() < namePos) &&
+            (true == toUInt8(par.c_str(), namePos - par.c_str(), selectedGroup)) &&
+            (Competition::MAX_GROUP_NAME_LENGTH >= strlen(&namePos[1])) &&
+            (true == m_laptrigger->setGroupName(selectedGroup, &namePos[1])))
         {
             outputMessage = "ACK;SET_NAME;";
             outputMessage += selectedGroup;
             outputMessage += ';';
-            outputMessage += selectedName;
+            outputMessage += &namePos[1];
         }
-
-        m_webSocketSrv.sendTXT(clientId, outputMessage);
     }
     else if (cmd.equals("GET_NAME"))
     {
-        uint8_t selectedGroup = par.toInt();
-        String selectedName = "";
-        String outputMessage = "NACK";
+        uint8_t selectedGroup = 0;
+        const char *selectedName = nullptr;
+
+        outputMessage = "NACK";
 
-        if (true == m_laptrigger->getGroupName(selectedGroup, selectedName))
+        if ((true == toUInt8(par.c_str(), par.length(), selectedGroup)) &&
+            (true == m_laptrigger->getGroupName(selectedGroup, selectedName)))
         {
             outputMessage = "ACK;GET_NAME;";
             outputMessage += selectedGroup;
             outputMessage += ';';
             outputMessage += selectedName;
         }
-
-        m_webSocketSrv.sendTXT(clientId, outputMessage);
     }
     else if (cmd.equals("CLEAR_NAME"))
     {
-        if (m_laptrigger->clearName(par.toInt()))
+        uint8_t group = 0;
+
+        if ((true == toUInt8(par.c_str(), par.length(), group)) &&
+            (true == m_laptrigger->clearName(group)))
         {
-            String outputMessage = "ACK;CLEAR_NAME;" + par;
-            m_webSocketSrv.sendTXT(clientId, outputMessage);
+            outputMessage = "ACK;CLEAR_NAME;";
+            outputMessage += par;
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
     else if(cmd.equals("REJECT_RUN"))
     {
         if (m_laptrigger->rejectRun())
         {
-            String outputMessage = "ACK;REJECT_RUN";
-            m_webSocketSrv.sendTXT(clientId, outputMessage);
+            outputMessage = "ACK;REJECT_RUN";
         }
         else
         {
-            m_webSocketSrv.sendTXT(clientId, "NACK");
+            outputMessage = "NACK";
         }
     }
+    else if ((cmd.equals("UNDO")) || (cmd.equals("REDO")))
+    {
+        uint32_t run = 0;
+        bool isSuccess = false;
+
+        if (cmd.equals("UNDO"))
+        {
+            isSuccess = m_laptrigger->undoRun(run);
+        }
+        else
+        {
+            isSuccess = m_laptrigger->redoRun(run);
+        }
+
+        if (true == isSuccess)
+        {
+            outputMessage = "ACK;";
+            outputMessage += cmd;
+            outputMessage += ';';
+            outputMessage += run;
+        }
+        else
+        {
+            outputMessage = "NACK";
+        }
+    }
+    else if (cmd.equals("GET_JOURNAL"))
+    {
+        /* Oldest run first, every run as "<run>:<group>:<lap time>:<undone>". */
+        JournalMessage journalMessage = "ACK;GET_JOURNAL;";
+        uint8_t idx = 0;
+        uint32_t run = 0;
+        uint8_t group = 0;
+        uint32_t lapTime = 0;
+        bool isUndone = false;
+
+        journalMessage += m_laptrigger->getJournalCount();
+
+        while (true == m_laptrigger->getJournalEntry(idx, run, group, lapTime, isUndone))
+        {
+            journalMessage += ';';
+            journalMessage += run;
+            journalMessage += ':';
+            journalMessage += group;
+            journalMessage += ':';
+            journalMessage += lapTime;
+            journalMessage += ':';
+            journalMessage += (true == isUndone) ? '1' : '0';
+            ++idx;
+        }
+
+        m_webSocketSrv.sendTXT(clientId, journalMessage.c_str(), journalMessage.length());
+    }
+    else if (cmd.equals("CONFIRM_RUN"))
+    {
+        if (m_laptrigger->confirmRun())
+        {
+            outputMessage = "ACK;CONFIRM_RUN";
+        }
+        else
+        {
+            outputMessage = "NACK";
+        }
+    }
+    else if (cmd.equals("HOLD_SUSPICIOUS"))
+    {
+        if ((true == par.equals("0")) || (true == par.equals("1")))
+        {
+            outputMessage = "ACK;HOLD_SUSPICIOUS;";
+            outputMessage += par;
+
+            m_laptrigger->setHoldSuspicious(par.equals("1"));
+        }
+        else
+        {
+            outputMessage = "NACK";
+        }
+    }
+    else if (cmd.equals("GET_BLIND_PERIOD"))
+    {
+        uint32_t period = 0;
+        uint8_t ratio = 0;
+
+        m_laptrigger->getBlindPeriod(period, ratio);
+
+        outputMessage = "ACK;GET_BLIND_PERIOD;";
+        outputMessage += period;
+        outputMessage += ';';
+        outputMessage += ratio;
+        outputMessage += ';';
+        outputMessage += m_laptrigger->getEffectiveBlindPeriod();
+    }
+    else if (cmd.equals("SET_BLIND_PERIOD"))
+    {
+        /* Parameter is "<ms>" for a fixed or "<min. ms>:<percent>" for an adaptive blind period. */
+        const char *ratioPos = strchr(par.c_str(), ':');
+        uint32_t period = 0;
+        uint8_t ratio = 0;
+        bool isValid = false;
+
+        if (nullptr == ratioPos)
+        {
+            isValid = toUInt32(par.c_str(), par.length(), period);
+        }
+        else
+        {
+            isValid = (true == toUInt32(par.c_str(), ratioPos - par.c_str(), period)) &&
+                      (true == toUInt8(&ratioPos[1], strlen(&ratioPos[1]), ratio));
+        }
+
+        if ((true == isValid) &&
+            (true == m_laptrigger->setBlindPeriod(period, ratio)))
+        {
+            outputMessage = "ACK;SET_BLIND_PERIOD;";
+            outputMessage += m_laptrigger->getEffectiveBlindPeriod();
+        }
+        else
+        {
+            outputMessage = "NACK";
+        }
+    }
+    else if (cmd.equals("GET_METRICS"))
+    {
+        /* The summary is requested on demand and its length depends on the number of tasks. */
+        HEAP_SCOPE(HeapMonitor::TAG_STRING);
+        String metricsMessage = "ACK;GET_METRICS";
+
+        Metrics::getInstance().getSummary(metricsMessage);
+        m_webSocketSrv.sendTXT(clientId, metricsMessage);
+    }
+    else if (cmd.equals("BATCH"))
+    {
+        handleBatch(clientId, &strPayload[index], length - index);
+    }
     else
+    {
+        outputMessage = "NACK";
+    }
+
+    if (false == outputMessage.isEmpty())
+    {
+        m_webSocketSrv.sendTXT(clientId, outputMessage.c_str(), outputMessage.length());
+    }
+}
+
+void LapTriggerWebServer::handleBatch(uint8_t clientId, const char *data, size_t length)
+{
+    BatchCmd    cmds[BATCH_MAX_COMMANDS];
+    uint8_t     cmdCount        = 0;
+    uint8_t     numberOfGroups  = 0;
+    bool        isValid         = m_laptrigger->getNumberofGroups(numberOfGroups);
+    size_t      index           = 0;
+
+    /* Validate the whole batch, before anything is applied. */
+    while ((true == isValid) && (index < length))
+    {
+        Message segment;
+
+        while ((index < length) && (';' != data[index]))
+        {
+            segment += data[index];
+            ++index;
+        }
+
+        /* Skip separator. */
+        ++index;
+
+        if (true == segment.isEmpty())
+        {
+            /* Skip empty sub-command, e.g. caused by a trailing separator. */
+            ;
+        }
+        else if (BATCH_MAX_COMMANDS <= cmdCount)
+        {
+            LOG_WARNING("Ws client (%u): Too many sub-commands.", clientId);
+            isValid = false;
+        }
+        else if ((true == segment.isTruncated()) ||
+                 (false == parseBatchCmd(segment, numberOfGroups, cmds[cmdCount])))
+        {
+            LOG_WARNING("Ws client (%u): Invalid sub-command %u.", clientId, cmdCount);
+            isValid = false;
+        }
+        else
+        {
+            ++cmdCount;
+        }
+    }
+
+    if ((false == isValid) ||
+        (0 == cmdCount))
     {
         m_webSocketSrv.sendTXT(clientId, "NACK");
     }
+    else
+    {
+        bool    isSuccess   = true;
+        uint8_t idx         = 0;
+        Message outputMessage;
+
+        Settings::getInstance().beginTransaction();
+
+        for (idx = 0; idx < cmdCount; ++idx)
+        {
+            bool isCmdSuccessful = false;
+
+            switch (cmds[idx].id)
+            {
+            case BATCH_CMD_SET_NAME:
+                isCmdSuccessful = m_laptrigger->setGroupName(cmds[idx].value, cmds[idx].name.c_str());
+                break;
+
+            case BATCH_CMD_CLEAR:
+                isCmdSuccessful = m_laptrigger->clearLaptime(cmds[idx].value);
+                break;
+
+            case BATCH_CMD_CLEAR_NAME:
+                isCmdSuccessful = m_laptrigger->clearName(cmds[idx].value);
+                break;
+
+            case BATCH_CMD_SET_GROUPS:
+                isCmdSuccessful = m_laptrigger->setNumberofGroups(cmds[idx].value);
+                break;
+
+            default:
+                break;
+            }
+
+            if (false == isCmdSuccessful)
+            {
+                isSuccess = false;
+            }
+        }
+
+        if (false == Settings::getInstance().commitTransaction())
+        {
+            LOG_ERROR("Failed to store batch.");
+            isSuccess = false;
+        }
+
+        if (true == isSuccess)
+        {
+            outputMessage = "ACK;BATCH;";
+            outputMessage += cmdCount;
+        }
+        else
+        {
+            outputMessage = "NACK";
+        }
+
+        m_webSocketSrv.sendTXT(clientId, outputMessage.c_str(), outputMessage.length());
+
+        /* Notify all clients once about the changes, the table follows by the event bus. */
+        broadcastEvent("EVT;CHANGED");
+    }
+}
+
+bool LapTriggerWebServer::parseBatchCmd(const Message &segment, uint8_t &numberOfGroups, BatchCmd &cmd)
+{
+    bool        isValid = false;
+    const char  *sepPos = strchr(segment.c_str(), ':');
+
+    if ((nullptr != sepPos) &&
+        (segment.c_str() < sepPos))
+    {
+        Command     name;
+        const char  *par    = &sepPos[1];
+        size_t      parLen  = strlen(par);
+
+        name.append(segment.c_str(), sepPos - segment.c_str());
+
+        if (name.equals("SET_NAME"))
+        {
+            const char *namePos = strchr(par, ':');
+
+            if ((nullptr != namePos) &&
+                (par < namePos) &&
+                (true == toUInt8(par, namePos - par, cmd.value)) &&
+                (numberOfGroups > cmd.value))
+            {
+                cmd.id      = BATCH_CMD_SET_NAME;
+                cmd.name    = &namePos[1];
+
+                if (false == cmd.name.isTruncated())
+                {
+                    isValid = true;
+                }
+            }
+        }
+        else if (name.equals("CLEAR"))
+        {
+            if ((true == toUInt8(par, parLen, cmd.value)) &&
+                (numberOfGroups > cmd.value))
+            {
+                cmd.id  = BATCH_CMD_CLEAR;
+                isValid = true;
+            }
+        }
+        else if (name.equals("CLEAR_NAME"))
+        {
+            if ((true == toUInt8(par, parLen, cmd.value)) &&
+                (numberOfGroups > cmd.value))
+            {
+                cmd.id  = BATCH_CMD_CLEAR_NAME;
+                isValid = true;
+            }
+        }
+        else if (name.equals("SET_GROUPS"))
+        {
+            if ((true == toUInt8(par, parLen, cmd.value)) &&
+                (m_laptrigger->getMinNumberOfGroups() <= cmd.value) &&
+                (m_laptrigger->getMaxNumberOfGroups() >= cmd.value))
+            {
+                cmd.id          = BATCH_CMD_SET_GROUPS;
+                numberOfGroups  = cmd.value;
+                isValid         = true;
+            }
+        }
+        else
+        {
+            /* Unknown or not supported sub-command. */
+            ;
+        }
+    }
+
+    return isValid;
 }
 
 /******************************************************************************
@@ -425,3 +1295,101 @@ void LapTriggerWebServer::parseWSTextEvent(const uint8_t clientId, const WStype_
 /******************************************************************************
  * Local functions
  *****************************************************************************/
+
+/**
+ *  Converts a string with a decimal number to an 8-bit unsigned integer.
+ *  In difference to String::toInt() the whole string must be a valid number.
+ *
+ *  @param[in]  str     String with decimal number, needs no termination.
+ *  @param[in]  length  Number of characters.
+ *  @param[out] value   Converted value.
+ *  @return If the string is a valid 8-bit unsigned integer, returns true. Otherwise, false.
+ */
+static bool toUInt8(const char *str, size_t length, uint8_t &value)
+{
+    bool            isValid = false;
+    uint16_t        result  = 0;
+    size_t          idx     = 0;
+
+    /* Max. 3 digits for a 8-bit value. */
+    if ((0 < length) &&
+        (3 >= length))
+    {
+        isValid = true;
+
+        for (idx = 0; idx < length; ++idx)
+        {
+            char digit = str[idx];
+
+            if (('0' > digit) ||
+                ('9' < digit))
+            {
+                isValid = false;
+                break;
+            }
+
+            result = (result * 10U) + static_cast<uint16_t>(digit - '0');
+        }
+
+        if (UINT8_MAX < result)
+        {
+            isValid = false;
+        }
+    }
+
+    if (true == isValid)
+    {
+        value = static_cast<uint8_t>(result);
+    }
+
+    return isValid;
+}
+
+/**
+ *  Converts a string with a decimal number to a 32-bit unsigned integer.
+ *  In difference to String::toInt() the whole string must be a valid number.
+ *
+ *  @param[in]  str     String with decimal number, needs no termination.
+ *  @param[in]  length  Number of characters.
+ *  @param[out] value   Converted value.
+ *  @return If the string is a valid 32-bit unsigned integer, returns true. Otherwise, false.
+ */
+static bool toUInt32(const char *str, size_t length, uint32_t &value)
+{
+    bool            isValid = false;
+    uint64_t        result  = 0;
+    size_t          idx     = 0;
+
+    /* Max. 10 digits for a 32-bit value. */
+    if ((0 < length) &&
+        (10 >= length))
+    {
+        isValid = true;
+
+        for (idx = 0; idx < length; ++idx)
+        {
+            char digit = str[idx];
+
+            if (('0' > digit) ||
+                ('9' < digit))
+            {
+                isValid = false;
+                break;
+            }
+
+            result = (result * 10U) + static_cast<uint64_t>(digit - '0');
+        }
+
+        if (UINT32_MAX < result)
+        {
+            isValid = false;
+        }
+    }
+
+    if (true == isValid)
+    {
+        value = static_cast<uint32_t>(result);
+    }
+
+    return isValid;
+}
@@ -42,6 +42,11 @@
 #include <LittleFS.h>
 #include <WebSocketsServer.h>
 #include "Competition.h"
+#include "UdpEventFeed.h"
+#include <EventBus.h>
+#include <FixedString.h>
+#include <Settings.h>
+#include <HeapMonitor.h>
 
 /******************************************************************************
  * Macros
@@ -53,11 +58,41 @@
 
 /**
  *  Abstraction Class for ESP8266 Web Server.
+ *  It listens to the competition events and serialises them for the
+ *  websocket, server-sent event and UDP clients.
  */
-class LapTriggerWebServer
+class LapTriggerWebServer : public EventBus::Listener
 {
 public:
 
+    /**
+     *  Max. number of events, which wait to be sent. The websocket task runs
+     *  every cycle, therefore a start and a finish are rarely waiting
+     *  together. If the queue is full, the result table is sent instead.
+     */
+    static const uint8_t EVENT_QUEUE_SIZE = 8U;
+
+    /**
+     *  Max. number of concurrent server-sent event clients (spectators).
+     *  The slot itself is a WiFiClient in this object, the connection is
+     *  only allocated, if the heap is sufficient, see SSE_MIN_FREE_HEAP.
+     */
+    static const uint8_t SSE_MAX_CLIENTS = 32U;
+
+    /**
+     *  Min. free heap in byte to accept a further spectator.
+     *
+     *  Every spectator keeps a TCP connection open. On the ESP8266 it costs
+     *  the lwIP control block and the client context, about 300 byte, plus
+     *  up to TCP_SND_BUF (2920 byte) of unacknowledged frames, if the
+     *  spectator reads slowly. A spectator, which reads too slowly, is
+     *  disconnected. A further spectator is accepted, as long as its worst
+     *  case still leaves the warning threshold of the heap monitor free.
+     *  After the start about 40 KB heap are free, therefore spectators,
+     *  which keep up, fill all slots with about 10 KB.
+     */
+    static const uint32_t SSE_MIN_FREE_HEAP = HEAP_MONITOR_MIN_FREE + 3220U;
+
     /**
      *  Class Constructor.
      * 
@@ -78,11 +113,55 @@ public:
     bool begin();
 
     /**
-     *  Executes Loop Cycle.
+     *  Handles the competition, its events are queued by onEvent().
+     *  This is the time critical part, which polls the sensor.
+     * 
+     *  @return If successfully handled, returns true. Otherwise, false.
+     */
+    bool handleCompetition();
+
+    /**
+     *  Queues a competition event. It is called in the time critical sensor
+     *  task, therefore the event is only copied. It is serialised and sent
+     *  to all clients by the next handleWebSocket() or handleWebServer().
+     *  A changed result table is only marked and sent by handleWebServer(),
+     *  because it is large.
+     *
+     *  @param[in] event    Competition event.
+     */
+    void onEvent(const EventBus::Event& event) override;
+
+    /**
+     *  Sends the queued events, handles the HTTP clients, sends a changed
+     *  result table and keeps the server-sent event clients alive.
+     *  Until the server is started, nothing happens.
+     * 
+     *  @return If successfully handled, returns true. Otherwise, false.
+     */
+    bool handleWebServer();
+
+    /**
+     *  Sends the queued events and handles the websocket clients.
+     *  Until the server is started, only the UDP feed gets the events.
+     * 
+     *  @return If successfully handled, returns true. Otherwise, false.
+     */
+    bool handleWebSocket();
+
+    /**
+     *  Handles the mDNS responder.
+     *  Until the server is started, nothing happens.
+     * 
+     *  @return If successfully handled, returns true. Otherwise, false.
+     */
+    bool handleMDNS();
+
+    /**
+     *  Samples the metrics, which are not recorded on change, like the heap.
      * 
-     *  @return If WebServer successfully handled, returns true. Otherwise, false..
+     *  @return If successfully handled, returns true. Otherwise, false.
      */
-    bool runCycle();
+    bool handleMetrics();
 
 private:
     /** Hostname for DNS Server. */
@@ -94,6 +173,63 @@ private:
     /** Websocket port. */
     const uint32_t WEBSOCKET_PORT = 81;
 
+    /** Period in ms to send a keep-alive comment to server-sent event clients. */
+    static const uint32_t SSE_KEEP_ALIVE_PERIOD = 15000U;
+
+    /** Max. length of a websocket or server-sent event message, without string termination. */
+    static const size_t MESSAGE_LENGTH = 127U;
+
+    /** Max. length of a command name, without string termination. */
+    static const size_t COMMAND_LENGTH = 31U;
+
+    /** Max. length of the journal reply, e.g. ";4294967295:255:4294967295:1" per run. */
+    static const size_t JOURNAL_MESSAGE_LENGTH = 24U + (Competition::JOURNAL_SIZE * 28U);
+
+    /** Max. length of a server-sent event frame, "data: <message>\n\n". */
+    static const size_t SSE_FRAME_LENGTH = MESSAGE_LENGTH + 8U;
+
+    /** Websocket or server-sent event message, built without allocating memory. */
+    typedef FixedString<MESSAGE_LENGTH> Message;
+
+    /** Command name of a websocket command. */
+    typedef FixedString<COMMAND_LENGTH> Command;
+
+    /** Reply of the GET_JOURNAL command. */
+    typedef FixedString<JOURNAL_MESSAGE_LENGTH> JournalMessage;
+
+    /** Server-sent event frame. */
+    typedef FixedString<SSE_FRAME_LENGTH> SseFrame;
+
+    /** Max. number of sub-commands in a single BATCH command. */
+    static const uint8_t BATCH_MAX_COMMANDS = 24U;
+
+    /** Sub-commands, which are supported by the BATCH command. */
+    typedef enum
+    {
+        BATCH_CMD_SET_NAME = 0, /**< Set the name of a group. */
+        BATCH_CMD_CLEAR,        /**< Clear the lap time of a group. */
+        BATCH_CMD_CLEAR_NAME,   /**< Clear the name of a group. */
+        BATCH_CMD_SET_GROUPS    /**< Set the number of groups. */
+
+    } BatchCmdId;
+
+    /** A single validated sub-command of a BATCH command. */
+    typedef struct
+    {
+        BatchCmdId                  id;     /**< Sub-command id. */
+        uint8_t                     value;  /**< Group index or number of groups, depends on sub-command. */
+        Competition::Group::Name    name;   /**< Group name, only used by BATCH_CMD_SET_NAME. */
+
+    } BatchCmd;
+
+    /** Competition event, which waits to be sent. */
+    typedef struct
+    {
+        EventBus::Event event;      /**< Event. */
+        uint32_t        timestamp;  /**< Timestamp in us, when the event was published. */
+
+    } QueuedEvent;
+
     /** Competition Handler Instance. */
     Competition *m_laptrigger;
 
@@ -103,6 +239,36 @@ private:
     /** Websocket server on port for ws protocol. */
     WebSocketsServer m_webSocketSrv;
 
+    /**
+     *  Server-sent event clients, which only listen to events.
+     *  A not connected client means the slot is free.
+     */
+    WiFiClient m_sseClients[SSE_MAX_CLIENTS];
+
+    /** Timestamp in ms of the last keep-alive, sent to the server-sent event clients. */
+    uint32_t m_sseKeepAliveTimestamp;
+
+    /** Timing events for LAN displays via UDP multicast. */
+    UdpEventFeed m_udpFeed;
+
+    /**
+     *  Is the server started? The competition is handled before, because
+     *  the timing is armed before the network is up.
+     */
+    bool m_isStarted;
+
+    /** Is the result table changed, but not sent yet? */
+    bool m_isTableChanged;
+
+    /** Events, which wait to be sent, in a ring buffer. */
+    QueuedEvent m_eventQueue[EVENT_QUEUE_SIZE];
+
+    /** Index of the oldest event in the queue. */
+    uint8_t m_eventQueueHead;
+
+    /** Number of events in the queue. */
+    uint8_t m_eventQueueCount;
+
     /**
      *  Handler for websocket event.
      *
@@ -116,15 +282,151 @@ private:
     /** Handler for POST Request for the storage of the STA Credentials. */
     void handleCredentials();
 
+    /**
+     *  Handler for GET request of the server-sent event stream.
+     *  The connection is kept open and the client is registered as spectator.
+     */
+    void handleEvents();
+
+    /**
+     *  Handler for GET request of the metrics in the Prometheus text format.
+     *  The metrics are sent in chunks, to keep the heap usage low.
+     */
+    void handleMetricsRequest();
+
+    /**
+     *  Handler for GET request of the trace timeline.
+     *  Every event is a line with "<timestamp us> <B|E|I> <name> <arg>".
+     *  The recording pauses during the download, to get a consistent timeline.
+     */
+    void handleTraceRequest();
+
+    /**
+     *  Handler for GET request of the results export as CSV.
+     *  Every group is a line with its fastest lap time, rank and the
+     *  statistics of all its lap times.
+     */
+    void handleResultsRequest();
+
+    /**
+     *  Sends a event to all websocket and server-sent event clients.
+     *  The server-sent event frame is only built, if a client is connected.
+     *
+     *  @param[in] msg  Event message.
+     */
+    void broadcastEvent(const char *msg);
+
+    /**
+     *  Copies an event into the queue. If the queue is full, the event is
+     *  dropped and the result table is sent instead.
+     *
+     *  @param[in] event    Competition event.
+     */
+    void queueEvent(const EventBus::Event& event);
+
+    /**
+     *  Serialises and sends all queued events, the oldest first.
+     */
+    void sendQueuedEvents();
+
+    /**
+     *  Serialises a run event and sends it to the websocket, server-sent
+     *  event and UDP clients.
+     *
+     *  @param[in] event    Competition event.
+     */
+    void sendEvent(const EventBus::Event& event);
+
+    /**
+     *  Sends a message to all server-sent event clients.
+     *  Clients which can not keep up are disconnected, to never block the loop.
+     *
+     *  @param[in] msg  Message.
+     */
+    void sendSseEvent(const char *msg);
+
+    /**
+     *  Sends a message to a single server-sent event client.
+     *
+     *  @param[in] client   Server-sent event client.
+     *  @param[in] msg      Message.
+     */
+    void sendSseEvent(WiFiClient &client, const char *msg);
+
+    /**
+     *  Sends the whole result table to all server-sent event clients.
+     *  Spectators can't request the table, therefore it is pushed after every change.
+     */
+    void sendSseTable();
+
+    /**
+     *  Notifies all listeners, which can't request the result table, about a change of it.
+     */
+    void notifyTableChanged();
+
+    /**
+     *  Publishes the whole leaderboard via UDP multicast.
+     */
+    void publishLeaderboard();
+
+    /**
+     *  Sends the whole result table to a single server-sent event client.
+     *
+     *  @param[in] client   Server-sent event client.
+     */
+    void sendSseTable(WiFiClient &client);
+
+    /**
+     *  Get the result table entry event of a group.
+     *
+     *  @param[in]  group    Group index.
+     *  @param[out] output   Table entry event, e.g. "EVT;TABLE;<group>;<laptime>;<name>".
+     */
+    void getTableEntry(uint8_t group, Message &output);
+
+    /**
+     *  Get the lap time statistics of a group.
+     *
+     *  @param[in]  group       Group index.
+     *  @param[out] output      Statistics, e.g. "<laps>;<mean>;<stddev>;<median>;<p90>"
+     *                          with all times in ms. They are appended.
+     *  @param[in]  separator   Separator between the values.
+     *  @return If the group is valid, it will return true otherwise false.
+     */
+    bool getStatistics(uint8_t group, Message &output, char separator);
+
     /**
      *  Parses incoming Web Socket Event of Type TEXT.
      * 
      *  @param[in] clientId  Websocket client id.
-     *  @param[in] type      Event type.
      *  @param[in] payload   Event payload.
      *  @param[in] length    Event payload length.
      */
-    void parseWSTextEvent(const uint8_t clientId, const WStype_t type, const uint8_t *payload, const size_t length);
+    void parseWSTextEvent(const uint8_t clientId, const uint8_t *payload, const size_t length);
+
+    /**
+     *  Handles the BATCH command. All sub-commands are validated first and
+     *  only if the whole batch is valid, they are applied with a single
+     *  settings commit. Afterwards all clients are notified once about the change.
+     *
+     *  The sub-commands are separated by ';' and have the format <CMD>:<PAR>,
+     *  e.g. "SET_NAME:0:Team A;CLEAR:0;CLEAR_NAME:1;SET_GROUPS:4".
+     *
+     *  @param[in] clientId  Websocket client id.
+     *  @param[in] data      Sub-commands.
+     *  @param[in] length    Length of sub-commands in byte.
+     */
+    void handleBatch(uint8_t clientId, const char *data, size_t length);
+
+    /**
+     *  Parses and validates a single sub-command of a BATCH command.
+     *
+     *  @param[in]      segment         Sub-command in the format <CMD>:<PAR>.
+     *  @param[in,out]  numberOfGroups  Number of groups, considering all previous sub-commands.
+     *  @param[out]     cmd             Validated sub-command.
+     *  @return If the sub-command is valid, returns true. Otherwise, false.
+     */
+    bool parseBatchCmd(const Message &segment, uint8_t &numberOfGroups, BatchCmd &cmd);
 
     /**
      * Default constructor is not allowed.
@@ -39,6 +39,9 @@
 #include "LapTriggerWebServer.h"
 #include "Competition.h"
 #include "Group.h"
+#include "Scheduler.h"
+#include "Metrics.h"
+#include "HeapMonitor.h"
 
 #include <Log.h>
 
@@ -50,39 +53,58 @@
  * Types and Classes
  *****************************************************************************/
 
+/** Startup steps, which run in the background after the timing is armed. */
+typedef enum
+{
+    STARTUP_STEP_WIFI = 0,      /**< Start the wireless connection. */
+    STARTUP_STEP_FILESYSTEM,    /**< Mount the filesystem. */
+    STARTUP_STEP_WEBSERVER,     /**< Start the web server. */
+    STARTUP_STEP_DONE           /**< All services are started. */
+
+} StartupStep;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
 
+static bool registerTasks();
+static bool startupTask();
+static bool persistenceTask();
+
 /******************************************************************************
  * Variables
  *****************************************************************************/
 
-/** Max. number of participating groups/teams. */
-static const size_t         MAX_GROUPS  = 10;
-
-/** The groups/teams, which may take part in the challenge. */
-static Group                m_groups[MAX_GROUPS];
-
 /** WiFi Instance */
 static WIFI                 gWiFi;
 
-/** Competition Instance */
-static Competition          gCompetition(m_groups, MAX_GROUPS);
+/** Competition Instance, with the groups/teams, which may take part in the challenge. */
+static Competition          gCompetition;
 
 /** WebServer Instance */
 static LapTriggerWebServer  gWebServer(gCompetition);
 
+/** Scheduler for all tasks in the main loop. */
+static Scheduler            gScheduler;
+
+/** Next startup step. */
+static StartupStep          gStartupStep    = STARTUP_STEP_WIFI;
+
 /******************************************************************************
  * External functions
  *****************************************************************************/
 
 /**
  * Setup the system.
+ * Only what the timing needs is started here: the board, the settings and
+ * the competition with its results. The network services are started by
+ * the startup task in the background, therefore the sensor is polled
+ * while the WiFi connects.
  */
 void setup() /* cppcheck-suppress unusedFunction */
 {
-    bool isError = false;
+    bool        isError = false;
+    Metrics&    metrics = Metrics::getInstance();
 
     /* Initialize HAL. */
     if (false == Board::begin())
@@ -90,40 +112,51 @@ void setup() /* cppcheck-suppress unusedFunction */
         LOG_FATAL("Failed to initialize the HAL.");
         isError = true;
     }
-    /* Mount settings. */
-    else if (false == Settings::getInstance().begin())
-    {
-        LOG_FATAL("Failed to mount settings.");
-        isError = true;
-    }
-    /* Start Wireless Connection. */
-    else if (false == gWiFi.begin())
-    {
-        LOG_FATAL("Failed to start wifi.");
-        isError = true;
-    }
-    /* Mount filesystem. */
-    else if (false == LittleFS.begin())
+    else
     {
-        LOG_FATAL("Failed to mount filesystem.");
-        isError = false;
+        metrics.recordBootPhase("board");
     }
-    /* Initialize competition */
-    else if (false == gCompetition.begin())
+
+    /* Mount settings. */
+    if (false == isError)
     {
-        LOG_FATAL("Failed to initialize competition.");
-        isError = false;
+        if (false == Settings::getInstance().begin())
+        {
+            LOG_FATAL("Failed to mount settings.");
+            isError = true;
+        }
+        else
+        {
+            metrics.recordBootPhase("settings");
+        }
     }
-    /* Start Web Server. */
-    else if (false == gWebServer.begin())
+
+    /* Initialize competition, which restores the results after a restart. */
+    if (false == isError)
     {
-        LOG_FATAL("Failed to start webserver.");
-        isError = true;
+        if (false == gCompetition.begin())
+        {
+            LOG_FATAL("Failed to initialize competition.");
+            isError = true;
+        }
+        else
+        {
+            metrics.recordBootPhase("competition");
+        }
     }
-    else
+
+    /* Register all tasks of the main loop. */
+    if (false == isError)
     {
-        /* Successful */
-        ;
+        if (false == registerTasks())
+        {
+            LOG_FATAL("Failed to register tasks.");
+            isError = true;
+        }
+        else
+        {
+            metrics.recordBootPhase("tasks");
+        }
     }
 
     if (true == isError)
@@ -132,7 +165,11 @@ void setup() /* cppcheck-suppress unusedFunction */
     }
     else
     {
-        LOG_INFO("Ready.");
+        /* From now on, the persistence task decides when to write to flash. */
+        Settings::getInstance().setDeferredWrite(true);
+
+        metrics.recordArmed();
+        LOG_INFO("Timing armed.");
     }
 }
 
@@ -140,29 +177,160 @@ void setup() /* cppcheck-suppress unusedFunction */
  * Main loop, which is called periodically.
  */
 void loop() /* cppcheck-suppress unusedFunction */
+{
+    if (false == gScheduler.process())
+    {
+        Board::errorHalt();
+    }
+
+    HeapMonitor::getInstance().sample();
+}
+
+/******************************************************************************
+ * Local functions
+ *****************************************************************************/
+
+/**
+ * Register all tasks of the main loop.
+ * Period and time budget are in us, priority 0 is the highest.
+ * 
+ * @return If successful, it will return true otherwise false.
+ */
+static bool registerTasks()
 {
     bool isSuccess = true;
 
-    if (false == gWebServer.runCycle())
+    if (false == gScheduler.setSensorTask("competition", []() { return gWebServer.handleCompetition(); }, 500U))
+    {
+        isSuccess = false;
+    }
+    /* A single startup step per cycle, the sensor is polled in between. */
+    else if (false == gScheduler.addTask("startup", startupTask, 0U, 100000U, 0U))
+    {
+        isSuccess = false;
+    }
+    else if (false == gScheduler.addTask("websocket", []() { return gWebServer.handleWebSocket(); }, 0U, 10000U, 0U))
     {
         isSuccess = false;
     }
-    else if (false == gWiFi.runCycle())
+    else if (false == gScheduler.addTask("web", []() { return gWebServer.handleWebServer(); }, 0U, 20000U, 1U))
+    {
+        isSuccess = false;
+    }
+    else if (false == gScheduler.addTask("mdns", []() { return gWebServer.handleMDNS(); }, 10000U, 5000U, 2U))
+    {
+        isSuccess = false;
+    }
+    else if (false == gScheduler.addTask("wifi", []() { return gWiFi.runCycle(); }, 100000U, 5000U, 3U))
+    {
+        isSuccess = false;
+    }
+    else if (false == gScheduler.addTask("persistence", persistenceTask, 1000000U, 100000U, 4U))
+    {
+        isSuccess = false;
+    }
+    else if (false == gScheduler.addTask("metrics", []() { return gWebServer.handleMetrics(); }, 1000000U, 1000U, 5U))
+    {
+        isSuccess = false;
+    }
+    /* The log output runs in the idle time, after all other tasks. */
+    else if (false == gScheduler.addTask("log", Log::process, 0U, 1000U, 6U))
     {
         isSuccess = false;
     }
     else
     {
-        /* Successful */
-        ;
+        Metrics::getInstance().setScheduler(&gScheduler);
     }
 
-    if (false == isSuccess)
+    return isSuccess;
+}
+
+/**
+ * Start the network services step by step, after the timing is armed.
+ * Until the web server is started, its tasks do nothing.
+ * 
+ * @return If successful, it will return true otherwise false.
+ */
+static bool startupTask()
+{
+    bool isSuccess = true;
+
+    switch (gStartupStep)
     {
-        Board::errorHalt();
+    case STARTUP_STEP_WIFI:
+        /* It doesn't wait for the connection, the wifi task polls it. */
+        if (false == gWiFi.begin())
+        {
+            LOG_FATAL("Failed to start wifi.");
+            isSuccess = false;
+        }
+        else
+        {
+            Metrics::getInstance().recordBootPhase("wifi");
+            gStartupStep = STARTUP_STEP_FILESYSTEM;
+        }
+        break;
+
+    case STARTUP_STEP_FILESYSTEM:
+        /* Without filesystem there is no web interface, but the websocket protocol still works. */
+        if (false == LittleFS.begin())
+        {
+            LOG_ERROR("Failed to mount filesystem.");
+        }
+
+        Metrics::getInstance().recordBootPhase("filesystem");
+        gStartupStep = STARTUP_STEP_WEBSERVER;
+        break;
+
+    case STARTUP_STEP_WEBSERVER:
+        if (false == gWebServer.begin())
+        {
+            LOG_FATAL("Failed to start webserver.");
+            isSuccess = false;
+        }
+        else
+        {
+            Metrics::getInstance().recordBootPhase("webserver");
+            Metrics::getInstance().recordReady();
+            gStartupStep = STARTUP_STEP_DONE;
+
+            LOG_INFO("Ready.");
+        }
+        break;
+
+    case STARTUP_STEP_DONE:
+        /* Nothing to do anymore. */
+        break;
+
+    default:
+        break;
     }
+
+    return isSuccess;
 }
 
-/******************************************************************************
- * Local functions
- *****************************************************************************/
+/**
+ * Write pending settings to flash.
+ * A flash write stalls the CPU for several ms, which would falsify a lap time.
+ * Therefore it is only done, while no run is released or in progress.
+ * 
+ * @return If successful, it will return true otherwise false.
+ */
+static bool persistenceTask()
+{
+    Competition::CompetitionState state = gCompetition.getState();
+
+    if ((true == Settings::getInstance().isWritePending()) &&
+        (Competition::COMPETITION_STATE_RELEASED != state) &&
+        (Competition::COMPETITION_STATE_STARTED != state))
+    {
+        if (false == Settings::getInstance().flush())
+        {
+            LOG_ERROR("Failed to write settings.");
+        }
+    }
+
+    /* A failed write is not fatal, it is tried again with the next change. */
+    return true;
+}
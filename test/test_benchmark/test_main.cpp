@@ -0,0 +1,477 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Cost of the hot paths with regression thresholds
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <Board.h>
+#include <Settings.h>
+#include <LittleFS.h>
+#include <EventBus.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/*
+ * The thresholds have a wide margin to the host numbers, because the tests
+ * run unoptimized and on loaded build servers. A regression by an order of
+ * magnitude or a single allocation still fails.
+ */
+
+/** Max. cost of publishing an event without listener in ns. */
+#ifndef TEST_MAX_PUBLISH_NS
+#define TEST_MAX_PUBLISH_NS             500U
+#endif
+
+/** Max. cost of publishing an event to the web server in ns. */
+#ifndef TEST_MAX_PUBLISH_WEB_SERVER_NS
+#define TEST_MAX_PUBLISH_WEB_SERVER_NS  1000U
+#endif
+
+/** Max. cost of a competition poll without sensor event in ns. */
+#ifndef TEST_MAX_POLL_NS
+#define TEST_MAX_POLL_NS                1000U
+#endif
+
+/** Max. cost of a whole run, driven by the websocket commands, in ns. */
+#ifndef TEST_MAX_RUN_NS
+#define TEST_MAX_RUN_NS                 500000U
+#endif
+
+/** Max. heap allocations per operation of all cases, after the warm up. */
+#ifndef TEST_MAX_ALLOCATIONS_PER_OP
+#define TEST_MAX_ALLOCATIONS_PER_OP     0U
+#endif
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Measured cost of a case. */
+typedef struct
+{
+    double      nsPerOp;        /**< Host time per operation in ns. */
+    uint32_t    allocations;    /**< Heap allocations of all operations. */
+
+} Cost;
+
+/** Operations of a case. */
+typedef void (*CaseFunc)(uint32_t iterations);
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void measure(const char* name, CaseFunc func, uint32_t iterations, Cost& cost);
+static uint64_t getHostNs();
+static void publishEvents(uint32_t iterations);
+static void publishEventsToWebServer(uint32_t iterations, Cost& cost);
+static void pollCompetition(uint32_t iterations);
+static void simulateRuns(uint32_t iterations);
+static void sendCommand(const char* cmd);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*          EEPROM_FILE     = "test_benchmark_eeprom.bin";
+
+/** Client number, which sends the commands. */
+static const uint8_t        CLIENT_ID       = 0U;
+
+/** Min. lap time in ms of the simulated runs. */
+static const uint32_t       MIN_LAP_TIME    = 10000U;
+
+/** Number of measured operations of the fast cases. */
+static const uint32_t       ITERATIONS      = 1000000U;
+
+/** Number of runs, until the heap is considered in steady state. */
+static const uint32_t       WARM_UP_RUNS    = 100U;
+
+/** Number of measured runs. */
+static const uint32_t       RUNS            = 2000U;
+
+/** Competition of the simulated runs. */
+static Competition*         gCompetition    = nullptr;
+
+/** Web server of the simulated runs. It is only there, if a test needs it. */
+static LapTriggerWebServer* gWebServer      = nullptr;
+
+/** Number of the next simulated run. */
+static uint32_t             gRun            = 0U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings, which are kept in RAM like in a long
+ * running event, and a new competition.
+ */
+void setUp()
+{
+    static const uint32_t   ZEROS[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)] = { 0U };
+
+    (void)NativeHAL::writeRtcMemory(0U, ZEROS, sizeof(ZEROS));
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+    Settings::getInstance().setDeferredWrite(true);
+
+    gRun            = 0U;
+    gCompetition    = new Competition();
+    TEST_ASSERT_TRUE(gCompetition->begin());
+}
+
+/**
+ * Clean up after every test. A web server leaves the event bus.
+ */
+void tearDown()
+{
+    delete gWebServer;
+    gWebServer = nullptr;
+
+    delete gCompetition;
+    gCompetition = nullptr;
+
+    Settings::getInstance().setDeferredWrite(false);
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * Publishing an event without listener is only the dispatch.
+ */
+static void testPublishCost()
+{
+    Cost cost;
+
+    measure("publish, no listener", publishEvents, ITERATIONS, cost);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_PUBLISH_NS, static_cast<uint32_t>(cost.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_ALLOCATIONS_PER_OP * ITERATIONS, cost.allocations);
+}
+
+/**
+ * Publishing an event to the web server, the real listener, is part of the
+ * sensor task. The web server shall only queue it, the serialisation and
+ * the sending happen later in its websocket task.
+ */
+static void testPublishWebServerCost()
+{
+    Cost cost;
+
+    gWebServer = new LapTriggerWebServer(*gCompetition);
+    TEST_ASSERT_TRUE(gWebServer->begin());
+
+    /* The first broadcast allocates the buffers of the servers once. */
+    publishEventsToWebServer(LapTriggerWebServer::EVENT_QUEUE_SIZE, cost);
+    publishEventsToWebServer(ITERATIONS, cost);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_PUBLISH_WEB_SERVER_NS, static_cast<uint32_t>(cost.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_ALLOCATIONS_PER_OP * ITERATIONS, cost.allocations);
+}
+
+/**
+ * Polling the released competition is the sensor task, which runs every
+ * loop cycle.
+ */
+static void testPollCost()
+{
+    Cost cost;
+
+    TEST_ASSERT_TRUE(gCompetition->setReleasedState(0U));
+
+    measure("competition poll", pollCompetition, ITERATIONS, cost);
+
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_RELEASED, gCompetition->getState());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_POLL_NS, static_cast<uint32_t>(cost.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_ALLOCATIONS_PER_OP * ITERATIONS, cost.allocations);
+}
+
+/**
+ * A run like the operator page drives it: release, start, finish, result
+ * table, name, statistics and journal. After the warm up, the heap shall be
+ * in steady state.
+ */
+static void testRunCost()
+{
+    Cost cost;
+
+    TEST_ASSERT_TRUE(NativeHAL::isHeapCounted());
+
+    gWebServer = new LapTriggerWebServer(*gCompetition);
+    TEST_ASSERT_TRUE(gWebServer->begin());
+
+    simulateRuns(WARM_UP_RUNS);
+    measure("run", simulateRuns, RUNS, cost);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_RUN_NS, static_cast<uint32_t>(cost.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_ALLOCATIONS_PER_OP * RUNS, cost.allocations);
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argPortOffset[] = "--port-offset";
+    static char     portOffset[]    = "32000";
+    static char     argEeprom[]     = "--eeprom";
+    static char     eeprom[]        = "test_benchmark_eeprom.bin";
+    char*           args[]          = { argv[0], argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+    int             failures        = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(5, args);
+    NativeHAL::setVirtualTime(true);
+
+    /* Every release logs the active group, which only costs time here. */
+    Log::setLevel(Log::LOG_ERROR);
+
+    (void)Board::begin();
+    (void)LittleFS.begin();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testPublishCost);
+    RUN_TEST(testPublishWebServerCost);
+    RUN_TEST(testPollCost);
+    RUN_TEST(testRunCost);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Measure the host time and the heap allocations of a case and print them.
+ *
+ * @param[in]  name         Name of the case.
+ * @param[in]  func         Operations of the case.
+ * @param[in]  iterations   Number of operations.
+ * @param[out] cost         Cost per operation.
+ */
+static void measure(const char* name, CaseFunc func, uint32_t iterations, Cost& cost)
+{
+    NativeHAL::HeapUsage    begin;
+    NativeHAL::HeapUsage    end;
+    uint64_t                start   = 0U;
+    uint64_t                stop    = 0U;
+    char                    line[96U];
+
+    NativeHAL::getHeapUsage(begin);
+    start = getHostNs();
+
+    func(iterations);
+
+    stop = getHostNs();
+    NativeHAL::getHeapUsage(end);
+
+    cost.nsPerOp        = static_cast<double>(stop - start) / iterations;
+    cost.allocations    = static_cast<uint32_t>(end.allocations - begin.allocations);
+
+    (void)snprintf(line, sizeof(line), "%s: %.1f ns/op, %.3f allocations/op", name, cost.nsPerOp,
+                   static_cast<double>(cost.allocations) / iterations);
+    TEST_MESSAGE(line);
+}
+
+/**
+ * Get the monotonic host time.
+ *
+ * @return Host time in ns.
+ */
+static uint64_t getHostNs()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000000U) + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * Publish finish events.
+ *
+ * @param[in] iterations    Number of events.
+ */
+static void publishEvents(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        EventBus::getInstance().publishRunFinished(static_cast<uint8_t>(idx % 3U), MIN_LAP_TIME + idx, 0U);
+    }
+}
+
+/**
+ * Publish finish events to the web server, in batches of its queue size.
+ * Only the publishing is timed, the websocket task, which sends the events
+ * after every batch, is not. The heap allocations of both are counted.
+ *
+ * @param[in]  iterations   Number of events.
+ * @param[out] cost         Cost per event.
+ */
+static void publishEventsToWebServer(uint32_t iterations, Cost& cost)
+{
+    NativeHAL::HeapUsage    begin;
+    NativeHAL::HeapUsage    end;
+    uint64_t                start   = 0U;
+    uint64_t                ns      = 0U;
+    uint32_t                idx     = 0U;
+    uint32_t                count   = 0U;
+    char                    line[96U];
+
+    NativeHAL::getHeapUsage(begin);
+
+    while (idx < iterations)
+    {
+        start = getHostNs();
+
+        for (count = 0U; (count < LapTriggerWebServer::EVENT_QUEUE_SIZE) && (idx < iterations); ++count)
+        {
+            EventBus::getInstance().publishRunFinished(static_cast<uint8_t>(idx % 3U), MIN_LAP_TIME + idx, 0U);
+            ++idx;
+        }
+
+        ns += getHostNs() - start;
+
+        (void)gWebServer->handleWebSocket();
+    }
+
+    NativeHAL::getHeapUsage(end);
+
+    cost.nsPerOp        = static_cast<double>(ns) / iterations;
+    cost.allocations    = static_cast<uint32_t>(end.allocations - begin.allocations);
+
+    (void)snprintf(line, sizeof(line), "publish, web server listener: %.1f ns/op, %.3f allocations/op",
+                   cost.nsPerOp, static_cast<double>(cost.allocations) / iterations);
+    TEST_MESSAGE(line);
+}
+
+/**
+ * Poll the competition, while the sensor is free.
+ *
+ * @param[in] iterations    Number of polls.
+ */
+static void pollCompetition(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        (void)gCompetition->handleCompetition();
+    }
+}
+
+/**
+ * Simulate runs like the operator page drives them.
+ *
+ * @param[in] iterations    Number of runs.
+ */
+static void simulateRuns(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        uint8_t group   = static_cast<uint8_t>(gRun % 3U);
+        char    cmd[16U];
+
+        (void)snprintf(cmd, sizeof(cmd), "RELEASE;%u", static_cast<unsigned int>(group));
+        sendCommand(cmd);
+
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+        (void)gWebServer->handleCompetition();
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+        NativeHAL::advanceTime(static_cast<uint64_t>(MIN_LAP_TIME + ((gRun * 37U) % 1000U)) * 1000U);
+
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+        (void)gWebServer->handleCompetition();
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+        (void)gWebServer->handleCompetition();
+        (void)gWebServer->handleWebServer();
+
+        sendCommand("GET_TABLE");
+        (void)snprintf(cmd, sizeof(cmd), "GET_NAME;%u", static_cast<unsigned int>(group));
+        sendCommand(cmd);
+        (void)snprintf(cmd, sizeof(cmd), "GET_STATS;%u", static_cast<unsigned int>(group));
+        sendCommand(cmd);
+        sendCommand("GET_JOURNAL");
+
+        ++gRun;
+    }
+}
+
+/**
+ * Send a command as text frame to the command dispatch.
+ *
+ * @param[in] cmd   Command
+ */
+static void sendCommand(const char* cmd)
+{
+    char    payload[32U];
+    size_t  length  = strlen(cmd);
+
+    /* The dispatch gets a writable frame, like from the websocket server. */
+    memcpy(payload, cmd, length + 1U);
+    (void)WebSocketsServer::injectEvent(CLIENT_ID, WStype_TEXT, reinterpret_cast<uint8_t*>(payload), length);
+}
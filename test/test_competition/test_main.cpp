@@ -0,0 +1,675 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the competition state machine, the lap times and the journal
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Settings.h>
+#include <Competition.h>
+#include <Group.h>
+#include <Log.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Everything of a group, which the result table and the statistics show. */
+typedef struct
+{
+    uint32_t    lapTime;    /**< Fastest lap time in ms. */
+    uint8_t     rank;       /**< Rank in the result table. */
+    uint32_t    count;      /**< Number of laps. */
+    uint32_t    mean;       /**< Mean lap time in ms. */
+    uint32_t    stdDev;     /**< Standard deviation in ms. */
+    uint32_t    median;     /**< Estimated median in ms. */
+    uint32_t    p90;        /**< Estimated 90th percentile in ms. */
+
+} GroupState;
+
+/** State of all groups and of the track record. */
+typedef struct
+{
+    GroupState  groups[3U];     /**< Groups of the competition under test. */
+    uint32_t    blindPeriod;    /**< Blind period in ms, which follows the track record. */
+
+} TableState;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void triggerSensor(Competition& competition);
+static void runLap(Competition& competition, uint8_t group, uint32_t lapTime);
+static void getTableState(Competition& competition, TableState& state);
+static void assertTableState(const TableState& expected, const TableState& actual);
+static uint32_t getJournalLapTime(uint32_t run);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*  EEPROM_FILE     = "test_competition_eeprom.bin";
+
+/** Lap time in ms, which is longer than the blind period. */
+static const uint32_t LAP_TIME      = 12000U;
+
+/** Number of groups of the competition under test. */
+static const uint8_t  GROUPS        = 3U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings and a power-on RTC memory, therefore
+ * the competition doesn't restore the state of the test before.
+ */
+void setUp()
+{
+    static const uint32_t   ZEROS[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)] = { 0U };
+
+    (void)NativeHAL::writeRtcMemory(0U, ZEROS, sizeof(ZEROS));
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * A new competition ignores the sensor, until a group is released.
+ */
+static void testUnreleased()
+{
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    TEST_ASSERT_FALSE(competition.handleCompetition());
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+}
+
+/**
+ * A run goes through released, started and finished. The sensor is ignored
+ * during the blind period and after the finish.
+ */
+static void testRunTransitions()
+{
+    Competition competition;
+    uint32_t    period      = 0U;
+    uint8_t     ratio       = 0U;
+
+    TEST_ASSERT_TRUE(competition.begin());
+    competition.getBlindPeriod(period, ratio);
+
+    TEST_ASSERT_TRUE(competition.setReleasedState(1U));
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_RELEASED, competition.getState());
+    TEST_ASSERT_EQUAL_UINT8(1U, competition.getActiveGroup());
+
+    /* Nothing happens without the robot. */
+    TEST_ASSERT_FALSE(competition.handleCompetition());
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_RELEASED, competition.getState());
+
+    triggerSensor(competition);
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_STARTED, competition.getState());
+
+    /* The robot still in the barrier doesn't finish the run. */
+    NativeHAL::advanceTime(static_cast<uint64_t>(period - 1U) * 1000U);
+    triggerSensor(competition);
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_STARTED, competition.getState());
+
+    /* A release during the run is refused. */
+    TEST_ASSERT_FALSE(competition.setReleasedState(1U));
+
+    NativeHAL::advanceTime(static_cast<uint64_t>(LAP_TIME - (period - 1U)) * 1000U);
+    triggerSensor(competition);
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, competition.getState());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getRunLapTime());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, competition.getRank(1U));
+
+    /* The next run must be released first. */
+    NativeHAL::advanceTime(1000000U);
+    triggerSensor(competition);
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, competition.getState());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getRunLapTime());
+
+    TEST_ASSERT_TRUE(competition.setReleasedState(0U));
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_RELEASED, competition.getState());
+}
+
+/**
+ * Only a configured group can be released.
+ */
+static void testReleaseConfiguredGroupsOnly()
+{
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+    TEST_ASSERT_TRUE(competition.setNumberofGroups(GROUPS));
+
+    TEST_ASSERT_FALSE(competition.setReleasedState(GROUPS));
+    TEST_ASSERT_FALSE(competition.setReleasedState(Competition::MAX_GROUPS));
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+
+    TEST_ASSERT_TRUE(competition.setReleasedState(GROUPS - 1U));
+    TEST_ASSERT_EQUAL_UINT8(GROUPS - 1U, competition.getActiveGroup());
+}
+
+/**
+ * The fastest lap time of a group only gets faster, except it is not set yet.
+ */
+static void testSetLapTimeIfFaster()
+{
+    Group group;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, group.getfastestLapTime());
+
+    group.setLapTimeIfFaster(LAP_TIME);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, group.getfastestLapTime());
+
+    group.setLapTimeIfFaster(LAP_TIME + 1U);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, group.getfastestLapTime());
+
+    group.setLapTimeIfFaster(LAP_TIME);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, group.getfastestLapTime());
+
+    group.setLapTimeIfFaster(LAP_TIME - 1U);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 1U, group.getfastestLapTime());
+
+    /* Cleared, any lap time is the fastest one. */
+    group.setFastestLapTime(0U);
+    group.setLapTimeIfFaster(LAP_TIME + 1U);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME + 1U, group.getfastestLapTime());
+}
+
+/**
+ * Rejecting the last run restores its group, including the statistics, and
+ * is only possible once.
+ */
+static void testRejectRun()
+{
+    Competition     competition;
+    LapStatistics   statistics;
+
+    TEST_ASSERT_TRUE(competition.begin());
+
+    /* Nothing to reject yet. */
+    TEST_ASSERT_FALSE(competition.rejectRun());
+
+    runLap(competition, 0U, LAP_TIME);
+    runLap(competition, 0U, LAP_TIME - 500U);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 500U, competition.getLaptime(0U));
+
+    TEST_ASSERT_TRUE(competition.rejectRun());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+    TEST_ASSERT_TRUE(competition.getLapStatistics(0U, statistics));
+    TEST_ASSERT_EQUAL_UINT32(1U, statistics.getCount());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, statistics.getMean());
+
+    /* The run before can only be undone, not rejected. */
+    TEST_ASSERT_FALSE(competition.rejectRun());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+}
+
+/**
+ * A rejected run of another group doesn't touch the fastest lap times of
+ * the others.
+ */
+static void testRejectRunKeepsOtherGroups()
+{
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+
+    runLap(competition, 0U, LAP_TIME);
+    runLap(competition, 1U, LAP_TIME - 1000U);
+    TEST_ASSERT_EQUAL_UINT8(2U, competition.getRank(0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, competition.getRank(1U));
+
+    TEST_ASSERT_TRUE(competition.rejectRun());
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(1U));
+    TEST_ASSERT_EQUAL_UINT8(1U, competition.getRank(0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, competition.getRank(1U));
+}
+
+/**
+ * Every undo restores the whole table to the state before the run, including
+ * the statistics with more laps than P2 markers, and every redo replays the
+ * run to the state after it.
+ */
+static void testUndoRedo()
+{
+    const uint8_t   RUNS            = Competition::JOURNAL_SIZE;
+    const uint8_t   PREVIOUS_RUNS   = 6U;
+    TableState      states[RUNS + 1U];
+    TableState      actual;
+    uint32_t        run             = 0U;
+    uint8_t         idx             = 0U;
+    Competition     competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+
+    /* More laps than P2 markers, therefore the markers are estimated. */
+    for (idx = 0U; idx < PREVIOUS_RUNS; ++idx)
+    {
+        runLap(competition, 0U, getJournalLapTime(idx));
+    }
+
+    for (idx = 0U; idx < RUNS; ++idx)
+    {
+        getTableState(competition, states[idx]);
+        runLap(competition, idx % GROUPS, getJournalLapTime(PREVIOUS_RUNS + idx));
+    }
+
+    getTableState(competition, states[RUNS]);
+    TEST_ASSERT_EQUAL_UINT8(RUNS, competition.getJournalCount());
+
+    for (idx = RUNS; idx > 0U; --idx)
+    {
+        TEST_ASSERT_TRUE(competition.undoRun(run));
+        TEST_ASSERT_EQUAL_UINT32(PREVIOUS_RUNS + idx, run);
+        getTableState(competition, actual);
+        assertTableState(states[idx - 1U], actual);
+    }
+
+    /* The older runs were dropped from the journal. */
+    TEST_ASSERT_FALSE(competition.undoRun(run));
+
+    for (idx = 0U; idx < RUNS; ++idx)
+    {
+        TEST_ASSERT_TRUE(competition.redoRun(run));
+        TEST_ASSERT_EQUAL_UINT32(PREVIOUS_RUNS + idx + 1U, run);
+        getTableState(competition, actual);
+        assertTableState(states[idx + 1U], actual);
+    }
+
+    TEST_ASSERT_FALSE(competition.redoRun(run));
+}
+
+/**
+ * A new run after an undo discards the undone runs, they can't be redone
+ * anymore.
+ */
+static void testRedoInvalidated()
+{
+    uint32_t    run         = 0U;
+    uint8_t     group       = 0U;
+    uint32_t    lapTime     = 0U;
+    bool        isUndone    = false;
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+
+    runLap(competition, 0U, LAP_TIME);
+    runLap(competition, 1U, LAP_TIME - 100U);
+    runLap(competition, 2U, LAP_TIME - 200U);
+
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(2U, run);
+
+    /* The undone runs are still listed, until the next run. */
+    TEST_ASSERT_EQUAL_UINT8(3U, competition.getJournalCount());
+    TEST_ASSERT_TRUE(competition.getJournalEntry(1U, run, group, lapTime, isUndone));
+    TEST_ASSERT_TRUE(isUndone);
+
+    runLap(competition, 2U, LAP_TIME + 100U);
+    TEST_ASSERT_FALSE(competition.redoRun(run));
+
+    TEST_ASSERT_EQUAL_UINT8(2U, competition.getJournalCount());
+    TEST_ASSERT_TRUE(competition.getJournalEntry(0U, run, group, lapTime, isUndone));
+    TEST_ASSERT_EQUAL_UINT32(1U, run);
+    TEST_ASSERT_EQUAL_UINT8(0U, group);
+    TEST_ASSERT_FALSE(isUndone);
+    TEST_ASSERT_TRUE(competition.getJournalEntry(1U, run, group, lapTime, isUndone));
+    TEST_ASSERT_EQUAL_UINT32(4U, run);
+    TEST_ASSERT_EQUAL_UINT8(2U, group);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME + 100U, lapTime);
+    TEST_ASSERT_FALSE(isUndone);
+    TEST_ASSERT_FALSE(competition.getJournalEntry(2U, run, group, lapTime, isUndone));
+
+    /* The undone runs are gone from the table too. */
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(1U));
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME + 100U, competition.getLaptime(2U));
+}
+
+/**
+ * The journal keeps the latest runs in order. Undoing all of them and
+ * replaying them with redo gives the same table again.
+ */
+static void testJournalReplay()
+{
+    const uint8_t   RUNS        = Competition::JOURNAL_SIZE + 2U;
+    uint32_t        run         = 0U;
+    uint8_t         group       = 0U;
+    uint32_t        lapTime     = 0U;
+    bool            isUndone    = false;
+    uint8_t         idx         = 0U;
+    TableState      expected;
+    TableState      actual;
+    Competition     competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+
+    for (idx = 0U; idx < RUNS; ++idx)
+    {
+        runLap(competition, idx % GROUPS, getJournalLapTime(idx));
+    }
+
+    getTableState(competition, expected);
+
+    /* The oldest runs are dropped. */
+    TEST_ASSERT_EQUAL_UINT8(Competition::JOURNAL_SIZE, competition.getJournalCount());
+
+    for (idx = 0U; idx < Competition::JOURNAL_SIZE; ++idx)
+    {
+        uint8_t runIdx = idx + (RUNS - Competition::JOURNAL_SIZE);
+
+        TEST_ASSERT_TRUE(competition.getJournalEntry(idx, run, group, lapTime, isUndone));
+        TEST_ASSERT_EQUAL_UINT32(runIdx + 1U, run);
+        TEST_ASSERT_EQUAL_UINT8(runIdx % GROUPS, group);
+        TEST_ASSERT_EQUAL_UINT32(getJournalLapTime(runIdx), lapTime);
+        TEST_ASSERT_FALSE(isUndone);
+    }
+
+    while (true == competition.undoRun(run))
+    {
+        ;
+    }
+
+    /* Only the runs before the journal are left. */
+    TEST_ASSERT_TRUE(competition.getJournalEntry(0U, run, group, lapTime, isUndone));
+    TEST_ASSERT_TRUE(isUndone);
+
+    while (true == competition.redoRun(run))
+    {
+        ;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(RUNS, run);
+    getTableState(competition, actual);
+    assertTableState(expected, actual);
+}
+
+/**
+ * Clearing the lap times of a group drops only its runs from the journal.
+ * The runs of the other groups can still be undone and redone.
+ */
+static void testClearKeepsOtherRuns()
+{
+    uint32_t    run         = 0U;
+    uint8_t     group       = 0U;
+    uint32_t    lapTime     = 0U;
+    bool        isUndone    = false;
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+    TEST_ASSERT_TRUE(competition.setNumberofGroups(GROUPS));
+
+    runLap(competition, 1U, LAP_TIME);
+    runLap(competition, 0U, LAP_TIME - 100U);
+    runLap(competition, 1U, LAP_TIME - 50U);
+    runLap(competition, 0U, LAP_TIME - 200U);
+
+    /* The undone run of group 1 stays undone. */
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(3U, run);
+    TEST_ASSERT_TRUE(competition.redoRun(run));
+
+    TEST_ASSERT_TRUE(competition.clearLaptime(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(0U));
+
+    TEST_ASSERT_EQUAL_UINT8(2U, competition.getJournalCount());
+    TEST_ASSERT_TRUE(competition.getJournalEntry(0U, run, group, lapTime, isUndone));
+    TEST_ASSERT_EQUAL_UINT32(1U, run);
+    TEST_ASSERT_EQUAL_UINT8(1U, group);
+    TEST_ASSERT_FALSE(isUndone);
+    TEST_ASSERT_TRUE(competition.getJournalEntry(1U, run, group, lapTime, isUndone));
+    TEST_ASSERT_EQUAL_UINT32(3U, run);
+    TEST_ASSERT_EQUAL_UINT8(1U, group);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 50U, lapTime);
+    TEST_ASSERT_FALSE(isUndone);
+
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(3U, run);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(1U));
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(1U, run);
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(1U));
+    TEST_ASSERT_FALSE(competition.undoRun(run));
+
+    TEST_ASSERT_TRUE(competition.redoRun(run));
+    TEST_ASSERT_TRUE(competition.redoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(3U, run);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 50U, competition.getLaptime(1U));
+    TEST_ASSERT_FALSE(competition.redoRun(run));
+
+    /* The cleared group is never touched. */
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(0U));
+}
+
+/**
+ * Less groups drop only the runs of the removed groups from the journal.
+ */
+static void testLessGroupsKeepRuns()
+{
+    uint32_t    run         = 0U;
+    Competition competition;
+
+    TEST_ASSERT_TRUE(competition.begin());
+    TEST_ASSERT_TRUE(competition.setNumberofGroups(GROUPS));
+
+    runLap(competition, 0U, LAP_TIME);
+    runLap(competition, GROUPS - 1U, LAP_TIME - 100U);
+
+    TEST_ASSERT_TRUE(competition.setNumberofGroups(GROUPS - 1U));
+    TEST_ASSERT_EQUAL_UINT8(1U, competition.getJournalCount());
+
+    TEST_ASSERT_TRUE(competition.undoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(1U, run);
+    TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(0U));
+    TEST_ASSERT_FALSE(competition.undoRun(run));
+
+    /* More groups keep the journal. */
+    TEST_ASSERT_TRUE(competition.setNumberofGroups(GROUPS));
+    TEST_ASSERT_TRUE(competition.redoRun(run));
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argEeprom[] = "--eeprom";
+    static char     eeprom[]    = "test_competition_eeprom.bin";
+    char*           args[]      = { argv[0], argEeprom, eeprom, nullptr };
+    int             failures    = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(3, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_WARNING);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testUnreleased);
+    RUN_TEST(testRunTransitions);
+    RUN_TEST(testReleaseConfiguredGroupsOnly);
+    RUN_TEST(testSetLapTimeIfFaster);
+    RUN_TEST(testRejectRun);
+    RUN_TEST(testRejectRunKeepsOtherGroups);
+    RUN_TEST(testUndoRedo);
+    RUN_TEST(testRedoInvalidated);
+    RUN_TEST(testJournalReplay);
+    RUN_TEST(testClearKeepsOtherRuns);
+    RUN_TEST(testLessGroupsKeepRuns);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Pass the sensor: it is interrupted for a poll of the competition.
+ *
+ * @param[in] competition   Competition
+ */
+static void triggerSensor(Competition& competition)
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)competition.handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)competition.handleCompetition();
+}
+
+/**
+ * Release a group and let it drive a lap.
+ *
+ * @param[in] competition   Competition
+ * @param[in] group         Group
+ * @param[in] lapTime       Lap time in ms.
+ */
+static void runLap(Competition& competition, uint8_t group, uint32_t lapTime)
+{
+    TEST_ASSERT_TRUE(competition.setReleasedState(group));
+
+    triggerSensor(competition);
+    NativeHAL::advanceTime(static_cast<uint64_t>(lapTime) * 1000U);
+    triggerSensor(competition);
+
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, competition.getState());
+    TEST_ASSERT_EQUAL_UINT32(lapTime, competition.getRunLapTime());
+}
+
+/**
+ * Get the state of all groups and of the track record.
+ *
+ * @param[in]  competition  Competition
+ * @param[out] state        State
+ */
+static void getTableState(Competition& competition, TableState& state)
+{
+    uint8_t         group   = 0U;
+    LapStatistics   statistics;
+
+    for (group = 0U; group < GROUPS; ++group)
+    {
+        GroupState& groupState = state.groups[group];
+
+        TEST_ASSERT_TRUE(competition.getLapStatistics(group, statistics));
+
+        groupState.lapTime  = competition.getLaptime(group);
+        groupState.rank     = competition.getRank(group);
+        groupState.count    = statistics.getCount();
+        groupState.mean     = statistics.getMean();
+        groupState.stdDev   = statistics.getStdDev();
+        groupState.median   = statistics.getMedian();
+        groupState.p90      = statistics.getP90();
+    }
+
+    state.blindPeriod = competition.getEffectiveBlindPeriod();
+}
+
+/**
+ * Assert that all groups and the track record are in the expected state.
+ *
+ * @param[in] expected  Expected state
+ * @param[in] actual    Actual state
+ */
+static void assertTableState(const TableState& expected, const TableState& actual)
+{
+    uint8_t group = 0U;
+
+    for (group = 0U; group < GROUPS; ++group)
+    {
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].lapTime, actual.groups[group].lapTime);
+        TEST_ASSERT_EQUAL_UINT8(expected.groups[group].rank, actual.groups[group].rank);
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].count, actual.groups[group].count);
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].mean, actual.groups[group].mean);
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].stdDev, actual.groups[group].stdDev);
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].median, actual.groups[group].median);
+        TEST_ASSERT_EQUAL_UINT32(expected.groups[group].p90, actual.groups[group].p90);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(expected.blindPeriod, actual.blindPeriod);
+}
+
+/**
+ * Get a lap time of a series of runs, which spreads around LAP_TIME.
+ *
+ * @param[in] run   Index of the run in the series.
+ *
+ * @return Lap time in ms.
+ */
+static uint32_t getJournalLapTime(uint32_t run)
+{
+    return LAP_TIME - 700U + ((run * 379U) % 1500U);
+}
@@ -0,0 +1,379 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the tokenized against the formatted log messages
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Log.h>
+#include <LogToken.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <type_traits>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/*
+ * The thresholds have a wide margin to the host numbers, because the tests
+ * run unoptimized and on loaded build servers. A regression by an order of
+ * magnitude or a single allocation still fails.
+ */
+
+/** Max. cost of a formatted log message in ns, including the idle time sending. */
+#ifndef TEST_MAX_FORMATTED_NS
+#define TEST_MAX_FORMATTED_NS           20000U
+#endif
+
+/** Max. cost of a tokenized log message in ns, including the idle time sending. */
+#ifndef TEST_MAX_TOKENIZED_NS
+#define TEST_MAX_TOKENIZED_NS           10000U
+#endif
+
+/** Max. serial bytes of a tokenized message in percent of the formatted one. */
+#ifndef TEST_MAX_TOKENIZED_BYTES_PERCENT
+#define TEST_MAX_TOKENIZED_BYTES_PERCENT    40U
+#endif
+
+/** Format string of the measured log message, a typical one after a finish. */
+#define TEST_FORMAT                     "Group %u finished in %u ms, rank %u."
+
+/** Token of the measured log message, like the LOG_* macros calculate it. */
+#define TEST_TOKEN                      (std::integral_constant<uint32_t, LogToken::getToken(__FILE__, TEST_FORMAT)>::value)
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Measured cost of a case. */
+typedef struct
+{
+    double      nsPerOp;        /**< Host time per operation in ns. */
+    double      bytesPerOp;     /**< Serial bytes per operation. */
+    uint32_t    allocations;    /**< Heap allocations of all operations. */
+
+} Cost;
+
+/** Operations of a case. */
+typedef void (*CaseFunc)(uint32_t iterations);
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void measure(const char* name, CaseFunc func, uint32_t iterations, Cost& cost);
+static uint64_t getHostNs();
+static void logFormatted(uint32_t iterations);
+static void logTokenized(uint32_t iterations);
+static size_t captureSerial(CaseFunc func, uint32_t iterations, uint8_t* buffer, size_t size);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of measured log messages. */
+static const uint32_t   ITERATIONS          = 100000U;
+
+/** Baudrate of the serial interface on the device. */
+static const uint32_t   BAUDRATE            = 115200U;
+
+/** Bits on the wire per byte: start, 8 data and stop bit. */
+static const uint32_t   BITS_PER_BYTE       = 10U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: all log levels are sent.
+ */
+void setUp()
+{
+    Log::setLevel(Log::LOG_INFO);
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+    Log::setLevel(Log::LOG_ERROR);
+}
+
+/**
+ * The tokenized frame carries the token of the call site and the raw
+ * arguments, instead of the text.
+ */
+static void testTokenFrame()
+{
+    uint8_t     frame[64U];
+    uint32_t    token       = 0U;
+    uint32_t    timestamp   = 0U;
+    size_t      size        = captureSerial(logTokenized, 1U, frame, sizeof(frame));
+    size_t      idx         = 0U;
+
+    for (idx = 0U; idx < 4U; ++idx)
+    {
+        token       |= static_cast<uint32_t>(frame[2U + idx]) << (8U * idx);
+        timestamp   |= static_cast<uint32_t>(frame[6U + idx]) << (8U * idx);
+    }
+
+    /* Start, length, token, timestamp, level and three tagged 32-bit arguments. */
+    TEST_ASSERT_EQUAL_UINT32(11U + (3U * 5U), size);
+    TEST_ASSERT_EQUAL_UINT8(LogToken::FRAME_START, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(size - 2U, frame[1]);
+    TEST_ASSERT_EQUAL_UINT32(LogToken::getToken("test_main.cpp", TEST_FORMAT), token);
+    TEST_ASSERT_EQUAL_UINT32(millis(), timestamp);
+    TEST_ASSERT_EQUAL_UINT8(Log::LOG_INFO, frame[10]);
+    TEST_ASSERT_EQUAL_UINT8('u', frame[11]);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame[12]);
+    TEST_ASSERT_EQUAL_UINT8('u', frame[16]);
+    TEST_ASSERT_EQUAL_UINT8(10000U & 0xFFU, frame[17]);
+    TEST_ASSERT_EQUAL_UINT8(10000U >> 8U, frame[18]);
+    TEST_ASSERT_EQUAL_UINT8('u', frame[21]);
+    TEST_ASSERT_EQUAL_UINT8(1U, frame[22]);
+}
+
+/**
+ * The tokenized message costs less time in the loop and much less time on
+ * the serial interface than the formatted one. No message is dropped,
+ * because the idle time task sends them in between.
+ */
+static void testLogCost()
+{
+    Cost        formatted;
+    Cost        tokenized;
+    uint32_t    dropped     = Log::getDroppedCount();
+    char        line[128U];
+
+    measure("formatted", logFormatted, ITERATIONS, formatted);
+    measure("tokenized", logTokenized, ITERATIONS, tokenized);
+
+    (void)snprintf(line, sizeof(line), "tokenized: %.0f %% of the time, %.0f %% of the serial bytes",
+                   (100.0 * tokenized.nsPerOp) / formatted.nsPerOp,
+                   (100.0 * tokenized.bytesPerOp) / formatted.bytesPerOp);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT32(dropped, Log::getDroppedCount());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_FORMATTED_NS, static_cast<uint32_t>(formatted.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TEST_MAX_TOKENIZED_NS, static_cast<uint32_t>(tokenized.nsPerOp));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32((TEST_MAX_TOKENIZED_BYTES_PERCENT * formatted.bytesPerOp) / 100U,
+                                     static_cast<uint32_t>(tokenized.bytesPerOp));
+    TEST_ASSERT_EQUAL_UINT32(0U, formatted.allocations);
+    TEST_ASSERT_EQUAL_UINT32(0U, tokenized.allocations);
+}
+
+/**
+ * A message below the runtime level is discarded, before it is formatted
+ * or encoded.
+ */
+static void testFilteredCost()
+{
+    uint8_t buffer[16U];
+
+    Log::setLevel(Log::LOG_ERROR);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, captureSerial(logFormatted, ITERATIONS, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT32(0U, captureSerial(logTokenized, ITERATIONS, buffer, sizeof(buffer)));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    int failures = 0;
+
+    (void)NativeHAL::begin(argc, argv);
+    NativeHAL::setVirtualTime(true);
+    NativeHAL::advanceTime(123456U * 1000U);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testTokenFrame);
+    RUN_TEST(testLogCost);
+    RUN_TEST(testFilteredCost);
+
+    failures = UNITY_END();
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Measure the host time, the serial bytes and the heap allocations of a case
+ * and print them, together with the time on the serial interface of the
+ * device.
+ *
+ * @param[in]  name         Name of the case.
+ * @param[in]  func         Operations of the case.
+ * @param[in]  iterations   Number of operations.
+ * @param[out] cost         Cost per operation.
+ */
+static void measure(const char* name, CaseFunc func, uint32_t iterations, Cost& cost)
+{
+    NativeHAL::HeapUsage    begin;
+    NativeHAL::HeapUsage    end;
+    uint64_t                start   = 0U;
+    uint64_t                stop    = 0U;
+    size_t                  bytes   = 0U;
+    char                    line[128U];
+
+    NativeHAL::getHeapUsage(begin);
+    start = getHostNs();
+
+    bytes = captureSerial(func, iterations, nullptr, 0U);
+
+    stop = getHostNs();
+    NativeHAL::getHeapUsage(end);
+
+    cost.nsPerOp        = static_cast<double>(stop - start) / iterations;
+    cost.bytesPerOp     = static_cast<double>(bytes) / iterations;
+    cost.allocations    = static_cast<uint32_t>(end.allocations - begin.allocations);
+
+    (void)snprintf(line, sizeof(line), "%s: %.1f ns/op, %.1f byte/op, %.0f us/op on the serial interface, %.3f allocations/op",
+                   name, cost.nsPerOp, cost.bytesPerOp, (cost.bytesPerOp * BITS_PER_BYTE * 1000000.0) / BAUDRATE,
+                   static_cast<double>(cost.allocations) / iterations);
+    TEST_MESSAGE(line);
+}
+
+/**
+ * Get the monotonic host time.
+ *
+ * @return Host time in ns.
+ */
+static uint64_t getHostNs()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000000U) + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * Log formatted messages, each followed by the idle time task, like in the
+ * main loop.
+ *
+ * @param[in] iterations    Number of messages.
+ */
+static void logFormatted(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        Log::print(__FILE__, __LINE__, Log::LOG_INFO, TEST_FORMAT, idx % 3U, 10000U + idx, 1U);
+        (void)Log::process();
+    }
+}
+
+/**
+ * Log tokenized messages, each followed by the idle time task, like in the
+ * main loop.
+ *
+ * @param[in] iterations    Number of messages.
+ */
+static void logTokenized(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        Log::printToken(Log::LOG_INFO, TEST_TOKEN, idx % 3U, 10000U + idx, 1U);
+        (void)Log::process();
+    }
+}
+
+/**
+ * Run a case with the serial interface redirected to a temporary file and
+ * count the sent bytes.
+ *
+ * @param[in]  func         Operations of the case.
+ * @param[in]  iterations   Number of operations.
+ * @param[out] buffer       The first sent bytes, may be nullptr.
+ * @param[in]  size         Size of the buffer in byte.
+ *
+ * @return Number of sent bytes.
+ */
+static size_t captureSerial(CaseFunc func, uint32_t iterations, uint8_t* buffer, size_t size)
+{
+    FILE*       capture = tmpfile();
+    int         console = -1;
+    size_t      bytes   = 0U;
+    struct stat status;
+
+    TEST_ASSERT_NOT_NULL(capture);
+
+    (void)fflush(stdout);
+    console = dup(STDOUT_FILENO);
+    (void)dup2(fileno(capture), STDOUT_FILENO);
+
+    func(iterations);
+    Log::flush();
+
+    (void)fflush(stdout);
+    (void)dup2(console, STDOUT_FILENO);
+    (void)close(console);
+
+    if (0 == fstat(fileno(capture), &status))
+    {
+        bytes = static_cast<size_t>(status.st_size);
+    }
+
+    if (nullptr != buffer)
+    {
+        rewind(capture);
+        (void)fread(buffer, 1U, size, capture);
+    }
+
+    (void)fclose(capture);
+
+    return bytes;
+}
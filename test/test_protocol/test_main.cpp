@@ -0,0 +1,428 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the websocket command protocol
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <Board.h>
+#include <Settings.h>
+#include <LittleFS.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void sendCommand(const char* cmd);
+static const char* getReply(size_t idx);
+static void runLap(uint8_t group, uint32_t lapTime);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*          EEPROM_FILE = "test_protocol_eeprom.bin";
+
+/** Client number, which sends the commands. */
+static const uint8_t        CLIENT_ID   = 0U;
+
+/** Lap time in ms, which is longer than the blind period. */
+static const uint32_t       LAP_TIME    = 12000U;
+
+/** Replies to the last command. */
+static std::vector<String>  gReplies;
+
+/** Competition under test. */
+static Competition*         gCompetition    = nullptr;
+
+/** Web server under test, which dispatches the commands. */
+static LapTriggerWebServer* gWebServer      = nullptr;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings with 3 groups, a power-on RTC memory
+ * and a new competition with its web server. They are created on the heap,
+ * because a failed test doesn't return and would skip their destructors.
+ */
+void setUp()
+{
+    static const uint32_t   ZEROS[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)] = { 0U };
+
+    (void)NativeHAL::writeRtcMemory(0U, ZEROS, sizeof(ZEROS));
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+
+    gReplies.clear();
+
+    gCompetition    = new Competition();
+    gWebServer      = new LapTriggerWebServer(*gCompetition);
+
+    TEST_ASSERT_TRUE(gCompetition->begin());
+    TEST_ASSERT_TRUE(gWebServer->begin());
+}
+
+/**
+ * Clean up after every test. The web server stops listening and leaves the
+ * event bus.
+ */
+void tearDown()
+{
+    delete gWebServer;
+    gWebServer = nullptr;
+
+    delete gCompetition;
+    gCompetition = nullptr;
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * A configured group is released, anything else is answered with NACK.
+ */
+static void testRelease()
+{
+    sendCommand("RELEASE;2");
+    TEST_ASSERT_EQUAL_STRING("ACK", getReply(0U));
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_RELEASED, gCompetition->getState());
+    TEST_ASSERT_EQUAL_UINT8(2U, gCompetition->getActiveGroup());
+
+    sendCommand("RELEASE;3");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    /* Not truncated to group 0. */
+    sendCommand("RELEASE;256");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("RELEASE;");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("RELEASE;-1");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("RELEASE;1x");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    TEST_ASSERT_EQUAL_UINT8(2U, gCompetition->getActiveGroup());
+}
+
+/**
+ * The number of groups is read and written within the limits of the build.
+ */
+static void testGroups()
+{
+    char                expected[32U];
+    char                cmd[32U];
+
+    (void)snprintf(expected, sizeof(expected), "ACK;GET_GROUPS;3;%u", static_cast<unsigned int>(Competition::MAX_GROUPS));
+    sendCommand("GET_GROUPS");
+    TEST_ASSERT_EQUAL_STRING(expected, getReply(0U));
+
+    (void)snprintf(cmd, sizeof(cmd), "SET_GROUPS;%u", static_cast<unsigned int>(Competition::MAX_GROUPS));
+    sendCommand(cmd);
+    TEST_ASSERT_EQUAL_STRING("ACK;SET_GROUPS", getReply(0U));
+
+    /* More groups than the build supports are limited to them. */
+    (void)snprintf(cmd, sizeof(cmd), "SET_GROUPS;%u", static_cast<unsigned int>(Competition::MAX_GROUPS + 1U));
+    sendCommand(cmd);
+    TEST_ASSERT_EQUAL_STRING("ACK;SET_GROUPS", getReply(0U));
+
+    (void)snprintf(expected, sizeof(expected), "ACK;GET_GROUPS;%u;%u", static_cast<unsigned int>(Competition::MAX_GROUPS), static_cast<unsigned int>(Competition::MAX_GROUPS));
+    sendCommand("GET_GROUPS");
+    TEST_ASSERT_EQUAL_STRING(expected, getReply(0U));
+
+    sendCommand("SET_GROUPS;256");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("SET_GROUPS;two");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("SET_GROUPS;2");
+    TEST_ASSERT_EQUAL_STRING("ACK;SET_GROUPS", getReply(0U));
+
+    /* The table has a header and one entry per group. */
+    sendCommand("GET_TABLE");
+    TEST_ASSERT_EQUAL_UINT32(3U, gReplies.size());
+    TEST_ASSERT_EQUAL_STRING("ACK;GET_TABLE;2", getReply(0U));
+    TEST_ASSERT_EQUAL_STRING("EVT;TABLE;0;0;", getReply(1U));
+    TEST_ASSERT_EQUAL_STRING("EVT;TABLE;1;0;", getReply(2U));
+}
+
+/**
+ * A group name is set, read back and cleared. A name, which doesn't fit,
+ * is refused instead of cut.
+ */
+static void testNames()
+{
+    sendCommand("SET_NAME;1:Rocket");
+    TEST_ASSERT_EQUAL_STRING("ACK;SET_NAME;1;Rocket", getReply(0U));
+
+    sendCommand("GET_NAME;1");
+    TEST_ASSERT_EQUAL_STRING("ACK;GET_NAME;1;Rocket", getReply(0U));
+
+    sendCommand("SET_NAME;1:The name is too long!");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("SET_NAME;1");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("SET_NAME;:Rocket");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("SET_NAME;3:Rocket");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("GET_NAME;3");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("CLEAR_NAME;1");
+    TEST_ASSERT_EQUAL_STRING("ACK;CLEAR_NAME;1", getReply(0U));
+
+    sendCommand("GET_NAME;1");
+    TEST_ASSERT_EQUAL_STRING("ACK;GET_NAME;1;", getReply(0U));
+}
+
+/**
+ * Unknown, empty and truncated commands are answered with NACK.
+ */
+static void testInvalidCommands()
+{
+    char                cmd[200U];
+
+    sendCommand("");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("UNKNOWN");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("release;0");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    /* A truncated command must not match a shorter one. */
+    (void)memset(cmd, 'A', sizeof(cmd) - 1U);
+    cmd[sizeof(cmd) - 1U] = '\0';
+    (void)memcpy(cmd, "RELEASE", 7U);
+    sendCommand(cmd);
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    (void)memcpy(cmd, "RELEASE;0", 9U);
+    sendCommand(cmd);
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("HOLD_SUSPICIOUS;2");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("HOLD_SUSPICIOUS;1");
+    TEST_ASSERT_EQUAL_STRING("ACK;HOLD_SUSPICIOUS;1", getReply(0U));
+    TEST_ASSERT_TRUE(gCompetition->isHoldSuspicious());
+
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, gCompetition->getState());
+}
+
+/**
+ * The run commands work on the journal of the gCompetition->
+ */
+static void testRunCommands()
+{
+    sendCommand("REJECT_RUN");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("UNDO");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    runLap(1U, LAP_TIME);
+
+    sendCommand("GET_JOURNAL");
+    TEST_ASSERT_EQUAL_STRING("ACK;GET_JOURNAL;1;1:1:12000:0", getReply(0U));
+
+    sendCommand("UNDO");
+    TEST_ASSERT_EQUAL_STRING("ACK;UNDO;1", getReply(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, gCompetition->getLaptime(1U));
+
+    sendCommand("REDO");
+    TEST_ASSERT_EQUAL_STRING("ACK;REDO;1", getReply(0U));
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, gCompetition->getLaptime(1U));
+
+    sendCommand("REDO");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("REJECT_RUN");
+    TEST_ASSERT_EQUAL_STRING("ACK;REJECT_RUN", getReply(0U));
+
+    sendCommand("GET_JOURNAL");
+    TEST_ASSERT_EQUAL_STRING("ACK;GET_JOURNAL;1;1:1:12000:1", getReply(0U));
+
+    sendCommand("CLEAR;3");
+    TEST_ASSERT_EQUAL_STRING("NACK", getReply(0U));
+
+    sendCommand("CLEAR;1");
+    TEST_ASSERT_EQUAL_STRING("ACK;CLEAR;1", getReply(0U));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argPortOffset[] = "--port-offset";
+    static char     portOffset[]    = "31000";
+    static char     argEeprom[]     = "--eeprom";
+    static char     eeprom[]        = "test_protocol_eeprom.bin";
+    char*           args[]          = { argv[0], argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+    int             failures        = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(5, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_ERROR);
+
+    (void)Board::begin();
+    (void)LittleFS.begin();
+
+    WebSocketsServer::observeText([](uint8_t num, const uint8_t* payload, size_t length) {
+        if (CLIENT_ID == num)
+        {
+            String reply;
+
+            (void)reply.concat(reinterpret_cast<const char*>(payload), length);
+            gReplies.push_back(reply);
+        }
+    });
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testRelease);
+    RUN_TEST(testGroups);
+    RUN_TEST(testNames);
+    RUN_TEST(testInvalidCommands);
+    RUN_TEST(testRunCommands);
+
+    failures = UNITY_END();
+
+    WebSocketsServer::observeText(nullptr);
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Send a command as text frame to the command dispatch and keep the replies.
+ *
+ * @param[in] cmd   Command
+ */
+static void sendCommand(const char* cmd)
+{
+    std::vector<uint8_t>    payload(cmd, cmd + strlen(cmd) + 1U);
+
+    gReplies.clear();
+
+    /* The dispatch gets a writable frame, like from the websocket server. */
+    TEST_ASSERT_TRUE(WebSocketsServer::injectEvent(CLIENT_ID, WStype_TEXT, &payload[0], payload.size() - 1U));
+}
+
+/**
+ * Get a reply to the last command.
+ *
+ * @param[in] idx   Index of the reply.
+ *
+ * @return Reply
+ */
+static const char* getReply(size_t idx)
+{
+    TEST_ASSERT_TRUE_MESSAGE(idx < gReplies.size(), "Reply is missing.");
+
+    return gReplies[idx].c_str();
+}
+
+/**
+ * Release a group and let it drive a lap, handled by the web server.
+ *
+ * @param[in] group         Group
+ * @param[in] lapTime       Lap time in ms.
+ */
+static void runLap(uint8_t group, uint32_t lapTime)
+{
+    char cmd[16U];
+
+    (void)snprintf(cmd, sizeof(cmd), "RELEASE;%u", static_cast<unsigned int>(group));
+    sendCommand(cmd);
+    TEST_ASSERT_EQUAL_STRING("ACK", getReply(0U));
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)gWebServer->handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    NativeHAL::advanceTime(static_cast<uint64_t>(lapTime) * 1000U);
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)gWebServer->handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)gWebServer->handleWebServer();
+
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, gCompetition->getState());
+    TEST_ASSERT_EQUAL_UINT32(lapTime, gCompetition->getRunLapTime());
+}
@@ -0,0 +1,460 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the CRC protected data in the emulated RTC memory
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Board.h>
+#include <Settings.h>
+#include <Competition.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void fillRtcMemory(uint8_t value);
+static void flipRtcBit(size_t offset, uint8_t bit);
+static void triggerSensor(Competition& competition);
+static void runLap(Competition& competition, uint8_t group, uint32_t lapTime);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*      EEPROM_FILE     = "test_rtc_eeprom.bin";
+
+/**
+ * Offset in byte of the data in the RTC memory, see Board. The memory
+ * before belongs to the boot loader.
+ */
+static const size_t     RTC_DATA_BEGIN  = 128U;
+
+/** Size in byte of the header before the data: CRC and size. */
+static const size_t     RTC_HEADER_SIZE = 8U;
+
+/** Size in byte of the test data. */
+static const size_t     DATA_SIZE       = 42U;
+
+/** Lap time in ms, which is longer than the blind period. */
+static const uint32_t   LAP_TIME        = 12000U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings and a power-on RTC memory.
+ */
+void setUp()
+{
+    fillRtcMemory(0U);
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * Stored data is read back unchanged, the boot loader area stays untouched.
+ */
+static void testRoundTrip()
+{
+    uint8_t     data[DATA_SIZE];
+    uint8_t     readData[DATA_SIZE];
+    uint32_t    bootLoader[RTC_DATA_BEGIN / sizeof(uint32_t)];
+    size_t      idx                 = 0U;
+
+    fillRtcMemory(0x5AU);
+
+    for (idx = 0U; idx < DATA_SIZE; ++idx)
+    {
+        data[idx] = static_cast<uint8_t>(idx * 7U);
+    }
+
+    TEST_ASSERT_TRUE(Board::writeRtcData(data, sizeof(data)));
+    TEST_ASSERT_TRUE(Board::readRtcData(readData, sizeof(readData)));
+    TEST_ASSERT_EQUAL_MEMORY(data, readData, sizeof(data));
+
+    TEST_ASSERT_TRUE(NativeHAL::readRtcMemory(0U, bootLoader, sizeof(bootLoader)));
+
+    for (idx = 0U; idx < (sizeof(bootLoader) / sizeof(bootLoader[0])); ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0x5A5A5A5AU, bootLoader[idx]);
+    }
+}
+
+/**
+ * After a power-on the memory content is random, it is never taken as data.
+ */
+static void testPowerOn()
+{
+    uint8_t readData[DATA_SIZE];
+    uint8_t value       = 0U;
+
+    fillRtcMemory(0U);
+    TEST_ASSERT_FALSE(Board::readRtcData(readData, sizeof(readData)));
+
+    for (value = 1U; value != 0U; value = static_cast<uint8_t>(value << 1U))
+    {
+        fillRtcMemory(value);
+        TEST_ASSERT_FALSE(Board::readRtcData(readData, sizeof(readData)));
+    }
+
+    fillRtcMemory(0xFFU);
+    TEST_ASSERT_FALSE(Board::readRtcData(readData, sizeof(readData)));
+}
+
+/**
+ * Every single bit error in the header or the data is detected. The data
+ * is valid again, once the bit is restored.
+ */
+static void testCorruption()
+{
+    uint8_t data[DATA_SIZE];
+    uint8_t readData[DATA_SIZE];
+    size_t  offset      = 0U;
+    uint8_t bit         = 0U;
+
+    (void)memset(data, 0xC3, sizeof(data));
+    TEST_ASSERT_TRUE(Board::writeRtcData(data, sizeof(data)));
+
+    for (offset = 0U; offset < (RTC_HEADER_SIZE + DATA_SIZE); ++offset)
+    {
+        for (bit = 0U; bit < 8U; ++bit)
+        {
+            flipRtcBit(RTC_DATA_BEGIN + offset, bit);
+            TEST_ASSERT_FALSE(Board::readRtcData(readData, sizeof(readData)));
+
+            flipRtcBit(RTC_DATA_BEGIN + offset, bit);
+            TEST_ASSERT_TRUE(Board::readRtcData(readData, sizeof(readData)));
+        }
+    }
+}
+
+/**
+ * Data is only read with the size it was stored with, sizes beyond the
+ * limit are refused.
+ */
+static void testSize()
+{
+    uint8_t data[Board::RTC_DATA_MAX_SIZE + 1U];
+
+    (void)memset(data, 0x11, sizeof(data));
+
+    TEST_ASSERT_TRUE(Board::writeRtcData(data, DATA_SIZE));
+    TEST_ASSERT_FALSE(Board::readRtcData(data, DATA_SIZE + 4U));
+    TEST_ASSERT_FALSE(Board::readRtcData(data, DATA_SIZE - 1U));
+    TEST_ASSERT_TRUE(Board::readRtcData(data, DATA_SIZE));
+
+    TEST_ASSERT_TRUE(Board::writeRtcData(data, Board::RTC_DATA_MAX_SIZE));
+    TEST_ASSERT_TRUE(Board::readRtcData(data, Board::RTC_DATA_MAX_SIZE));
+
+    TEST_ASSERT_FALSE(Board::writeRtcData(data, sizeof(data)));
+    TEST_ASSERT_FALSE(Board::readRtcData(data, sizeof(data)));
+    TEST_ASSERT_FALSE(Board::writeRtcData(nullptr, DATA_SIZE));
+    TEST_ASSERT_FALSE(Board::readRtcData(nullptr, DATA_SIZE));
+}
+
+/**
+ * After a restart the competition continues with the lap times and the
+ * state of its snapshot.
+ */
+static void testCompetitionRestore()
+{
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        runLap(competition, 0U, LAP_TIME);
+        runLap(competition, 2U, LAP_TIME - 1000U);
+    }
+
+    /* Restart */
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, competition.getState());
+        TEST_ASSERT_EQUAL_UINT8(2U, competition.getActiveGroup());
+        TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 1000U, competition.getRunLapTime());
+        TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+        TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(1U));
+        TEST_ASSERT_EQUAL_UINT32(LAP_TIME - 1000U, competition.getLaptime(2U));
+        TEST_ASSERT_EQUAL_UINT8(2U, competition.getRank(0U));
+        TEST_ASSERT_EQUAL_UINT8(1U, competition.getRank(2U));
+    }
+}
+
+/**
+ * A corrupted snapshot is discarded, the competition starts without lap
+ * times instead of with wrong ones.
+ */
+static void testCompetitionCorruptedSnapshot()
+{
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        runLap(competition, 1U, LAP_TIME);
+    }
+
+    flipRtcBit(RTC_DATA_BEGIN + RTC_HEADER_SIZE + 9U, 3U);
+
+    /* Restart */
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+        TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(1U));
+        TEST_ASSERT_EQUAL_UINT8(0U, competition.getRank(1U));
+    }
+}
+
+/**
+ * The lap time statistics must survive the restart, otherwise the
+ * plausibility check of a group starts from zero again.
+ */
+static void testCompetitionStatistics()
+{
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        runLap(competition, 0U, 20000U);
+        runLap(competition, 0U, 20400U);
+        runLap(competition, 0U, 19600U);
+        runLap(competition, 1U, 16000U);
+    }
+
+    /* Restart */
+    {
+        Competition     competition;
+        LapStatistics   statistics;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        TEST_ASSERT_TRUE(competition.getLapStatistics(0U, statistics));
+        TEST_ASSERT_EQUAL_UINT32(3U, statistics.getCount());
+        TEST_ASSERT_EQUAL_UINT32(20000U, statistics.getMean());
+        TEST_ASSERT_UINT32_WITHIN(1U, 400U, statistics.getStdDev());
+        TEST_ASSERT_TRUE(competition.getLapStatistics(1U, statistics));
+        TEST_ASSERT_EQUAL_UINT32(1U, statistics.getCount());
+        TEST_ASSERT_EQUAL_UINT32(16000U, statistics.getMean());
+
+        /* Plausible according to the track record, but not for group 0. */
+        runLap(competition, 0U, 14000U);
+        TEST_ASSERT_TRUE(competition.isRunSuspicious());
+    }
+}
+
+/**
+ * A run, which was interrupted by the restart, must be released again,
+ * because its start time is lost.
+ */
+static void testCompetitionInterruptedRun()
+{
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        runLap(competition, 0U, LAP_TIME);
+
+        TEST_ASSERT_TRUE(competition.setReleasedState(1U));
+        triggerSensor(competition);
+        TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_STARTED, competition.getState());
+    }
+
+    /* Restart */
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+        TEST_ASSERT_EQUAL_UINT32(LAP_TIME, competition.getLaptime(0U));
+    }
+}
+
+/**
+ * A snapshot of another number of groups is discarded.
+ */
+static void testCompetitionOtherGroups()
+{
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        runLap(competition, 0U, LAP_TIME);
+    }
+
+    Settings::getInstance().setNumberOfGroups(2U);
+
+    /* Restart */
+    {
+        Competition competition;
+
+        TEST_ASSERT_TRUE(competition.begin());
+        TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_UNRELEASED, competition.getState());
+        TEST_ASSERT_EQUAL_UINT32(0U, competition.getLaptime(0U));
+    }
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argEeprom[] = "--eeprom";
+    static char     eeprom[]    = "test_rtc_eeprom.bin";
+    char*           args[]      = { argv[0], argEeprom, eeprom, nullptr };
+    int             failures    = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(3, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_ERROR);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testRoundTrip);
+    RUN_TEST(testPowerOn);
+    RUN_TEST(testCorruption);
+    RUN_TEST(testSize);
+    RUN_TEST(testCompetitionRestore);
+    RUN_TEST(testCompetitionStatistics);
+    RUN_TEST(testCompetitionCorruptedSnapshot);
+    RUN_TEST(testCompetitionInterruptedRun);
+    RUN_TEST(testCompetitionOtherGroups);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Fill the whole RTC memory with a value, like the random content after a
+ * power-on.
+ *
+ * @param[in] value Value of every byte.
+ */
+static void fillRtcMemory(uint8_t value)
+{
+    uint32_t memory[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)];
+
+    (void)memset(memory, value, sizeof(memory));
+    TEST_ASSERT_TRUE(NativeHAL::writeRtcMemory(0U, memory, sizeof(memory)));
+}
+
+/**
+ * Flip a single bit in the RTC memory.
+ *
+ * @param[in] offset    Offset in byte.
+ * @param[in] bit       Bit in the byte, 0 - 7.
+ */
+static void flipRtcBit(size_t offset, uint8_t bit)
+{
+    uint32_t    memory[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)];
+    uint8_t*    bytes   = reinterpret_cast<uint8_t*>(memory);
+
+    TEST_ASSERT_TRUE(NativeHAL::readRtcMemory(0U, memory, sizeof(memory)));
+    bytes[offset] ^= static_cast<uint8_t>(1U << bit);
+    TEST_ASSERT_TRUE(NativeHAL::writeRtcMemory(0U, memory, sizeof(memory)));
+}
+
+/**
+ * Pass the sensor: it is interrupted for a poll of the competition. The
+ * poll after it stores the snapshot.
+ *
+ * @param[in] competition   Competition
+ */
+static void triggerSensor(Competition& competition)
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)competition.handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)competition.handleCompetition();
+}
+
+/**
+ * Release a group and let it drive a lap.
+ *
+ * @param[in] competition   Competition
+ * @param[in] group         Group
+ * @param[in] lapTime       Lap time in ms.
+ */
+static void runLap(Competition& competition, uint8_t group, uint32_t lapTime)
+{
+    TEST_ASSERT_TRUE(competition.setReleasedState(group));
+
+    triggerSensor(competition);
+    NativeHAL::advanceTime(static_cast<uint64_t>(lapTime) * 1000U);
+    triggerSensor(competition);
+
+    TEST_ASSERT_EQUAL(Competition::COMPETITION_STATE_FINISHED, competition.getState());
+}
@@ -0,0 +1,442 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the task scheduler with a virtual clock
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <Scheduler.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Behaviour of a task under test. */
+typedef struct
+{
+    uint32_t    runtime;    /**< Runtime of a run in us, which the virtual clock advances. */
+    bool        result;     /**< Result of a run. */
+
+} TaskBehaviour;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static unsigned long getVirtualTime();
+static bool runTask(uint8_t id);
+static bool sensorTask();
+static bool taskA();
+static bool taskB();
+static bool taskC();
+static bool taskD();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Id of the sensor task in the run log. */
+static const uint8_t    SENSOR          = 0U;
+
+/** Id of the task A in the run log. The others follow. */
+static const uint8_t    TASK_A          = 1U;
+
+/** Number of task ids, including the sensor task. */
+static const uint8_t    TASK_IDS        = 5U;
+
+/** Max. number of runs in the run log. */
+static const size_t     MAX_LOG_LENGTH  = 64U;
+
+/** Virtual clock in us. */
+static uint32_t         gClock          = 0U;
+
+/** Behaviour of the tasks, indexed by id. */
+static TaskBehaviour    gBehaviours[TASK_IDS];
+
+/** Ids of the tasks in the order they ran. */
+static uint8_t          gLog[MAX_LOG_LENGTH];
+
+/** Number of runs in the run log. */
+static size_t           gLogLength      = 0U;
+
+/** Timestamps in us of the sensor runs. */
+static uint32_t         gSensorRuns[MAX_LOG_LENGTH];
+
+/** Number of sensor runs. */
+static size_t           gSensorRunCount = 0U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: the clock starts at 1 s and every task runs 10 us
+ * successfully.
+ */
+void setUp()
+{
+    uint8_t id = 0U;
+
+    gClock          = 1000000U;
+    gLogLength      = 0U;
+    gSensorRunCount = 0U;
+
+    for (id = 0U; id < TASK_IDS; ++id)
+    {
+        gBehaviours[id].runtime = 10U;
+        gBehaviours[id].result  = true;
+    }
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+}
+
+/**
+ * The tasks run in the order of their priority, the ones with the same
+ * priority in the order they were added. The sensor task runs before every
+ * task and once at the end of the cycle.
+ */
+static void testPriorityOrder()
+{
+    const uint8_t   EXPECTED[] = { SENSOR, 2U, SENSOR, 4U, SENSOR, 3U, SENSOR, 1U, SENSOR };
+    Scheduler       scheduler(getVirtualTime);
+
+    TEST_ASSERT_TRUE(scheduler.setSensorTask("sensor", sensorTask, 100U));
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, 0U, 100U, 2U));
+    TEST_ASSERT_TRUE(scheduler.addTask("b", taskB, 0U, 100U, 0U));
+    TEST_ASSERT_TRUE(scheduler.addTask("c", taskC, 0U, 100U, 1U));
+    TEST_ASSERT_TRUE(scheduler.addTask("d", taskD, 0U, 100U, 0U));
+
+    TEST_ASSERT_EQUAL_STRING("b", scheduler.getTask(0U)->name);
+    TEST_ASSERT_EQUAL_STRING("d", scheduler.getTask(1U)->name);
+    TEST_ASSERT_EQUAL_STRING("c", scheduler.getTask(2U)->name);
+    TEST_ASSERT_EQUAL_STRING("a", scheduler.getTask(3U)->name);
+    TEST_ASSERT_NULL(scheduler.getTask(4U));
+
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED), gLogLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED, gLog, sizeof(EXPECTED));
+}
+
+/**
+ * A periodic task is due at once and then after every period, a task
+ * without period runs every cycle.
+ */
+static void testPeriod()
+{
+    const uint32_t  PERIOD  = 1000U;
+    Scheduler       scheduler(getVirtualTime);
+
+    /* Without runtime, the clock only moves with the test. */
+    gBehaviours[TASK_A].runtime         = 0U;
+    gBehaviours[TASK_A + 1U].runtime    = 0U;
+
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, PERIOD, 100U, 0U));
+    TEST_ASSERT_TRUE(scheduler.addTask("b", taskB, 0U, 100U, 1U));
+
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(1U, scheduler.getTask(0U)->runCount);
+    TEST_ASSERT_EQUAL_UINT32(1U, scheduler.getTask(1U)->runCount);
+
+    gClock += PERIOD - 1U;
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(1U, scheduler.getTask(0U)->runCount);
+    TEST_ASSERT_EQUAL_UINT32(2U, scheduler.getTask(1U)->runCount);
+
+    gClock += 1U;
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(2U, scheduler.getTask(0U)->runCount);
+    TEST_ASSERT_EQUAL_UINT32(3U, scheduler.getTask(1U)->runCount);
+}
+
+/**
+ * The period survives the wrap around of the clock.
+ */
+static void testClockWrapAround()
+{
+    const uint32_t  PERIOD  = 1000U;
+    Scheduler       scheduler(getVirtualTime);
+
+    gClock = UINT32_MAX - 500U;
+    gBehaviours[TASK_A].runtime = 0U;
+
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, PERIOD, 100U, 0U));
+    TEST_ASSERT_TRUE(scheduler.process());
+
+    gClock += PERIOD - 1U;
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(1U, scheduler.getTask(0U)->runCount);
+
+    gClock += 1U;
+    TEST_ASSERT_TRUE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(2U, scheduler.getTask(0U)->runCount);
+}
+
+/**
+ * Runs longer than the budget are counted as overrun, the runtime
+ * statistics follow every run.
+ */
+static void testBudget()
+{
+    const uint32_t          BUDGET      = 100U;
+    const uint32_t          RUNTIMES[]  = { 50U, 100U, 101U, 300U };
+    uint8_t                 idx         = 0U;
+    const Scheduler::Task*  task        = nullptr;
+    Scheduler               scheduler(getVirtualTime);
+
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, 0U, BUDGET, 0U));
+    task = scheduler.getTask(0U);
+
+    for (idx = 0U; idx < (sizeof(RUNTIMES) / sizeof(RUNTIMES[0])); ++idx)
+    {
+        gBehaviours[TASK_A].runtime = RUNTIMES[idx];
+        TEST_ASSERT_TRUE(scheduler.process());
+        TEST_ASSERT_EQUAL_UINT32(RUNTIMES[idx], task->lastRuntime);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(4U, task->runCount);
+    TEST_ASSERT_EQUAL_UINT32(2U, task->overrunCount);
+    TEST_ASSERT_EQUAL_UINT32(300U, task->maxRuntime);
+    TEST_ASSERT_EQUAL_UINT64(551U, task->totalRuntime);
+    TEST_ASSERT_EQUAL_UINT32(4U, task->runtimes.getCount());
+    TEST_ASSERT_EQUAL_UINT64(551U, task->runtimes.getSum());
+}
+
+/**
+ * The sensor is polled between the tasks, therefore a slow task delays it
+ * only by its own runtime, not by the runtime of the whole cycle.
+ */
+static void testSensorLatency()
+{
+    const uint32_t  SLOW_RUNTIME    = 5000U;
+    const uint32_t  SENSOR_BUDGET   = 500U;
+    uint8_t         cycle           = 0U;
+    size_t          idx             = 0U;
+    uint32_t        maxGap          = 0U;
+    Scheduler       scheduler(getVirtualTime);
+
+    gBehaviours[TASK_A].runtime         = SLOW_RUNTIME;
+    gBehaviours[TASK_A + 1U].runtime    = SLOW_RUNTIME;
+    gBehaviours[TASK_A + 2U].runtime    = SLOW_RUNTIME;
+
+    TEST_ASSERT_TRUE(scheduler.setSensorTask("sensor", sensorTask, SENSOR_BUDGET));
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, 0U, SLOW_RUNTIME, 0U));
+    TEST_ASSERT_TRUE(scheduler.addTask("b", taskB, 0U, SLOW_RUNTIME, 1U));
+    TEST_ASSERT_TRUE(scheduler.addTask("c", taskC, 0U, SLOW_RUNTIME, 2U));
+
+    for (cycle = 0U; cycle < 4U; ++cycle)
+    {
+        TEST_ASSERT_TRUE(scheduler.process());
+    }
+
+    for (idx = 1U; idx < gSensorRunCount; ++idx)
+    {
+        uint32_t gap = gSensorRuns[idx] - gSensorRuns[idx - 1U];
+
+        if (maxGap < gap)
+        {
+            maxGap = gap;
+        }
+    }
+
+    /* 4 cycles with 3 tasks and 4 sensor runs each. */
+    TEST_ASSERT_EQUAL_UINT32(16U, gSensorRunCount);
+    TEST_ASSERT_EQUAL_UINT32(SLOW_RUNTIME + gBehaviours[SENSOR].runtime, maxGap);
+    TEST_ASSERT_EQUAL_UINT32(0U, scheduler.getSensorTask().overrunCount);
+
+    /* The loop period is the runtime of the whole cycle. */
+    TEST_ASSERT_EQUAL_UINT32(3U, scheduler.getLoopPeriods().getCount());
+    TEST_ASSERT_EQUAL_UINT32((3U * SLOW_RUNTIME) + (4U * gBehaviours[SENSOR].runtime), scheduler.getLoopPeriods().getMax());
+}
+
+/**
+ * A failed task fails the cycle, but the other tasks still run.
+ */
+static void testFailedTask()
+{
+    Scheduler scheduler(getVirtualTime);
+
+    gBehaviours[TASK_A].result = false;
+
+    TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, 0U, 100U, 0U));
+    TEST_ASSERT_TRUE(scheduler.addTask("b", taskB, 0U, 100U, 1U));
+
+    TEST_ASSERT_FALSE(scheduler.process());
+    TEST_ASSERT_EQUAL_UINT32(1U, scheduler.getTask(1U)->runCount);
+
+    gBehaviours[TASK_A].result = true;
+    TEST_ASSERT_TRUE(scheduler.process());
+}
+
+/**
+ * Tasks without function and more than the max. number of tasks are refused.
+ */
+static void testLimits()
+{
+    uint8_t     idx = 0U;
+    Scheduler   scheduler(getVirtualTime);
+
+    TEST_ASSERT_FALSE(scheduler.setSensorTask("sensor", nullptr, 100U));
+    TEST_ASSERT_FALSE(scheduler.addTask("a", nullptr, 0U, 100U, 0U));
+
+    for (idx = 0U; idx < Scheduler::MAX_TASKS; ++idx)
+    {
+        TEST_ASSERT_TRUE(scheduler.addTask("a", taskA, 0U, 100U, idx));
+    }
+
+    TEST_ASSERT_FALSE(scheduler.addTask("b", taskB, 0U, 100U, 0U));
+    TEST_ASSERT_EQUAL_UINT8(Scheduler::MAX_TASKS, scheduler.getTaskCount());
+}
+
+/**
+ * Run the tests.
+ *
+ * @return Number of failed tests.
+ */
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testPriorityOrder);
+    RUN_TEST(testPeriod);
+    RUN_TEST(testClockWrapAround);
+    RUN_TEST(testBudget);
+    RUN_TEST(testSensorLatency);
+    RUN_TEST(testFailedTask);
+    RUN_TEST(testLimits);
+
+    return UNITY_END();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Time source of the scheduler under test.
+ *
+ * @return Virtual time in us.
+ */
+static unsigned long getVirtualTime()
+{
+    return gClock;
+}
+
+/**
+ * Run a task: it is logged, takes its runtime on the virtual clock and
+ * returns its result.
+ *
+ * @param[in] id    Task id
+ *
+ * @return Result of the task.
+ */
+static bool runTask(uint8_t id)
+{
+    if (MAX_LOG_LENGTH > gLogLength)
+    {
+        gLog[gLogLength] = id;
+        ++gLogLength;
+    }
+
+    gClock += gBehaviours[id].runtime;
+
+    return gBehaviours[id].result;
+}
+
+/**
+ * Sensor task, which records the time of every run.
+ *
+ * @return Result of the task.
+ */
+static bool sensorTask()
+{
+    if (MAX_LOG_LENGTH > gSensorRunCount)
+    {
+        gSensorRuns[gSensorRunCount] = gClock;
+        ++gSensorRunCount;
+    }
+
+    return runTask(SENSOR);
+}
+
+/**
+ * Task A.
+ *
+ * @return Result of the task.
+ */
+static bool taskA()
+{
+    return runTask(TASK_A);
+}
+
+/**
+ * Task B.
+ *
+ * @return Result of the task.
+ */
+static bool taskB()
+{
+    return runTask(TASK_A + 1U);
+}
+
+/**
+ * Task C.
+ *
+ * @return Result of the task.
+ */
+static bool taskC()
+{
+    return runTask(TASK_A + 2U);
+}
+
+/**
+ * Task D.
+ *
+ * @return Result of the task.
+ */
+static bool taskD()
+{
+    return runTask(TASK_A + 3U);
+}
@@ -0,0 +1,423 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the settings and their round trip through the EEPROM file
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <EEPROM.h>
+#include <FlashMem.h>
+#include <Settings.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void reboot();
+static void getFastConnect(Settings::WiFiFastConnect& fastConnect);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*  EEPROM_FILE = "test_settings_eeprom.bin";
+
+/** Size of the settings of former firmware versions in the EEPROM, which had only 10 group names. */
+static const int    FORMER_SETTINGS_SIZE = 328;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: the EEPROM is erased, like a new device.
+ */
+void setUp()
+{
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+    Settings::getInstance().setDeferredWrite(false);
+}
+
+/**
+ * An erased EEPROM is initialized with the factory settings in a single
+ * flash write, although every setting commits itself.
+ */
+static void testFactorySettings()
+{
+    Settings&                   settings        = Settings::getInstance();
+    uint32_t                    writeCount      = EEPROM.getWriteCount();
+    uint8_t                     numberOfGroups  = 0U;
+    String                      ssid            = "x";
+    Settings::GroupName         name            = "x";
+    Settings::WiFiFastConnect   fastConnect;
+    Settings::BlindPeriod       blindPeriod;
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(settings.begin());
+    TEST_ASSERT_EQUAL_UINT32(writeCount + 1U, EEPROM.getWriteCount());
+
+    settings.getNumberOfGroups(numberOfGroups);
+    TEST_ASSERT_EQUAL_UINT8(3U, numberOfGroups);
+
+    settings.getWiFiSSD(ssid);
+    TEST_ASSERT_EQUAL_STRING("", ssid.c_str());
+
+    settings.getGroupName(0U, name);
+    TEST_ASSERT_EQUAL_STRING("", name.c_str());
+
+    TEST_ASSERT_FALSE(settings.getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_FALSE(settings.getBlindPeriod(blindPeriod));
+
+    /* Valid settings are not written again. */
+    reboot();
+    TEST_ASSERT_EQUAL_UINT32(writeCount + 1U, EEPROM.getWriteCount());
+}
+
+/**
+ * All settings survive a restart, which reads them back from the file.
+ */
+static void testRoundTrip()
+{
+    Settings&                   settings        = Settings::getInstance();
+    uint8_t                     numberOfGroups  = 0U;
+    String                      text;
+    Settings::GroupName         name;
+    Settings::WiFiFastConnect   fastConnect;
+    Settings::WiFiFastConnect   readFastConnect;
+    Settings::BlindPeriod       blindPeriod;
+    FILE*                       file            = nullptr;
+    uint8_t                     content[FlashMem::EEPROM_SIZE + 1U];
+    size_t                      size            = 0U;
+
+    settings.setWiFiSSID("Makerspace");
+    settings.setWiFiPassphrase("secret passphrase");
+    settings.setNumberOfGroups(7U);
+    settings.setGroupName(0U, "Rocket");
+    settings.setGroupName(6U, "Line Follower");
+    getFastConnect(fastConnect);
+    settings.setWiFiFastConnect(fastConnect);
+    blindPeriod.period  = 800U;
+    blindPeriod.ratio   = 25U;
+    settings.setBlindPeriod(blindPeriod);
+
+    reboot();
+
+    settings.getWiFiSSD(text);
+    TEST_ASSERT_EQUAL_STRING("Makerspace", text.c_str());
+    settings.getWiFiPassphrase(text);
+    TEST_ASSERT_EQUAL_STRING("secret passphrase", text.c_str());
+    settings.getNumberOfGroups(numberOfGroups);
+    TEST_ASSERT_EQUAL_UINT8(7U, numberOfGroups);
+    settings.getGroupName(0U, name);
+    TEST_ASSERT_EQUAL_STRING("Rocket", name.c_str());
+    settings.getGroupName(1U, name);
+    TEST_ASSERT_EQUAL_STRING("", name.c_str());
+    settings.getGroupName(6U, name);
+    TEST_ASSERT_EQUAL_STRING("Line Follower", name.c_str());
+
+    TEST_ASSERT_TRUE(settings.getWiFiFastConnect(readFastConnect));
+    TEST_ASSERT_EQUAL_MEMORY(fastConnect.bssid, readFastConnect.bssid, Settings::BSSID_LENGTH);
+    TEST_ASSERT_EQUAL_UINT8(fastConnect.channel, readFastConnect.channel);
+    TEST_ASSERT_EQUAL_UINT32(fastConnect.localIP, readFastConnect.localIP);
+    TEST_ASSERT_EQUAL_UINT32(fastConnect.gatewayIP, readFastConnect.gatewayIP);
+    TEST_ASSERT_EQUAL_UINT32(fastConnect.subnetMask, readFastConnect.subnetMask);
+    TEST_ASSERT_EQUAL_UINT32(fastConnect.dnsIP, readFastConnect.dnsIP);
+
+    TEST_ASSERT_TRUE(settings.getBlindPeriod(blindPeriod));
+    TEST_ASSERT_EQUAL_UINT32(800U, blindPeriod.period);
+    TEST_ASSERT_EQUAL_UINT8(25U, blindPeriod.ratio);
+
+    /* The file has the size of the EEPROM and starts with the valid marker. */
+    file = fopen(EEPROM_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(file);
+    size = fread(content, 1U, sizeof(content), file);
+    (void)fclose(file);
+    TEST_ASSERT_EQUAL_UINT32(FlashMem::EEPROM_SIZE, size);
+    TEST_ASSERT_EQUAL_MEMORY("UZ", content, 2U);
+}
+
+/**
+ * A new SSID or passphrase invalidates the WiFi fast connect parameters.
+ */
+static void testCredentialsClearFastConnect()
+{
+    Settings&                   settings    = Settings::getInstance();
+    Settings::WiFiFastConnect   fastConnect;
+
+    getFastConnect(fastConnect);
+    settings.setWiFiFastConnect(fastConnect);
+    TEST_ASSERT_TRUE(settings.getWiFiFastConnect(fastConnect));
+
+    settings.setWiFiSSID("Other");
+    reboot();
+    TEST_ASSERT_FALSE(settings.getWiFiFastConnect(fastConnect));
+}
+
+/**
+ * A transaction around settings, which use their own transaction, writes
+ * the flash only once at its end.
+ */
+static void testNestedTransaction()
+{
+    Settings&   settings    = Settings::getInstance();
+    uint32_t    writeCount  = EEPROM.getWriteCount();
+    String      text;
+
+    settings.beginTransaction();
+    settings.setWiFiSSID("Nested");
+    settings.setWiFiPassphrase("inner transactions");
+    settings.setNumberOfGroups(5U);
+    settings.setGroupName(2U, "Inner");
+    TEST_ASSERT_EQUAL_UINT32(writeCount, EEPROM.getWriteCount());
+    TEST_ASSERT_TRUE(settings.isWritePending());
+
+    TEST_ASSERT_TRUE(settings.commitTransaction());
+    TEST_ASSERT_EQUAL_UINT32(writeCount + 1U, EEPROM.getWriteCount());
+    TEST_ASSERT_FALSE(settings.isWritePending());
+
+    reboot();
+    settings.getWiFiPassphrase(text);
+    TEST_ASSERT_EQUAL_STRING("inner transactions", text.c_str());
+}
+
+/**
+ * Deferred writes stay in RAM, until they are flushed.
+ */
+static void testDeferredWrite()
+{
+    Settings&   settings        = Settings::getInstance();
+    uint32_t    writeCount      = EEPROM.getWriteCount();
+    uint8_t     numberOfGroups  = 0U;
+
+    settings.setDeferredWrite(true);
+    settings.setNumberOfGroups(4U);
+    settings.setGroupName(3U, "Deferred");
+    TEST_ASSERT_EQUAL_UINT32(writeCount, EEPROM.getWriteCount());
+    TEST_ASSERT_TRUE(settings.isWritePending());
+
+    TEST_ASSERT_TRUE(settings.flush());
+    TEST_ASSERT_EQUAL_UINT32(writeCount + 1U, EEPROM.getWriteCount());
+    settings.setDeferredWrite(false);
+
+    reboot();
+    settings.getNumberOfGroups(numberOfGroups);
+    TEST_ASSERT_EQUAL_UINT8(4U, numberOfGroups);
+}
+
+/**
+ * A group name is cut to its max. length and a group beyond the layout
+ * never overwrites the settings behind the group names.
+ */
+static void testGroupNameBounds()
+{
+    Settings&                   settings    = Settings::getInstance();
+    Settings::GroupName         name;
+    Settings::WiFiFastConnect   fastConnect;
+    Settings::BlindPeriod       blindPeriod;
+    uint8_t                     idx         = 0U;
+
+    getFastConnect(fastConnect);
+    settings.setWiFiFastConnect(fastConnect);
+    blindPeriod.period  = 600U;
+    blindPeriod.ratio   = 0U;
+    settings.setBlindPeriod(blindPeriod);
+
+    settings.setGroupName(0U, "A very long group name, which is cut");
+    settings.getGroupName(0U, name);
+    TEST_ASSERT_EQUAL_UINT32(Settings::MAX_GROUP_NAME_LENGTH, name.length());
+
+    for (idx = Settings::MAX_GROUPS; idx < (Settings::MAX_GROUPS + 4U); ++idx)
+    {
+        settings.setGroupName(idx, "Out of bounds group");
+        settings.getGroupName(idx, name);
+        TEST_ASSERT_EQUAL_STRING("", name.c_str());
+    }
+
+    settings.setGroupName(UINT8_MAX, "Out of bounds group");
+
+    reboot();
+    TEST_ASSERT_TRUE(settings.getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_TRUE(settings.getBlindPeriod(blindPeriod));
+    TEST_ASSERT_EQUAL_UINT32(600U, blindPeriod.period);
+    TEST_ASSERT_EQUAL_UINT8(0U, blindPeriod.ratio);
+}
+
+/**
+ * Settings of a former firmware version keep their layout. The group names,
+ * which are stored behind them, were not there yet and start empty. The
+ * names of all groups of the largest event configuration are kept, in every
+ * event configuration.
+ */
+static void testFormerSettings()
+{
+    Settings&                   settings    = Settings::getInstance();
+    Settings::GroupName         name;
+    Settings::WiFiFastConnect   fastConnect;
+    Settings::BlindPeriod       blindPeriod;
+    uint8_t                     idx         = 0U;
+    int                         address     = 0;
+
+    getFastConnect(fastConnect);
+    settings.setWiFiFastConnect(fastConnect);
+    blindPeriod.period  = 600U;
+    blindPeriod.ratio   = 0U;
+    settings.setBlindPeriod(blindPeriod);
+    settings.setGroupName(0U, "Rocket");
+    settings.setGroupName(9U, "Line Follower");
+
+    /* Anything behind the former settings. */
+    for (address = FORMER_SETTINGS_SIZE; address < static_cast<int>(EEPROM.length()); ++address)
+    {
+        EEPROM.write(address, 0xFFU);
+    }
+
+    TEST_ASSERT_TRUE(EEPROM.commit());
+
+    reboot();
+    TEST_ASSERT_TRUE(settings.getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_TRUE(settings.getBlindPeriod(blindPeriod));
+    TEST_ASSERT_EQUAL_UINT32(600U, blindPeriod.period);
+    settings.getGroupName(0U, name);
+    TEST_ASSERT_EQUAL_STRING("Rocket", name.c_str());
+    settings.getGroupName(9U, name);
+    TEST_ASSERT_EQUAL_STRING("Line Follower", name.c_str());
+
+    for (idx = 10U; idx < Settings::MAX_GROUPS; ++idx)
+    {
+        settings.getGroupName(idx, name);
+        TEST_ASSERT_EQUAL_STRING("", name.c_str());
+    }
+
+    settings.setGroupName(Settings::MAX_GROUPS - 1U, "Large Event");
+
+    reboot();
+    settings.getGroupName(Settings::MAX_GROUPS - 1U, name);
+    TEST_ASSERT_EQUAL_STRING("Large Event", name.c_str());
+    settings.getGroupName(9U, name);
+    TEST_ASSERT_EQUAL_STRING("Line Follower", name.c_str());
+    TEST_ASSERT_TRUE(settings.getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_TRUE(settings.getBlindPeriod(blindPeriod));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argEeprom[] = "--eeprom";
+    static char     eeprom[]    = "test_settings_eeprom.bin";
+    char*           args[]      = { argv[0], argEeprom, eeprom, nullptr };
+    int             failures    = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(3, args);
+    Log::setLevel(Log::LOG_WARNING);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testFactorySettings);
+    RUN_TEST(testRoundTrip);
+    RUN_TEST(testCredentialsClearFastConnect);
+    RUN_TEST(testNestedTransaction);
+    RUN_TEST(testDeferredWrite);
+    RUN_TEST(testGroupNameBounds);
+    RUN_TEST(testFormerSettings);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Release the EEPROM content and read it back from the file, like after a
+ * restart of the device.
+ */
+static void reboot()
+{
+    TEST_ASSERT_TRUE(EEPROM.end());
+    TEST_ASSERT_EQUAL_UINT32(0U, EEPROM.length());
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+}
+
+/**
+ * Get WiFi fast connect parameters, which differ in every byte.
+ *
+ * @param[out] fastConnect  WiFi fast connect parameters
+ */
+static void getFastConnect(Settings::WiFiFastConnect& fastConnect)
+{
+    static const uint8_t BSSID[Settings::BSSID_LENGTH] = { 0x12U, 0x34U, 0x56U, 0x78U, 0x9AU, 0xBCU };
+
+    memcpy(fastConnect.bssid, BSSID, sizeof(BSSID));
+    fastConnect.channel     = 11U;
+    fastConnect.localIP     = 0x0A00A8C0U;
+    fastConnect.gatewayIP   = 0x0100A8C0U;
+    fastConnect.subnetMask  = 0x00FFFFFFU;
+    fastConnect.dnsIP       = 0x08080808U;
+}
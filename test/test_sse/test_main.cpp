@@ -0,0 +1,521 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fleet test of the server-sent events with many spectators
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <Board.h>
+#include <Settings.h>
+#include <LittleFS.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <HeapMonitor.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A spectator, which follows the events with its own TCP connection. */
+typedef struct
+{
+    int         fd;         /**< Socket, -1 if not connected. */
+    std::string received;   /**< Everything received so far. */
+
+} Spectator;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool connectSpectator(Spectator& spectator);
+static void disconnectSpectator(Spectator& spectator);
+static bool receiveUntil(Spectator& spectator, const char* text);
+static size_t countText(const std::string& received, const char* text);
+static void sendCommand(const char* cmd);
+static void triggerSensor();
+static uint64_t getLiveBytes();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*          EEPROM_FILE     = "test_sse_eeprom.bin";
+
+/** Max. number of spectators, which are served. */
+static const size_t         SSE_MAX_CLIENTS = LapTriggerWebServer::SSE_MAX_CLIENTS;
+
+/** Number of spectators, which try to follow the event. */
+static const size_t         SPECTATORS      = SSE_MAX_CLIENTS + 8U;
+
+/** Number of groups of the factory settings. */
+static const size_t         GROUPS          = 3U;
+
+/** Lap time in ms, which is longer than the blind period. */
+static const uint32_t       LAP_TIME        = 12000U;
+
+/** Keep-alive period of the server-sent events in ms. */
+static const uint32_t       KEEP_ALIVE      = 15000U;
+
+/** Max. number of web server loops until a spectator gets the expected text. */
+static const uint32_t       MAX_LOOPS       = 1000U;
+
+/** Bytes, which are reserved for the received text of a spectator. */
+static const size_t         RECEIVE_SIZE    = 4096U;
+
+/** Web server port of the device. */
+static const uint16_t       WEBSERVER_PORT  = 80U;
+
+/** Spectators */
+static Spectator            gSpectators[SPECTATORS];
+
+/** Competition under test. */
+static Competition*         gCompetition    = nullptr;
+
+/** Web server under test, which serves the spectators. */
+static LapTriggerWebServer* gWebServer      = nullptr;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings, a power-on RTC memory and a new
+ * competition with its web server. They are created on the heap, because a
+ * failed test doesn't return and would skip their destructors.
+ */
+void setUp()
+{
+    static const uint32_t   ZEROS[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)] = { 0U };
+    size_t                  idx = 0U;
+
+    (void)NativeHAL::writeRtcMemory(0U, ZEROS, sizeof(ZEROS));
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+
+    for (idx = 0U; idx < SPECTATORS; ++idx)
+    {
+        gSpectators[idx].fd = -1;
+        gSpectators[idx].received.clear();
+    }
+
+    gCompetition    = new Competition();
+    gWebServer      = new LapTriggerWebServer(*gCompetition);
+
+    TEST_ASSERT_TRUE(gCompetition->begin());
+    TEST_ASSERT_TRUE(gWebServer->begin());
+}
+
+/**
+ * Clean up after every test. The spectators leave, the web server stops
+ * listening and leaves the event bus.
+ */
+void tearDown()
+{
+    size_t idx = 0U;
+
+    for (idx = 0U; idx < SPECTATORS; ++idx)
+    {
+        disconnectSpectator(gSpectators[idx]);
+    }
+
+    delete gWebServer;
+    gWebServer = nullptr;
+
+    delete gCompetition;
+    gCompetition = nullptr;
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * More spectators than slots connect: the first ones get the event stream
+ * with the result table, the others are refused with 503 and their
+ * connections are closed.
+ */
+static void testFleet()
+{
+    size_t      idx         = 0U;
+    uint64_t    liveBytes   = 0U;
+
+    for (idx = 0U; idx < SPECTATORS; ++idx)
+    {
+        if (SSE_MAX_CLIENTS == idx)
+        {
+            liveBytes = getLiveBytes();
+        }
+
+        TEST_ASSERT_TRUE(connectSpectator(gSpectators[idx]));
+
+        if (SSE_MAX_CLIENTS > idx)
+        {
+            /* The result table follows the header. */
+            TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;TABLE;2;"));
+            TEST_ASSERT_EQUAL_UINT32(0U, gSpectators[idx].received.find("HTTP/1.1 200 OK\r\n"));
+            TEST_ASSERT_TRUE(std::string::npos == gSpectators[idx].received.find("Transfer-Encoding"));
+            TEST_ASSERT_EQUAL_UINT32(GROUPS, countText(gSpectators[idx].received, "data: EVT;TABLE;"));
+        }
+        else
+        {
+            /* Refused and closed by the server. */
+            TEST_ASSERT_FALSE(receiveUntil(gSpectators[idx], "data: "));
+            TEST_ASSERT_EQUAL_UINT32(0U, gSpectators[idx].received.find("HTTP/1.1 503"));
+            disconnectSpectator(gSpectators[idx]);
+        }
+    }
+
+    /* The refused spectators leave nothing behind. */
+    TEST_ASSERT_EQUAL_UINT64(liveBytes, getLiveBytes());
+}
+
+/**
+ * Every served spectator gets the events of a run.
+ */
+static void testBroadcast()
+{
+    size_t idx = 0U;
+
+    for (idx = 0U; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        TEST_ASSERT_TRUE(connectSpectator(gSpectators[idx]));
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;TABLE;2;"));
+    }
+
+    sendCommand("RELEASE;1");
+    triggerSensor();
+    NativeHAL::advanceTime(static_cast<uint64_t>(LAP_TIME) * 1000U);
+    triggerSensor();
+
+    for (idx = 0U; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;STARTED\n\n"));
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;FINISHED;12000;1\n\n"));
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;TABLE;1;12000;"));
+    }
+}
+
+/**
+ * Spectators, which leave, free their slots for the next ones. The others
+ * keep their connection and get the keep-alive.
+ */
+static void testSlotReuse()
+{
+    const size_t    LEAVING = 4U;
+    size_t          idx     = 0U;
+
+    for (idx = 0U; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        TEST_ASSERT_TRUE(connectSpectator(gSpectators[idx]));
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;TABLE;2;"));
+    }
+
+    for (idx = 0U; idx < LEAVING; ++idx)
+    {
+        disconnectSpectator(gSpectators[idx]);
+    }
+
+    /* The keep-alive detects the dead connections and reaches the others. */
+    NativeHAL::advanceTime(static_cast<uint64_t>(KEEP_ALIVE) * 1000U);
+
+    for (idx = LEAVING; idx < SSE_MAX_CLIENTS; ++idx)
+    {
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], ":\n\n"));
+    }
+
+    /* The new spectators get the free slots, one more is refused. */
+    for (idx = SSE_MAX_CLIENTS; idx < (SSE_MAX_CLIENTS + LEAVING); ++idx)
+    {
+        TEST_ASSERT_TRUE(connectSpectator(gSpectators[idx]));
+        TEST_ASSERT_TRUE(receiveUntil(gSpectators[idx], "data: EVT;TABLE;2;"));
+    }
+
+    TEST_ASSERT_TRUE(connectSpectator(gSpectators[idx]));
+    TEST_ASSERT_FALSE(receiveUntil(gSpectators[idx], "data: "));
+    TEST_ASSERT_EQUAL_UINT32(0U, gSpectators[idx].received.find("HTTP/1.1 503"));
+}
+
+/**
+ * A spectator is refused with 503, if the heap would get too low for its
+ * connection, although a slot is free. It is served again, if the heap
+ * is sufficient.
+ */
+static void testLowHeap()
+{
+    uint8_t* block = nullptr;
+
+    TEST_ASSERT_TRUE(connectSpectator(gSpectators[0U]));
+    TEST_ASSERT_TRUE(receiveUntil(gSpectators[0U], "data: EVT;TABLE;2;"));
+
+    /* Only the warning threshold of the heap monitor is left. */
+    block = new uint8_t[ESP.getFreeHeap() - HEAP_MONITOR_MIN_FREE];
+
+    TEST_ASSERT_TRUE(connectSpectator(gSpectators[1U]));
+    TEST_ASSERT_FALSE(receiveUntil(gSpectators[1U], "data: "));
+    TEST_ASSERT_EQUAL_UINT32(0U, gSpectators[1U].received.find("HTTP/1.1 503"));
+    disconnectSpectator(gSpectators[1U]);
+
+    delete[] block;
+
+    TEST_ASSERT_TRUE(connectSpectator(gSpectators[1U]));
+    TEST_ASSERT_TRUE(receiveUntil(gSpectators[1U], "data: EVT;TABLE;2;"));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argPortOffset[] = "--port-offset";
+    static char     portOffset[]    = "33000";
+    static char     argEeprom[]     = "--eeprom";
+    static char     eeprom[]        = "test_sse_eeprom.bin";
+    char*           args[]          = { argv[0], argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+    int             failures        = 0;
+    size_t          idx             = 0U;
+
+    (void)argc;
+
+    /* Reserved before the HAL begins, therefore it belongs to the host and
+     * not to the heap of the device, which limits the spectators.
+     */
+    for (idx = 0U; idx < SPECTATORS; ++idx)
+    {
+        gSpectators[idx].received.reserve(RECEIVE_SIZE);
+    }
+
+    (void)NativeHAL::begin(5, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_ERROR);
+
+    (void)Board::begin();
+    (void)LittleFS.begin();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testFleet);
+    RUN_TEST(testBroadcast);
+    RUN_TEST(testSlotReuse);
+    RUN_TEST(testLowHeap);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Connect a spectator to the web server and request the event stream.
+ *
+ * @param[in] spectator Spectator
+ *
+ * @return If the request is sent, it will return true otherwise false.
+ */
+static bool connectSpectator(Spectator& spectator)
+{
+    static const char   REQUEST[]   = "GET /events HTTP/1.1\r\nHost: laptimer\r\nAccept: text/event-stream\r\n\r\n";
+    bool                isSuccess   = false;
+    struct sockaddr_in  address;
+
+    spectator.received.clear();
+    spectator.fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (0 <= spectator.fd)
+    {
+        (void)memset(&address, 0, sizeof(address));
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(NativeHAL::getHostPort(WEBSERVER_PORT));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if ((0 == connect(spectator.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) &&
+            (static_cast<ssize_t>(sizeof(REQUEST) - 1U) == send(spectator.fd, REQUEST, sizeof(REQUEST) - 1U, MSG_NOSIGNAL)))
+        {
+            isSuccess = true;
+        }
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Close the connection of a spectator.
+ *
+ * @param[in] spectator Spectator
+ */
+static void disconnectSpectator(Spectator& spectator)
+{
+    if (0 <= spectator.fd)
+    {
+        (void)close(spectator.fd);
+        spectator.fd = -1;
+    }
+}
+
+/**
+ * Let the web server run, until the spectator received the text or the
+ * server closed the connection.
+ *
+ * @param[in] spectator Spectator
+ * @param[in] text      Expected text
+ *
+ * @return If the text is received, it will return true otherwise false.
+ */
+static bool receiveUntil(Spectator& spectator, const char* text)
+{
+    uint32_t    loops       = 0U;
+    bool        isClosed    = false;
+    char        buffer[512U];
+
+    while ((std::string::npos == spectator.received.find(text)) && (false == isClosed) && (MAX_LOOPS > loops))
+    {
+        struct pollfd   pollFd  = { spectator.fd, POLLIN, 0 };
+        ssize_t         length  = 0;
+
+        (void)gWebServer->handleWebServer();
+
+        if (0 < poll(&pollFd, 1U, 1))
+        {
+            length = recv(spectator.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+            if (0 < length)
+            {
+                spectator.received.append(buffer, static_cast<size_t>(length));
+            }
+            else if (0 == length)
+            {
+                isClosed = true;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        ++loops;
+    }
+
+    return std::string::npos != spectator.received.find(text);
+}
+
+/**
+ * Count how often a text was received.
+ *
+ * @param[in] received  Received text
+ * @param[in] text      Text to count
+ *
+ * @return Number of occurrences
+ */
+static size_t countText(const std::string& received, const char* text)
+{
+    size_t  count   = 0U;
+    size_t  pos     = received.find(text);
+
+    while (std::string::npos != pos)
+    {
+        ++count;
+        pos = received.find(text, pos + 1U);
+    }
+
+    return count;
+}
+
+/**
+ * Send a command as text frame to the command dispatch, like the operator
+ * page does.
+ *
+ * @param[in] cmd   Command
+ */
+static void sendCommand(const char* cmd)
+{
+    char    payload[32U];
+    size_t  length  = strlen(cmd);
+
+    /* The dispatch gets a writable frame, like from the websocket server. */
+    (void)memcpy(payload, cmd, length + 1U);
+    (void)WebSocketsServer::injectEvent(0U, WStype_TEXT, reinterpret_cast<uint8_t*>(payload), length);
+}
+
+/**
+ * Pass the sensor with a short pulse.
+ */
+static void triggerSensor()
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)gWebServer->handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)gWebServer->handleCompetition();
+}
+
+/**
+ * Get the bytes, which are allocated on the heap of the host.
+ *
+ * @return Allocated bytes
+ */
+static uint64_t getLiveBytes()
+{
+    NativeHAL::HeapUsage usage;
+
+    NativeHAL::getHeapUsage(usage);
+
+    return usage.liveBytes;
+}
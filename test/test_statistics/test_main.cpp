@@ -0,0 +1,514 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Accuracy tests of the running statistics against exact reference values
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <Statistics.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Distribution of the generated lap times. */
+typedef enum
+{
+    DISTRIBUTION_UNIFORM = 0,   /**< Uniform between 10 s and 20 s. */
+    DISTRIBUTION_NORMAL,        /**< Approximately normal, mean 15 s, standard deviation 1 s. */
+    DISTRIBUTION_EXPONENTIAL,   /**< 10 s plus an exponential delay with mean 2 s, like runs with mistakes. */
+    DISTRIBUTION_ASCENDING      /**< Uniform, but in ascending order, like a field getting faster. */
+
+} Distribution;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void generate(Distribution distribution, uint32_t count);
+static double getRandom();
+static double getExactMean(uint32_t count);
+static double getExactVariance(uint32_t count);
+static double getExactQuantile(uint32_t count, double quantile);
+static double getRankError(uint32_t count, double quantile, double value);
+static void checkQuantile(const char* name, uint32_t count, float quantile, double maxRankError);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of values of a test. */
+static const uint32_t   MAX_VALUES      = 10000U;
+
+/** Generated values in the order they are recorded. */
+static float            gValues[MAX_VALUES];
+
+/** Generated values in ascending order, for the exact quantiles. */
+static float            gSorted[MAX_VALUES];
+
+/** State of the pseudo random generator, every test starts with the same sequence. */
+static uint32_t         gRandomState    = 0U;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: the same pseudo random sequence.
+ */
+void setUp()
+{
+    gRandomState = 12345U;
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+}
+
+/**
+ * Without values and with a single value, the results are defined.
+ */
+static void testWelfordFewValues()
+{
+    RunningStatistics statistics;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, statistics.getCount());
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 0.0, statistics.getMean());
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 0.0, statistics.getVariance());
+
+    statistics.record(12000.0);
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 12000.0, statistics.getMean());
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 0.0, statistics.getVariance());
+
+    statistics.record(14000.0);
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 13000.0, statistics.getMean());
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 2000000.0, statistics.getVariance());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, sqrt(2000000.0), statistics.getStdDev());
+
+    statistics.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, statistics.getCount());
+    TEST_ASSERT_DOUBLE_WITHIN(0.0, 0.0, statistics.getMean());
+}
+
+/**
+ * Mean and variance match the two pass reference of every distribution.
+ */
+static void testWelfordAccuracy()
+{
+    const Distribution  DISTRIBUTIONS[]     = { DISTRIBUTION_UNIFORM, DISTRIBUTION_NORMAL, DISTRIBUTION_EXPONENTIAL, DISTRIBUTION_ASCENDING };
+    size_t              idx                 = 0U;
+
+    for (idx = 0U; idx < (sizeof(DISTRIBUTIONS) / sizeof(DISTRIBUTIONS[0])); ++idx)
+    {
+        RunningStatistics   statistics;
+        uint32_t            value       = 0U;
+        double              mean        = 0.0;
+        double              variance    = 0.0;
+
+        generate(DISTRIBUTIONS[idx], MAX_VALUES);
+
+        for (value = 0U; value < MAX_VALUES; ++value)
+        {
+            statistics.record(gValues[value]);
+        }
+
+        mean        = getExactMean(MAX_VALUES);
+        variance    = getExactVariance(MAX_VALUES);
+
+        TEST_ASSERT_EQUAL_UINT32(MAX_VALUES, statistics.getCount());
+        TEST_ASSERT_DOUBLE_WITHIN(mean * 1e-12, mean, statistics.getMean());
+        TEST_ASSERT_DOUBLE_WITHIN(variance * 1e-9, variance, statistics.getVariance());
+    }
+}
+
+/**
+ * A large offset doesn't cancel the variance, like with the sum of the
+ * squares. The sum of the squares loses all digits of 30 here.
+ */
+static void testWelfordLargeOffset()
+{
+    const double        VALUES[]    = { 4.0, 7.0, 13.0, 16.0 };
+    const double        OFFSET      = 1e9;
+    RunningStatistics   statistics;
+    size_t              idx         = 0U;
+
+    for (idx = 0U; idx < (sizeof(VALUES) / sizeof(VALUES[0])); ++idx)
+    {
+        statistics.record(OFFSET + VALUES[idx]);
+    }
+
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, OFFSET + 10.0, statistics.getMean());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 30.0, statistics.getVariance());
+}
+
+/**
+ * Up to five values, the quantiles are exact.
+ */
+static void testP2FewValues()
+{
+    const float QUANTILES[] = { 0.0F, 0.25F, 0.5F, 0.9F, 1.0F };
+    size_t      idx         = 0U;
+    uint32_t    count       = 0U;
+
+    generate(DISTRIBUTION_UNIFORM, P2Quantile::MARKERS);
+
+    for (idx = 0U; idx < (sizeof(QUANTILES) / sizeof(QUANTILES[0])); ++idx)
+    {
+        P2Quantile estimator(QUANTILES[idx]);
+
+        TEST_ASSERT_DOUBLE_WITHIN(0.0, 0.0, estimator.getValue());
+
+        for (count = 1U; count <= P2Quantile::MARKERS; ++count)
+        {
+            estimator.record(gValues[count - 1U]);
+
+            /* The reference sorts only the recorded values. */
+            std::copy(gValues, gValues + count, gSorted);
+            std::sort(gSorted, gSorted + count);
+
+            TEST_ASSERT_DOUBLE_WITHIN(0.01, getExactQuantile(count, QUANTILES[idx]), estimator.getValue());
+        }
+    }
+}
+
+/**
+ * The markers follow the P2 algorithm step by step. The data is the example
+ * of Jain and Chlamtac, the reference markers are calculated with double
+ * precision by an independent implementation of the algorithm of the paper.
+ */
+static void testP2Markers()
+{
+    const float         VALUES[]            =
+    {
+        0.02F, 0.5F, 0.74F, 3.39F, 0.83F, 22.37F, 10.15F, 15.43F, 38.62F, 15.92F,
+        34.6F, 10.28F, 1.47F, 0.4F, 0.05F, 11.39F, 0.27F, 0.42F, 0.09F, 11.37F
+    };
+    const float         HEIGHTS[]           = { 0.02F, 0.154192F, 4.246239F, 17.555891F, 38.62F };
+    const int32_t       POSITIONS[]         = { 6, 10, 16 };
+    P2Quantile          estimator(0.5F);
+    P2Quantile::Markers markers;
+    size_t              idx                 = 0U;
+
+    for (idx = 0U; idx < (sizeof(VALUES) / sizeof(VALUES[0])); ++idx)
+    {
+        estimator.record(VALUES[idx]);
+    }
+
+    estimator.getMarkers(markers);
+
+    for (idx = 0U; idx < P2Quantile::MARKERS; ++idx)
+    {
+        TEST_ASSERT_DOUBLE_WITHIN(0.0001, HEIGHTS[idx], markers.heights[idx]);
+    }
+
+    for (idx = 0U; idx < (sizeof(POSITIONS) / sizeof(POSITIONS[0])); ++idx)
+    {
+        TEST_ASSERT_EQUAL_INT32(POSITIONS[idx], markers.positions[idx]);
+    }
+
+    TEST_ASSERT_DOUBLE_WITHIN(0.0001, HEIGHTS[2], estimator.getValue());
+}
+
+/**
+ * The estimated median and 90th percentile are close to the exact ones:
+ * the share of values below the estimation differs only a little from the
+ * quantile, for every distribution.
+ */
+static void testP2Accuracy()
+{
+    const float QUANTILES[]         = { 0.5F, 0.9F };
+    size_t      idx                 = 0U;
+
+    for (idx = 0U; idx < (sizeof(QUANTILES) / sizeof(QUANTILES[0])); ++idx)
+    {
+        generate(DISTRIBUTION_UNIFORM, MAX_VALUES);
+        checkQuantile("uniform", MAX_VALUES, QUANTILES[idx], 0.01);
+
+        generate(DISTRIBUTION_NORMAL, MAX_VALUES);
+        checkQuantile("normal", MAX_VALUES, QUANTILES[idx], 0.01);
+
+        generate(DISTRIBUTION_EXPONENTIAL, MAX_VALUES);
+        checkQuantile("exponential", MAX_VALUES, QUANTILES[idx], 0.01);
+
+        generate(DISTRIBUTION_ASCENDING, MAX_VALUES);
+        checkQuantile("ascending", MAX_VALUES, QUANTILES[idx], 0.01);
+    }
+}
+
+/**
+ * With the number of runs of a typical event, the estimation is already
+ * usable, it converges with more values.
+ */
+static void testP2Convergence()
+{
+    const uint32_t  COUNTS[]    = { 20U, 100U, 1000U };
+    const double    ERRORS[]    = { 0.15, 0.06, 0.02 };
+    size_t          idx         = 0U;
+
+    for (idx = 0U; idx < (sizeof(COUNTS) / sizeof(COUNTS[0])); ++idx)
+    {
+        setUp();
+        generate(DISTRIBUTION_NORMAL, COUNTS[idx]);
+        checkQuantile("normal", COUNTS[idx], 0.5F, ERRORS[idx]);
+        checkQuantile("normal", COUNTS[idx], 0.9F, ERRORS[idx]);
+    }
+}
+
+/**
+ * Run the tests.
+ *
+ * @return Number of failed tests.
+ */
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testWelfordFewValues);
+    RUN_TEST(testWelfordAccuracy);
+    RUN_TEST(testWelfordLargeOffset);
+    RUN_TEST(testP2FewValues);
+    RUN_TEST(testP2Markers);
+    RUN_TEST(testP2Accuracy);
+    RUN_TEST(testP2Convergence);
+
+    return UNITY_END();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Generate lap times in ms and sort a copy of them.
+ *
+ * @param[in] distribution  Distribution of the values.
+ * @param[in] count         Number of values.
+ */
+static void generate(Distribution distribution, uint32_t count)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < count; ++idx)
+    {
+        double  value   = 0.0;
+        uint8_t sum     = 0U;
+
+        switch (distribution)
+        {
+        case DISTRIBUTION_NORMAL:
+            /* Sum of twelve uniform values, its standard deviation is 1. */
+            for (sum = 0U; sum < 12U; ++sum)
+            {
+                value += getRandom();
+            }
+
+            value = 15000.0 + ((value - 6.0) * 1000.0);
+            break;
+
+        case DISTRIBUTION_EXPONENTIAL:
+            value = 10000.0 - (2000.0 * log(1.0 - getRandom()));
+            break;
+
+        case DISTRIBUTION_UNIFORM:
+        case DISTRIBUTION_ASCENDING:
+        default:
+            value = 10000.0 + (10000.0 * getRandom());
+            break;
+        }
+
+        /* Lap times are measured in ms. */
+        gValues[idx] = static_cast<float>(floor(value));
+    }
+
+    std::copy(gValues, gValues + count, gSorted);
+    std::sort(gSorted, gSorted + count);
+
+    if (DISTRIBUTION_ASCENDING == distribution)
+    {
+        std::copy(gSorted, gSorted + count, gValues);
+    }
+}
+
+/**
+ * Get the next pseudo random number of a linear congruential generator.
+ *
+ * @return Random number in the range [0; 1).
+ */
+static double getRandom()
+{
+    gRandomState = (gRandomState * 1664525U) + 1013904223U;
+
+    return static_cast<double>(gRandomState >> 8U) / 16777216.0;
+}
+
+/**
+ * Get the exact mean of the generated values.
+ *
+ * @param[in] count Number of values.
+ *
+ * @return Mean
+ */
+static double getExactMean(uint32_t count)
+{
+    double      sum = 0.0;
+    uint32_t    idx = 0U;
+
+    for (idx = 0U; idx < count; ++idx)
+    {
+        sum += gValues[idx];
+    }
+
+    return sum / count;
+}
+
+/**
+ * Get the exact sample variance of the generated values, with two passes.
+ *
+ * @param[in] count Number of values.
+ *
+ * @return Variance
+ */
+static double getExactVariance(uint32_t count)
+{
+    double      mean    = getExactMean(count);
+    double      sum     = 0.0;
+    uint32_t    idx     = 0U;
+
+    for (idx = 0U; idx < count; ++idx)
+    {
+        sum += (gValues[idx] - mean) * (gValues[idx] - mean);
+    }
+
+    return sum / (count - 1U);
+}
+
+/**
+ * Get the exact quantile of the sorted values, linear interpolated between
+ * the closest ranks.
+ *
+ * @param[in] count     Number of values.
+ * @param[in] quantile  Quantile in the range [0; 1].
+ *
+ * @return Quantile
+ */
+static double getExactQuantile(uint32_t count, double quantile)
+{
+    double      rank    = quantile * (count - 1U);
+    uint32_t    lower   = static_cast<uint32_t>(rank);
+    double      value   = gSorted[lower];
+
+    if ((lower + 1U) < count)
+    {
+        value += (rank - lower) * (gSorted[lower + 1U] - gSorted[lower]);
+    }
+
+    return value;
+}
+
+/**
+ * Get the rank error of an estimated quantile: the difference between the
+ * share of the values below it and the quantile. Unlike the difference of
+ * the values, it doesn't depend on the spread of the distribution.
+ *
+ * @param[in] count     Number of values.
+ * @param[in] quantile  Quantile in the range [0; 1].
+ * @param[in] value     Estimated quantile
+ *
+ * @return Rank error, 0 if it is between the values around the exact rank.
+ */
+static double getRankError(uint32_t count, double quantile, double value)
+{
+    double  below       = static_cast<double>(std::lower_bound(gSorted, gSorted + count, value) - gSorted) / count;
+    double  belowEqual  = static_cast<double>(std::upper_bound(gSorted, gSorted + count, value) - gSorted) / count;
+    double  error       = 0.0;
+
+    if (quantile < below)
+    {
+        error = below - quantile;
+    }
+    else if (quantile > belowEqual)
+    {
+        error = quantile - belowEqual;
+    }
+    else
+    {
+        ;
+    }
+
+    return error;
+}
+
+/**
+ * Estimate a quantile of the generated values, print the deviation to the
+ * exact one and check its rank error.
+ *
+ * @param[in] name          Name of the distribution.
+ * @param[in] count         Number of values.
+ * @param[in] quantile      Quantile in the range [0; 1].
+ * @param[in] maxRankError  Max. rank error.
+ */
+static void checkQuantile(const char* name, uint32_t count, float quantile, double maxRankError)
+{
+    P2Quantile  estimator(quantile);
+    uint32_t    idx         = 0U;
+    double      exact       = getExactQuantile(count, quantile);
+    double      rankError   = 0.0;
+    char        line[128U];
+
+    for (idx = 0U; idx < count; ++idx)
+    {
+        estimator.record(gValues[idx]);
+    }
+
+    rankError = getRankError(count, quantile, estimator.getValue());
+
+    (void)snprintf(line, sizeof(line), "%s, %u values, q%.0f: exact %.0f ms, estimated %.0f ms, rank error %.4f",
+                   name, static_cast<unsigned int>(count), quantile * 100.0F, exact, estimator.getValue(), rankError);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT32(count, estimator.getCount());
+    TEST_ASSERT_LESS_OR_EQUAL(maxRankError, rankError);
+}
@@ -0,0 +1,503 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the UDP multicast event feed with listeners on the loopback interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <Board.h>
+#include <Settings.h>
+#include <LittleFS.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <UdpEventFeed.h>
+#include <Log.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A received datagram, deserialized like a scoreboard does it. */
+typedef struct
+{
+    size_t      size;           /**< Size in byte. */
+    uint8_t     raw[64U];       /**< Received bytes. */
+    uint8_t     version;        /**< Protocol version. */
+    uint8_t     type;           /**< Event type. */
+    uint32_t    sequenceNumber; /**< Sequence number. */
+    uint32_t    timestamp;      /**< Device timestamp in ms. */
+    uint8_t     group;          /**< Group index. */
+    uint8_t     rank;           /**< Rank of the group. */
+    uint32_t    lapTime;        /**< Lap time in ms. */
+
+} Datagram;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int openListener();
+static void closeListener(int& fd);
+static bool receiveDatagram(int fd, Datagram& datagram);
+static uint32_t readUInt32(const uint8_t* buffer);
+static void sendCommand(const char* cmd);
+static void triggerSensor();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*          EEPROM_FILE     = "test_udp_eeprom.bin";
+
+/** Number of groups of the factory settings. */
+static const uint8_t        GROUPS          = 3U;
+
+/** Lap time in ms, which is longer than the blind period. */
+static const uint32_t       LAP_TIME        = 12000U;
+
+/** Time in ms, a listener waits for a datagram. Loopback delivers at once. */
+static const int            RECEIVE_TIMEOUT = 200;
+
+/** Listener, which joined the multicast group. */
+static int                  gListenerFd     = -1;
+
+/** Event feed under test. */
+static UdpEventFeed*        gFeed           = nullptr;
+
+/** Competition, which causes the events. */
+static Competition*         gCompetition    = nullptr;
+
+/** Web server, which publishes the events of the competition. */
+static LapTriggerWebServer* gWebServer      = nullptr;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings, a power-on RTC memory, a listener
+ * and a new feed and competition with its web server. They are created on
+ * the heap, because a failed test doesn't return and would skip their
+ * destructors.
+ */
+void setUp()
+{
+    static const uint32_t ZEROS[NativeHAL::RTC_USER_MEMORY_SIZE / sizeof(uint32_t)] = { 0U };
+
+    (void)NativeHAL::writeRtcMemory(0U, ZEROS, sizeof(ZEROS));
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+
+    gListenerFd = openListener();
+    TEST_ASSERT_TRUE(0 <= gListenerFd);
+
+    gFeed           = new UdpEventFeed();
+    gCompetition    = new Competition();
+    gWebServer      = new LapTriggerWebServer(*gCompetition);
+
+    TEST_ASSERT_TRUE(gCompetition->begin());
+    TEST_ASSERT_TRUE(gWebServer->begin());
+}
+
+/**
+ * Clean up after every test. The listener leaves the multicast group, the
+ * web server leaves the event bus.
+ */
+void tearDown()
+{
+    closeListener(gListenerFd);
+
+    delete gWebServer;
+    gWebServer = nullptr;
+
+    delete gCompetition;
+    gCompetition = nullptr;
+
+    delete gFeed;
+    gFeed = nullptr;
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * A datagram has the fixed size and all values in network byte order.
+ */
+static void testLayout()
+{
+    Datagram    datagram;
+    uint32_t    timestamp   = 0U;
+
+    NativeHAL::advanceTime(123456U * 1000U);
+    timestamp = millis();
+
+    gFeed->publishFinished(2U, 0x01020304U);
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+    TEST_ASSERT_EQUAL_UINT32(UdpEventFeed::DATAGRAM_SIZE, datagram.size);
+    TEST_ASSERT_EQUAL_UINT8('R', datagram.raw[0]);
+    TEST_ASSERT_EQUAL_UINT8('L', datagram.raw[1]);
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::PROTOCOL_VERSION, datagram.version);
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_FINISHED, datagram.type);
+    TEST_ASSERT_EQUAL_UINT32(0U, datagram.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT32(timestamp, datagram.timestamp);
+    TEST_ASSERT_EQUAL_UINT8(2U, datagram.group);
+    TEST_ASSERT_EQUAL_UINT8(0U, datagram.rank);
+
+    /* Big endian */
+    TEST_ASSERT_EQUAL_UINT8(0x01U, datagram.raw[14]);
+    TEST_ASSERT_EQUAL_UINT8(0x02U, datagram.raw[15]);
+    TEST_ASSERT_EQUAL_UINT8(0x03U, datagram.raw[16]);
+    TEST_ASSERT_EQUAL_UINT8(0x04U, datagram.raw[17]);
+
+    /* Nothing else was sent. */
+    TEST_ASSERT_FALSE(receiveDatagram(gListenerFd, datagram));
+}
+
+/**
+ * Every datagram gets the next sequence number, so a listener detects lost
+ * datagrams.
+ */
+static void testSequence()
+{
+    Datagram    datagram;
+    uint32_t    idx         = 0U;
+
+    gFeed->publishStarted(1U);
+    gFeed->publishFinished(1U, LAP_TIME);
+
+    for (idx = 0U; idx < GROUPS; ++idx)
+    {
+        gFeed->publishLeaderboard(static_cast<uint8_t>(idx), static_cast<uint8_t>(idx + 1U), LAP_TIME + idx);
+    }
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_STARTED, datagram.type);
+    TEST_ASSERT_EQUAL_UINT32(0U, datagram.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT8(1U, datagram.group);
+    TEST_ASSERT_EQUAL_UINT32(0U, datagram.lapTime);
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_FINISHED, datagram.type);
+    TEST_ASSERT_EQUAL_UINT32(1U, datagram.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, datagram.lapTime);
+
+    for (idx = 0U; idx < GROUPS; ++idx)
+    {
+        TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+        TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_LEADERBOARD, datagram.type);
+        TEST_ASSERT_EQUAL_UINT32(2U + idx, datagram.sequenceNumber);
+        TEST_ASSERT_EQUAL_UINT8(idx, datagram.group);
+        TEST_ASSERT_EQUAL_UINT8(idx + 1U, datagram.rank);
+        TEST_ASSERT_EQUAL_UINT32(LAP_TIME + idx, datagram.lapTime);
+    }
+}
+
+/**
+ * Every listener, which joined the group, gets every datagram. The device
+ * sends it only once.
+ */
+static void testListeners()
+{
+    const size_t    LISTENERS               = 4U;
+    int             listeners[LISTENERS];
+    Datagram        datagram;
+    size_t          idx                     = 0U;
+
+    for (idx = 0U; idx < LISTENERS; ++idx)
+    {
+        listeners[idx] = openListener();
+    }
+
+    gFeed->publishStarted(2U);
+
+    for (idx = 0U; idx < LISTENERS; ++idx)
+    {
+        bool isReceived = receiveDatagram(listeners[idx], datagram);
+
+        closeListener(listeners[idx]);
+
+        TEST_ASSERT_TRUE(isReceived);
+        TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_STARTED, datagram.type);
+        TEST_ASSERT_EQUAL_UINT8(2U, datagram.group);
+    }
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+}
+
+/**
+ * A run of the competition reaches the listener: its start, its finish and
+ * the leaderboard of all groups, which is sent once. The sensor task only
+ * queues the events, the websocket task sends them.
+ */
+static void testRun()
+{
+    Datagram    datagram;
+    uint8_t     group       = 0U;
+
+    sendCommand("RELEASE;1");
+    triggerSensor();
+
+    TEST_ASSERT_FALSE(receiveDatagram(gListenerFd, datagram));
+    (void)gWebServer->handleWebSocket();
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_STARTED, datagram.type);
+    TEST_ASSERT_EQUAL_UINT8(1U, datagram.group);
+
+    NativeHAL::advanceTime(static_cast<uint64_t>(LAP_TIME) * 1000U);
+    triggerSensor();
+
+    TEST_ASSERT_FALSE(receiveDatagram(gListenerFd, datagram));
+    (void)gWebServer->handleWebSocket();
+
+    TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+    TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_FINISHED, datagram.type);
+    TEST_ASSERT_EQUAL_UINT8(1U, datagram.group);
+    TEST_ASSERT_EQUAL_UINT32(LAP_TIME, datagram.lapTime);
+
+    /* The leaderboard follows with the next web server loop, once per batch of changes. */
+    TEST_ASSERT_FALSE(receiveDatagram(gListenerFd, datagram));
+    (void)gWebServer->handleWebServer();
+
+    for (group = 0U; group < GROUPS; ++group)
+    {
+        TEST_ASSERT_TRUE(receiveDatagram(gListenerFd, datagram));
+        TEST_ASSERT_EQUAL_UINT8(UdpEventFeed::EVENT_TYPE_LEADERBOARD, datagram.type);
+        TEST_ASSERT_EQUAL_UINT8(group, datagram.group);
+
+        if (1U == group)
+        {
+            TEST_ASSERT_EQUAL_UINT8(1U, datagram.rank);
+            TEST_ASSERT_EQUAL_UINT32(LAP_TIME, datagram.lapTime);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_UINT8(0U, datagram.rank);
+            TEST_ASSERT_EQUAL_UINT32(0U, datagram.lapTime);
+        }
+    }
+
+    (void)gWebServer->handleWebServer();
+    TEST_ASSERT_FALSE(receiveDatagram(gListenerFd, datagram));
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argPortOffset[] = "--port-offset";
+    static char     portOffset[]    = "34000";
+    static char     argEeprom[]     = "--eeprom";
+    static char     eeprom[]        = "test_udp_eeprom.bin";
+    char*           args[]          = { argv[0], argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+    int             failures        = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(5, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_ERROR);
+
+    (void)Board::begin();
+    (void)LittleFS.begin();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testLayout);
+    RUN_TEST(testSequence);
+    RUN_TEST(testListeners);
+    RUN_TEST(testRun);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Open a listener, which joins the multicast group on the loopback
+ * interface, like the UDP event receiver tool does.
+ *
+ * @return Socket, -1 on failure.
+ */
+static int openListener()
+{
+    int                 fd          = socket(AF_INET, SOCK_DGRAM, 0);
+    int                 reuse       = 1;
+    struct sockaddr_in  address;
+    struct ip_mreq      membership;
+
+    if (0 <= fd)
+    {
+        (void)memset(&address, 0, sizeof(address));
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(NativeHAL::getHostPort(UdpEventFeed::MULTICAST_PORT));
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        (void)memcpy(&membership.imr_multiaddr.s_addr, UdpEventFeed::MULTICAST_ADDRESS, sizeof(UdpEventFeed::MULTICAST_ADDRESS));
+        membership.imr_interface.s_addr = htonl(INADDR_LOOPBACK);
+
+        if ((0 != setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))) ||
+            (0 != bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) ||
+            (0 != setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership))))
+        {
+            closeListener(fd);
+        }
+    }
+
+    return fd;
+}
+
+/**
+ * Close a listener, it leaves the multicast group.
+ *
+ * @param[in,out] fd    Socket, -1 afterwards.
+ */
+static void closeListener(int& fd)
+{
+    if (0 <= fd)
+    {
+        (void)close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * Wait for the next datagram and deserialize it.
+ *
+ * @param[in]   fd          Socket of the listener.
+ * @param[out]  datagram    Received datagram.
+ *
+ * @return If a valid datagram is received, it will return true otherwise false.
+ */
+static bool receiveDatagram(int fd, Datagram& datagram)
+{
+    struct pollfd   pollFd      = { fd, POLLIN, 0 };
+    bool            isSuccess   = false;
+
+    (void)memset(&datagram, 0, sizeof(datagram));
+
+    if (0 < poll(&pollFd, 1U, RECEIVE_TIMEOUT))
+    {
+        ssize_t length = recv(fd, datagram.raw, sizeof(datagram.raw), MSG_DONTWAIT);
+
+        if ((static_cast<ssize_t>(UdpEventFeed::DATAGRAM_SIZE) == length) &&
+            ('R' == datagram.raw[0]) &&
+            ('L' == datagram.raw[1]))
+        {
+            datagram.size           = static_cast<size_t>(length);
+            datagram.version        = datagram.raw[2];
+            datagram.type           = datagram.raw[3];
+            datagram.sequenceNumber = readUInt32(&datagram.raw[4]);
+            datagram.timestamp      = readUInt32(&datagram.raw[8]);
+            datagram.group          = datagram.raw[12];
+            datagram.rank           = datagram.raw[13];
+            datagram.lapTime        = readUInt32(&datagram.raw[14]);
+            isSuccess               = true;
+        }
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Read a 32-bit value in network byte order.
+ *
+ * @param[in] buffer    Buffer with 4 bytes.
+ *
+ * @return Value
+ */
+static uint32_t readUInt32(const uint8_t* buffer)
+{
+    return (static_cast<uint32_t>(buffer[0]) << 24U) |
+           (static_cast<uint32_t>(buffer[1]) << 16U) |
+           (static_cast<uint32_t>(buffer[2]) << 8U) |
+           static_cast<uint32_t>(buffer[3]);
+}
+
+/**
+ * Send a command as text frame to the command dispatch, like the operator
+ * page does.
+ *
+ * @param[in] cmd   Command
+ */
+static void sendCommand(const char* cmd)
+{
+    char    payload[32U];
+    size_t  length  = strlen(cmd);
+
+    /* The dispatch gets a writable frame, like from the websocket server. */
+    (void)memcpy(payload, cmd, length + 1U);
+    (void)WebSocketsServer::injectEvent(0U, WStype_TEXT, reinterpret_cast<uint8_t*>(payload), length);
+}
+
+/**
+ * Pass the sensor with a short pulse.
+ */
+static void triggerSensor()
+{
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)gWebServer->handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)gWebServer->handleCompetition();
+}
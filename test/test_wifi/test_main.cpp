@@ -0,0 +1,346 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Tests of the WiFi connection state machine with the emulated access point
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <EEPROM.h>
+#include <ESP8266WiFi.h>
+#include <Settings.h>
+#include <WIFI.h>
+#include <Log.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t runUntilStatus(WIFI& wifi, wl_status_t status, uint32_t timeout);
+static void setCredentials();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** File, which backs the EEPROM during the tests. */
+static const char*      EEPROM_FILE             = "test_wifi_eeprom.bin";
+
+/** Period in ms between two cycles of the state machine. */
+static const uint32_t   CYCLE_PERIOD            = 10U;
+
+/** Timeout in ms of a full connect, see WIFI. */
+static const uint32_t   WIFI_TIMEOUT            = 30000U;
+
+/** Timeout in ms of a fast connect, see WIFI. */
+static const uint32_t   FAST_CONNECT_TIMEOUT    = 5000U;
+
+/** Back-off in ms after the first failed connect, see WIFI. */
+static const uint32_t   BACKOFF_MIN             = 1000U;
+
+/** Returned by runUntilStatus(), if the status was not reached. */
+static const uint32_t   NOT_REACHED             = UINT32_MAX;
+
+/** Channel, which the access point moves to. */
+static const int32_t    OTHER_CHANNEL           = 11;
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Prepare every test: factory settings and the emulated access point in
+ * range on its channel, without a connection.
+ */
+void setUp()
+{
+    (void)remove(EEPROM_FILE);
+    TEST_ASSERT_TRUE(Settings::getInstance().begin());
+
+    (void)WiFi.disconnect(true);
+    (void)WiFi.mode(WIFI_OFF);
+    WiFi.setApInRange(true);
+    WiFi.setApChannel(ESP8266WiFiClass::AP_CHANNEL);
+}
+
+/**
+ * Clean up after every test.
+ */
+void tearDown()
+{
+    (void)WiFi.disconnect(true);
+}
+
+/**
+ * Without credentials only the access point is started.
+ */
+static void testNoCredentials()
+{
+    WIFI wifi;
+
+    TEST_ASSERT_TRUE(wifi.begin());
+    TEST_ASSERT_EQUAL(WIFI_AP, WiFi.getMode());
+    TEST_ASSERT_EQUAL_UINT32(IPAddress(127U, 0U, 0U, 1U), wifi.getIPAddress());
+
+    TEST_ASSERT_EQUAL_UINT32(NOT_REACHED, runUntilStatus(wifi, WL_CONNECTED, 1000U));
+    TEST_ASSERT_EQUAL(WIFI_AP, WiFi.getMode());
+}
+
+/**
+ * The first connect scans and waits for DHCP and stores the connection
+ * parameters. The next start connects fast with them, without writing the
+ * same parameters again.
+ */
+static void testFullThenFastConnect()
+{
+    Settings::WiFiFastConnect   fastConnect;
+    uint32_t                    writeCount  = 0U;
+
+    setCredentials();
+    TEST_ASSERT_FALSE(Settings::getInstance().getWiFiFastConnect(fastConnect));
+
+    {
+        WIFI wifi;
+
+        TEST_ASSERT_TRUE(wifi.begin());
+        TEST_ASSERT_EQUAL(WIFI_STA, WiFi.getMode());
+        TEST_ASSERT_EQUAL_UINT32(ESP8266WiFiClass::CONNECT_TIME_MS, runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+        TEST_ASSERT_EQUAL_UINT32(ESP8266WiFiClass::CONNECT_TIME_MS, wifi.getConnectDuration());
+        TEST_ASSERT_FALSE(wifi.isFastConnected());
+    }
+
+    TEST_ASSERT_TRUE(Settings::getInstance().getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_EQUAL_UINT8(ESP8266WiFiClass::AP_CHANNEL, fastConnect.channel);
+    TEST_ASSERT_EQUAL_UINT32(IPAddress(127U, 0U, 0U, 1U), fastConnect.localIP);
+
+    /* Restart */
+    (void)WiFi.disconnect(true);
+    writeCount = EEPROM.getWriteCount();
+
+    {
+        WIFI wifi;
+
+        TEST_ASSERT_TRUE(wifi.begin());
+        TEST_ASSERT_EQUAL_UINT32(ESP8266WiFiClass::FAST_CONNECT_TIME_MS, runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+        TEST_ASSERT_EQUAL_UINT32(ESP8266WiFiClass::FAST_CONNECT_TIME_MS, wifi.getConnectDuration());
+        TEST_ASSERT_TRUE(wifi.isFastConnected());
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(writeCount, EEPROM.getWriteCount());
+}
+
+/**
+ * If the access point moved to another channel, the fast connect fails and
+ * the full connect follows at once. The new parameters are stored.
+ */
+static void testFastConnectFallback()
+{
+    Settings::WiFiFastConnect   fastConnect;
+    WIFI                        wifi;
+
+    setCredentials();
+
+    {
+        WIFI firstWifi;
+
+        TEST_ASSERT_TRUE(firstWifi.begin());
+        TEST_ASSERT_TRUE(NOT_REACHED != runUntilStatus(firstWifi, WL_CONNECTED, WIFI_TIMEOUT));
+    }
+
+    (void)WiFi.disconnect(true);
+    WiFi.setApChannel(OTHER_CHANNEL);
+
+    TEST_ASSERT_TRUE(wifi.begin());
+    TEST_ASSERT_EQUAL_UINT32(FAST_CONNECT_TIMEOUT + ESP8266WiFiClass::CONNECT_TIME_MS, runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+
+    /* The duration covers the failed fast connect too. */
+    TEST_ASSERT_EQUAL_UINT32(FAST_CONNECT_TIMEOUT + ESP8266WiFiClass::CONNECT_TIME_MS, wifi.getConnectDuration());
+    TEST_ASSERT_FALSE(wifi.isFastConnected());
+
+    TEST_ASSERT_TRUE(Settings::getInstance().getWiFiFastConnect(fastConnect));
+    TEST_ASSERT_EQUAL_UINT8(OTHER_CHANNEL, fastConnect.channel);
+}
+
+/**
+ * Without the access point in range, the station retries with a doubling
+ * back-off. The access point is started after the first failed connect,
+ * because the station was never connected, and it stays after the station
+ * connected.
+ */
+static void testBackOff()
+{
+    uint32_t    backOff = BACKOFF_MIN;
+    uint8_t     attempt = 0U;
+    WIFI        wifi;
+
+    setCredentials();
+    WiFi.setApInRange(false);
+
+    TEST_ASSERT_TRUE(wifi.begin());
+    TEST_ASSERT_EQUAL_UINT32(WIFI_TIMEOUT, runUntilStatus(wifi, WL_IDLE_STATUS, WIFI_TIMEOUT + BACKOFF_MIN));
+    TEST_ASSERT_EQUAL(WIFI_AP_STA, WiFi.getMode());
+
+    for (attempt = 0U; attempt < 3U; ++attempt)
+    {
+        TEST_ASSERT_EQUAL_UINT32(backOff, runUntilStatus(wifi, WL_NO_SSID_AVAIL, WIFI_TIMEOUT));
+        TEST_ASSERT_EQUAL_UINT32(WIFI_TIMEOUT, runUntilStatus(wifi, WL_IDLE_STATUS, WIFI_TIMEOUT + BACKOFF_MIN));
+
+        backOff *= 2U;
+    }
+
+    WiFi.setApInRange(true);
+
+    TEST_ASSERT_EQUAL_UINT32(backOff + ESP8266WiFiClass::CONNECT_TIME_MS, runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+    TEST_ASSERT_EQUAL(WIFI_AP_STA, WiFi.getMode());
+}
+
+/**
+ * A lost connection is detected and reconnected with the fast connect,
+ * once the access point is back.
+ */
+static void testConnectionLost()
+{
+    WIFI wifi;
+
+    setCredentials();
+
+    TEST_ASSERT_TRUE(wifi.begin());
+    TEST_ASSERT_TRUE(NOT_REACHED != runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+    TEST_ASSERT_FALSE(wifi.isFastConnected());
+
+    WiFi.setApInRange(false);
+    TEST_ASSERT_EQUAL_UINT32(0U, runUntilStatus(wifi, WL_NO_SSID_AVAIL, WIFI_TIMEOUT));
+
+    /* The station was connected before, therefore the access point is not started. */
+    TEST_ASSERT_EQUAL_UINT32(NOT_REACHED, runUntilStatus(wifi, WL_CONNECTED, 1000U));
+    TEST_ASSERT_EQUAL(WIFI_STA, WiFi.getMode());
+
+    WiFi.setApInRange(true);
+    TEST_ASSERT_TRUE(NOT_REACHED != runUntilStatus(wifi, WL_CONNECTED, WIFI_TIMEOUT));
+    TEST_ASSERT_TRUE(wifi.isFastConnected());
+    TEST_ASSERT_EQUAL(WIFI_STA, WiFi.getMode());
+}
+
+/**
+ * Run the tests.
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Number of failed tests.
+ */
+int main(int argc, char** argv)
+{
+    static char     argEeprom[] = "--eeprom";
+    static char     eeprom[]    = "test_wifi_eeprom.bin";
+    char*           args[]      = { argv[0], argEeprom, eeprom, nullptr };
+    int             failures    = 0;
+
+    (void)argc;
+
+    (void)NativeHAL::begin(3, args);
+    NativeHAL::setVirtualTime(true);
+    Log::setLevel(Log::LOG_ERROR);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testNoCredentials);
+    RUN_TEST(testFullThenFastConnect);
+    RUN_TEST(testFastConnectFallback);
+    RUN_TEST(testBackOff);
+    RUN_TEST(testConnectionLost);
+
+    failures = UNITY_END();
+
+    (void)remove(EEPROM_FILE);
+
+    return failures;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Cycle the state machine, until the WiFi has the status.
+ *
+ * @param[in] wifi      WiFi
+ * @param[in] status    Expected status
+ * @param[in] timeout   Timeout in ms.
+ *
+ * @return Duration in ms, until the status was reached. NOT_REACHED after the timeout.
+ */
+static uint32_t runUntilStatus(WIFI& wifi, wl_status_t status, uint32_t timeout)
+{
+    uint32_t duration = 0U;
+
+    TEST_ASSERT_TRUE(wifi.runCycle());
+
+    while ((status != WiFi.status()) && (NOT_REACHED != duration))
+    {
+        if (timeout <= duration)
+        {
+            duration = NOT_REACHED;
+        }
+        else
+        {
+            NativeHAL::advanceTime(static_cast<uint64_t>(CYCLE_PERIOD) * 1000U);
+            duration += CYCLE_PERIOD;
+
+            TEST_ASSERT_TRUE(wifi.runCycle());
+        }
+    }
+
+    return duration;
+}
+
+/**
+ * Store the credentials of the emulated access point.
+ */
+static void setCredentials()
+{
+    Settings::getInstance().setWiFiSSID("Racetrack");
+    Settings::getInstance().setWiFiPassphrase("fast cars");
+}
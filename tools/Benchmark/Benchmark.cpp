@@ -0,0 +1,217 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmarks of the lap timer on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Benchmark.h"
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Log.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Entry point of the benchmarks. The suites run on the host, therefore the
+ * results only compare the cases with each other and don't show the cost on
+ * the target.
+ *
+ * Usage: benchmark [--suite all|eventbus|competition|heap] [--iterations <n>] [--max-publish-ns <ns>]
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Exit status, which is EXIT_FAILURE if a suite failed.
+ */
+int main(int argc, char** argv)
+{
+    int         status          = EXIT_SUCCESS;
+    uint32_t    iterations      = 1000000U;
+    double      maxPublishNs    = 0.0;
+    const char* suite           = "all";
+    int         argIdx          = 0;
+
+    for (argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const char* value = ((argIdx + 1) < argc) ? argv[argIdx + 1] : "0";
+
+        if (0 == strcmp(argv[argIdx], "--iterations"))
+        {
+            iterations = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            ++argIdx;
+        }
+        else if (0 == strcmp(argv[argIdx], "--max-publish-ns"))
+        {
+            maxPublishNs = strtod(value, nullptr);
+            ++argIdx;
+        }
+        else if (0 == strcmp(argv[argIdx], "--suite"))
+        {
+            suite = value;
+            ++argIdx;
+
+            if ((0 != strcmp(suite, "all")) &&
+                (0 != strcmp(suite, "eventbus")) &&
+                (0 != strcmp(suite, "competition")) &&
+                (0 != strcmp(suite, "heap")))
+            {
+                fprintf(stderr, "Unknown suite: %s\n", suite);
+                status = EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Unknown argument: %s\n", argv[argIdx]);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    if (EXIT_SUCCESS == status)
+    {
+        /* The benchmarks drive the clock. The web server of the heap suite
+         * shall not collide with a running lap timer and the settings are
+         * not kept.
+         */
+        static char     argPortOffset[] = "--port-offset";
+        static char     portOffset[]    = "30000";
+        static char     argEeprom[]     = "--eeprom";
+        static char     eeprom[]        = "/dev/null";
+        char*           args[]          = { argv[0], argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+
+        (void)NativeHAL::begin(5, args);
+        NativeHAL::setVirtualTime(true);
+
+        /* Every release logs the active group, which only costs time here. */
+        Log::setLevel(Log::LOG_WARNING);
+
+        if (((0 == strcmp(suite, "all")) || (0 == strcmp(suite, "eventbus"))) &&
+            (false == runEventBusBenchmark(iterations, maxPublishNs)))
+        {
+            status = EXIT_FAILURE;
+        }
+
+        if (((0 == strcmp(suite, "all")) || (0 == strcmp(suite, "competition"))) &&
+            (false == runCompetitionBenchmark(iterations)))
+        {
+            status = EXIT_FAILURE;
+        }
+
+        if (((0 == strcmp(suite, "all")) || (0 == strcmp(suite, "heap"))) &&
+            (false == runHeapChurnBenchmark()))
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Run a benchmark case and print its cost per iteration.
+ *
+ * @param[in] name          Name of the case.
+ * @param[in] func          Benchmark case.
+ * @param[in] iterations    Number of iterations.
+ *
+ * @return Cost per iteration in ns.
+ */
+double runCase(const char* name, BenchmarkFunc func, uint32_t iterations)
+{
+    double begin    = 0.0;
+    double ns       = 0.0;
+
+    /* Warm up the caches and the allocator. */
+    func(iterations / 10U);
+
+    begin = getHostSeconds();
+    func(iterations);
+    ns = (0U < iterations) ? (((getHostSeconds() - begin) * 1e9) / iterations) : 0.0;
+
+    printf("%-32s %10.1f\n", name, ns);
+
+    return ns;
+}
+
+/**
+ * Get the monotonic time of the host.
+ *
+ * @return Time in s.
+ */
+double getHostSeconds()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_nsec) / 1e9);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,100 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmarks of the lap timer on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Benchmark case, which runs the given number of iterations. */
+typedef void (*BenchmarkFunc)(uint32_t iterations);
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Run a benchmark case and print its cost per iteration.
+ *
+ * @param[in] name          Name of the case.
+ * @param[in] func          Benchmark case.
+ * @param[in] iterations    Number of iterations.
+ *
+ * @return Cost per iteration in ns.
+ */
+double runCase(const char* name, BenchmarkFunc func, uint32_t iterations);
+
+/**
+ * Get the monotonic time of the host.
+ *
+ * @return Time in s.
+ */
+double getHostSeconds();
+
+/**
+ * Compare the former string based event path with the event bus.
+ *
+ * @param[in] iterations    Number of iterations per case.
+ * @param[in] maxPublishNs  Max. cost of publishing to 4 listeners or to the web server in ns, 0 to disable the check.
+ *
+ * @return If publishing is fast enough, it will return true otherwise false.
+ */
+bool runEventBusBenchmark(uint32_t iterations, double maxPublishNs);
+
+/**
+ * Compare the competition of the small, standard and large event configuration.
+ *
+ * @param[in] iterations    Number of iterations per case.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool runCompetitionBenchmark(uint32_t iterations);
+
+/**
+ * Simulate 10000 runs with the competition and the web server and count the
+ * heap allocations.
+ *
+ * @return If the heap is in steady state, it will return true otherwise false.
+ */
+bool runHeapChurnBenchmark();
+
+#endif /* BENCHMARK_H_ */
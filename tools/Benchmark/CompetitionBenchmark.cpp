@@ -0,0 +1,266 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the competition in the event configurations on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Benchmark.h"
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Competition.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+template <typename Config>
+static CompetitionT<Config>& getCompetition();
+
+template <typename Config>
+static void runConfig(const char* name, uint32_t iterations);
+
+template <typename Config>
+static void benchmarkPoll(uint32_t iterations);
+
+template <typename Config>
+static void benchmarkRun(uint32_t iterations);
+
+template <typename Config>
+static void benchmarkRanks(uint32_t iterations);
+
+static void advanceMillis(uint32_t duration);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Min. lap time in ms of the benchmarked runs. */
+static const uint32_t   MIN_LAP_TIME    = 10000U;
+
+/** Sink for the results, which keeps the compiler from removing the calls. */
+static volatile uint32_t gSink          = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Compare the competition of the small, standard and large event
+ * configuration: its RAM footprint and the cost of a sensor poll without
+ * run, of a whole run and of reading the ranks of all groups.
+ *
+ * @param[in] iterations    Number of iterations per case.
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+bool runCompetitionBenchmark(uint32_t iterations)
+{
+    printf("%-32s %10s\n", "configuration", "RAM/byte");
+    printf("%-32s %10u\n", "small", static_cast<unsigned int>(sizeof(CompetitionT<SmallEventConfig>)));
+    printf("%-32s %10u\n", "standard", static_cast<unsigned int>(sizeof(CompetitionT<StandardEventConfig>)));
+    printf("%-32s %10u\n", "large", static_cast<unsigned int>(sizeof(CompetitionT<LargeEventConfig>)));
+
+    printf("%-32s %10s\n", "case", "ns/op");
+
+    runConfig<SmallEventConfig>("small", iterations);
+    runConfig<StandardEventConfig>("standard", iterations);
+    runConfig<LargeEventConfig>("large", iterations);
+
+    return true;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the competition of a configuration. All groups participate.
+ *
+ * @tparam Config Event configuration.
+ *
+ * @return Competition
+ */
+template <typename Config>
+static CompetitionT<Config>& getCompetition()
+{
+    static CompetitionT<Config> competition;
+    uint8_t                     groups      = 0U;
+
+    if ((false == competition.getNumberofGroups(groups)) ||
+        (CompetitionT<Config>::MAX_GROUPS != groups))
+    {
+        (void)competition.setNumberofGroups(CompetitionT<Config>::MAX_GROUPS);
+    }
+
+    return competition;
+}
+
+/**
+ * Run all cases of a configuration.
+ *
+ * @tparam Config Event configuration.
+ *
+ * @param[in] name          Name of the configuration.
+ * @param[in] iterations    Number of iterations per case.
+ */
+template <typename Config>
+static void runConfig(const char* name, uint32_t iterations)
+{
+    char caseName[32U];
+
+    /* A run is much more expensive than a poll. */
+    (void)snprintf(caseName, sizeof(caseName), "%s: poll", name);
+    (void)runCase(caseName, benchmarkPoll<Config>, iterations);
+    (void)snprintf(caseName, sizeof(caseName), "%s: run", name);
+    (void)runCase(caseName, benchmarkRun<Config>, iterations / 10U);
+    (void)snprintf(caseName, sizeof(caseName), "%s: ranks of all groups", name);
+    (void)runCase(caseName, benchmarkRanks<Config>, iterations);
+}
+
+/**
+ * Poll the sensor of a released competition, while no robot is detected.
+ * This is what the sensor task does most of the time.
+ *
+ * @tparam Config Event configuration.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+template <typename Config>
+static void benchmarkPoll(uint32_t iterations)
+{
+    CompetitionT<Config>&   competition = getCompetition<Config>();
+    uint32_t                idx         = 0U;
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)competition.setReleasedState(0U);
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        if (true == competition.handleCompetition())
+        {
+            ++gSink;
+        }
+    }
+}
+
+/**
+ * Drive whole runs of changing groups and lap times: release, start, finish
+ * and the poll, which stores the snapshot. The finish updates the statistics,
+ * the ranks and the journal.
+ *
+ * @tparam Config Event configuration.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+template <typename Config>
+static void benchmarkRun(uint32_t iterations)
+{
+    CompetitionT<Config>&   competition = getCompetition<Config>();
+    uint32_t                idx         = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        uint8_t group = static_cast<uint8_t>(idx % CompetitionT<Config>::MAX_GROUPS);
+
+        (void)competition.setReleasedState(group);
+
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+        (void)competition.handleCompetition();
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+        advanceMillis(MIN_LAP_TIME + ((idx * 37U) % 1000U));
+
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+        (void)competition.handleCompetition();
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+        (void)competition.handleCompetition();
+    }
+
+    gSink = gSink + competition.getRunLapTime();
+}
+
+/**
+ * Read the ranks of all groups, like the result table does.
+ *
+ * @tparam Config Event configuration.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+template <typename Config>
+static void benchmarkRanks(uint32_t iterations)
+{
+    CompetitionT<Config>&   competition = getCompetition<Config>();
+    uint32_t                idx         = 0U;
+    uint8_t                 group       = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        for (group = 0U; group < CompetitionT<Config>::MAX_GROUPS; ++group)
+        {
+            gSink = gSink + competition.getRank(group);
+        }
+    }
+}
+
+/**
+ * Advance the virtual time.
+ *
+ * @param[in] duration  Duration in ms.
+ */
+static void advanceMillis(uint32_t duration)
+{
+    NativeHAL::advanceTime(static_cast<uint64_t>(duration) * 1000U);
+}
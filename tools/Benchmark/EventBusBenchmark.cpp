@@ -0,0 +1,336 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Benchmark of the event bus publish cost on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Benchmark.h"
+#include <Arduino.h>
+#include <EventBus.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Listener, which only counts the events. */
+class CountingListener : public EventBus::Listener
+{
+public:
+
+    /**
+     * Constructs the listener.
+     */
+    CountingListener() :
+        m_count(0U)
+    {
+    }
+
+    /**
+     * Destroys the listener.
+     */
+    ~CountingListener()
+    {
+    }
+
+    /**
+     * Count the event.
+     *
+     * @param[in] event Event
+     */
+    void onEvent(const EventBus::Event& event) override
+    {
+        m_count += event.lapTime;
+    }
+
+    /**
+     * Get the sum of all lap times, which keeps the compiler from removing the calls.
+     *
+     * @return Sum of the lap times.
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+private:
+
+    uint32_t m_count;   /**< Sum of the lap times. */
+};
+
+/** Listener, which serialises the events like the websocket listener. */
+class FormattingListener : public EventBus::Listener
+{
+public:
+
+    /**
+     * Constructs the listener.
+     */
+    FormattingListener() :
+        m_length(0U)
+    {
+    }
+
+    /**
+     * Destroys the listener.
+     */
+    ~FormattingListener()
+    {
+    }
+
+    /**
+     * Serialise the event on the stack.
+     *
+     * @param[in] event Event
+     */
+    void onEvent(const EventBus::Event& event) override
+    {
+        char msg[48U];
+
+        m_length += snprintf(msg, sizeof(msg), "EVT;FINISHED;%u;%u%s",
+                             static_cast<unsigned int>(event.lapTime),
+                             static_cast<unsigned int>(event.group),
+                             (0U != (event.flags & EventBus::FLAG_SUSPICIOUS)) ? ";SUSPICIOUS" : "");
+    }
+
+    /**
+     * Get the sum of all message lengths, which keeps the compiler from removing the calls.
+     *
+     * @return Sum of the message lengths.
+     */
+    uint32_t getLength() const
+    {
+        return m_length;
+    }
+
+private:
+
+    uint32_t m_length;  /**< Sum of the message lengths. */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void benchmarkStringPoll(uint32_t iterations);
+static void benchmarkStringFinish(uint32_t iterations);
+static void benchmarkPublish(uint32_t iterations);
+static double benchmarkPublishWebServer(uint32_t iterations);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Sink for the results of the string cases, which keeps the compiler from removing them. */
+static volatile uint32_t    gSink = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Compare the cost of the former string based event path in the sensor task
+ * with the event bus, without and with listeners.
+ *
+ * @param[in] iterations    Number of iterations per case.
+ * @param[in] maxPublishNs  Max. cost of publishing to 4 listeners or to the web server in ns, 0 to disable the check.
+ *
+ * @return If publishing is fast enough, it will return true otherwise false.
+ */
+bool runEventBusBenchmark(uint32_t iterations, double maxPublishNs)
+{
+    bool                isSuccess   = true;
+    double              publishNs   = 0.0;
+    double              webServerNs = 0.0;
+    CountingListener    counters[3];
+    FormattingListener  formatter;
+    EventBus&           bus         = EventBus::getInstance();
+    uint8_t             idx         = 0U;
+
+    printf("%-32s %10s\n", "case", "ns/op");
+
+    (void)runCase("string per poll", benchmarkStringPoll, iterations);
+    (void)runCase("string finish event", benchmarkStringFinish, iterations);
+    (void)runCase("publish, no listener", benchmarkPublish, iterations);
+
+    (void)bus.subscribe(counters[0U]);
+    (void)runCase("publish, 1 listener", benchmarkPublish, iterations);
+
+    (void)bus.subscribe(formatter);
+    (void)bus.subscribe(counters[1U]);
+    (void)bus.subscribe(counters[2U]);
+    publishNs = runCase("publish, 4 listeners, formatted", benchmarkPublish, iterations);
+
+    for (idx = 0U; idx < 3U; ++idx)
+    {
+        bus.unsubscribe(counters[idx]);
+        gSink = gSink + counters[idx].getCount();
+    }
+
+    bus.unsubscribe(formatter);
+    gSink = gSink + formatter.getLength();
+
+    webServerNs = benchmarkPublishWebServer(iterations);
+
+    if ((0.0 < maxPublishNs) &&
+        ((maxPublishNs < publishNs) || (maxPublishNs < webServerNs)))
+    {
+        printf("Publishing takes more than %.0f ns.\n", maxPublishNs);
+        isSuccess = false;
+    }
+
+    return isSuccess;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * The former sensor task, which created a empty string in every poll.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+static void benchmarkStringPoll(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        String outputMessage;
+
+        gSink = gSink + outputMessage.length();
+    }
+}
+
+/**
+ * The former finish event, which the competition formatted into a string.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+static void benchmarkStringFinish(uint32_t iterations)
+{
+    uint32_t idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        String outputMessage;
+
+        outputMessage = "EVT;FINISHED;";
+        outputMessage += (10000U + (idx & 0xffU));
+        outputMessage += ';';
+        outputMessage += static_cast<uint8_t>(idx & 0x07U);
+
+        gSink = gSink + outputMessage.length();
+    }
+}
+
+/**
+ * Publish finish events on the bus, with the listeners, which are registered.
+ *
+ * @param[in] iterations    Number of iterations.
+ */
+static void benchmarkPublish(uint32_t iterations)
+{
+    EventBus&   bus = EventBus::getInstance();
+    uint32_t    idx = 0U;
+
+    for (idx = 0U; idx < iterations; ++idx)
+    {
+        bus.publishRunFinished(static_cast<uint8_t>(idx & 0x07U), 10000U + (idx & 0xffU), 0U);
+    }
+}
+
+/**
+ * Publish finish events to the web server, the real listener, and print the
+ * cost per event. Only the publishing in the sensor task is measured. The
+ * queue of the web server is drained by its websocket task after every
+ * batch, which is not measured. The web server is not started, therefore it
+ * sends only to the UDP feed.
+ *
+ * @param[in] iterations    Number of events.
+ *
+ * @return Cost per event in ns.
+ */
+static double benchmarkPublishWebServer(uint32_t iterations)
+{
+    EventBus&           bus         = EventBus::getInstance();
+    Competition         competition;
+    LapTriggerWebServer webServer(competition);
+    uint32_t            idx         = 0U;
+    uint32_t            count       = 0U;
+    double              begin       = 0.0;
+    double              seconds     = 0.0;
+    double              ns          = 0.0;
+
+    while (idx < iterations)
+    {
+        begin = getHostSeconds();
+
+        for (count = 0U; (count < LapTriggerWebServer::EVENT_QUEUE_SIZE) && (idx < iterations); ++count)
+        {
+            bus.publishRunFinished(static_cast<uint8_t>(idx & 0x07U), 10000U + (idx & 0xffU), 0U);
+            ++idx;
+        }
+
+        seconds += getHostSeconds() - begin;
+
+        (void)webServer.handleWebSocket();
+    }
+
+    ns = (0U < iterations) ? ((seconds * 1e9) / iterations) : 0.0;
+
+    printf("%-32s %10.1f\n", "publish, web server listener", ns);
+
+    return ns;
+}
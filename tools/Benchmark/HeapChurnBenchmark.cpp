@@ -0,0 +1,261 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap churn of the runs and the websocket protocol on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Benchmark.h"
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <Board.h>
+#include <Settings.h>
+#include <LittleFS.h>
+#include <Competition.h>
+#include <LapTriggerWebServer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif  /* defined(__GLIBC__) */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Heap usage at a point in time. */
+typedef struct
+{
+    uint64_t    allocations;    /**< Number of allocations since the start. */
+    uint64_t    liveBlocks;     /**< Number of allocated blocks. */
+    uint64_t    liveBytes;      /**< Allocated bytes. */
+    uint64_t    freeBytes;      /**< Free bytes inside the heap of the host, the holes. */
+
+} HeapUsage;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void simulateRun(LapTriggerWebServer& webServer, uint32_t run);
+static void sendCommand(const char* cmd);
+static void getHeapUsage(HeapUsage& usage);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Client number, which sends the commands. */
+static const uint8_t        CLIENT_ID       = 0U;
+
+/** Number of runs, until the heap is considered in steady state. */
+static const uint32_t       WARM_UP_RUNS    = 100U;
+
+/** Number of measured runs. */
+static const uint32_t       RUNS            = 10000U;
+
+/** Min. lap time in ms of the simulated runs. */
+static const uint32_t       MIN_LAP_TIME    = 10000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Simulate runs with the competition and the web server and count the heap
+ * allocations. Every run is released, timed and read back via the websocket
+ * commands, like the operator page does. After the warm up, the heap shall
+ * be in steady state: no allocations and no new holes.
+ *
+ * The competition and the web server live only while the suite runs. The web
+ * server listens to the event bus, therefore it shall not be there while the
+ * other suites measure the event bus.
+ *
+ * @return If the heap is in steady state, it will return true otherwise false.
+ */
+bool runHeapChurnBenchmark()
+{
+    bool                        isSuccess   = true;
+    uint32_t                    run         = 0U;
+    HeapUsage                   begin;
+    HeapUsage                   end;
+    Competition                 competition;
+    LapTriggerWebServer         webServer(competition);
+
+    if (false == NativeHAL::isHeapCounted())
+    {
+        printf("The heap is not counted by the HAL.\n");
+        isSuccess = false;
+    }
+    else if ((false == Board::begin()) ||
+        (false == Settings::getInstance().begin()) ||
+        (false == LittleFS.begin()) ||
+        (false == competition.begin()) ||
+        (false == webServer.begin()))
+    {
+        printf("Failed to initialize the firmware.\n");
+        isSuccess = false;
+    }
+    else
+    {
+        /* Keep the changes in RAM, otherwise the EEPROM file is written on every run. */
+        Settings::getInstance().setDeferredWrite(true);
+
+        for (run = 0U; run < WARM_UP_RUNS; ++run)
+        {
+            simulateRun(webServer, run);
+        }
+
+        getHeapUsage(begin);
+
+        for (run = 0U; run < RUNS; ++run)
+        {
+            simulateRun(webServer, run);
+        }
+
+        getHeapUsage(end);
+
+        printf("%-32s %10u\n", "runs", static_cast<unsigned int>(RUNS));
+        printf("%-32s %10llu\n", "allocations", static_cast<unsigned long long>(end.allocations - begin.allocations));
+        printf("%-32s %10lld\n", "live blocks, change", static_cast<long long>(end.liveBlocks - begin.liveBlocks));
+        printf("%-32s %10lld\n", "live bytes, change", static_cast<long long>(end.liveBytes - begin.liveBytes));
+        printf("%-32s %10lld\n", "free bytes in heap, change", static_cast<long long>(end.freeBytes - begin.freeBytes));
+
+        if ((begin.allocations != end.allocations) ||
+            (begin.liveBlocks != end.liveBlocks))
+        {
+            printf("The heap is not in steady state.\n");
+            isSuccess = false;
+        }
+    }
+
+    return isSuccess;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Simulate a run like the operator page drives it: release a group, pass the
+ * start and the finish, let the web server send the changed table and read
+ * the results back.
+ *
+ * @param[in] webServer Web server, which handles the commands.
+ * @param[in] run       Run number, which selects the group and the lap time.
+ */
+static void simulateRun(LapTriggerWebServer& webServer, uint32_t run)
+{
+    uint8_t group   = static_cast<uint8_t>(run % 3U);
+    char    cmd[16U];
+
+    (void)snprintf(cmd, sizeof(cmd), "RELEASE;%u", static_cast<unsigned int>(group));
+    sendCommand(cmd);
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)webServer.handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+
+    NativeHAL::advanceTime(static_cast<uint64_t>(MIN_LAP_TIME + ((run * 37U) % 1000U)) * 1000U);
+
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+    (void)webServer.handleCompetition();
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    (void)webServer.handleCompetition();
+    (void)webServer.handleWebServer();
+
+    sendCommand("GET_TABLE");
+    (void)snprintf(cmd, sizeof(cmd), "GET_NAME;%u", static_cast<unsigned int>(group));
+    sendCommand(cmd);
+    (void)snprintf(cmd, sizeof(cmd), "GET_STATS;%u", static_cast<unsigned int>(group));
+    sendCommand(cmd);
+    sendCommand("GET_JOURNAL");
+}
+
+/**
+ * Send a command as text frame to the command dispatch.
+ *
+ * @param[in] cmd   Command
+ */
+static void sendCommand(const char* cmd)
+{
+    char    payload[32U];
+    size_t  length  = strlen(cmd);
+
+    /* The dispatch gets a writable frame, like from the websocket server. */
+    memcpy(payload, cmd, length + 1U);
+    (void)WebSocketsServer::injectEvent(CLIENT_ID, WStype_TEXT, reinterpret_cast<uint8_t*>(payload), length);
+}
+
+/**
+ * Get the heap usage. The free bytes inside the heap are the holes between
+ * the allocated blocks, which grow if the heap fragments.
+ *
+ * @param[out] usage    Heap usage
+ */
+static void getHeapUsage(HeapUsage& usage)
+{
+    NativeHAL::HeapUsage heapUsage;
+
+    NativeHAL::getHeapUsage(heapUsage);
+
+    usage.allocations   = heapUsage.allocations;
+    usage.liveBlocks    = heapUsage.liveBlocks;
+    usage.liveBytes     = heapUsage.liveBytes;
+
+#if defined(__GLIBC__) && ((2 < __GLIBC__) || ((2 == __GLIBC__) && (33 <= __GLIBC_MINOR__)))
+    usage.freeBytes     = mallinfo2().fordblks;
+#else
+    usage.freeBytes     = 0U;
+#endif
+}
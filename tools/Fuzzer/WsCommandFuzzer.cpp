@@ -0,0 +1,525 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fuzzer for the websocket command parser and the command dispatch
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <WebSocketsServer.h>
+#include <LittleFS.h>
+#include <Board.h>
+#include <Settings.h>
+#include <Competition.h>
+#include <Group.h>
+#include <LapTriggerWebServer.h>
+#include <Log.h>
+#include <vector>
+#include <time.h>
+#include <dirent.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/common_interface_defs.h>
+#endif  /* defined(__SANITIZE_ADDRESS__) */
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Input of a fuzzer run. */
+typedef std::vector<uint8_t> Input;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv);
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+#if defined(FUZZ_STANDALONE)
+
+static bool loadCorpus(const char* path, std::vector<Input>& corpus);
+static bool loadFile(const char* fileName, Input& input);
+static uint32_t getRandom();
+static void mutate(Input& input, const std::vector<Input>& corpus, size_t maxLength);
+#if defined(__SANITIZE_ADDRESS__)
+static void onDeath();
+#endif  /* defined(__SANITIZE_ADDRESS__) */
+static double getHostSeconds();
+
+#endif  /* defined(FUZZ_STANDALONE) */
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Client number, which sends the fuzzed commands. */
+static const uint8_t        CLIENT_ID   = 0U;
+
+/** Competition, which is controlled by the commands. */
+static Competition          gCompetition;
+
+/** Web server, which dispatches the commands. */
+static LapTriggerWebServer  gWebServer(gCompetition);
+
+#if defined(FUZZ_STANDALONE)
+
+/** Protocol tokens, which are inserted by the mutator. */
+static const char*          DICTIONARY[] =
+{
+    "RELEASE", "GET_GROUPS", "SET_GROUPS", "GET_TABLE", "CLEAR", "SET_NAME", "GET_NAME",
+    "CLEAR_NAME", "REJECT_RUN", "CONFIRM_RUN", "HOLD_SUSPICIOUS", "GET_METRICS", "GET_STATS", "BATCH",
+    "GET_BLIND_PERIOD", "SET_BLIND_PERIOD", "UNDO", "REDO", "GET_JOURNAL", ";", ":", "255", "256", "-1", "9", "10", "4294967296"
+};
+
+/** State of the random number generator. */
+static uint32_t             gRandomState    = 1U;
+
+/** Input of the current run, which is saved if the run crashes. */
+static const Input*         gCurrentInput   = nullptr;
+
+#endif  /* defined(FUZZ_STANDALONE) */
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Initialize the firmware parts, which are needed for the command dispatch.
+ * The ports are moved, to not collide with a running native firmware.
+ *
+ * @param[in] argc  Number of arguments, not used.
+ * @param[in] argv  Arguments, not used.
+ *
+ * @return 0
+ */
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+    static char arg0[]          = "fuzzer";
+    static char argPortOffset[] = "--port-offset";
+    static char portOffset[]    = "20000";
+    static char argEeprom[]     = "--eeprom";
+    static char eeprom[]        = "fuzz-eeprom.bin";
+    static char* args[]         = { arg0, argPortOffset, portOffset, argEeprom, eeprom, nullptr };
+
+    (void)argc;
+    (void)argv;
+
+    /* Every command is logged, which only costs time here. */
+    Log::setLevel(Log::LOG_FATAL);
+
+    if ((false == NativeHAL::begin(5, args)) ||
+        (false == Board::begin()) ||
+        (false == Settings::getInstance().begin()) ||
+        (false == LittleFS.begin()) ||
+        (false == gCompetition.begin()) ||
+        (false == gWebServer.begin()))
+    {
+        fprintf(stderr, "Failed to initialize the firmware.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Keep the changes in RAM, otherwise the EEPROM file is written on every run. */
+    Settings::getInstance().setDeferredWrite(true);
+
+    return 0;
+}
+
+/**
+ * Send the input as text frame to the command dispatch. The input is
+ * copied to a buffer of exactly its size, so the address sanitizer
+ * detects every read beyond the frame.
+ *
+ * @param[in] data  Input
+ * @param[in] size  Input size in byte.
+ *
+ * @return 0
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    uint8_t* payload = new uint8_t[size];
+
+    memcpy(payload, data, size);
+    (void)WebSocketsServer::injectEvent(CLIENT_ID, WStype_TEXT, payload, size);
+
+    delete[] payload;
+
+    return 0;
+}
+
+#if defined(FUZZ_STANDALONE)
+
+/**
+ * Entry point of the fuzzer without libFuzzer. It runs the seed corpus and
+ * random mutations of it. There is no coverage feedback, but it needs no
+ * clang and reports the executions per second the same way.
+ *
+ * Usage: fuzzer [--runs <n>] [--seed <n>] [--max-len <n>] [--min-exec-rate <n>] <corpus> ...
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Exit status, which is EXIT_FAILURE if the execution rate is too low.
+ */
+int main(int argc, char** argv)
+{
+    int                 status      = EXIT_SUCCESS;
+    std::vector<Input>  corpus;
+    uint32_t            runs        = 100000U;
+    size_t              maxLength   = 256U;
+    double              minExecRate = 0.0;
+    double              begin       = 0.0;
+    double              duration    = 0.0;
+    uint32_t            run         = 0U;
+    size_t              idx         = 0U;
+    int                 argIdx      = 0;
+
+    for (argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        const char* value = ((argIdx + 1) < argc) ? argv[argIdx + 1] : "0";
+
+        if (0 == strcmp(argv[argIdx], "--runs"))
+        {
+            runs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            ++argIdx;
+        }
+        else if (0 == strcmp(argv[argIdx], "--seed"))
+        {
+            gRandomState = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            ++argIdx;
+        }
+        else if (0 == strcmp(argv[argIdx], "--max-len"))
+        {
+            maxLength = static_cast<size_t>(strtoul(value, nullptr, 10));
+            ++argIdx;
+        }
+        else if (0 == strcmp(argv[argIdx], "--min-exec-rate"))
+        {
+            minExecRate = strtod(value, nullptr);
+            ++argIdx;
+        }
+        else if (false == loadCorpus(argv[argIdx], corpus))
+        {
+            status = EXIT_FAILURE;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    /* The generator state must never be 0. */
+    if (0U == gRandomState)
+    {
+        gRandomState = 1U;
+    }
+
+    if (EXIT_SUCCESS == status)
+    {
+        (void)LLVMFuzzerInitialize(&argc, &argv);
+
+#if defined(__SANITIZE_ADDRESS__)
+        __sanitizer_set_death_callback(onDeath);
+#endif  /* defined(__SANITIZE_ADDRESS__) */
+
+        if (true == corpus.empty())
+        {
+            corpus.push_back(Input());
+        }
+
+        begin = getHostSeconds();
+
+        for (idx = 0U; corpus.size() > idx; ++idx)
+        {
+            gCurrentInput = &corpus[idx];
+            (void)LLVMFuzzerTestOneInput(corpus[idx].data(), corpus[idx].size());
+        }
+
+        for (run = 0U; run < runs; ++run)
+        {
+            Input input = corpus[getRandom() % corpus.size()];
+
+            mutate(input, corpus, maxLength);
+
+            gCurrentInput = &input;
+            (void)LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+
+        gCurrentInput = nullptr;
+        duration = getHostSeconds() - begin;
+
+        printf("#%zu runs in %.3f s, %.0f exec/s\n",
+               runs + corpus.size(), duration,
+               (0.0 < duration) ? ((runs + corpus.size()) / duration) : 0.0);
+
+        if ((0.0 < duration) &&
+            (minExecRate > ((runs + corpus.size()) / duration)))
+        {
+            printf("Execution rate is below %.0f exec/s.\n", minExecRate);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+#endif  /* defined(FUZZ_STANDALONE) */
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#if defined(FUZZ_STANDALONE)
+
+/**
+ * Load a corpus file or all files of a corpus directory.
+ *
+ * @param[in]     path      File or directory.
+ * @param[in,out] corpus    Corpus
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadCorpus(const char* path, std::vector<Input>& corpus)
+{
+    bool    isSuccess   = true;
+    DIR*    dir         = opendir(path);
+
+    if (nullptr == dir)
+    {
+        Input input;
+
+        isSuccess = loadFile(path, input);
+
+        if (true == isSuccess)
+        {
+            corpus.push_back(input);
+        }
+    }
+    else
+    {
+        struct dirent* entry = readdir(dir);
+
+        while ((true == isSuccess) && (nullptr != entry))
+        {
+            if ('.' != entry->d_name[0])
+            {
+                String  fileName    = path;
+                Input   input;
+
+                fileName += '/';
+                fileName += entry->d_name;
+
+                isSuccess = loadFile(fileName.c_str(), input);
+
+                if (true == isSuccess)
+                {
+                    corpus.push_back(input);
+                }
+            }
+
+            entry = readdir(dir);
+        }
+
+        (void)closedir(dir);
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Load a file.
+ *
+ * @param[in]  fileName Name of the file.
+ * @param[out] input    File content
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadFile(const char* fileName, Input& input)
+{
+    bool    isSuccess   = true;
+    FILE*   file        = fopen(fileName, "rb");
+
+    if (nullptr == file)
+    {
+        perror(fileName);
+        isSuccess = false;
+    }
+    else
+    {
+        int value = fgetc(file);
+
+        while (EOF != value)
+        {
+            input.push_back(static_cast<uint8_t>(value));
+            value = fgetc(file);
+        }
+
+        (void)fclose(file);
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Get a random number (xorshift32).
+ *
+ * @return Random number
+ */
+static uint32_t getRandom()
+{
+    gRandomState ^= gRandomState << 13U;
+    gRandomState ^= gRandomState >> 17U;
+    gRandomState ^= gRandomState << 5U;
+
+    return gRandomState;
+}
+
+/**
+ * Mutate an input with 1 to 4 random mutations: flip a bit, insert a random
+ * byte or a protocol token, delete a range or splice with another input.
+ *
+ * @param[in,out] input     Input
+ * @param[in]     corpus    Corpus, which is used for splicing.
+ * @param[in]     maxLength Max. input length in byte.
+ */
+static void mutate(Input& input, const std::vector<Input>& corpus, size_t maxLength)
+{
+    uint32_t mutations = 1U + (getRandom() % 4U);
+
+    while (0U < mutations)
+    {
+        size_t pos = (true == input.empty()) ? 0U : (getRandom() % (input.size() + 1U));
+
+        switch (getRandom() % 5U)
+        {
+        case 0:
+            if (input.size() > pos)
+            {
+                input[pos] ^= static_cast<uint8_t>(1U << (getRandom() % 8U));
+            }
+            break;
+
+        case 1:
+            input.insert(input.begin() + pos, static_cast<uint8_t>(getRandom()));
+            break;
+
+        case 2:
+            {
+                const char* token = DICTIONARY[getRandom() % (sizeof(DICTIONARY) / sizeof(DICTIONARY[0]))];
+
+                input.insert(input.begin() + pos, token, token + strlen(token));
+            }
+            break;
+
+        case 3:
+            if (input.size() > pos)
+            {
+                input.erase(input.begin() + pos, input.begin() + pos + 1U + (getRandom() % (input.size() - pos)));
+            }
+            break;
+
+        default:
+            {
+                const Input& other = corpus[getRandom() % corpus.size()];
+
+                input.resize(pos);
+                input.insert(input.end(), other.begin() + (getRandom() % (other.size() + 1U)), other.end());
+            }
+            break;
+        }
+
+        --mutations;
+    }
+
+    if (maxLength < input.size())
+    {
+        input.resize(maxLength);
+    }
+}
+
+#if defined(__SANITIZE_ADDRESS__)
+
+/**
+ * Save the input, which crashed, like libFuzzer does.
+ */
+static void onDeath()
+{
+    if (nullptr != gCurrentInput)
+    {
+        FILE* file = fopen("crash-input", "wb");
+
+        if (nullptr != file)
+        {
+            (void)fwrite(gCurrentInput->data(), 1U, gCurrentInput->size(), file);
+            (void)fclose(file);
+
+            fprintf(stderr, "Crashing input saved to crash-input.\n");
+        }
+    }
+}
+
+#endif  /* defined(__SANITIZE_ADDRESS__) */
+
+/**
+ * Get the monotonic host time.
+ *
+ * @return Host time in s.
+ */
+static double getHostSeconds()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_nsec) / 1e9);
+}
+
+#endif  /* defined(FUZZ_STANDALONE) */
@@ -0,0 +1,478 @@
+#!/usr/bin/env python3
+"""WebSocket load generator for the RacingLapTimer.
+
+Opens operator clients, which send a mix of commands, and spectator clients,
+which only listen, against the native firmware or a device. It measures:
+
+- the command throughput and the ack latency (command sent until the
+  ACK/NACK received) per command,
+- the broadcast fan-out latency: a probe client sends a BATCH command
+  periodically, the server answers with the EVT;CHANGED broadcast and the
+  time until every client received it is measured,
+- the skew of the EVT;STARTED/EVT;FINISHED broadcasts between the clients,
+  if races run during the measurement.
+
+The results are written as JSON, which can be compared with the results of
+another firmware version by --compare.
+
+Note: SET_NAME and the BATCH probe store the group names in flash. On a
+device use a moderate rate and a short duration.
+
+Usage:
+    ws_load_generator.py --host 127.0.0.1 --port 8081 --operators 2 --spectators 3 -o results.json
+    ws_load_generator.py --host laptimer.local --mix GET_TABLE=80,RELEASE=20 --compare old.json
+"""
+
+import argparse
+import base64
+import json
+import os
+import random
+import selectors
+import socket
+import struct
+import sys
+import time
+
+WEBSOCKET_PORT = 81
+OPCODE_TEXT = 0x1
+OPCODE_CLOSE = 0x8
+OPCODE_PING = 0x9
+OPCODE_PONG = 0xA
+DEFAULT_MIX = "GET_TABLE=60,SET_NAME=15,RELEASE=25"
+PROBE_NAME = "LoadGen"
+COMMAND_TIMEOUT = 5.0  # s
+
+
+class WsClient:
+    """Minimal WebSocket client with a non-blocking receive path."""
+
+    def __init__(self, name, host, port, timeout):
+        self.name = name
+        self.sock = socket.create_connection((host, port), timeout=timeout)
+        self.rx_buffer = b""
+        self.is_open = True
+        self.pending = None  # (command, send time, expected table entries)
+        self.table_entries = 0
+        self.events = {}  # Event name -> list of receive times
+        self.handshake(host)
+        self.sock.setblocking(False)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    def handshake(self, host):
+        """Upgrade the HTTP connection to a WebSocket."""
+        key = base64.b64encode(os.urandom(16)).decode()
+        request = ("GET / HTTP/1.1\r\n"
+                   "Host: %s\r\n"
+                   "Upgrade: websocket\r\n"
+                   "Connection: Upgrade\r\n"
+                   "Sec-WebSocket-Key: %s\r\n"
+                   "Sec-WebSocket-Version: 13\r\n\r\n") % (host, key)
+        self.sock.sendall(request.encode())
+        response = b""
+
+        while b"\r\n\r\n" not in response:
+            data = self.sock.recv(1024)
+
+            if not data:
+                raise ConnectionError("Connection closed during handshake")
+
+            response += data
+
+        header, _, self.rx_buffer = response.partition(b"\r\n\r\n")
+
+        if b" 101 " not in header.split(b"\r\n")[0]:
+            raise ConnectionError("Handshake rejected: %s" % header.split(b"\r\n")[0].decode(errors="replace"))
+
+    def send_frame(self, opcode, payload):
+        """Send a masked frame, like every client must."""
+        mask = os.urandom(4)
+        length = len(payload)
+
+        if 126 > length:
+            header = struct.pack(">BB", 0x80 | opcode, 0x80 | length)
+        elif 65536 > length:
+            header = struct.pack(">BBH", 0x80 | opcode, 0x80 | 126, length)
+        else:
+            header = struct.pack(">BBQ", 0x80 | opcode, 0x80 | 127, length)
+
+        masked = bytes(byte ^ mask[idx % 4] for idx, byte in enumerate(payload))
+
+        self.sock.setblocking(True)
+        self.sock.sendall(header + mask + masked)
+        self.sock.setblocking(False)
+
+    def send_text(self, text):
+        """Send a text message."""
+        self.send_frame(OPCODE_TEXT, text.encode())
+
+    def receive(self):
+        """Read the available data. Returns a list of the received text messages."""
+        messages = []
+
+        try:
+            data = self.sock.recv(65536)
+
+            if not data:
+                self.is_open = False
+
+            self.rx_buffer += data
+        except BlockingIOError:
+            pass
+        except OSError:
+            self.is_open = False
+
+        while 2 <= len(self.rx_buffer):
+            opcode = self.rx_buffer[0] & 0x0F
+            length = self.rx_buffer[1] & 0x7F
+            offset = 2
+
+            if 126 == length:
+                if 4 > len(self.rx_buffer):
+                    break
+                length = struct.unpack_from(">H", self.rx_buffer, 2)[0]
+                offset = 4
+            elif 127 == length:
+                if 10 > len(self.rx_buffer):
+                    break
+                length = struct.unpack_from(">Q", self.rx_buffer, 2)[0]
+                offset = 10
+
+            # Frames from the server are never masked.
+            if (offset + length) > len(self.rx_buffer):
+                break
+
+            payload = self.rx_buffer[offset:offset + length]
+            self.rx_buffer = self.rx_buffer[offset + length:]
+
+            if OPCODE_TEXT == opcode:
+                messages.append(payload.decode(errors="replace"))
+            elif OPCODE_PING == opcode:
+                self.send_frame(OPCODE_PONG, payload)
+            elif OPCODE_CLOSE == opcode:
+                self.is_open = False
+
+        return messages
+
+    def close(self):
+        """Close the connection."""
+        try:
+            self.send_frame(OPCODE_CLOSE, b"")
+        except OSError:
+            pass
+
+        self.sock.close()
+
+
+def parse_mix(text):
+    """Parse the command mix, e.g. GET_TABLE=60,SET_NAME=15. Returns (commands, weights)."""
+    commands = []
+    weights = []
+
+    for item in text.split(","):
+        command, _, weight = item.partition("=")
+        command = command.strip().upper()
+
+        if command not in ("GET_TABLE", "SET_NAME", "RELEASE"):
+            raise ValueError("Unsupported command in mix: %s" % command)
+
+        commands.append(command)
+        weights.append(float(weight) if weight else 1.0)
+
+    return commands, weights
+
+
+def percentile(values, percent):
+    """Get the percentile of the values by the nearest rank method."""
+    result = None
+
+    if values:
+        ordered = sorted(values)
+        rank = max(1, int(-(-percent * len(ordered) // 100)))
+        result = ordered[rank - 1]
+
+    return result
+
+
+def summarize(values):
+    """Summary of latencies in s as dict in ms."""
+    summary = {"count": len(values)}
+
+    if values:
+        summary["mean_ms"] = round(1000.0 * sum(values) / len(values), 3)
+        summary["p50_ms"] = round(1000.0 * percentile(values, 50), 3)
+        summary["p99_ms"] = round(1000.0 * percentile(values, 99), 3)
+        summary["max_ms"] = round(1000.0 * max(values), 3)
+
+    return summary
+
+
+def build_command(command, rng, groups):
+    """Build the message of a command."""
+    group = rng.randrange(groups)
+    message = command
+
+    if "RELEASE" == command:
+        message = "RELEASE;%u" % group
+    elif "SET_NAME" == command:
+        message = "SET_NAME;%u:%s%u" % (group, PROBE_NAME, rng.randrange(100))
+
+    return message
+
+
+def handle_messages(client, messages, now, results):
+    """Evaluate the received messages of a client."""
+    for message in messages:
+        fields = message.split(";")
+
+        if "EVT" == fields[0] and (1 < len(fields)):
+            if "TABLE" == fields[1] and (0 < client.table_entries):
+                client.table_entries -= 1
+
+                # The table is complete with the last entry.
+                if (0 == client.table_entries) and (client.pending is not None):
+                    command, sent, _ = client.pending
+                    results["complete"].setdefault(command, []).append(now - sent)
+                    client.pending = None
+            else:
+                client.events.setdefault(fields[1], []).append(now)
+        elif (fields[0] in ("ACK", "NACK")) and (client.pending is not None):
+            command, sent, _ = client.pending
+            results["ack"].setdefault(command, []).append(now - sent)
+
+            if "NACK" == fields[0]:
+                results["nacked"] += 1
+
+            if ("ACK" == fields[0]) and ("GET_TABLE" == command) and (2 < len(fields)):
+                client.table_entries = int(fields[2])
+
+            if 0 == client.table_entries:
+                if "GET_TABLE" == command:
+                    results["complete"].setdefault(command, []).append(now - sent)
+                client.pending = None
+
+
+def run(args):
+    """Run the load. Returns the results as dict."""
+    rng = random.Random(args.seed)
+    commands, weights = parse_mix(args.mix)
+    selector = selectors.DefaultSelector()
+    clients = []
+    operators = []
+    connect_failures = 0
+
+    for idx in range(args.operators + args.spectators + 1):
+        if 0 == idx:
+            name = "probe"
+        elif args.operators >= idx:
+            name = "operator%u" % idx
+        else:
+            name = "spectator%u" % (idx - args.operators)
+
+        try:
+            client = WsClient(name, args.host, args.port, COMMAND_TIMEOUT)
+        except OSError as error:
+            print("%s: connect failed: %s" % (name, error), file=sys.stderr)
+            connect_failures += 1
+            continue
+
+        clients.append(client)
+        selector.register(client.sock, selectors.EVENT_READ, client)
+
+        if name.startswith("operator"):
+            operators.append(client)
+
+    results = {"ack": {}, "complete": {}, "nacked": 0, "timeouts": 0, "sent": 0}
+    fanout = []
+    fanout_missed = 0
+    probe = clients[0] if (clients and ("probe" == clients[0].name)) else None
+    probe_sent = None
+    probe_received = {}
+    next_probe = time.monotonic() + args.probe_interval
+    next_command = {client.name: time.monotonic() + rng.expovariate(args.rate) for client in operators}
+    start = time.monotonic()
+    end = start + args.duration
+
+    while time.monotonic() < end and any(client.is_open for client in clients):
+        now = time.monotonic()
+
+        for client in operators:
+            if not client.is_open:
+                continue
+
+            if (client.pending is not None) and (COMMAND_TIMEOUT < (now - client.pending[1])):
+                results["timeouts"] += 1
+                client.pending = None
+                client.table_entries = 0
+
+            if (client.pending is None) and (next_command[client.name] <= now):
+                command = rng.choices(commands, weights)[0]
+                client.pending = (command, now, 0)
+                client.send_text(build_command(command, rng, args.groups))
+                results["sent"] += 1
+                next_command[client.name] = now + rng.expovariate(args.rate)
+
+        # Only a single probe is in flight, because EVT;CHANGED carries no id.
+        if (probe is not None) and probe.is_open:
+            if (probe_sent is None) and (next_probe <= now):
+                probe_sent = now
+                probe_received = {}
+                probe.send_text("BATCH;SET_NAME:%u:%s" % (args.groups - 1, PROBE_NAME))
+            elif (probe_sent is not None) and (COMMAND_TIMEOUT < (now - probe_sent)):
+                fanout_missed += len([client for client in clients if client.name not in probe_received])
+                probe_sent = None
+                next_probe = now + args.probe_interval
+
+        for key, _ in selector.select(timeout=0.001):
+            client = key.data
+            received = time.monotonic()
+            messages = client.receive()
+            changed_before = len(client.events.get("CHANGED", []))
+
+            handle_messages(client, messages, received, results)
+
+            if (probe_sent is not None) and (changed_before < len(client.events.get("CHANGED", []))):
+                probe_received[client.name] = received - probe_sent
+
+                if len(probe_received) == len([client for client in clients if client.is_open]):
+                    fanout.append(max(probe_received.values()))
+                    probe_sent = None
+                    next_probe = received + args.probe_interval
+
+            if not client.is_open:
+                selector.unregister(client.sock)
+
+    elapsed = time.monotonic() - start
+
+    for client in clients:
+        client.close()
+
+    all_acks = [latency for latencies in results["ack"].values() for latency in latencies]
+    acked = len(all_acks)
+
+    return {
+        "label": args.label,
+        "target": "%s:%u" % (args.host, args.port),
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "config": {
+            "operators": args.operators,
+            "spectators": args.spectators,
+            "rate": args.rate,
+            "mix": args.mix,
+            "duration_s": args.duration,
+            "seed": args.seed
+        },
+        "connected": len(clients),
+        "connect_failures": connect_failures,
+        "elapsed_s": round(elapsed, 3),
+        "commands": {
+            "sent": results["sent"],
+            "acked": acked,
+            "nacked": results["nacked"],
+            "timeouts": results["timeouts"],
+            "throughput_per_s": round(acked / elapsed, 1) if 0 < elapsed else 0.0,
+            "ack_latency": summarize(all_acks),
+            "per_command": {command: summarize(latencies) for command, latencies in sorted(results["ack"].items())},
+            "table_complete_latency": summarize(results["complete"].get("GET_TABLE", []))
+        },
+        "fanout_latency": dict(summarize(fanout), missed=fanout_missed),
+        "event_skew": {name: summarize(skews) for name, skews in event_skews(clients).items()}
+    }
+
+
+def event_skews(clients):
+    """Skew of the race event broadcasts: the k-th event of every client belongs together."""
+    skews = {}
+
+    for name in ("STARTED", "FINISHED"):
+        series = [client.events.get(name, []) for client in clients]
+        count = min(len(times) for times in series) if series else 0
+
+        skews[name] = [max(times[idx] for times in series) - min(times[idx] for times in series)
+                       for idx in range(count)]
+
+    return skews
+
+
+def print_summary(result):
+    """Print a human readable summary."""
+    commands = result["commands"]
+
+    print("Target: %s, %u clients connected, %u failed" %
+          (result["target"], result["connected"], result["connect_failures"]))
+    print("Commands: %u sent, %u acked (%u NACK), %u timeouts, %.1f/s" %
+          (commands["sent"], commands["acked"], commands["nacked"], commands["timeouts"], commands["throughput_per_s"]))
+
+    for name, summary in [("ack latency", commands["ack_latency"])] + \
+                         sorted(commands["per_command"].items()) + \
+                         [("table complete", commands["table_complete_latency"]),
+                          ("fan-out", result["fanout_latency"])] + \
+                         sorted(("skew " + name, skew) for name, skew in result["event_skew"].items()):
+        if 0 < summary["count"]:
+            print("  %-16s n=%-6u p50 %8.3f ms  p99 %8.3f ms  max %8.3f ms" %
+                  (name, summary["count"], summary["p50_ms"], summary["p99_ms"], summary["max_ms"]))
+
+
+def compare(result, baseline):
+    """Print the change of the main figures compared to a baseline result."""
+    figures = [
+        ("throughput [1/s]", ["commands", "throughput_per_s"]),
+        ("ack p50 [ms]", ["commands", "ack_latency", "p50_ms"]),
+        ("ack p99 [ms]", ["commands", "ack_latency", "p99_ms"]),
+        ("fan-out p50 [ms]", ["fanout_latency", "p50_ms"]),
+        ("fan-out p99 [ms]", ["fanout_latency", "p99_ms"])
+    ]
+
+    print("Compared to %s:" % baseline.get("label", "baseline"))
+
+    for name, path in figures:
+        old = baseline
+        new = result
+
+        for key in path:
+            old = old.get(key, {}) if isinstance(old, dict) else None
+            new = new.get(key, {}) if isinstance(new, dict) else None
+
+        if isinstance(old, (int, float)) and isinstance(new, (int, float)):
+            change = ((new - old) * 100.0 / old) if 0 != old else 0.0
+            print("  %-18s %10.3f -> %10.3f (%+.1f %%)" % (name, old, new, change))
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="RacingLapTimer WebSocket load generator")
+    parser.add_argument("--host", default="127.0.0.1", help="Host of the native firmware or the device")
+    parser.add_argument("--port", type=int, default=WEBSOCKET_PORT, help="WebSocket port, native with --port-offset 8000: 8081")
+    parser.add_argument("--operators", type=int, default=1, help="Number of clients, which send commands")
+    parser.add_argument("--spectators", type=int, default=3, help="Number of clients, which only listen")
+    parser.add_argument("--rate", type=float, default=5.0, help="Commands per second and operator")
+    parser.add_argument("--mix", default=DEFAULT_MIX, help="Command mix with weights, default: " + DEFAULT_MIX)
+    parser.add_argument("--groups", type=int, default=2, help="Number of groups, which are used by the commands")
+    parser.add_argument("--duration", type=float, default=10.0, help="Duration in s")
+    parser.add_argument("--probe-interval", type=float, default=1.0, help="Interval of the fan-out probe in s")
+    parser.add_argument("--seed", type=int, default=1, help="Seed of the command sequence")
+    parser.add_argument("--label", default="", help="Label of the run, e.g. the firmware version")
+    parser.add_argument("-o", "--output", help="JSON result file")
+    parser.add_argument("--compare", help="JSON result file of a previous run")
+    args = parser.parse_args()
+
+    if (0 >= args.rate) or (0 >= args.groups):
+        parser.error("rate and groups must be positive")
+
+    result = run(args)
+    print_summary(result)
+
+    if args.output is not None:
+        with open(args.output, "w", encoding="utf-8") as file:
+            json.dump(result, file, indent=1)
+
+    if args.compare is not None:
+        with open(args.compare, encoding="utf-8") as file:
+            compare(result, json.load(file))
+
+    if (0 == result["connected"]) or (0 < result["commands"]["timeouts"]):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""Decoder for the RacingLapTimer tokenized log output.
+
+Firmware built with LOG_TOKENIZED sends only a token and the raw arguments
+of every log message, see lib/Common/LogToken.h. This tool rebuilds the
+readable text.
+
+Create the token database from the sources, once per firmware build:
+    log_decoder.py db lib src -o tokens.json
+
+Decode a captured serial stream or read it from stdin:
+    log_decoder.py decode --db tokens.json capture.bin
+    cat /dev/ttyUSB0 | log_decoder.py decode --db tokens.json
+
+Text, which is not part of a frame (e.g. the boot messages), is passed through.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+FRAME_START = 0xFE
+FRAME_HEAD_SIZE = 9  # Token, timestamp and level, after the length byte.
+
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+LEVELS = ["Info", "Warning", "Error", "Fatal"]
+
+# Log macro call with a format string, which may consist of several adjacent literals.
+LOG_CALL = re.compile(r'\bLOG_(INFO|WARNING|ERROR|FATAL)\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+STRING_LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+# printf conversion specification.
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcsfeEgGp%])")
+
+SOURCE_EXTENSIONS = (".c", ".cpp", ".h", ".hpp", ".ino")
+
+
+def fnv1a(data, value=FNV_OFFSET_BASIS):
+    """Continue the 32-bit FNV-1a hash with the given bytes."""
+    for byte in data:
+        value = ((value ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+
+def get_token(file_name, fmt):
+    """Calculate the token like LogToken::getToken() on the target."""
+    return fnv1a(fmt, fnv1a(file_name.encode() + b"|"))
+
+
+def unescape(literal):
+    """Convert the content of a C string literal to bytes."""
+    return literal.encode("latin-1").decode("unicode_escape").encode("latin-1")
+
+
+def scan_file(path, database):
+    """Add all log calls of a source file to the database. Returns the number of calls."""
+    file_name = os.path.basename(path)
+    calls = 0
+
+    with open(path, encoding="utf-8", errors="replace") as file:
+        content = file.read()
+
+    for match in LOG_CALL.finditer(content):
+        fmt = b"".join(unescape(part) for part in STRING_LITERAL.findall(match.group(2)))
+        token = "%08x" % get_token(file_name, fmt)
+        line = content.count("\n", 0, match.start()) + 1
+
+        if (token in database) and (database[token]["format"] != fmt.decode("latin-1")):
+            print("Token collision: %s:%u" % (path, line), file=sys.stderr)
+
+        database.setdefault(token, {
+            "file": file_name,
+            "line": line,
+            "format": fmt.decode("latin-1")
+        })
+        calls += 1
+
+    return calls
+
+
+def create_database(paths, output):
+    """Create the token database and report the flash, which is saved."""
+    database = {}
+    calls = 0
+    files = set()
+
+    for root_path in paths:
+        for root, _, names in os.walk(root_path):
+            for name in sorted(names):
+                if name.endswith(SOURCE_EXTENSIONS):
+                    found = scan_file(os.path.join(root, name), database)
+
+                    if 0 < found:
+                        files.add(name)
+                        calls += found
+
+    with open(output, "w", encoding="utf-8") as file:
+        json.dump(database, file, indent=4, sort_keys=True)
+
+    # Every unique format string and file name is no longer stored in flash.
+    format_bytes = sum(len(entry["format"]) + 1 for entry in database.values())
+    file_bytes = sum(len(name) + 1 for name in files)
+
+    print("%u log calls, %u tokens written to %s." % (calls, len(database), output))
+    print("Format strings no longer in flash: %u byte" % format_bytes)
+    print("File names no longer in flash: at least %u byte (without path)" % file_bytes)
+
+
+def decode_args(data):
+    """Decode the tagged arguments of a frame."""
+    args = []
+    idx = 0
+
+    while idx < len(data):
+        tag = chr(data[idx])
+        idx += 1
+
+        if "i" == tag:
+            args.append(struct.unpack_from("<i", data, idx)[0])
+            idx += 4
+        elif "u" == tag:
+            args.append(struct.unpack_from("<I", data, idx)[0])
+            idx += 4
+        elif "I" == tag:
+            args.append(struct.unpack_from("<q", data, idx)[0])
+            idx += 8
+        elif "U" == tag:
+            args.append(struct.unpack_from("<Q", data, idx)[0])
+            idx += 8
+        elif "f" == tag:
+            args.append(struct.unpack_from("<f", data, idx)[0])
+            idx += 4
+        elif "s" == tag:
+            length = data[idx]
+            args.append(data[idx + 1:idx + 1 + length].decode("latin-1"))
+            idx += 1 + length
+        else:
+            raise ValueError("Unknown argument tag: %r" % tag)
+
+    return args
+
+
+def format_message(fmt, args):
+    """Format the message like printf on the target."""
+    remaining = list(args)
+
+    def replace(match):
+        flags, _, conversion = match.groups()
+
+        if "%" == conversion:
+            return "%"
+        if 0 == len(remaining):
+            return "<missing>"
+
+        value = remaining.pop(0)
+
+        if conversion in "iu":
+            conversion = "d"
+        elif "p" == conversion:
+            conversion = "x"
+
+        try:
+            return ("%" + flags + conversion) % value
+        except (TypeError, ValueError):
+            return str(value)
+
+    return CONVERSION.sub(replace, fmt)
+
+
+def decode_frame(frame, database):
+    """Decode a single frame (without start and length byte) to a text line."""
+    token, timestamp, level = struct.unpack_from("<IIB", frame)
+    entry = database.get("%08x" % token)
+    level_str = LEVELS[level] if level < len(LEVELS) else "Unknown"
+
+    if entry is None:
+        return "%6u %24s (%5s) %7s <unknown token %08x>" % (timestamp, "?", "?", level_str, token)
+
+    try:
+        message = format_message(entry["format"], decode_args(frame[FRAME_HEAD_SIZE:]))
+    except (ValueError, struct.error, IndexError) as error:
+        message = "<%s> %s" % (error, entry["format"])
+
+    return "%6u %24s (%5u) %7s %s" % (timestamp, entry["file"], entry["line"], level_str, message)
+
+
+def decode_stream(stream, database):
+    """Decode a serial stream and print the text."""
+    buffer = bytearray()
+    read = getattr(stream, "read1", stream.read)  # Don't wait for a full chunk.
+
+    while True:
+        chunk = read(256)
+
+        if not chunk:
+            break
+
+        buffer += chunk
+
+        while 0 < len(buffer):
+            start = buffer.find(FRAME_START)
+
+            # Pass through text in front of a frame.
+            if 0 != start:
+                end = len(buffer) if 0 > start else start
+                sys.stdout.write(buffer[:end].decode("latin-1"))
+                del buffer[:end]
+                continue
+
+            if (2 > len(buffer)) or ((2 + buffer[1]) > len(buffer)):
+                break  # Incomplete frame, wait for more data.
+
+            length = buffer[1]
+
+            if FRAME_HEAD_SIZE > length:
+                del buffer[:1]  # Not a valid frame, resynchronize.
+                continue
+
+            print(decode_frame(bytes(buffer[2:2 + length]), database), flush=True)
+            del buffer[:2 + length]
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="RacingLapTimer tokenized log decoder")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    db_parser = commands.add_parser("db", help="Create the token database from the sources")
+    db_parser.add_argument("paths", nargs="+", help="Source directories, e.g. lib src")
+    db_parser.add_argument("-o", "--output", default="tokens.json", help="Token database")
+
+    decode_parser = commands.add_parser("decode", help="Decode a tokenized log stream")
+    decode_parser.add_argument("--db", default="tokens.json", help="Token database")
+    decode_parser.add_argument("input", nargs="?", help="Captured stream, default is stdin")
+
+    args = parser.parse_args()
+
+    if "db" == args.command:
+        create_database(args.paths, args.output)
+    else:
+        with open(args.db, encoding="utf-8") as file:
+            database = json.load(file)
+
+        try:
+            if args.input is None:
+                decode_stream(sys.stdin.buffer, database)
+            else:
+                with open(args.input, "rb") as stream:
+                    decode_stream(stream, database)
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
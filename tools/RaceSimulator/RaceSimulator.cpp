@@ -0,0 +1,1059 @@
+/* MIT License
+ *
+ * Copyright (c) 2020 - 2025 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Race simulator, which replays whole event days in virtual time
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <NativeHAL.h>
+#include <Competition.h>
+#include <EventBus.h>
+#include <Group.h>
+#include <Histogram.h>
+#include <Log.h>
+#include <time.h>
+#include <vector>
+#include <algorithm>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A race with fixed values, which is replayed as it is. */
+typedef struct
+{
+    uint32_t    lapTime;        /**< Lap time in us. */
+    uint32_t    pulseWidth;     /**< Time in us, the robot interrupts the sensor. */
+
+} Replay;
+
+/** Scenario, which describes the races of a simulation. */
+typedef struct
+{
+    uint32_t            races;              /**< Number of generated races. */
+    uint32_t            lapTimeMin;         /**< Min. lap time in us. */
+    uint32_t            lapTimeMax;         /**< Max. lap time in us. */
+    uint32_t            lapSpread;          /**< Max. deviation in % of a lap time from the group lap time, 0 if groups are not consistent. */
+    uint32_t            pulseWidthMin;      /**< Min. time in us, the robot interrupts the sensor. */
+    uint32_t            pulseWidthMax;      /**< Max. time in us, the robot interrupts the sensor. */
+    uint32_t            pauseMin;           /**< Min. time in us between release and start. */
+    uint32_t            pauseMax;           /**< Max. time in us between release and start. */
+    uint32_t            loopPeriod;         /**< Period in us, the sensor is sampled with. */
+    uint32_t            loopJitter;         /**< Max. deviation in us of the loop period. */
+    double              stallProbability;   /**< Probability of a loop stall at a sensor edge. */
+    uint32_t            stallDuration;      /**< Duration of a loop stall in us. */
+    double              noiseProbability;   /**< Probability of a noise pulse during a race. */
+    uint32_t            noiseWidth;         /**< Width of a noise pulse in us. */
+    uint32_t            noiseWindowMin;     /**< Min. time in us after the start, a noise pulse occurs. */
+    uint32_t            noiseWindowMax;     /**< Max. time in us after the start, a noise pulse occurs. 0 for the whole lap. */
+    double              minDetection;       /**< Min. percentage of flagged false finishes, negative if not checked. */
+    double              maxFalseAlarms;     /**< Max. percentage of flagged valid finishes, negative if not checked. */
+    uint32_t            blindPeriod;        /**< Blind period in ms, in adaptive mode the min. blind period. */
+    uint8_t             blindPeriodRatio;   /**< Blind period in % of the track record, 0 for a fixed blind period. */
+    uint32_t            tolerance;          /**< Max. lap time error in us, 0 derives it from the loop timing. */
+    uint64_t            startTime;          /**< Virtual time in us at start, to test the millis() wrap around. */
+    uint32_t            seed;               /**< Seed of the random number generator. */
+    std::vector<Replay> replays;            /**< Races, which are replayed as they are. */
+
+} Scenario;
+
+/** A pulse of the sensor signal. */
+typedef struct
+{
+    uint64_t    start;      /**< Rising edge in us. */
+    uint64_t    end;        /**< Falling edge in us. */
+    bool        isNoise;    /**< Is it noise (true) or the robot (false)? */
+    bool        isStalled;  /**< Is the loop stalled at the rising edge? */
+
+} Pulse;
+
+/** Result of a race. */
+typedef enum
+{
+    RESULT_OK = 0,          /**< Lap time measured within the tolerance. */
+    RESULT_TIMING_ERROR,    /**< Lap time error is out of tolerance. */
+    RESULT_MISSED_START,    /**< Start pulse was not detected. */
+    RESULT_MISSED_FINISH,   /**< Finish pulse was not detected. */
+    RESULT_FALSE_FINISH,    /**< A noise pulse finished the race. */
+    RESULT_FLAGGED_FINISH,  /**< A noise pulse finished the race, but it was flagged as suspicious. */
+    RESULT_PROTOCOL_ERROR,  /**< Competition state or event is wrong. */
+    RESULT_COUNT            /**< Number of results. */
+
+} Result;
+
+/** Report of a simulation. */
+typedef struct
+{
+    uint32_t    counters[RESULT_COUNT]; /**< Number of races per result. */
+    uint32_t    expectedMisses;         /**< Missed pulses, which were too short for the loop timing. */
+    uint32_t    falseAlarms;            /**< Valid finishes, which were flagged as suspicious. */
+    Histogram*  absErrors;              /**< Absolute lap time errors in us. */
+    int64_t     errorMin;               /**< Min. lap time error in us. */
+    int64_t     errorMax;               /**< Max. lap time error in us. */
+    int64_t     errorSum;               /**< Sum of the lap time errors in us. */
+    uint32_t    errorCount;             /**< Number of measured lap times. */
+
+} Report;
+
+/** Records the run events of the competition into the events of the current race. */
+class EventRecorder : public EventBus::Listener
+{
+public:
+
+    /**
+     * Constructs the recorder, which doesn't record yet.
+     */
+    EventRecorder() :
+        m_events(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the recorder.
+     */
+    ~EventRecorder()
+    {
+    }
+
+    /**
+     * Set the events, the run events are appended to.
+     *
+     * @param[in] events    Events of the current race or nullptr to stop recording.
+     */
+    void setEvents(std::vector<EventBus::Event>* events)
+    {
+        m_events = events;
+    }
+
+    /**
+     * Record a run event.
+     *
+     * @param[in] event Event
+     */
+    void onEvent(const EventBus::Event& event) override
+    {
+        if ((nullptr != m_events) &&
+            (EventBus::EVENT_TABLE_CHANGED != event.type))
+        {
+            m_events->push_back(event);
+        }
+    }
+
+private:
+
+    std::vector<EventBus::Event>*   m_events;   /**< Events of the current race. */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool loadScenario(const char* fileName, Scenario& scenario);
+static uint32_t getRandom();
+static uint32_t getRandom(uint32_t min, uint32_t max);
+static double getRandomProbability();
+static void advanceTo(uint64_t time);
+static void samplePulse(Competition& competition, const Scenario& scenario, const Pulse& pulse, uint64_t& tick, std::vector<EventBus::Event>& events, size_t& startEvent, size_t& finishEvent);
+static Result runRace(Competition& competition, const Scenario& scenario, uint8_t group, uint32_t lapTime, uint32_t startWidth, uint32_t finishWidth, Report& report);
+static void recover(Competition& competition);
+static bool runScenario(const char* fileName, uint32_t races, bool isVerbose);
+static void printReport(const char* fileName, const Report& report, double seconds);
+static bool getDetectionRate(const Report& report, double& rate);
+static double getFalseAlarmRate(const Report& report);
+static double getHostSeconds();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. number of groups, same as the firmware. */
+static const size_t     MAX_GROUPS          = Competition::MAX_GROUPS;
+
+/** Resolution of millis() in us, which adds to the lap time error. */
+static const uint32_t   MILLIS_RESOLUTION   = 1000U;
+
+/** Pulse width in us of a replayed race, if not given. */
+static const uint32_t   DEFAULT_PULSE_WIDTH = 50000U;
+
+/** Bucket bounds of the absolute lap time error in us. */
+static const uint32_t   ERROR_BOUNDS[]      = { 250U, 500U, 1000U, 2000U, 5000U, 10000U, 20000U, 50000U };
+
+/** Names of the results, in the order of Result. */
+static const char*      RESULT_NAMES[RESULT_COUNT] =
+{
+    "ok",
+    "timing error",
+    "missed start",
+    "missed finish",
+    "false finish",
+    "flagged finish",
+    "protocol error"
+};
+
+/** State of the random number generator. */
+static uint32_t         gRandomState        = 1U;
+
+/** Records the events of the race, which runs. */
+static EventRecorder    gEventRecorder;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Entry point of the race simulator.
+ *
+ * Usage: race_simulator [-v] [--races <n>] <scenario> [<scenario> ...]
+ *
+ * @param[in] argc  Number of arguments.
+ * @param[in] argv  Arguments.
+ *
+ * @return Exit status, which is EXIT_FAILURE if any race failed.
+ */
+int main(int argc, char** argv)
+{
+    int     status      = EXIT_SUCCESS;
+    bool    isVerbose   = false;
+    uint32_t races      = 0U;
+    int     idx         = 0;
+    int     scenarios   = 0;
+
+    /* The simulator drives the clock, the HAL options are not used. */
+    (void)NativeHAL::begin(1, argv);
+    NativeHAL::setVirtualTime(true);
+
+    /* Every release logs the active group, which only costs time here. */
+    Log::setLevel(Log::LOG_WARNING);
+
+    (void)EventBus::getInstance().subscribe(gEventRecorder);
+
+    for (idx = 1; idx < argc; ++idx)
+    {
+        if (0 == strcmp(argv[idx], "-v"))
+        {
+            isVerbose = true;
+        }
+        else if ((0 == strcmp(argv[idx], "--races")) && ((idx + 1) < argc))
+        {
+            ++idx;
+            races = static_cast<uint32_t>(strtoul(argv[idx], nullptr, 10));
+        }
+        else
+        {
+            ++scenarios;
+
+            if (false == runScenario(argv[idx], races, isVerbose))
+            {
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (0 == scenarios)
+    {
+        fprintf(stderr, "Usage: %s [-v] [--races <n>] <scenario> [<scenario> ...]\n", argv[0]);
+        status = EXIT_FAILURE;
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Load a scenario file. Every line is a key followed by its values, lines
+ * starting with '#' are comments:
+ *
+ * races <n>                        Number of generated races.
+ * lap_time_ms <min> <max>          Lap time range.
+ * lap_spread_percent <p>           Every group gets a lap time from the range and
+ *                                  deviates by max. p % from it per race.
+ * pulse_width_us <min> <max>       Time the robot interrupts the sensor.
+ * pause_ms <min> <max>             Time between release and start.
+ * loop_period_us <period>          Period the sensor is sampled with.
+ * loop_jitter_us <jitter>          Max. deviation of the loop period.
+ * stall <probability> <us>         Loop stall at a sensor edge.
+ * noise <probability> <us>         Noise pulse during a race.
+ * noise_window_ms <min> <max>      Time after the start, a noise pulse occurs. Default: whole lap.
+ * min_detection_percent <p>        Min. percentage of false finishes, which must be flagged.
+ * max_false_alarm_percent <p>      Max. percentage of valid finishes, which may be flagged.
+ * blind_period_ms <ms> [<percent>] Fixed blind period or with percent of the track record
+ *                                  an adaptive one, ms is then the minimum. Default: 400
+ * tolerance_us <us>                Max. lap time error, default derived from the loop timing.
+ * start_time_ms <ms>               Virtual time at start.
+ * seed <n>                         Seed of the random number generator.
+ * race <lap time ms> [<pulse us>]  Race, which is replayed as it is.
+ *
+ * @param[in]  fileName Name of the scenario file.
+ * @param[out] scenario Scenario
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadScenario(const char* fileName, Scenario& scenario)
+{
+    bool    isSuccess   = true;
+    FILE*   file        = fopen(fileName, "r");
+
+    scenario.races              = 0U;
+    scenario.lapTimeMin         = 5000000U;
+    scenario.lapTimeMax         = 30000000U;
+    scenario.lapSpread          = 0U;
+    scenario.pulseWidthMin      = 20000U;
+    scenario.pulseWidthMax      = 80000U;
+    scenario.pauseMin           = 500000U;
+    scenario.pauseMax           = 5000000U;
+    scenario.loopPeriod         = 1000U;
+    scenario.loopJitter         = 0U;
+    scenario.stallProbability   = 0.0;
+    scenario.stallDuration      = 0U;
+    scenario.noiseProbability   = 0.0;
+    scenario.noiseWidth         = 0U;
+    scenario.noiseWindowMin     = 0U;
+    scenario.noiseWindowMax     = 0U;
+    scenario.minDetection       = -1.0;
+    scenario.maxFalseAlarms     = -1.0;
+    scenario.blindPeriod        = 400U;
+    scenario.blindPeriodRatio   = 0U;
+    scenario.tolerance          = 0U;
+    scenario.startTime          = 0U;
+    scenario.seed               = 1U;
+    scenario.replays.clear();
+
+    if (nullptr == file)
+    {
+        perror(fileName);
+        isSuccess = false;
+    }
+    else
+    {
+        char    line[128];
+        size_t  lineNumber = 0U;
+
+        while ((true == isSuccess) && (nullptr != fgets(line, sizeof(line), file)))
+        {
+            char                key[32];
+            double              value1  = 0.0;
+            double              value2  = 0.0;
+            int                 fields  = 0;
+
+            ++lineNumber;
+
+            fields = sscanf(line, "%31s %lf %lf", key, &value1, &value2);
+
+            if ((0 >= fields) || ('#' == key[0]))
+            {
+                continue;
+            }
+            else if ((0 == strcmp(key, "races")) && (2 <= fields))
+            {
+                scenario.races = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "lap_time_ms")) && (3 == fields) && (value1 <= value2))
+            {
+                scenario.lapTimeMin = static_cast<uint32_t>(value1 * 1000.0);
+                scenario.lapTimeMax = static_cast<uint32_t>(value2 * 1000.0);
+            }
+            else if ((0 == strcmp(key, "lap_spread_percent")) && (2 <= fields) && (100.0 > value1))
+            {
+                scenario.lapSpread = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "pulse_width_us")) && (3 == fields) && (value1 <= value2))
+            {
+                scenario.pulseWidthMin = static_cast<uint32_t>(value1);
+                scenario.pulseWidthMax = static_cast<uint32_t>(value2);
+            }
+            else if ((0 == strcmp(key, "pause_ms")) && (3 == fields) && (value1 <= value2))
+            {
+                scenario.pauseMin = static_cast<uint32_t>(value1 * 1000.0);
+                scenario.pauseMax = static_cast<uint32_t>(value2 * 1000.0);
+            }
+            else if ((0 == strcmp(key, "loop_period_us")) && (2 <= fields) && (0.0 < value1))
+            {
+                scenario.loopPeriod = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "loop_jitter_us")) && (2 <= fields))
+            {
+                scenario.loopJitter = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "stall")) && (3 == fields))
+            {
+                scenario.stallProbability   = value1;
+                scenario.stallDuration      = static_cast<uint32_t>(value2);
+            }
+            else if ((0 == strcmp(key, "noise")) && (3 == fields))
+            {
+                scenario.noiseProbability   = value1;
+                scenario.noiseWidth         = static_cast<uint32_t>(value2);
+            }
+            else if ((0 == strcmp(key, "noise_window_ms")) && (3 == fields) && (value1 < value2))
+            {
+                scenario.noiseWindowMin = static_cast<uint32_t>(value1 * 1000.0);
+                scenario.noiseWindowMax = static_cast<uint32_t>(value2 * 1000.0);
+            }
+            else if ((0 == strcmp(key, "min_detection_percent")) && (2 <= fields))
+            {
+                scenario.minDetection = value1;
+            }
+            else if ((0 == strcmp(key, "max_false_alarm_percent")) && (2 <= fields))
+            {
+                scenario.maxFalseAlarms = value1;
+            }
+            else if ((0 == strcmp(key, "blind_period_ms")) && (2 <= fields) && ((2 == fields) || (100.0 > value2)))
+            {
+                scenario.blindPeriod        = static_cast<uint32_t>(value1);
+                scenario.blindPeriodRatio   = (3 == fields) ? static_cast<uint8_t>(value2) : 0U;
+            }
+            else if ((0 == strcmp(key, "tolerance_us")) && (2 <= fields))
+            {
+                scenario.tolerance = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "start_time_ms")) && (2 <= fields))
+            {
+                scenario.startTime = static_cast<uint64_t>(value1) * 1000U;
+            }
+            else if ((0 == strcmp(key, "seed")) && (2 <= fields))
+            {
+                scenario.seed = static_cast<uint32_t>(value1);
+            }
+            else if ((0 == strcmp(key, "race")) && (2 <= fields))
+            {
+                Replay replay;
+
+                replay.lapTime      = static_cast<uint32_t>(value1 * 1000.0);
+                replay.pulseWidth   = (3 == fields) ? static_cast<uint32_t>(value2) : DEFAULT_PULSE_WIDTH;
+
+                scenario.replays.push_back(replay);
+            }
+            else
+            {
+                fprintf(stderr, "%s:%zu: Invalid line.\n", fileName, lineNumber);
+                isSuccess = false;
+            }
+        }
+
+        (void)fclose(file);
+    }
+
+    /* The generator state must never be 0. */
+    if (0U == scenario.seed)
+    {
+        scenario.seed = 1U;
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Get a random number (xorshift32). It is used instead of the standard
+ * library, because its distributions differ between implementations and
+ * a scenario shall produce the same races everywhere.
+ *
+ * @return Random number
+ */
+static uint32_t getRandom()
+{
+    gRandomState ^= gRandomState << 13U;
+    gRandomState ^= gRandomState >> 17U;
+    gRandomState ^= gRandomState << 5U;
+
+    return gRandomState;
+}
+
+/**
+ * Get a random number in a range.
+ *
+ * @param[in] min   Min. value
+ * @param[in] max   Max. value, including.
+ *
+ * @return Random number
+ */
+static uint32_t getRandom(uint32_t min, uint32_t max)
+{
+    uint32_t value = min;
+
+    if (min < max)
+    {
+        value = min + static_cast<uint32_t>(getRandom() % (static_cast<uint64_t>(max - min) + 1U));
+    }
+
+    return value;
+}
+
+/**
+ * Get a random probability.
+ *
+ * @return Probability in the range [0; 1).
+ */
+static double getRandomProbability()
+{
+    return static_cast<double>(getRandom()) / 4294967296.0;
+}
+
+/**
+ * Advance the virtual time. Time never goes backwards.
+ *
+ * @param[in] time  Virtual time in us.
+ */
+static void advanceTo(uint64_t time)
+{
+    uint64_t now = NativeHAL::getTime();
+
+    if (time > now)
+    {
+        NativeHAL::advanceTime(time - now);
+    }
+}
+
+/**
+ * Sample a sensor pulse with the loop timing. Between the pulses nothing
+ * can change in the competition, therefore the loop is only simulated
+ * while the sensor is interrupted. The phase of the first loop cycle is
+ * random, which is what a long series of jittered loop periods results in.
+ *
+ * @param[in]     competition   Competition
+ * @param[in]     scenario      Scenario
+ * @param[in]     pulse         Pulse
+ * @param[in,out] tick          Virtual time in us of the next loop cycle.
+ * @param[in,out] events        Run events of the competition.
+ * @param[in,out] startEvent    Index of the pulse, which started the race.
+ * @param[in,out] finishEvent   Index of the pulse, which finished the race.
+ */
+static void samplePulse(Competition& competition, const Scenario& scenario, const Pulse& pulse, uint64_t& tick, std::vector<EventBus::Event>& events, size_t& startEvent, size_t& finishEvent)
+{
+    uint64_t first = pulse.start + getRandom(0U, scenario.loopPeriod - 1U);
+
+    if (true == pulse.isStalled)
+    {
+        first += scenario.stallDuration;
+    }
+
+    tick = std::max(tick, first);
+
+    advanceTo(pulse.start);
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+
+    while (pulse.end > tick)
+    {
+        size_t eventCount = events.size();
+
+        advanceTo(tick);
+
+        if ((true == competition.handleCompetition()) &&
+            (eventCount < events.size()))
+        {
+            if (EventBus::EVENT_RUN_STARTED == events[eventCount].type)
+            {
+                startEvent = eventCount;
+            }
+            else
+            {
+                finishEvent = eventCount;
+            }
+        }
+
+        tick += getRandom(scenario.loopPeriod - std::min(scenario.loopPeriod - 1U, scenario.loopJitter),
+                          scenario.loopPeriod + scenario.loopJitter);
+    }
+
+    advanceTo(pulse.end);
+    NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+}
+
+/**
+ * Run a single race.
+ *
+ * @param[in]     competition   Competition
+ * @param[in]     scenario      Scenario
+ * @param[in]     group         Group, which is released for the race.
+ * @param[in]     lapTime       Ground truth lap time in us.
+ * @param[in]     startWidth    Width of the start pulse in us.
+ * @param[in]     finishWidth   Width of the finish pulse in us.
+ * @param[in,out] report        Report
+ *
+ * @return Result of the race.
+ */
+static Result runRace(Competition& competition, const Scenario& scenario, uint8_t group, uint32_t lapTime, uint32_t startWidth, uint32_t finishWidth, Report& report)
+{
+    Result              result      = RESULT_OK;
+    std::vector<Pulse>  pulses;
+    std::vector<EventBus::Event> events;
+    Pulse               pulse;
+    uint64_t            start       = 0U;
+    uint64_t            tick        = 0U;
+    size_t              idx         = 0U;
+    const size_t        NONE        = static_cast<size_t>(-1);
+    size_t              startEvent  = NONE;
+    size_t              finishEvent = NONE;
+    size_t              startPulse  = NONE;
+    size_t              finishPulse = NONE;
+    uint32_t            maxGap      = scenario.loopPeriod + scenario.loopJitter;
+    uint32_t            noiseFrom   = startWidth;
+    uint32_t            noiseTo     = lapTime;
+
+    if (0U < scenario.noiseWindowMax)
+    {
+        noiseFrom   = std::max(noiseFrom, scenario.noiseWindowMin);
+        noiseTo     = std::min(noiseTo, scenario.noiseWindowMax);
+    }
+
+    if (false == competition.setReleasedState(group))
+    {
+        result = RESULT_PROTOCOL_ERROR;
+    }
+
+    gEventRecorder.setEvents(&events);
+
+    start = NativeHAL::getTime() + getRandom(scenario.pauseMin, scenario.pauseMax);
+
+    pulse.start     = start;
+    pulse.end       = start + startWidth;
+    pulse.isNoise   = false;
+    pulse.isStalled = (scenario.stallProbability > getRandomProbability());
+    pulses.push_back(pulse);
+
+    pulse.start     = start + lapTime;
+    pulse.end       = pulse.start + finishWidth;
+    pulse.isStalled = (scenario.stallProbability > getRandomProbability());
+    pulses.push_back(pulse);
+
+    if ((scenario.noiseProbability > getRandomProbability()) &&
+        (noiseFrom < noiseTo))
+    {
+        pulse.start     = start + getRandom(noiseFrom, noiseTo);
+        pulse.end       = std::min(pulse.start + scenario.noiseWidth, start + lapTime);
+        pulse.isNoise   = true;
+        pulse.isStalled = false;
+
+        if (pulse.start < pulse.end)
+        {
+            pulses.insert(pulses.begin() + 1, pulse);
+        }
+    }
+
+    for (idx = 0U; pulses.size() > idx; ++idx)
+    {
+        size_t eventCount = events.size();
+
+        samplePulse(competition, scenario, pulses[idx], tick, events, startEvent, finishEvent);
+
+        if ((NONE != startEvent) && (NONE == startPulse))
+        {
+            startPulse = idx;
+        }
+
+        if ((NONE != finishEvent) && (NONE == finishPulse))
+        {
+            finishPulse = idx;
+        }
+
+        /* A miss of a pulse, which the loop can't sample reliably, is expected. */
+        if ((eventCount == events.size()) &&
+            (false == pulses[idx].isNoise) &&
+            ((pulses[idx].end - pulses[idx].start) < (maxGap + (pulses[idx].isStalled ? scenario.stallDuration : 0U))))
+        {
+            ++report.expectedMisses;
+        }
+    }
+
+    if (RESULT_PROTOCOL_ERROR == result)
+    {
+        /* Release failed, nothing to evaluate. */
+        ;
+    }
+    else if ((NONE == startPulse) || (true == pulses[startPulse].isNoise))
+    {
+        result = RESULT_MISSED_START;
+    }
+    else if (NONE == finishPulse)
+    {
+        result = RESULT_MISSED_FINISH;
+    }
+    else if (true == pulses[finishPulse].isNoise)
+    {
+        /* The operator rejects a flagged run, an unnoticed one stays in the results. */
+        if (true == competition.isRunSuspicious())
+        {
+            result = RESULT_FLAGGED_FINISH;
+            (void)competition.rejectRun();
+        }
+        else
+        {
+            result = RESULT_FALSE_FINISH;
+        }
+    }
+    else
+    {
+        /* The event carries the lap time and group, it must match the competition. */
+        const EventBus::Event& event = events[finishEvent];
+        uint8_t         flags       = 0U;
+        uint32_t        measured    = competition.getRunLapTime();
+        int64_t         error       = (static_cast<int64_t>(measured) * MILLIS_RESOLUTION) - lapTime;
+        int64_t         minError    = -static_cast<int64_t>(maxGap + MILLIS_RESOLUTION);
+        int64_t         maxError    = maxGap + MILLIS_RESOLUTION;
+
+        if (true == competition.isRunSuspicious())
+        {
+            flags = EventBus::FLAG_SUSPICIOUS;
+            ++report.falseAlarms;
+        }
+
+        if (true == pulses[startPulse].isStalled)
+        {
+            minError -= scenario.stallDuration;
+        }
+
+        if (true == pulses[finishPulse].isStalled)
+        {
+            maxError += scenario.stallDuration;
+        }
+
+        if (0U < scenario.tolerance)
+        {
+            minError = -static_cast<int64_t>(scenario.tolerance);
+            maxError = scenario.tolerance;
+        }
+
+        if ((measured != event.lapTime) ||
+            (group != event.group) ||
+            (flags != event.flags) ||
+            (Competition::COMPETITION_STATE_FINISHED != competition.getState()))
+        {
+            result = RESULT_PROTOCOL_ERROR;
+        }
+        else if ((minError > error) || (maxError < error))
+        {
+            result = RESULT_TIMING_ERROR;
+        }
+        else
+        {
+            ;
+        }
+
+        report.absErrors->record(static_cast<uint32_t>((0 > error) ? -error : error));
+        report.errorMin = std::min(report.errorMin, error);
+        report.errorMax = std::max(report.errorMax, error);
+        report.errorSum += error;
+        ++report.errorCount;
+    }
+
+    gEventRecorder.setEvents(nullptr);
+    recover(competition);
+
+    return result;
+}
+
+/**
+ * Bring the competition back to a state, which can be released. A race,
+ * which missed its finish, is finished by a late pulse.
+ *
+ * @param[in] competition   Competition
+ */
+static void recover(Competition& competition)
+{
+    if (Competition::COMPETITION_STATE_STARTED == competition.getState())
+    {
+        advanceTo(NativeHAL::getTime() + 1000000U);
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, HIGH);
+        (void)competition.handleCompetition();
+        NativeHAL::setPin(NativeHAL::SENSOR_PIN, LOW);
+    }
+}
+
+/**
+ * Run all races of a scenario.
+ *
+ * @param[in] fileName  Name of the scenario file.
+ * @param[in] races     Number of generated races, 0 uses the scenario value.
+ * @param[in] isVerbose Print every failed race?
+ *
+ * @return If all races passed, it will return true otherwise false.
+ */
+static bool runScenario(const char* fileName, uint32_t races, bool isVerbose)
+{
+    bool        isSuccess       = true;
+    Scenario    scenario;
+    Competition competition;
+    Histogram   absErrors(ERROR_BOUNDS, sizeof(ERROR_BOUNDS) / sizeof(ERROR_BOUNDS[0]));
+    Report      report;
+    double      begin           = 0.0;
+    double      detectionRate   = 0.0;
+    uint32_t    race            = 0U;
+    uint32_t    count           = 0U;
+    uint32_t    groupLapTimes[MAX_GROUPS];
+
+    memset(report.counters, 0, sizeof(report.counters));
+    report.expectedMisses   = 0U;
+    report.falseAlarms      = 0U;
+    report.absErrors        = &absErrors;
+    report.errorMin         = INT64_MAX;
+    report.errorMax         = INT64_MIN;
+    report.errorSum         = 0;
+    report.errorCount       = 0U;
+
+    if (false == loadScenario(fileName, scenario))
+    {
+        isSuccess = false;
+    }
+    else if (false == competition.setBlindPeriod(scenario.blindPeriod, scenario.blindPeriodRatio))
+    {
+        fprintf(stderr, "%s: Invalid blind period.\n", fileName);
+        isSuccess = false;
+    }
+    /* All groups of the build take part. */
+    else if (false == competition.setNumberofGroups(MAX_GROUPS))
+    {
+        fprintf(stderr, "%s: Invalid number of groups.\n", fileName);
+        isSuccess = false;
+    }
+    else
+    {
+        gRandomState = scenario.seed;
+        count = (0U < races) ? races : (scenario.races + scenario.replays.size());
+
+        /* Consistent groups drive around their own lap time. */
+        if (0U < scenario.lapSpread)
+        {
+            for (race = 0U; race < MAX_GROUPS; ++race)
+            {
+                groupLapTimes[race] = getRandom(scenario.lapTimeMin, scenario.lapTimeMax);
+            }
+        }
+
+        advanceTo(scenario.startTime);
+        begin = getHostSeconds();
+
+        for (race = 0U; race < count; ++race)
+        {
+            /* Groups take turns, like at a event. */
+            uint8_t     group       = static_cast<uint8_t>(race % MAX_GROUPS);
+            uint32_t    lapTime     = 0U;
+            uint32_t    startWidth  = 0U;
+            uint32_t    finishWidth = 0U;
+            Result      result      = RESULT_OK;
+
+            if (race < scenario.replays.size())
+            {
+                lapTime     = scenario.replays[race].lapTime;
+                startWidth  = scenario.replays[race].pulseWidth;
+                finishWidth = scenario.replays[race].pulseWidth;
+            }
+            else if (0U < scenario.lapSpread)
+            {
+                uint32_t deviation = static_cast<uint32_t>((static_cast<uint64_t>(groupLapTimes[group]) * scenario.lapSpread) / 100U);
+
+                lapTime     = getRandom(groupLapTimes[group] - deviation, groupLapTimes[group] + deviation);
+                startWidth  = getRandom(scenario.pulseWidthMin, scenario.pulseWidthMax);
+                finishWidth = getRandom(scenario.pulseWidthMin, scenario.pulseWidthMax);
+            }
+            else
+            {
+                lapTime     = getRandom(scenario.lapTimeMin, scenario.lapTimeMax);
+                startWidth  = getRandom(scenario.pulseWidthMin, scenario.pulseWidthMax);
+                finishWidth = getRandom(scenario.pulseWidthMin, scenario.pulseWidthMax);
+            }
+
+            result = runRace(competition, scenario, group, lapTime, startWidth, finishWidth, report);
+            ++report.counters[result];
+
+            if ((true == isVerbose) && (RESULT_OK != result))
+            {
+                printf("%s: race %u: %s (lap time %u us, pulses %u/%u us, measured %u ms)\n",
+                       fileName, race, RESULT_NAMES[result], lapTime, startWidth, finishWidth,
+                       competition.getRunLapTime());
+            }
+        }
+
+        printReport(fileName, report, getHostSeconds() - begin);
+
+        /* Timing and protocol errors are always failures, misses only if the pulse was long enough. */
+        if ((0U < report.counters[RESULT_TIMING_ERROR]) ||
+            (0U < report.counters[RESULT_PROTOCOL_ERROR]) ||
+            ((report.counters[RESULT_MISSED_START] + report.counters[RESULT_MISSED_FINISH]) > report.expectedMisses))
+        {
+            isSuccess = false;
+        }
+        /* The false finish detection is only checked, if the scenario requires it and false finishes happened. */
+        else if ((0.0 <= scenario.minDetection) &&
+                 (true == getDetectionRate(report, detectionRate)) &&
+                 (scenario.minDetection > detectionRate))
+        {
+            isSuccess = false;
+        }
+        else if ((0.0 <= scenario.maxFalseAlarms) &&
+                 (scenario.maxFalseAlarms < getFalseAlarmRate(report)))
+        {
+            isSuccess = false;
+        }
+        else
+        {
+            ;
+        }
+
+        printf("Result: %s\n\n", (true == isSuccess) ? "PASSED" : "FAILED");
+    }
+
+    return isSuccess;
+}
+
+/**
+ * Print the report of a scenario.
+ *
+ * @param[in] fileName  Name of the scenario file.
+ * @param[in] report    Report
+ * @param[in] seconds   Host time in s, the simulation took.
+ */
+static void printReport(const char* fileName, const Report& report, double seconds)
+{
+    uint32_t    races           = 0U;
+    uint8_t     idx             = 0U;
+    double      detectionRate   = 0.0;
+
+    for (idx = 0U; RESULT_COUNT > idx; ++idx)
+    {
+        races += report.counters[idx];
+    }
+
+    printf("Scenario: %s\n", fileName);
+    printf("Races: %u in %.3f s (%.0f races/s)\n", races, seconds, (0.0 < seconds) ? (races / seconds) : 0.0);
+
+    for (idx = 0U; RESULT_COUNT > idx; ++idx)
+    {
+        printf("  %-15s %u\n", RESULT_NAMES[idx], report.counters[idx]);
+    }
+
+    printf("  %-15s %u\n", "expected misses", report.expectedMisses);
+    if (true == getDetectionRate(report, detectionRate))
+    {
+        printf("False finishes flagged: %.1f %%", detectionRate);
+    }
+    else
+    {
+        printf("False finishes flagged: n/a");
+    }
+
+    printf(", valid finishes flagged: %u (%.2f %%)\n", report.falseAlarms, getFalseAlarmRate(report));
+
+    if (0U < report.errorCount)
+    {
+        printf("Lap time error [us]: min %lld, mean %.1f, max %lld, p50 <= %u, p99 <= %u\n",
+               static_cast<long long>(report.errorMin),
+               static_cast<double>(report.errorSum) / report.errorCount,
+               static_cast<long long>(report.errorMax),
+               report.absErrors->getPercentileBound(50U),
+               report.absErrors->getPercentileBound(99U));
+        printf("Absolute lap time error distribution:\n");
+
+        for (idx = 0U; report.absErrors->getBucketCount() > idx; ++idx)
+        {
+            uint32_t bound = report.absErrors->getBound(idx);
+
+            if (UINT32_MAX == bound)
+            {
+                printf("  > %8u us: %u\n", report.absErrors->getBound(idx - 1U), report.absErrors->getBucketCounter(idx));
+            }
+            else
+            {
+                printf("  <= %7u us: %u\n", bound, report.absErrors->getBucketCounter(idx));
+            }
+        }
+    }
+}
+
+/**
+ * Get the percentage of false finishes, which were flagged as suspicious.
+ *
+ * @param[in]  report   Report
+ * @param[out] rate     Percentage
+ *
+ * @return If there was a false finish, it will return true otherwise false.
+ */
+static bool getDetectionRate(const Report& report, double& rate)
+{
+    bool        isAvailable = false;
+    uint32_t    flagged     = report.counters[RESULT_FLAGGED_FINISH];
+    uint32_t    all         = flagged + report.counters[RESULT_FALSE_FINISH];
+
+    if (0U < all)
+    {
+        rate        = (100.0 * flagged) / all;
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+/**
+ * Get the percentage of valid finishes, which were flagged as suspicious.
+ *
+ * @param[in] report    Report
+ *
+ * @return Percentage
+ */
+static double getFalseAlarmRate(const Report& report)
+{
+    return (0U < report.errorCount) ? ((100.0 * report.falseAlarms) / report.errorCount) : 0.0;
+}
+
+/**
+ * Get the monotonic host time.
+ *
+ * @return Host time in s.
+ */
+static double getHostSeconds()
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_nsec) / 1e9);
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Converter for the RacingLapTimer trace timeline to the Chrome trace format.
+
+The firmware records begin, end and instant events into a ring buffer and
+provides them at http://<device>/trace. This tool converts them to the
+JSON format, which can be loaded in chrome://tracing (about:tracing) or
+https://ui.perfetto.dev.
+
+Usage:
+    trace_to_chrome.py --url http://laptimer.local/trace -o trace.json
+    trace_to_chrome.py trace.txt -o trace.json
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+
+TIMESTAMP_RANGE = 1 << 32  # The timestamp in us is 32-bit and wraps around.
+
+PHASES = {
+    "B": "B",
+    "E": "E",
+    "I": "i"
+}
+
+
+def parse(lines):
+    """Parse the trace lines. Returns a list of (timestamp, phase, name, arg)."""
+    events = []
+    offset = 0
+    last_timestamp = None
+
+    for line in lines:
+        line = line.strip()
+
+        if (0 == len(line)) or line.startswith("#"):
+            continue
+
+        fields = line.split()
+
+        if 4 != len(fields):
+            print("Invalid line: %s" % line, file=sys.stderr)
+            continue
+
+        timestamp = int(fields[0])
+
+        # The events are in chronological order, a smaller timestamp means a wrap around.
+        if (last_timestamp is not None) and (timestamp < last_timestamp):
+            offset += TIMESTAMP_RANGE
+
+        last_timestamp = timestamp
+        events.append((timestamp + offset, fields[1], fields[2], int(fields[3])))
+
+    return events
+
+
+def convert(events):
+    """Convert the events to the Chrome trace format."""
+    trace_events = []
+    open_names = {}
+
+    for timestamp, phase, name, arg in events:
+        # The ring buffer may start in the middle of a duration, skip its end.
+        if "E" == phase:
+            if 0 == open_names.get(name, 0):
+                continue
+            open_names[name] -= 1
+        elif "B" == phase:
+            open_names[name] = open_names.get(name, 0) + 1
+
+        event = {
+            "name": name,
+            "ph": PHASES.get(phase, "i"),
+            "ts": timestamp,
+            "pid": 1,
+            "tid": 1
+        }
+
+        if "I" == phase:
+            event["s"] = "g"
+            event["args"] = {"arg": arg}
+
+        trace_events.append(event)
+
+    return {
+        "traceEvents": trace_events,
+        "displayTimeUnit": "ms",
+        "otherData": {"source": "RacingLapTimer"}
+    }
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="RacingLapTimer trace to Chrome trace format converter")
+    parser.add_argument("input", nargs="?", help="Downloaded trace file, default is stdin")
+    parser.add_argument("--url", help="Download the trace from the device, e.g. http://laptimer.local/trace")
+    parser.add_argument("-o", "--output", default="trace.json", help="Chrome trace file")
+    args = parser.parse_args()
+
+    if args.url is not None:
+        with urllib.request.urlopen(args.url, timeout=10) as response:
+            lines = response.read().decode("ascii", errors="replace").splitlines()
+    elif args.input is not None:
+        with open(args.input, encoding="ascii", errors="replace") as file:
+            lines = file.read().splitlines()
+    else:
+        lines = sys.stdin.read().splitlines()
+
+    trace = convert(parse(lines))
+
+    with open(args.output, "w", encoding="utf-8") as file:
+        json.dump(trace, file, indent=1)
+
+    print("%u events written to %s." % (len(trace["traceEvents"]), args.output))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Receiver for the RacingLapTimer UDP multicast timing event feed.
+
+Joins the multicast group and prints every received timing event.
+Lost datagrams are detected by the sequence number.
+
+Usage: udp_event_receiver.py [--group 239.255.76.84] [--port 7684] [--interface 0.0.0.0]
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+MULTICAST_GROUP = "239.255.76.84"
+MULTICAST_PORT = 7684
+PROTOCOL_VERSION = 1
+
+# Magic, version, type, sequence number, timestamp, group, rank, lap time
+DATAGRAM_FORMAT = ">2sBBIIBBI"
+DATAGRAM_SIZE = struct.calcsize(DATAGRAM_FORMAT)
+
+EVENT_TYPES = {
+    1: "STARTED",
+    2: "FINISHED",
+    3: "LEADERBOARD"
+}
+
+
+def format_lap_time(lap_time_ms):
+    """Format a lap time in ms as mm:ss.mmm."""
+    minutes, rest = divmod(lap_time_ms, 60 * 1000)
+    seconds, milliseconds = divmod(rest, 1000)
+    return "%02u:%02u.%03u" % (minutes, seconds, milliseconds)
+
+
+def decode(datagram):
+    """Decode a datagram. Returns a dict or None if the datagram is invalid."""
+    event = None
+
+    if DATAGRAM_SIZE <= len(datagram):
+        magic, version, event_type, seq, timestamp, group, rank, lap_time = \
+            struct.unpack_from(DATAGRAM_FORMAT, datagram)
+
+        if (b"RL" == magic) and (PROTOCOL_VERSION == version):
+            event = {
+                "type": EVENT_TYPES.get(event_type, "UNKNOWN(%u)" % event_type),
+                "seq": seq,
+                "timestamp": timestamp,
+                "group": group,
+                "rank": rank,
+                "lapTime": lap_time
+            }
+
+    return event
+
+
+def open_socket(group, port, interface):
+    """Open a UDP socket, which is member of the multicast group."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", port))
+
+    membership = struct.pack("4s4s", socket.inet_aton(group), socket.inet_aton(interface))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+
+    return sock
+
+
+def main():
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="RacingLapTimer UDP event feed receiver")
+    parser.add_argument("--group", default=MULTICAST_GROUP, help="Multicast group address")
+    parser.add_argument("--port", type=int, default=MULTICAST_PORT, help="Multicast port")
+    parser.add_argument("--interface", default="0.0.0.0", help="Local interface address")
+    args = parser.parse_args()
+
+    sock = open_socket(args.group, args.port, args.interface)
+    expected_seq = None
+    lost = 0
+
+    print("Listening on %s:%u ..." % (args.group, args.port))
+
+    try:
+        while True:
+            datagram, sender = sock.recvfrom(1024)
+            event = decode(datagram)
+
+            if event is None:
+                print("Invalid datagram from %s." % sender[0], file=sys.stderr)
+                continue
+
+            if (expected_seq is not None) and (event["seq"] != expected_seq):
+                lost += (event["seq"] - expected_seq) & 0xFFFFFFFF
+                print("Lost datagrams: %u" % lost, file=sys.stderr)
+
+            expected_seq = (event["seq"] + 1) & 0xFFFFFFFF
+
+            line = "%10u %-11s group %u" % (event["timestamp"], event["type"], event["group"])
+
+            if "FINISHED" == event["type"]:
+                line += " lap time %s" % format_lap_time(event["lapTime"])
+            elif "LEADERBOARD" == event["type"]:
+                if 0 == event["rank"]:
+                    line += " rank - lap time -"
+                else:
+                    line += " rank %u lap time %s" % (event["rank"], format_lap_time(event["lapTime"]))
+
+            print(line, flush=True)
+
+    except KeyboardInterrupt:
+        pass
+
+    sock.close()
+
+
+if __name__ == "__main__":
+    main()